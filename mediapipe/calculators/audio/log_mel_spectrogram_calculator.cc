@@ -0,0 +1,306 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"
+#include "absl/status/status.h"
+#include "audio/dsp/window_functions.h"
+#include "mediapipe/calculators/audio/log_mel_spectrogram_calculator.pb.h"
+#include "mediapipe/calculators/audio/mel_filterbank.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/formats/time_series_header.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/util/time_series_util.h"
+#include "pffft.h"
+
+namespace mediapipe {
+namespace api2 {
+
+namespace {
+
+// PFFFT only supports transforms for inputs of length N of the form
+// N = (2^a)*(3^b)*(5^c) where b >=0 and c >= 0 and a >= 5 for the real FFT.
+bool IsValidFftSize(int size) {
+  if (size <= 0) {
+    return false;
+  }
+  constexpr int kFactors[] = {2, 3, 5};
+  int factorization[] = {0, 0, 0};
+  int n = size;
+  for (int i = 0; i < 3; ++i) {
+    while (n % kFactors[i] == 0) {
+      n = n / kFactors[i];
+      ++factorization[i];
+    }
+  }
+  return factorization[0] >= 5 && n == 1;
+}
+
+}  // namespace
+
+// Computes the log mel spectrogram of a mono audio stream in one pass:
+// framing, periodic Hann window, real FFT, magnitude, mel filterbank and
+// stabilized log. The output matches the chain
+//   SpectrogramCalculator (SQUARED_MAGNITUDE, HANN)
+//   -> MelSpectrumCalculator -> StabilizedLogCalculator
+// up to single-precision rounding, but no intermediate Matrix is allocated:
+// the FFT runs on the SIMD code paths of PFFFT in a workspace preallocated in
+// Open(), and each frame's mel channels are written straight into the output
+// tensor.
+//
+// Each input packet results in at most one output packet holding the frames
+// completed by its samples, like SpectrogramCalculator. Output timestamps are
+// the timestamps of the first sample of the first frame in the tensor, counted
+// from the first input timestamp and the number of frames emitted so far.
+//
+// Inputs:
+//   AUDIO - mediapipe::Matrix
+//     Mono audio samples with a TimeSeriesHeader.
+//
+// Outputs:
+//   TENSORS - std::vector<Tensor>
+//     Vector containing a single float32 Tensor of shape
+//     [num_frames, num_mel_channels].
+//
+// Example:
+// node {
+//   calculator: "LogMelSpectrogramCalculator"
+//   input_stream: "AUDIO:audio"
+//   output_stream: "TENSORS:log_mel_tensors"
+//   options {
+//     [mediapipe.LogMelSpectrogramCalculatorOptions.ext] {
+//       frame_duration_seconds: 0.025
+//       frame_overlap_seconds: 0.015
+//       mel_spectrum_params {
+//         channel_count: 64
+//         min_frequency_hertz: 125.0
+//         max_frequency_hertz: 7500.0
+//       }
+//       stabilizer: 0.001
+//     }
+//   }
+// }
+class LogMelSpectrogramCalculator : public Node {
+ public:
+  static constexpr Input<Matrix> kAudioIn{"AUDIO"};
+  static constexpr Output<std::vector<Tensor>> kTensorsOut{"TENSORS"};
+  MEDIAPIPE_NODE_CONTRACT(kAudioIn, kTensorsOut);
+
+  ~LogMelSpectrogramCalculator() override;
+
+  absl::Status Open(CalculatorContext* cc) override;
+  absl::Status Process(CalculatorContext* cc) override;
+  absl::Status Close(CalculatorContext* cc) override;
+
+ private:
+  // Emits the log mel spectrogram of all the complete frames in
+  // `sample_buffer_` and drops the samples no later frame needs.
+  void ProcessSampleBuffer(CalculatorContext* cc);
+
+  // Computes the mel channels of the frame starting at `samples` into `mel`.
+  void ComputeMelFrame(const float* samples, float* mel);
+
+  Timestamp CumulativeOutputTimestamp() const {
+    return initial_input_timestamp_ +
+           std::round(cumulative_completed_frames_ * frame_step_samples_ *
+                      Timestamp::kTimestampUnitsPerSecond / sample_rate_);
+  }
+
+  double sample_rate_ = 0.0;
+  int frame_duration_samples_ = 0;
+  int frame_step_samples_ = 0;
+  bool pad_final_packet_ = true;
+  float stabilizer_ = 0.0f;
+  float output_scale_ = 1.0f;
+  std::optional<BandedMelFilterbank> mel_filterbank_;
+
+  // Samples received but not yet consumed by a complete frame.
+  std::vector<float> sample_buffer_;
+  int64_t cumulative_input_samples_ = 0;
+  int64_t cumulative_completed_frames_ = 0;
+  Timestamp initial_input_timestamp_ = Timestamp::Unstarted();
+
+  // The internal state of the FFT library.
+  PFFFT_Setup* fft_state_ = nullptr;
+  int fft_size_ = 0;
+  std::vector<float> window_;
+  // PFFFT requires SIMD-aligned buffers. The input is zero-padded past the
+  // frame, which ComputeMelFrame() never overwrites.
+  std::vector<float, Eigen::aligned_allocator<float>> fft_input_;
+  std::vector<float, Eigen::aligned_allocator<float>> fft_output_;
+  std::vector<float, Eigen::aligned_allocator<float>> fft_workspace_;
+  std::vector<float, Eigen::aligned_allocator<float>> magnitudes_;
+};
+MEDIAPIPE_REGISTER_NODE(LogMelSpectrogramCalculator);
+
+LogMelSpectrogramCalculator::~LogMelSpectrogramCalculator() {
+  if (fft_state_) {
+    pffft_destroy_setup(fft_state_);
+  }
+}
+
+absl::Status LogMelSpectrogramCalculator::Open(CalculatorContext* cc) {
+  const auto& options = cc->Options<LogMelSpectrogramCalculatorOptions>();
+  TimeSeriesHeader input_header;
+  ABSL_RETURN_IF_ERROR(time_series_util::FillTimeSeriesHeaderIfValid(
+      kAudioIn(cc).Header(), &input_header));
+  RET_CHECK_EQ(input_header.num_channels(), 1)
+      << "LogMelSpectrogramCalculator only supports mono audio.";
+  sample_rate_ = input_header.sample_rate();
+
+  RET_CHECK_GT(options.frame_duration_seconds(), 0.0)
+      << "frame_duration_seconds must be greater than 0.";
+  RET_CHECK(options.frame_overlap_seconds() >= 0.0 &&
+            options.frame_overlap_seconds() < options.frame_duration_seconds())
+      << "frame_overlap_seconds must be in [0, frame_duration_seconds).";
+  frame_duration_samples_ =
+      std::round(options.frame_duration_seconds() * sample_rate_);
+  frame_step_samples_ =
+      frame_duration_samples_ -
+      std::round(options.frame_overlap_seconds() * sample_rate_);
+  RET_CHECK_GT(frame_step_samples_, 0)
+      << "The frame step must be at least one sample.";
+  pad_final_packet_ = options.pad_final_packet();
+  stabilizer_ = options.stabilizer();
+  RET_CHECK_GE(stabilizer_, 0.0f) << "stabilizer must be >= 0.";
+  output_scale_ = options.output_scale();
+
+  fft_size_ = options.fft_size();
+  if (fft_size_ == 0) {
+    fft_size_ = 32;
+    while (fft_size_ < frame_duration_samples_) {
+      fft_size_ *= 2;
+    }
+  }
+  RET_CHECK(IsValidFftSize(fft_size_) && fft_size_ >= frame_duration_samples_)
+      << "FFT size must hold the " << frame_duration_samples_
+      << " samples of a frame and be of the form "
+      << "fft_size = (2^a)*(3^b)*(5^c) where b >=0 and c >= 0 and a >= 5, "
+      << "the requested fft_size is " << fft_size_;
+  fft_state_ = pffft_new_setup(fft_size_, PFFFT_REAL);
+  RET_CHECK(fft_state_ != nullptr);
+  audio_dsp::HannWindow().GetPeriodicSamples(frame_duration_samples_,
+                                             &window_);
+  fft_input_.assign(fft_size_, 0.0f);
+  fft_output_.resize(fft_size_);
+  fft_workspace_.resize(fft_size_);
+  magnitudes_.resize(fft_size_ / 2 + 1);
+
+  const auto& mel_options = options.mel_spectrum_params();
+  ABSL_ASSIGN_OR_RETURN(
+      mel_filterbank_,
+      BandedMelFilterbank::Create(magnitudes_.size(), sample_rate_,
+                                  mel_options.channel_count(),
+                                  mel_options.min_frequency_hertz(),
+                                  mel_options.max_frequency_hertz()));
+  return absl::OkStatus();
+}
+
+absl::Status LogMelSpectrogramCalculator::Process(CalculatorContext* cc) {
+  if (kAudioIn(cc).IsEmpty()) {
+    return absl::OkStatus();
+  }
+  if (initial_input_timestamp_ == Timestamp::Unstarted()) {
+    initial_input_timestamp_ = cc->InputTimestamp();
+  }
+  const Matrix& input = kAudioIn(cc).Get();
+  RET_CHECK_EQ(input.rows(), 1)
+      << "LogMelSpectrogramCalculator only supports mono audio.";
+  sample_buffer_.insert(sample_buffer_.end(), input.data(),
+                        input.data() + input.cols());
+  cumulative_input_samples_ += input.cols();
+  ProcessSampleBuffer(cc);
+  return absl::OkStatus();
+}
+
+absl::Status LogMelSpectrogramCalculator::Close(CalculatorContext* cc) {
+  if (cumulative_input_samples_ > 0 && pad_final_packet_) {
+    // Flush the remaining samples with frame_step_samples - 1 zeros, unless
+    // there are fewer than one frame's worth of samples, in which case pad to
+    // exactly one frame, as SpectrogramCalculator does.
+    int required_padding_samples = frame_step_samples_ - 1;
+    if (cumulative_input_samples_ < frame_duration_samples_) {
+      required_padding_samples =
+          frame_duration_samples_ - cumulative_input_samples_;
+    }
+    sample_buffer_.resize(sample_buffer_.size() + required_padding_samples,
+                          0.0f);
+    ProcessSampleBuffer(cc);
+  }
+  return absl::OkStatus();
+}
+
+void LogMelSpectrogramCalculator::ProcessSampleBuffer(CalculatorContext* cc) {
+  const int num_buffered_samples = sample_buffer_.size();
+  if (num_buffered_samples < frame_duration_samples_) {
+    return;
+  }
+  const int num_frames =
+      1 +
+      (num_buffered_samples - frame_duration_samples_) / frame_step_samples_;
+  const int num_channels = mel_filterbank_->channel_count();
+  Tensor tensor(Tensor::ElementType::kFloat32,
+                Tensor::Shape({num_frames, num_channels}));
+  {
+    auto view = tensor.GetCpuWriteView();
+    float* output = view.buffer<float>();
+    for (int frame = 0; frame < num_frames; ++frame) {
+      ComputeMelFrame(sample_buffer_.data() + frame * frame_step_samples_,
+                      output + frame * num_channels);
+    }
+    Eigen::Map<Eigen::ArrayXf> log_mel(output, num_frames * num_channels);
+    log_mel = output_scale_ * (log_mel + stabilizer_).log();
+  }
+  sample_buffer_.erase(
+      sample_buffer_.begin(),
+      sample_buffer_.begin() + num_frames * frame_step_samples_);
+
+  std::vector<Tensor> tensors;
+  tensors.push_back(std::move(tensor));
+  kTensorsOut(cc).Send(std::move(tensors), CumulativeOutputTimestamp());
+  cumulative_completed_frames_ += num_frames;
+  kTensorsOut(cc).SetNextTimestampBound(CumulativeOutputTimestamp());
+}
+
+void LogMelSpectrogramCalculator::ComputeMelFrame(const float* samples,
+                                                  float* mel) {
+  Eigen::Map<Eigen::ArrayXf>(fft_input_.data(), frame_duration_samples_) =
+      Eigen::Map<const Eigen::ArrayXf>(samples, frame_duration_samples_) *
+      Eigen::Map<const Eigen::ArrayXf>(window_.data(), frame_duration_samples_);
+  pffft_transform_ordered(fft_state_, fft_input_.data(), fft_output_.data(),
+                          fft_workspace_.data(), PFFFT_FORWARD);
+  // The ordered real transform packs the real DC and Nyquist terms into the
+  // first two values, followed by interleaved (re, im) pairs.
+  const int num_complex_bins = fft_size_ / 2 - 1;
+  using Strided = Eigen::Map<const Eigen::ArrayXf, 0, Eigen::InnerStride<2>>;
+  const Strided real(fft_output_.data() + 2, num_complex_bins);
+  const Strided imag(fft_output_.data() + 3, num_complex_bins);
+  magnitudes_.front() = std::abs(fft_output_[0]);
+  magnitudes_.back() = std::abs(fft_output_[1]);
+  Eigen::Map<Eigen::ArrayXf>(magnitudes_.data() + 1, num_complex_bins) =
+      (real.square() + imag.square()).sqrt();
+  mel_filterbank_->Compute(magnitudes_.data(), mel);
+}
+
+}  // namespace api2
+}  // namespace mediapipe
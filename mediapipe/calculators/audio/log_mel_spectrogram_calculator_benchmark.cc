@@ -0,0 +1,148 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the CPU cost per second of audio of a log mel spectrogram front
+// end, computed by the SpectrogramCalculator -> MelSpectrumCalculator ->
+// StabilizedLogCalculator chain and by the fused LogMelSpectrogramCalculator.
+// The "cpu_seconds_per_audio_second" counter reports the cost.
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/calculators/audio/log_mel_spectrogram_calculator.pb.h"
+#include "mediapipe/calculators/audio/mfcc_mel_calculators.pb.h"
+#include "mediapipe/calculators/audio/spectrogram_calculator.pb.h"
+#include "mediapipe/calculators/audio/stabilized_log_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/time_series_header.pb.h"
+#include "mediapipe/framework/packet.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr double kSampleRate = 16000.0;
+constexpr double kFrameDurationSeconds = 0.025;
+constexpr double kFrameOverlapSeconds = 0.015;
+constexpr int kMelChannels = 64;
+constexpr float kMinFrequencyHertz = 125.0;
+constexpr float kMaxFrequencyHertz = 7500.0;
+constexpr float kStabilizer = 0.001;
+// 10 seconds of audio in 100 ms packets.
+constexpr int kPacketSamples = 1600;
+constexpr int kNumPackets = 100;
+constexpr double kAudioSeconds = kNumPackets * kPacketSamples / kSampleRate;
+
+void SetMelSpectrumOptions(MelSpectrumCalculatorOptions* options) {
+  options->set_channel_count(kMelChannels);
+  options->set_min_frequency_hertz(kMinFrequencyHertz);
+  options->set_max_frequency_hertz(kMaxFrequencyHertz);
+}
+
+CalculatorGraphConfig::Node* AddNode(const std::string& calculator,
+                                     const std::string& input_stream,
+                                     const std::string& output_stream,
+                                     CalculatorGraphConfig* config) {
+  auto* node = config->add_node();
+  node->set_calculator(calculator);
+  node->add_input_stream(input_stream);
+  node->add_output_stream(output_stream);
+  return node;
+}
+
+CalculatorGraphConfig ChainConfig() {
+  CalculatorGraphConfig config;
+  config.add_input_stream("audio");
+  config.add_output_stream("log_mel");
+  auto* spectrogram_options =
+      AddNode("SpectrogramCalculator", "audio", "spectrogram", &config)
+          ->mutable_options()
+          ->MutableExtension(SpectrogramCalculatorOptions::ext);
+  spectrogram_options->set_frame_duration_seconds(kFrameDurationSeconds);
+  spectrogram_options->set_frame_overlap_seconds(kFrameOverlapSeconds);
+  SetMelSpectrumOptions(
+      AddNode("MelSpectrumCalculator", "spectrogram", "mel", &config)
+          ->mutable_options()
+          ->MutableExtension(MelSpectrumCalculatorOptions::ext));
+  AddNode("StabilizedLogCalculator", "mel", "log_mel", &config)
+      ->mutable_options()
+      ->MutableExtension(StabilizedLogCalculatorOptions::ext)
+      ->set_stabilizer(kStabilizer);
+  return config;
+}
+
+CalculatorGraphConfig FusedConfig() {
+  CalculatorGraphConfig config;
+  config.add_input_stream("audio");
+  config.add_output_stream("log_mel");
+  auto* options =
+      AddNode("LogMelSpectrogramCalculator", "AUDIO:audio", "TENSORS:log_mel",
+              &config)
+          ->mutable_options()
+          ->MutableExtension(LogMelSpectrogramCalculatorOptions::ext);
+  options->set_frame_duration_seconds(kFrameDurationSeconds);
+  options->set_frame_overlap_seconds(kFrameOverlapSeconds);
+  SetMelSpectrumOptions(options->mutable_mel_spectrum_params());
+  options->set_stabilizer(kStabilizer);
+  return config;
+}
+
+void RunFrontEnd(benchmark::State& state, const CalculatorGraphConfig& config) {
+  std::vector<Packet> input_packets;
+  input_packets.reserve(kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    input_packets.push_back(
+        MakePacket<Matrix>(Matrix::Random(1, kPacketSamples))
+            .At(Timestamp::FromSeconds(i * kPacketSamples / kSampleRate)));
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    CalculatorGraph graph;
+    ABSL_CHECK_OK(graph.Initialize(config));
+    auto header = std::make_unique<TimeSeriesHeader>();
+    header->set_sample_rate(kSampleRate);
+    header->set_num_channels(1);
+    state.ResumeTiming();
+
+    ABSL_CHECK_OK(graph.StartRun({}, {{"audio", Adopt(header.release())}}));
+    for (const auto& packet : input_packets) {
+      ABSL_CHECK_OK(graph.AddPacketToInputStream("audio", packet));
+    }
+    ABSL_CHECK_OK(graph.CloseAllInputStreams());
+    ABSL_CHECK_OK(graph.WaitUntilDone());
+  }
+  // The calculators run on the graph executor threads, hence the benchmarks
+  // measure the CPU time of the whole process, which this rate is based on.
+  state.counters["cpu_seconds_per_audio_second"] = benchmark::Counter(
+      kAudioSeconds, benchmark::Counter::kIsIterationInvariantRate |
+                         benchmark::Counter::kInvert);
+}
+
+void BM_SpectrogramMelLogChain(benchmark::State& state) {
+  RunFrontEnd(state, ChainConfig());
+}
+BENCHMARK(BM_SpectrogramMelLogChain)->MeasureProcessCPUTime();
+
+void BM_LogMelSpectrogramCalculator(benchmark::State& state) {
+  RunFrontEnd(state, FusedConfig());
+}
+BENCHMARK(BM_LogMelSpectrogramCalculator)->MeasureProcessCPUTime();
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
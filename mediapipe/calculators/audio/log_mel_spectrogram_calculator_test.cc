@@ -0,0 +1,180 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "absl/strings/substitute.h"
+#include "audio/dsp/mfcc/mel_filterbank.h"
+#include "audio/dsp/window_functions.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/formats/time_series_header.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr double kSampleRate = 8000.0;
+constexpr int kFrameSamples = 256;
+constexpr int kStepSamples = 128;
+constexpr int kMelChannels = 20;
+constexpr double kStabilizer = 0.001;
+
+std::unique_ptr<CalculatorRunner> CreateRunner(int fft_size = 0) {
+  return std::make_unique<CalculatorRunner>(absl::Substitute(
+      R"pb(
+        calculator: "LogMelSpectrogramCalculator"
+        input_stream: "AUDIO:audio"
+        output_stream: "TENSORS:tensors"
+        options {
+          [mediapipe.LogMelSpectrogramCalculatorOptions.ext] {
+            frame_duration_seconds: 0.032
+            frame_overlap_seconds: 0.016
+            fft_size: $0
+            mel_spectrum_params { channel_count: $1 }
+            stabilizer: $2
+          }
+        }
+      )pb",
+      fft_size, kMelChannels, kStabilizer));
+}
+
+void AddHeader(CalculatorRunner& runner) {
+  auto header = std::make_unique<TimeSeriesHeader>();
+  header->set_sample_rate(kSampleRate);
+  header->set_num_channels(1);
+  runner.MutableInputs()->Tag("AUDIO").header = Adopt(header.release());
+}
+
+// A tone over white noise, so that every mel channel carries energy well
+// above single-precision rounding.
+std::vector<float> MakeSignal(int num_samples) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
+  std::vector<float> signal(num_samples);
+  for (int i = 0; i < num_samples; ++i) {
+    signal[i] =
+        0.5 * std::sin(2 * M_PI * 440.0 * i / kSampleRate) + noise(rng);
+  }
+  return signal;
+}
+
+// Computes the log mel spectrogram of the frame starting at `start` with the
+// same steps as SpectrogramCalculator, MelSpectrumCalculator and
+// StabilizedLogCalculator, in double precision and with a direct DFT.
+std::vector<double> ReferenceLogMel(const std::vector<float>& signal,
+                                    int start,
+                                    const audio_dsp::MelFilterbank& mel) {
+  constexpr int kFftSize = 256;
+  std::vector<double> window;
+  audio_dsp::HannWindow().GetPeriodicSamples(kFrameSamples, &window);
+  std::vector<double> squared_magnitudes(kFftSize / 2 + 1);
+  for (int k = 0; k < squared_magnitudes.size(); ++k) {
+    double real = 0.0;
+    double imag = 0.0;
+    for (int n = 0; n < kFrameSamples; ++n) {
+      const double x = signal[start + n] * window[n];
+      real += x * std::cos(2 * M_PI * k * n / kFftSize);
+      imag -= x * std::sin(2 * M_PI * k * n / kFftSize);
+    }
+    squared_magnitudes[k] = real * real + imag * imag;
+  }
+  std::vector<double> log_mel;
+  mel.Compute(squared_magnitudes, &log_mel);
+  for (double& value : log_mel) {
+    value = std::log(value + kStabilizer);
+  }
+  return log_mel;
+}
+
+TEST(LogMelSpectrogramCalculatorTest, MatchesSpectrogramMelLogChain) {
+  constexpr int kPacketSamples = 1000;
+  constexpr int kNumPackets = 2;
+  std::vector<float> signal = MakeSignal(kNumPackets * kPacketSamples);
+
+  auto runner = CreateRunner();
+  AddHeader(*runner);
+  for (int i = 0; i < kNumPackets; ++i) {
+    runner->MutableInputs()->Tag("AUDIO").packets.push_back(
+        MakePacket<Matrix>(Eigen::Map<const Matrix>(
+                               signal.data() + i * kPacketSamples, 1,
+                               kPacketSamples))
+            .At(Timestamp(i * kPacketSamples * 1e6 / kSampleRate)));
+  }
+  MP_ASSERT_OK(runner->Run());
+
+  // 1000 samples complete 6 frames, 2000 samples 14 frames, and the final
+  // padding completes one more.
+  const auto& packets = runner->Outputs().Tag("TENSORS").packets;
+  ASSERT_EQ(packets.size(), 3);
+  EXPECT_EQ(packets[0].Timestamp(), Timestamp(0));
+  EXPECT_EQ(packets[1].Timestamp(),
+            Timestamp(6 * kStepSamples * 1e6 / kSampleRate));
+  EXPECT_EQ(packets[2].Timestamp(),
+            Timestamp(14 * kStepSamples * 1e6 / kSampleRate));
+
+  audio_dsp::MelFilterbank mel;
+  ASSERT_TRUE(mel.Initialize(/*input_length=*/129, kSampleRate, kMelChannels,
+                             /*lower_frequency_limit=*/125.0,
+                             /*upper_frequency_limit=*/3800.0));
+  signal.resize(signal.size() + kStepSamples - 1, 0.0f);
+  const int expected_num_frames[] = {6, 8, 1};
+  int frame = 0;
+  for (int i = 0; i < packets.size(); ++i) {
+    const auto& tensors = packets[i].Get<std::vector<Tensor>>();
+    ASSERT_EQ(tensors.size(), 1);
+    EXPECT_EQ(tensors[0].shape().dims,
+              std::vector<int>({expected_num_frames[i], kMelChannels}));
+    auto view = tensors[0].GetCpuReadView();
+    const float* log_mel = view.buffer<float>();
+    for (int f = 0; f < expected_num_frames[i]; ++f, ++frame) {
+      const std::vector<double> expected =
+          ReferenceLogMel(signal, frame * kStepSamples, mel);
+      for (int c = 0; c < kMelChannels; ++c) {
+        EXPECT_NEAR(log_mel[f * kMelChannels + c], expected[c], 1e-3)
+            << "frame " << frame << ", channel " << c;
+      }
+    }
+  }
+}
+
+TEST(LogMelSpectrogramCalculatorTest, ShortInputIsPaddedToOneFrame) {
+  auto runner = CreateRunner();
+  AddHeader(*runner);
+  runner->MutableInputs()->Tag("AUDIO").packets.push_back(
+      MakePacket<Matrix>(Matrix::Ones(1, 100)).At(Timestamp(0)));
+  MP_ASSERT_OK(runner->Run());
+
+  const auto& packets = runner->Outputs().Tag("TENSORS").packets;
+  ASSERT_EQ(packets.size(), 1);
+  EXPECT_EQ(packets[0].Get<std::vector<Tensor>>()[0].shape().dims,
+            std::vector<int>({1, kMelChannels}));
+}
+
+TEST(LogMelSpectrogramCalculatorTest, FailsWithFftSizeShorterThanFrame) {
+  auto runner = CreateRunner(/*fft_size=*/128);
+  AddHeader(*runner);
+  EXPECT_THAT(runner->Run().message(),
+              testing::HasSubstr("FFT size must hold the 256 samples"));
+}
+
+}  // namespace
+}  // namespace mediapipe
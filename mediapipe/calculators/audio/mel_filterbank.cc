@@ -0,0 +1,159 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/audio/mel_filterbank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Eigen/Core"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Frames per block in ComputeFrames(). The magnitudes of a block of 257-bin
+// frames take 32 KiB, which stays in the L1 or L2 cache of common CPUs while
+// every channel reads its band of them.
+constexpr int kFramesPerBlock = 32;
+
+double FreqToMel(double freq) { return 1127.0 * std::log1p(freq / 700.0); }
+
+}  // namespace
+
+absl::StatusOr<BandedMelFilterbank> BandedMelFilterbank::Create(
+    int input_length, double sample_rate, int channel_count,
+    double lower_frequency_limit, double upper_frequency_limit) {
+  if (channel_count < 1 || sample_rate <= 0 || input_length < 2 ||
+      lower_frequency_limit < 0 ||
+      upper_frequency_limit <= lower_frequency_limit) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Invalid mel filterbank: input_length=", input_length,
+        ", sample_rate=", sample_rate, ", channel_count=", channel_count,
+        ", frequency limits=[", lower_frequency_limit, ", ",
+        upper_frequency_limit, "]"));
+  }
+
+  // The channel layout follows audio_dsp::MelFilterbank::Initialize(): an
+  // extra center frequency is computed at the top to get the upper limit on
+  // the high side of the final triangular filter, and DC is always excluded
+  // to emulate HTK.
+  std::vector<double> center_frequencies(channel_count + 1);
+  const double mel_low = FreqToMel(lower_frequency_limit);
+  const double mel_high = FreqToMel(upper_frequency_limit);
+  const double mel_spacing = (mel_high - mel_low) / (channel_count + 1);
+  for (int i = 0; i < channel_count + 1; ++i) {
+    center_frequencies[i] = mel_low + mel_spacing * (i + 1);
+  }
+  const double hz_per_bin = 0.5 * sample_rate / (input_length - 1);
+  const int start_bin =
+      static_cast<int>(1.5 + lower_frequency_limit / hz_per_bin);
+  const int end_bin = std::min(
+      static_cast<int>(upper_frequency_limit / hz_per_bin), input_length - 1);
+
+  // Each bin contributes `weight` to the channel whose downward slope it lies
+  // on and `1 - weight` to the upward slope of the next channel.
+  Eigen::MatrixXd dense_weights =
+      Eigen::MatrixXd::Zero(channel_count, input_length);
+  int channel = 0;
+  for (int i = start_bin; i <= end_bin; ++i) {
+    const double mel = FreqToMel(i * hz_per_bin);
+    while (channel < channel_count && center_frequencies[channel] < mel) {
+      ++channel;
+    }
+    const int lower_channel = channel - 1;
+    const double weight =
+        lower_channel >= 0
+            ? (center_frequencies[lower_channel + 1] - mel) /
+                  (center_frequencies[lower_channel + 1] -
+                   center_frequencies[lower_channel])
+            : (center_frequencies[0] - mel) / (center_frequencies[0] - mel_low);
+    if (lower_channel >= 0) {
+      dense_weights(lower_channel, i) += weight;
+    }
+    if (lower_channel + 1 < channel_count) {
+      dense_weights(lower_channel + 1, i) += 1.0 - weight;
+    }
+  }
+
+  BandedMelFilterbank filterbank;
+  filterbank.input_length_ = input_length;
+  filterbank.bands_.reserve(channel_count);
+  for (int c = 0; c < channel_count; ++c) {
+    int first = 0;
+    while (first < input_length && dense_weights(c, first) == 0.0) ++first;
+    int last = input_length - 1;
+    while (last >= first && dense_weights(c, last) == 0.0) --last;
+    const Band band = {.first_bin = first,
+                       .num_bins = last - first + 1,
+                       .weights_offset =
+                           static_cast<int>(filterbank.weights_.size())};
+    for (int i = first; i <= last; ++i) {
+      filterbank.weights_.push_back(static_cast<float>(dense_weights(c, i)));
+    }
+    filterbank.bands_.push_back(band);
+  }
+  return filterbank;
+}
+
+void BandedMelFilterbank::Compute(const float* magnitudes,
+                                  float* output) const {
+  for (int c = 0; c < channel_count(); ++c) {
+    const Band& band = bands_[c];
+    output[c] =
+        Eigen::Map<const Eigen::VectorXf>(magnitudes + band.first_bin,
+                                          band.num_bins)
+            .dot(Eigen::Map<const Eigen::VectorXf>(
+                weights_.data() + band.weights_offset, band.num_bins));
+  }
+}
+
+void BandedMelFilterbank::ComputeFrames(
+    const Eigen::MatrixXf& squared_magnitudes, Eigen::MatrixXf* output) const {
+  const int num_frames = squared_magnitudes.cols();
+  output->resize(channel_count(), num_frames);
+  // Within a block, frames run along the fixed-size columns of the transposed
+  // magnitudes, so every band weight scales a contiguous, unrolled run of
+  // frames instead of reducing over a short band.
+  using Block = Eigen::Matrix<float, kFramesPerBlock, Eigen::Dynamic>;
+  Block magnitudes(kFramesPerBlock, input_length_);
+  Block mel(kFramesPerBlock, channel_count());
+  for (int start = 0; start < num_frames; start += kFramesPerBlock) {
+    const int block_frames = std::min(kFramesPerBlock, num_frames - start);
+    if (block_frames < kFramesPerBlock) {
+      magnitudes.setZero();
+    }
+    magnitudes.topRows(block_frames) =
+        squared_magnitudes.middleCols(start, block_frames)
+            .transpose()
+            .cwiseSqrt();
+    for (int c = 0; c < channel_count(); ++c) {
+      const Band& band = bands_[c];
+      auto channel = mel.col(c);
+      channel.setZero();
+      for (int i = 0; i < band.num_bins; ++i) {
+        channel += weights_[band.weights_offset + i] *
+                   magnitudes.col(band.first_bin + i);
+      }
+    }
+    output->middleCols(start, block_frames) =
+        mel.topRows(block_frames).transpose();
+  }
+}
+
+}  // namespace mediapipe
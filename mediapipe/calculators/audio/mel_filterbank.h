@@ -0,0 +1,77 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_AUDIO_MEL_FILTERBANK_H_
+#define MEDIAPIPE_CALCULATORS_AUDIO_MEL_FILTERBANK_H_
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "absl/status/statusor.h"
+
+namespace mediapipe {
+
+// Single-precision equivalent of audio_dsp::MelFilterbank.
+//
+// audio_dsp::MelFilterbank splits every spectrogram bin between two adjacent
+// triangular mel channels, so each channel only weighs a contiguous band of
+// bins. The filterbank is therefore stored as a banded matrix: one
+// contiguous run of weights per channel, which makes every channel a short
+// dense dot product that Eigen vectorizes.
+class BandedMelFilterbank {
+ public:
+  // Same parameters and validity checks as audio_dsp::MelFilterbank:
+  // `input_length` is the number of spectrogram bins (fft_size / 2 + 1),
+  // `sample_rate` the sample rate of the audio the spectrogram was computed
+  // from, and the triangular channels span [lower_frequency_limit,
+  // upper_frequency_limit] Hz.
+  static absl::StatusOr<BandedMelFilterbank> Create(
+      int input_length, double sample_rate, int channel_count,
+      double lower_frequency_limit, double upper_frequency_limit);
+
+  int input_length() const { return input_length_; }
+  int channel_count() const { return static_cast<int>(bands_.size()); }
+
+  // Computes the `channel_count()` mel channels of one frame of linear
+  // magnitudes (`input_length()` values, i.e. the square root of the
+  // SQUARED_MAGNITUDE spectrogram that audio_dsp::MelFilterbank consumes).
+  void Compute(const float* magnitudes, float* output) const;
+
+  // Computes the mel channels of a batch of SQUARED_MAGNITUDE spectrogram
+  // frames, one frame per column of `squared_magnitudes` (which must have
+  // `input_length()` rows), into the columns of `output`. Frames are processed
+  // in cache-sized blocks, vectorized across the frames of a block.
+  void ComputeFrames(const Eigen::MatrixXf& squared_magnitudes,
+                     Eigen::MatrixXf* output) const;
+
+ private:
+  struct Band {
+    // First spectrogram bin weighed by the channel.
+    int first_bin;
+    // Number of consecutive bins weighed by the channel.
+    int num_bins;
+    // Offset of the first weight of the band in `weights_`.
+    int weights_offset;
+  };
+
+  BandedMelFilterbank() = default;
+
+  int input_length_ = 0;
+  std::vector<Band> bands_;
+  std::vector<float> weights_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_AUDIO_MEL_FILTERBANK_H_
@@ -12,28 +12,35 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
-// MediaPipe Calculator wrapper around audio/dsp/mfcc/
+// MediaPipe Calculators computing the outputs of audio/dsp/mfcc/
 // classes MelFilterbank (magnitude spectrograms warped to the Mel
 // approximation of the auditory frequency scale) and Mfcc (Mel Frequency
 // Cepstral Coefficients, the decorrelated transform of log-Mel-spectrum
 // commonly used as acoustic features in speech and other audio tasks.
 // Both calculators expect as input the SQUARED_MAGNITUDE-domain outputs
 // from the MediaPipe SpectrogramCalculator object.
+//
+// Rather than calling audio_dsp one frame at a time in double precision, the
+// calculators transform all the frames of an input packet at once in float:
+// the mel filterbank is a precomputed banded matrix (BandedMelFilterbank) and
+// the MFCC DCT a precomputed dense matrix. The results match audio_dsp up to
+// single-precision rounding.
+#include <cmath>
 #include <memory>
-#include <vector>
+#include <optional>
+#include <string>
 
 #include "Eigen/Core"
-#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
-#include "audio/dsp/mfcc/mel_filterbank.h"
-#include "audio/dsp/mfcc/mfcc.h"
+#include "mediapipe/calculators/audio/mel_filterbank.h"
 #include "mediapipe/calculators/audio/mfcc_mel_calculators.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/time_series_header.pb.h"
-#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/util/time_series_util.h"
 
@@ -60,7 +67,7 @@ std::string PortableDebugString(const TimeSeriesHeader& header) {
 // Abstract base class for Calculators that transform feature vectors on a
 // frame-by-frame basis.
 // Subclasses must override pure virtual methods ConfigureTransform and
-// TransformFrame.
+// TransformFrames.
 // Input and output MediaPipe packets are matrices with one column per frame,
 // and one row per feature dimension.  Each input packet results in an
 // output packet with the same number of columns (but differing numbers of
@@ -94,12 +101,13 @@ class FramewiseTransformCalculatorBase : public CalculatorBase {
   virtual absl::Status ConfigureTransform(const TimeSeriesHeader& header,
                                           CalculatorContext* cc) = 0;
 
-  // Takes a vector<double> corresponding to an input frame, and
-  // perform the specific transformation to produce an output frame.
-  virtual void TransformFrame(const std::vector<double>& input,
-                              std::vector<double>* output) const = 0;
+  // Takes a Matrix with one input frame per column, and performs the
+  // specific transformation to produce the output frames in the columns of
+  // `output`, which is already sized to num_output_channels() rows.
+  virtual void TransformFrames(const Matrix& input, Matrix* output) const = 0;
 
  private:
+  int num_input_channels_;
   int num_output_channels_;
 };
 
@@ -108,6 +116,7 @@ absl::Status FramewiseTransformCalculatorBase::Open(CalculatorContext* cc) {
   ABSL_RETURN_IF_ERROR(time_series_util::FillTimeSeriesHeaderIfValid(
       cc->Inputs().Index(0).Header(), &input_header));
 
+  num_input_channels_ = input_header.num_channels();
   absl::Status status = ConfigureTransform(input_header, cc);
 
   auto output_header = new TimeSeriesHeader(input_header);
@@ -121,35 +130,17 @@ absl::Status FramewiseTransformCalculatorBase::Open(CalculatorContext* cc) {
 
 absl::Status FramewiseTransformCalculatorBase::Process(CalculatorContext* cc) {
   const Matrix& input = cc->Inputs().Index(0).Get<Matrix>();
-  const int num_frames = input.cols();
-  std::unique_ptr<Matrix> output(new Matrix(num_output_channels_, num_frames));
-  // The main work here is converting each column of the float Matrix
-  // into a vector of doubles, which is what our target functions from
-  // dsp_core consume, and doing the reverse with their output.
-  std::vector<double> input_frame(input.rows());
-  std::vector<double> output_frame(num_output_channels_);
-
-  for (int frame = 0; frame < num_frames; ++frame) {
-    // Copy input from Eigen::Matrix column to vector<float>.
-    Eigen::Map<Eigen::MatrixXd> input_frame_map(&input_frame[0],
-                                                input_frame.size(), 1);
-    input_frame_map = input.col(frame).cast<double>();
-
-    // Perform the actual transformation.
-    TransformFrame(input_frame, &output_frame);
-
-    // Copy output from vector<float> to Eigen::Vector.
-    ABSL_CHECK_EQ(output_frame.size(), num_output_channels_);
-    Eigen::Map<const Eigen::MatrixXd> output_frame_map(&output_frame[0],
-                                                       output_frame.size(), 1);
-    output->col(frame) = output_frame_map.cast<float>();
-  }
+  RET_CHECK_EQ(input.rows(), num_input_channels_)
+      << "Input frames do not match the number of channels of the input "
+         "TimeSeriesHeader.";
+  auto output = std::make_unique<Matrix>(num_output_channels_, input.cols());
+  TransformFrames(input, output.get());
   cc->Outputs().Index(0).Add(output.release(), cc->InputTimestamp());
 
   return absl::OkStatus();
 }
 
-// Calculator wrapper around the dsp/mfcc/mfcc.cc routine.
+// Calculator computing the output of the dsp/mfcc/mfcc.cc routine.
 // Take frames of squared-magnitude spectra from the SpectrogramCalculator
 // and convert them into Mel Frequency Cepstral Coefficients.
 //
@@ -176,52 +167,65 @@ class MfccCalculator : public FramewiseTransformCalculatorBase {
   }
 
  private:
+  // Mel energies are floored at this value before the log, as in
+  // audio_dsp::Mfcc.
+  static constexpr float kFilterbankFloor = 1e-12;
+
   absl::Status ConfigureTransform(const TimeSeriesHeader& header,
                                   CalculatorContext* cc) override {
     MfccCalculatorOptions mfcc_options = cc->Options<MfccCalculatorOptions>();
-    mfcc_.reset(new audio_dsp::Mfcc());
     int input_length = header.num_channels();
-    // Set up the parameters to the Mfcc object.
     set_num_output_channels(mfcc_options.mfcc_count());
-    mfcc_->set_dct_coefficient_count(num_output_channels());
-    mfcc_->set_upper_frequency_limit(
-        mfcc_options.mel_spectrum_params().max_frequency_hertz());
-    mfcc_->set_lower_frequency_limit(
-        mfcc_options.mel_spectrum_params().min_frequency_hertz());
-    mfcc_->set_filterbank_channel_count(
-        mfcc_options.mel_spectrum_params().channel_count());
     // An upstream calculator (such as SpectrogramCalculator) must store
     // the sample rate of its input audio waveform in the TimeSeries Header.
-    // audio_dsp::MelFilterBank needs to know this to
-    // correctly interpret the spectrogram bins.
+    // The mel filterbank needs to know this to correctly interpret the
+    // spectrogram bins.
     if (!header.has_audio_sample_rate()) {
       return absl::InvalidArgumentError(
           absl::StrCat("No audio_sample_rate in input TimeSeriesHeader ",
                        PortableDebugString(header)));
     }
-    // Now we can initialize the Mfcc object.
-    bool initialized =
-        mfcc_->Initialize(input_length, header.audio_sample_rate());
-
-    if (initialized) {
-      return absl::OkStatus();
-    } else {
-      return absl::Status(absl::StatusCode::kInternal,
-                          "Mfcc::Initialize returned uninitialized");
+    const MelSpectrumCalculatorOptions& mel_options =
+        mfcc_options.mel_spectrum_params();
+    ABSL_ASSIGN_OR_RETURN(
+        mel_filterbank_,
+        BandedMelFilterbank::Create(input_length, header.audio_sample_rate(),
+                                    mel_options.channel_count(),
+                                    mel_options.min_frequency_hertz(),
+                                    mel_options.max_frequency_hertz()));
+    if (num_output_channels() > mel_options.channel_count()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "mfcc_count (", num_output_channels(),
+          ") must not exceed the mel channel_count (",
+          mel_options.channel_count(), ")"));
+    }
+    // The DCT-II of audio_dsp::MfccDct, as a matrix applied to the log mel
+    // spectrum of all the frames at once.
+    const int num_channels = mel_options.channel_count();
+    const double scale = std::sqrt(2.0 / num_channels);
+    dct_.resize(num_output_channels(), num_channels);
+    for (int i = 0; i < num_output_channels(); ++i) {
+      for (int j = 0; j < num_channels; ++j) {
+        dct_(i, j) = scale * std::cos(M_PI / num_channels * (j + 0.5) * i);
+      }
     }
+    return absl::OkStatus();
   }
 
-  void TransformFrame(const std::vector<double>& input,
-                      std::vector<double>* output) const override {
-    mfcc_->Compute(input, output);
+  void TransformFrames(const Matrix& input, Matrix* output) const override {
+    Matrix log_mel;
+    mel_filterbank_->ComputeFrames(input, &log_mel);
+    log_mel = log_mel.array().max(kFilterbankFloor).log().matrix();
+    output->noalias() = dct_ * log_mel;
   }
 
  private:
-  std::unique_ptr<audio_dsp::Mfcc> mfcc_;
+  std::optional<BandedMelFilterbank> mel_filterbank_;
+  Matrix dct_;
 };
 REGISTER_CALCULATOR(MfccCalculator);
 
-// Calculator wrapper around the dsp/mfcc/mel_filterbank.cc routine.
+// Calculator computing the output of the dsp/mfcc/mel_filterbank.cc routine.
 // Take frames of squared-magnitude spectra from the SpectrogramCalculator
 // and convert them into Mel-warped (linear-magnitude) spectra.
 // Note: This code computes a mel-frequency filterbank, using a simple
@@ -238,38 +242,32 @@ class MelSpectrumCalculator : public FramewiseTransformCalculatorBase {
                                   CalculatorContext* cc) override {
     MelSpectrumCalculatorOptions mel_spectrum_options =
         cc->Options<MelSpectrumCalculatorOptions>();
-    mel_filterbank_.reset(new audio_dsp::MelFilterbank());
     int input_length = header.num_channels();
     set_num_output_channels(mel_spectrum_options.channel_count());
     // An upstream calculator (such as SpectrogramCalculator) must store
     // the sample rate of its input audio waveform in the TimeSeries Header.
-    // audio_dsp::MelFilterBank needs to know this to
-    // correctly interpret the spectrogram bins.
+    // The mel filterbank needs to know this to correctly interpret the
+    // spectrogram bins.
     if (!header.has_audio_sample_rate()) {
       return absl::InvalidArgumentError(
           absl::StrCat("No audio_sample_rate in input TimeSeriesHeader ",
                        PortableDebugString(header)));
     }
-    bool initialized = mel_filterbank_->Initialize(
-        input_length, header.audio_sample_rate(), num_output_channels(),
-        mel_spectrum_options.min_frequency_hertz(),
-        mel_spectrum_options.max_frequency_hertz());
-
-    if (initialized) {
-      return absl::OkStatus();
-    } else {
-      return absl::Status(absl::StatusCode::kInternal,
-                          "mfcc::Initialize returned uninitialized");
-    }
+    ABSL_ASSIGN_OR_RETURN(
+        mel_filterbank_,
+        BandedMelFilterbank::Create(
+            input_length, header.audio_sample_rate(), num_output_channels(),
+            mel_spectrum_options.min_frequency_hertz(),
+            mel_spectrum_options.max_frequency_hertz()));
+    return absl::OkStatus();
   }
 
-  void TransformFrame(const std::vector<double>& input,
-                      std::vector<double>* output) const override {
-    mel_filterbank_->Compute(input, output);
+  void TransformFrames(const Matrix& input, Matrix* output) const override {
+    mel_filterbank_->ComputeFrames(input, output);
   }
 
  private:
-  std::unique_ptr<audio_dsp::MelFilterbank> mel_filterbank_;
+  std::optional<BandedMelFilterbank> mel_filterbank_;
 };
 REGISTER_CALCULATOR(MelSpectrumCalculator);
 
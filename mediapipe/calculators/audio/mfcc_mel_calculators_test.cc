@@ -11,9 +11,14 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <vector>
 
 #include "Eigen/Core"
+#include "audio/dsp/mfcc/mel_filterbank.h"
+#include "audio/dsp/mfcc/mfcc.h"
 #include "mediapipe/calculators/audio/mfcc_mel_calculators.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/matrix.h"
@@ -99,6 +104,32 @@ class FramewiseTransformCalculatorTest
     }
   }
 
+  // Checks that every output frame is within `tolerance` (relative to values
+  // larger than 1) of `transform` applied to the input frame in double
+  // precision.
+  void ExpectFramesNear(
+      const std::function<void(const std::vector<double>&,
+                               std::vector<double>*)>& transform,
+      double tolerance) {
+    ASSERT_EQ(this->output().packets.size(), this->input().packets.size());
+    for (int i = 0; i < this->input().packets.size(); ++i) {
+      const Matrix& input = this->input().packets[i].template Get<Matrix>();
+      const Matrix& output = this->output().packets[i].template Get<Matrix>();
+      for (int frame = 0; frame < input.cols(); ++frame) {
+        const std::vector<double> input_frame(
+            input.col(frame).data(), input.col(frame).data() + input.rows());
+        std::vector<double> expected;
+        transform(input_frame, &expected);
+        ASSERT_EQ(expected.size(), output.rows());
+        for (int c = 0; c < expected.size(); ++c) {
+          EXPECT_NEAR(output(c, frame), expected[c],
+                      tolerance * std::max(1.0, std::abs(expected[c])))
+              << "packet " << i << ", frame " << frame << ", channel " << c;
+        }
+      }
+    }
+  }
+
   // Allows SetupRandomInputPackets() to inform CheckResults() about how
   // big the packets are supposed to be.
   int num_samples_per_packet_;
@@ -125,6 +156,31 @@ TEST_F(MfccCalculatorTest, NoAudioSampleRate) {
   EXPECT_FALSE(Run().ok());
 }
 
+TEST_F(MfccCalculatorTest, MatchesAudioDspMfcc) {
+  audio_sample_rate_ = kAudioSampleRate;
+  options_.set_mfcc_count(20);
+  options_.mutable_mel_spectrum_params()->set_channel_count(40);
+  SetupGraphAndHeader();
+  SetupRandomInputPackets();
+
+  MP_ASSERT_OK(Run());
+
+  audio_dsp::Mfcc mfcc;
+  mfcc.set_dct_coefficient_count(options_.mfcc_count());
+  mfcc.set_upper_frequency_limit(
+      options_.mel_spectrum_params().max_frequency_hertz());
+  mfcc.set_lower_frequency_limit(
+      options_.mel_spectrum_params().min_frequency_hertz());
+  mfcc.set_filterbank_channel_count(
+      options_.mel_spectrum_params().channel_count());
+  ASSERT_TRUE(mfcc.Initialize(num_input_channels_, kAudioSampleRate));
+  ExpectFramesNear(
+      [&mfcc](const std::vector<double>& input, std::vector<double>* output) {
+        mfcc.Compute(input, output);
+      },
+      /*tolerance=*/1e-4);
+}
+
 constexpr char kMelSpectrumCalculator[] = "MelSpectrumCalculator";
 typedef FramewiseTransformCalculatorTest<MelSpectrumCalculatorOptions,
                                          kMelSpectrumCalculator>
@@ -138,6 +194,25 @@ TEST_F(MelSpectrumCalculatorTest, AudioSampleRateFromInputHeader) {
 
   CheckResults(options_.channel_count());
 }
+TEST_F(MelSpectrumCalculatorTest, MatchesAudioDspMelFilterbank) {
+  audio_sample_rate_ = kAudioSampleRate;
+  options_.set_channel_count(40);
+  SetupGraphAndHeader();
+  SetupRandomInputPackets();
+
+  MP_ASSERT_OK(Run());
+
+  audio_dsp::MelFilterbank mel_filterbank;
+  ASSERT_TRUE(mel_filterbank.Initialize(
+      num_input_channels_, kAudioSampleRate, options_.channel_count(),
+      options_.min_frequency_hertz(), options_.max_frequency_hertz()));
+  ExpectFramesNear(
+      [&mel_filterbank](const std::vector<double>& input,
+                        std::vector<double>* output) {
+        mel_filterbank.Compute(input, output);
+      },
+      /*tolerance=*/1e-5);
+}
 TEST_F(MelSpectrumCalculatorTest, NoAudioSampleRate) {
   // Leave audio_sample_rate_ == kUnset, so it is not present in the
   // input TimeSeriesHeader; expect failure.
@@ -17,6 +17,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/gpu/gpu_buffer_format.h"
 
 #if !MEDIAPIPE_DISABLE_GPU
 #include "mediapipe/gpu/gl_calculator_helper.h"
@@ -32,6 +33,24 @@ using GpuBuffer = AnyType;
 using GpuBuffer = mediapipe::GpuBuffer;
 #endif  // MEDIAPIPE_DISABLE_GPU
 
+namespace {
+
+// Whether `image` holds YUV planes on the CPU, e.g. from YUVToImageCalculator.
+bool IsCpuYuvImage(const Image& image) {
+  if (image.UsesGpu()) return false;
+  switch (image.format()) {
+    case GpuBufferFormat::kNV12:
+    case GpuBufferFormat::kNV21:
+    case GpuBufferFormat::kI420:
+    case GpuBufferFormat::kYV12:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 // Clones an input image and makes sure in the output clone the pixel data are
 // stored on the target storage (CPU vs GPU) specified in the calculator option.
 //
@@ -86,6 +105,10 @@ class ImageCloneCalculator : public Node {
       // the input Image.
       output = std::make_unique<Image>(input.GetGpuBuffer());
 #endif  // !MEDIAPIPE_DISABLE_GPU
+    } else if (IsCpuYuvImage(input)) {
+      // Co-own the YUV storage rather than converting the whole frame to an
+      // ImageFrame, so that CPU consumers can sample the planes directly.
+      output = std::make_unique<Image>(input);
     } else {
       // Make a copy of the input packet to co-own the input Image.
       mediapipe::Packet* packet_copy_ptr =
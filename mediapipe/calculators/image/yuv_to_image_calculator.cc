@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -19,13 +20,17 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "libyuv/convert_argb.h"
+#include "libyuv/planar_functions.h"
 #include "libyuv/video_common.h"
+#include "mediapipe/calculators/image/yuv_to_image_calculator.pb.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/yuv_image.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/gpu/gpu_buffer_storage_yuv_image.h"
 
 namespace mediapipe {
 namespace api2 {
@@ -42,6 +47,39 @@ std::string FourCCToString(libyuv::FourCC fourcc) {
   buf[4] = 0;
   return std::string(buf);
 }
+
+// Copies the planes of an NV12, NV21, YV12 or I420 `yuv_image` into a single
+// tightly packed buffer owned by the returned YUVImage.
+std::shared_ptr<YUVImage> CopyYuvImage(const YUVImage& yuv_image) {
+  const int width = yuv_image.width();
+  const int height = yuv_image.height();
+  const bool interleaved_chroma = yuv_image.fourcc() == libyuv::FOURCC_NV12 ||
+                                  yuv_image.fourcc() == libyuv::FOURCC_NV21;
+  const int chroma_height = (height + 1) / 2;
+  const int chroma_stride =
+      interleaved_chroma ? 2 * ((width + 1) / 2) : (width + 1) / 2;
+  const int num_chroma_planes = interleaved_chroma ? 1 : 2;
+  const int luma_size = width * height;
+  const int chroma_size = chroma_stride * chroma_height;
+  auto data =
+      std::make_unique<uint8_t[]>(luma_size + num_chroma_planes * chroma_size);
+  uint8_t* planes[3] = {data.get(), data.get() + luma_size, nullptr};
+  libyuv::CopyPlane(yuv_image.data(0), yuv_image.stride(0), planes[0], width,
+                    width, height);
+  for (int i = 1; i <= num_chroma_planes; ++i) {
+    planes[i] = planes[1] + (i - 1) * chroma_size;
+    libyuv::CopyPlane(yuv_image.data(i), yuv_image.stride(i), planes[i],
+                      chroma_stride, chroma_stride, chroma_height);
+  }
+  auto copy = std::make_shared<YUVImage>(
+      yuv_image.fourcc(), std::move(data), planes[0], width, planes[1],
+      chroma_stride, planes[2], interleaved_chroma ? 0 : chroma_stride, width,
+      height, yuv_image.bit_depth());
+  copy->set_matrix_coefficients(yuv_image.matrix_coefficients());
+  copy->set_full_range(yuv_image.full_range());
+  return copy;
+}
+
 }  // namespace
 
 // Converts a `YUVImage` into an RGB `Image` using libyuv.
@@ -50,6 +88,12 @@ std::string FourCCToString(libyuv::FourCC fourcc) {
 // YV21) format (as per the `fourcc()` property). This covers the most commonly
 // used YUV image formats used on mobile devices. Other formats are not
 // supported and will result in an `InvalidArgumentError`.
+//
+// With `convert_to_rgb: false` in YUVToImageCalculatorOptions, the output
+// `Image` holds a copy of the input YUV planes instead, leaving color
+// conversion to consumers that only need part of the frame (e.g.
+// ImageToTensorCalculator). The planes are copied because the output Image
+// hands out write views, while the input packet may be shared.
 class YUVToImageCalculator : public Node {
  public:
   static constexpr Input<YUVImage> kInput{"YUV_IMAGE"};
@@ -68,6 +112,11 @@ class YUVToImageCalculator : public Node {
                           "YV12 and I420 (aka YV21) are supported.",
                           FourCCToString(format)));
     }
+    if (!cc->Options<YUVToImageCalculatorOptions>().convert_to_rgb()) {
+      kOutput(cc).Send(Image(
+          std::make_shared<GpuBufferStorageYuvImage>(CopyYuvImage(yuv_image))));
+      return absl::OkStatus();
+    }
     // Build a transient ImageFrameSharedPtr with default alignment to host
     // conversion results.
     ImageFrameSharedPtr image_frame = std::make_shared<ImageFrame>(
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -23,6 +24,7 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "mediapipe/calculators/tensor/bert_preprocessor_calculator.pb.h"
@@ -33,10 +35,12 @@
 #include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/memory_manager_service.h"
 #include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/timestamp.h"
 #include "mediapipe/tasks/cc/core/utils.h"
 #include "mediapipe/tasks/cc/metadata/metadata_extractor.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer_utils.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 #include "mediapipe/tasks/metadata/metadata_schema_generated.h"
 
 namespace mediapipe {
@@ -44,6 +48,8 @@ namespace api2 {
 
 using ::mediapipe::tasks::core::FindTensorIndexByMetadataName;
 using ::mediapipe::tasks::metadata::ModelMetadataExtractor;
+using ::mediapipe::tasks::text::utils::GetSharedTextCache;
+using ::mediapipe::tasks::text::utils::TextCache;
 
 constexpr int kNumInputTensorsForBert = 3;
 constexpr int kTokenizerProcessUnitIndex = 0;
@@ -52,6 +58,8 @@ constexpr absl::string_view kInputMasksTensorName = "mask";
 constexpr absl::string_view kSegmentIdsTensorName = "segment_ids";
 constexpr absl::string_view kClassifierToken = "[CLS]";
 constexpr absl::string_view kSeparatorToken = "[SEP]";
+constexpr char kTokenCacheHitsCounter[] = "Token cache hits";
+constexpr char kTokenCacheMissesCounter[] = "Token cache misses";
 
 // Preprocesses input text into three int32 input tensors for a BERT model using
 // a tokenizer.
@@ -93,6 +101,20 @@ constexpr absl::string_view kSeparatorToken = "[SEP]";
 //            and 0 elsewhere.
 //     The Tensors will have size equal to the max sequence length for the BERT
 //     model.
+//   TIMESTAMPS - std::vector<Timestamp> @Optional
+//     The timestamps of the TENSORS sent for the input text, sent at the last
+//     of them.
+//
+// If `window_stride` is set in the options, long texts are not truncated but
+// split into overlapping windows of tokens, each with its own "[CLS]" and
+// "[SEP]" tokens. The TENSORS of the windows are sent at consecutive
+// timestamps starting at the input timestamp, so the timestamps of consecutive
+// input texts must be further apart than the number of windows. The full text
+// is tokenized only once.
+//
+// If `token_cache_size` is set in the options, the input ids of recent texts
+// are cached, and the "Token cache hits" and "Token cache misses" counters
+// count the texts found in the cache or tokenized.
 //
 // Example:
 // node {
@@ -112,8 +134,11 @@ class BertPreprocessorCalculator : public Node {
   static constexpr SideInput<ModelMetadataExtractor> kMetadataExtractorSideIn{
       "METADATA_EXTRACTOR"};
   static constexpr Output<std::vector<Tensor>> kTensorsOut{"TENSORS"};
+  static constexpr Output<std::vector<Timestamp>>::Optional kTimestampsOut{
+      "TIMESTAMPS"};
 
-  MEDIAPIPE_NODE_CONTRACT(kTextIn, kMetadataExtractorSideIn, kTensorsOut);
+  MEDIAPIPE_NODE_CONTRACT(kTextIn, kMetadataExtractorSideIn, kTensorsOut,
+                          kTimestampsOut);
 
   static absl::Status UpdateContract(CalculatorContract* cc);
   absl::Status Open(CalculatorContext* cc) override;
@@ -131,16 +156,29 @@ class BertPreprocessorCalculator : public Node {
   int input_masks_tensor_index_ = 2;
   // Whether the model's input tensor shapes are dynamic.
   bool has_dynamic_input_tensors_ = false;
+  // The distance between the first tokens of consecutive windows, or 0 if
+  // long texts are truncated.
+  int window_stride_ = 0;
 
   // Applies `tokenizer_` to the `input_text` to generate a vector of tokens.
   // This util prepends "[CLS]" and appends "[SEP]" to the input tokens and
   // clips the vector of tokens to have length at most `bert_max_seq_len_` if
-  // the input tensors are static.
+  // the input tensors are static and the text isn't split into windows.
   std::vector<std::string> TokenizeInputText(absl::string_view input_text);
-  // Processes the `input_tokens` to generate the three input tensors of size
+  // Converts the `input_tokens` into their ids in the vocabulary.
+  std::vector<int32_t> LookupInputIds(
+      const std::vector<std::string>& input_tokens);
+  // Processes the `token_ids` to generate the three input tensors of size
   // `tensor_size` for the BERT model.
   std::vector<Tensor> GenerateInputTensors(
-      const std::vector<std::string>& input_tokens, int tensor_size);
+      const std::vector<int32_t>& token_ids, int tensor_size);
+  // Sends the input tensors of the windows of the `token_ids` of a text at
+  // consecutive timestamps, and returns these timestamps.
+  std::vector<Timestamp> SendWindowTensors(
+      const std::vector<int32_t>& token_ids, CalculatorContext* cc);
+
+  // The input ids of recent texts, if caching is enabled.
+  std::shared_ptr<TextCache<std::vector<int32_t>>> token_cache_;
 
   // Enable pooling of AHWBs in Tensor instances.
   MemoryManager* memory_manager_ = nullptr;
@@ -150,6 +188,12 @@ absl::Status BertPreprocessorCalculator::UpdateContract(
     CalculatorContract* cc) {
   const auto& options =
       cc->Options<mediapipe::BertPreprocessorCalculatorOptions>();
+  if (options.window_stride() > 0) {
+    RET_CHECK(!options.has_dynamic_input_tensors())
+        << "window_stride is not supported with dynamic input tensors";
+    RET_CHECK_LE(options.window_stride(), options.bert_max_seq_len() - 2)
+        << "window_stride must be at most bert_max_seq_len - 2";
+  }
   if (options.has_dynamic_input_tensors()) {
     return absl::OkStatus();
   } else {
@@ -194,16 +238,53 @@ absl::Status BertPreprocessorCalculator::Open(CalculatorContext* cc) {
       cc->Options<mediapipe::BertPreprocessorCalculatorOptions>();
   bert_max_seq_len_ = options.bert_max_seq_len();
   has_dynamic_input_tensors_ = options.has_dynamic_input_tensors();
+  window_stride_ = options.window_stride();
+  if (options.token_cache_size() > 0) {
+    ABSL_ASSIGN_OR_RETURN(
+        size_t tokenizer_fingerprint,
+        tasks::text::tokenizers::GetTokenizerFingerprint(tokenizer_metadata,
+                                                         metadata_extractor));
+    token_cache_ = GetSharedTextCache<std::vector<int32_t>>(
+        absl::StrCat("BertPreprocessorCalculator/", tokenizer_fingerprint, "/",
+                     has_dynamic_input_tensors_ || window_stride_ > 0
+                         ? 0
+                         : bert_max_seq_len_),
+        options.token_cache_size());
+  }
   return absl::OkStatus();
 }
 
 absl::Status BertPreprocessorCalculator::Process(CalculatorContext* cc) {
-  int tensor_size = bert_max_seq_len_;
-  std::vector<std::string> input_tokens = TokenizeInputText(kTextIn(cc).Get());
-  if (has_dynamic_input_tensors_) {
-    tensor_size = input_tokens.size();
+  const std::string& input_text = kTextIn(cc).Get();
+  std::shared_ptr<const std::vector<int32_t>> input_ids;
+  if (token_cache_ != nullptr) {
+    input_ids = token_cache_->Lookup(input_text);
+    cc->GetCounter(input_ids != nullptr ? kTokenCacheHitsCounter
+                                        : kTokenCacheMissesCounter)
+        ->Increment();
+  }
+  if (input_ids == nullptr) {
+    input_ids = std::make_shared<const std::vector<int32_t>>(
+        LookupInputIds(TokenizeInputText(input_text)));
+    if (token_cache_ != nullptr) {
+      token_cache_->Insert(input_text, input_ids);
+    }
+  }
+  std::vector<Timestamp> timestamps;
+  if (window_stride_ > 0) {
+    timestamps = SendWindowTensors(*input_ids, cc);
+  } else {
+    int tensor_size = bert_max_seq_len_;
+    if (has_dynamic_input_tensors_) {
+      tensor_size = input_ids->size();
+    }
+    kTensorsOut(cc).Send(GenerateInputTensors(*input_ids, tensor_size));
+    timestamps.push_back(cc->InputTimestamp());
+  }
+  if (kTimestampsOut(cc).IsConnected()) {
+    Timestamp timestamp = timestamps.back();
+    kTimestampsOut(cc).Send(std::move(timestamps), timestamp);
   }
-  kTensorsOut(cc).Send(GenerateInputTensors(input_tokens, tensor_size));
   return absl::OkStatus();
 }
 
@@ -218,8 +299,9 @@ std::vector<std::string> BertPreprocessorCalculator::TokenizeInputText(
   // Offset by 2 to account for [CLS] and [SEP]
   int input_tokens_size =
       static_cast<int>(tokenizer_result.subwords.size()) + 2;
-  // For static shapes, truncate the input tokens to `bert_max_seq_len_`.
-  if (!has_dynamic_input_tensors_) {
+  // For static shapes, truncate the input tokens to `bert_max_seq_len_` unless
+  // they are split into windows.
+  if (!has_dynamic_input_tensors_ && window_stride_ == 0) {
     input_tokens_size = std::min(bert_max_seq_len_, input_tokens_size);
   }
   std::vector<std::string> input_tokens;
@@ -232,16 +314,23 @@ std::vector<std::string> BertPreprocessorCalculator::TokenizeInputText(
   return input_tokens;
 }
 
+std::vector<int32_t> BertPreprocessorCalculator::LookupInputIds(
+    const std::vector<std::string>& input_tokens) {
+  std::vector<int32_t> input_ids(input_tokens.size(), 0);
+  for (int i = 0; i < input_tokens.size(); ++i) {
+    tokenizer_->LookupId(input_tokens[i], &input_ids[i]);
+  }
+  return input_ids;
+}
+
 std::vector<Tensor> BertPreprocessorCalculator::GenerateInputTensors(
-    const std::vector<std::string>& input_tokens, int tensor_size) {
+    const std::vector<int32_t>& token_ids, int tensor_size) {
   std::vector<int32_t> input_ids(tensor_size, 0);
   std::vector<int32_t> segment_ids(tensor_size, 0);
   std::vector<int32_t> input_masks(tensor_size, 0);
-  // Convert tokens back into ids and set mask
-  for (int i = 0; i < input_tokens.size(); ++i) {
-    tokenizer_->LookupId(input_tokens[i], &input_ids[i]);
-    input_masks[i] = 1;
-  }
+  // Copy the ids and set mask
+  std::copy(token_ids.begin(), token_ids.end(), input_ids.begin());
+  std::fill(input_masks.begin(), input_masks.begin() + token_ids.size(), 1);
   //                           |<-----------tensor_size------------>|
   // input_ids                 [CLS] s1  s2...  sn [SEP]  0  0...  0
   // segment_ids                 0    0   0...  0    0    0  0...  0
@@ -270,6 +359,31 @@ std::vector<Tensor> BertPreprocessorCalculator::GenerateInputTensors(
   return input_tensors;
 }
 
+std::vector<Timestamp> BertPreprocessorCalculator::SendWindowTensors(
+    const std::vector<int32_t>& token_ids, CalculatorContext* cc) {
+  // The tokens between "[CLS]" and "[SEP]" are split into windows.
+  const int num_text_tokens = static_cast<int>(token_ids.size()) - 2;
+  const int window_size = bert_max_seq_len_ - 2;
+  std::vector<Timestamp> timestamps;
+  std::vector<int32_t> window_ids;
+  window_ids.reserve(bert_max_seq_len_);
+  for (int start = 0;; start += window_stride_) {
+    const int end = std::min(start + window_size, num_text_tokens);
+    window_ids.clear();
+    window_ids.push_back(token_ids.front());
+    window_ids.insert(window_ids.end(), token_ids.begin() + 1 + start,
+                      token_ids.begin() + 1 + end);
+    window_ids.push_back(token_ids.back());
+    const Timestamp timestamp =
+        cc->InputTimestamp() + static_cast<int64_t>(timestamps.size());
+    kTensorsOut(cc).Send(GenerateInputTensors(window_ids, bert_max_seq_len_),
+                         timestamp);
+    timestamps.push_back(timestamp);
+    if (end == num_text_tokens) break;
+  }
+  return timestamps;
+}
+
 MEDIAPIPE_REGISTER_NODE(BertPreprocessorCalculator);
 
 }  // namespace api2
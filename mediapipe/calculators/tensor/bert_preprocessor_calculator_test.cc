@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -35,6 +36,7 @@ namespace mediapipe {
 namespace {
 
 using ::mediapipe::tasks::metadata::ModelMetadataExtractor;
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 
 constexpr int kNumInputTensorsForBert = 3;
@@ -153,5 +155,140 @@ TEST(BertPreprocessorCalculatorTest, LongInput) {
   EXPECT_THAT(processed_tensor_values, ElementsAreArray(expected_result));
 }
 
+TEST(BertPreprocessorCalculatorTest, ReusesCachedTokensForRepeatedText) {
+  auto graph_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "text"
+    output_stream: "tensors"
+    node {
+      calculator: "BertPreprocessorCalculator"
+      input_stream: "TEXT:text"
+      input_side_packet: "METADATA_EXTRACTOR:metadata_extractor"
+      output_stream: "TENSORS:tensors"
+      options {
+        [mediapipe.BertPreprocessorCalculatorOptions.ext] {
+          bert_max_seq_len: 128
+          token_cache_size: 4
+        }
+      }
+    }
+  )pb");
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("tensors", &graph_config, &output_packets);
+  std::string model_buffer =
+      tasks::core::LoadBinaryContent(kTestModelPath.data());
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<ModelMetadataExtractor> metadata_extractor,
+      ModelMetadataExtractor::CreateFromModelBuffer(model_buffer.data(),
+                                                    model_buffer.size()));
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(
+      graph_config,
+      {{"metadata_extractor",
+        MakePacket<ModelMetadataExtractor>(std::move(*metadata_extractor))}}));
+  MP_ASSERT_OK(graph.StartRun({}));
+  int64_t timestamp = 0;
+  for (absl::string_view text :
+       {"it's a charming and often affecting journey", "a long movie",
+        "it's a charming and often affecting journey"}) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "text", MakePacket<std::string>(text).At(Timestamp(timestamp++))));
+  }
+  MP_ASSERT_OK(graph.CloseAllPacketSources());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  ASSERT_EQ(output_packets.size(), 3);
+  std::vector<std::vector<int>> input_ids;
+  for (const Packet& packet : output_packets) {
+    const Tensor& tensor = packet.Get<std::vector<Tensor>>()[0];
+    auto* buffer = tensor.GetCpuReadView().buffer<int>();
+    input_ids.emplace_back(buffer, buffer + kBertMaxSeqLen);
+  }
+  EXPECT_EQ(input_ids[2], input_ids[0]);
+  EXPECT_NE(input_ids[1], input_ids[0]);
+  EXPECT_EQ(graph.GetCounterFactory()
+                ->GetCounter("BertPreprocessorCalculator-Token cache hits")
+                ->Get(),
+            1);
+  EXPECT_EQ(graph.GetCounterFactory()
+                ->GetCounter("BertPreprocessorCalculator-Token cache misses")
+                ->Get(),
+            2);
+}
+
+TEST(BertPreprocessorCalculatorTest, SplitsLongInputIntoWindows) {
+  auto graph_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "text"
+    output_stream: "tensors"
+    output_stream: "timestamps"
+    node {
+      calculator: "BertPreprocessorCalculator"
+      input_stream: "TEXT:text"
+      input_side_packet: "METADATA_EXTRACTOR:metadata_extractor"
+      output_stream: "TENSORS:tensors"
+      output_stream: "TIMESTAMPS:timestamps"
+      options {
+        [mediapipe.BertPreprocessorCalculatorOptions.ext] {
+          bert_max_seq_len: 16
+          window_stride: 8
+        }
+      }
+    }
+  )pb");
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("tensors", &graph_config, &output_packets);
+  std::vector<Packet> timestamps_packets;
+  tool::AddVectorSink("timestamps", &graph_config, &timestamps_packets);
+  std::string model_buffer =
+      tasks::core::LoadBinaryContent(kTestModelPath.data());
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<ModelMetadataExtractor> metadata_extractor,
+      ModelMetadataExtractor::CreateFromModelBuffer(model_buffer.data(),
+                                                    model_buffer.size()));
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(
+      graph_config,
+      {{"metadata_extractor",
+        MakePacket<ModelMetadataExtractor>(std::move(*metadata_extractor))}}));
+  MP_ASSERT_OK(graph.StartRun({}));
+  std::stringstream long_input;
+  long_input << "it's a charming and often affecting journey";
+  for (int i = 0; i < 12; ++i) {
+    long_input << " long";
+  }
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "text", MakePacket<std::string>(long_input.str()).At(Timestamp(0))));
+  MP_ASSERT_OK(graph.CloseAllPacketSources());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  // The 21 tokens of the text are split into windows of 14 tokens starting
+  // at tokens 0 and 8.
+  std::vector<int> text_ids = {2009, 1005, 1055,  1037, 11951,
+                               1998, 2411, 12473, 4990};
+  text_ids.resize(21, 2146);
+  std::vector<int> first_window_ids = {101};
+  first_window_ids.insert(first_window_ids.end(), text_ids.begin(),
+                          text_ids.begin() + 14);
+  first_window_ids.push_back(102);
+  std::vector<int> second_window_ids = {101};
+  second_window_ids.insert(second_window_ids.end(), text_ids.begin() + 8,
+                           text_ids.end());
+  second_window_ids.push_back(102);
+  second_window_ids.push_back(0);
+
+  ASSERT_EQ(output_packets.size(), 2);
+  std::vector<std::vector<int>> input_ids;
+  for (int i = 0; i < output_packets.size(); ++i) {
+    EXPECT_EQ(output_packets[i].Timestamp(), Timestamp(i));
+    const Tensor& tensor = output_packets[i].Get<std::vector<Tensor>>()[0];
+    auto* buffer = tensor.GetCpuReadView().buffer<int>();
+    input_ids.emplace_back(buffer, buffer + 16);
+  }
+  EXPECT_THAT(input_ids, ElementsAre(first_window_ids, second_window_ids));
+  ASSERT_EQ(timestamps_packets.size(), 1);
+  EXPECT_EQ(timestamps_packets[0].Timestamp(), Timestamp(1));
+  EXPECT_THAT(timestamps_packets[0].Get<std::vector<Timestamp>>(),
+              ElementsAre(Timestamp(0), Timestamp(1)));
+}
+
 }  // namespace
 }  // namespace mediapipe
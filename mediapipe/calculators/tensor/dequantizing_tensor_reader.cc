@@ -0,0 +1,50 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/dequantizing_tensor_reader.h"
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+absl::StatusOr<DequantizingTensorReader> DequantizingTensorReader::Create(
+    const Tensor& tensor, const Tensor::CpuReadView& view) {
+  switch (tensor.element_type()) {
+    case Tensor::ElementType::kFloat32:
+      return DequantizingTensorReader(view.buffer<float>(),
+                                      tensor.element_type(), /*scale=*/1.0f,
+                                      /*zero_point=*/0);
+    case Tensor::ElementType::kUInt8:
+    case Tensor::ElementType::kInt8: {
+      const Tensor::QuantizationParameters& params =
+          tensor.quantization_parameters();
+      // A positive scale keeps raw values ordered like dequantized ones.
+      RET_CHECK_GT(params.scale, 0.0f)
+          << "Quantized tensor must have a positive scale.";
+      return DequantizingTensorReader(view.buffer<void>(),
+                                      tensor.element_type(), params.scale,
+                                      params.zero_point);
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unsupported tensor type: ",
+                       Tensor::ElementTypeName(tensor.element_type())));
+  }
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,86 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_DEQUANTIZING_TENSOR_READER_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_DEQUANTIZING_TENSOR_READER_H_
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/formats/tensor.h"
+
+namespace mediapipe {
+
+// Reads elements of a kFloat32, kUInt8 or kInt8 CPU tensor as floats.
+// Quantized elements are dequantized on access using the tensor quantization
+// parameters:
+//
+//   value = scale * (quantized_value - zero_point)
+//
+// This lets postprocessing calculators consume quantized model outputs
+// directly and dequantize only the elements they use, instead of converting
+// whole tensors with TensorsDequantizationCalculator.
+//
+// The reader doesn't own the tensor data: `view` must outlive it.
+class DequantizingTensorReader {
+ public:
+  static absl::StatusOr<DequantizingTensorReader> Create(
+      const Tensor& tensor, const Tensor::CpuReadView& view);
+
+  // Returns the dequantized element at `index`.
+  float operator[](int index) const { return Dequantize(Raw(index)); }
+
+  // Returns the element at `index` as stored, without applying quantization
+  // parameters. Raw values preserve the order of dequantized values, so e.g.
+  // an argmax can be computed on raw values and only the winner dequantized.
+  float Raw(int index) const {
+    switch (element_type_) {
+      case Tensor::ElementType::kUInt8:
+        return static_cast<const uint8_t*>(data_)[index];
+      case Tensor::ElementType::kInt8:
+        return static_cast<const int8_t*>(data_)[index];
+      default:
+        return static_cast<const float*>(data_)[index];
+    }
+  }
+
+  // Dequantizes a value returned by Raw(). Identity for float tensors.
+  float Dequantize(float raw) const { return scale_ * (raw - zero_point_); }
+
+  // Returns the underlying float buffer, or nullptr for quantized tensors.
+  const float* float_data() const {
+    return is_quantized() ? nullptr : static_cast<const float*>(data_);
+  }
+
+  bool is_quantized() const {
+    return element_type_ != Tensor::ElementType::kFloat32;
+  }
+
+ private:
+  DequantizingTensorReader(const void* data, Tensor::ElementType element_type,
+                           float scale, int zero_point)
+      : data_(data),
+        element_type_(element_type),
+        scale_(scale),
+        zero_point_(zero_point) {}
+
+  const void* data_;
+  Tensor::ElementType element_type_;
+  float scale_;
+  int zero_point_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_DEQUANTIZING_TENSOR_READER_H_
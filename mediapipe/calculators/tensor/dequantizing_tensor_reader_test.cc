@@ -0,0 +1,93 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/dequantizing_tensor_reader.h"
+
+#include <cstdint>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::FloatEq;
+using ::testing::IsNull;
+
+TEST(DequantizingTensorReaderTest, ReadsFloatTensorAsIs) {
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{3});
+  {
+    auto view = tensor.GetCpuWriteView();
+    float* data = view.buffer<float>();
+    data[0] = -1.5f;
+    data[1] = 0.0f;
+    data[2] = 2.25f;
+  }
+  auto view = tensor.GetCpuReadView();
+  MP_ASSERT_OK_AND_ASSIGN(auto reader,
+                          DequantizingTensorReader::Create(tensor, view));
+  EXPECT_FALSE(reader.is_quantized());
+  EXPECT_EQ(reader.float_data(), view.buffer<float>());
+  EXPECT_THAT(reader[0], FloatEq(-1.5f));
+  EXPECT_THAT(reader[2], FloatEq(2.25f));
+}
+
+TEST(DequantizingTensorReaderTest, DequantizesUInt8Tensor) {
+  Tensor tensor(Tensor::ElementType::kUInt8, Tensor::Shape{2},
+                Tensor::QuantizationParameters(0.5f, 10));
+  {
+    auto view = tensor.GetCpuWriteView();
+    uint8_t* data = view.buffer<uint8_t>();
+    data[0] = 0;
+    data[1] = 255;
+  }
+  auto view = tensor.GetCpuReadView();
+  MP_ASSERT_OK_AND_ASSIGN(auto reader,
+                          DequantizingTensorReader::Create(tensor, view));
+  EXPECT_TRUE(reader.is_quantized());
+  EXPECT_THAT(reader.float_data(), IsNull());
+  EXPECT_THAT(reader.Raw(1), FloatEq(255.0f));
+  EXPECT_THAT(reader[0], FloatEq(-5.0f));
+  EXPECT_THAT(reader[1], FloatEq(122.5f));
+}
+
+TEST(DequantizingTensorReaderTest, DequantizesInt8Tensor) {
+  Tensor tensor(Tensor::ElementType::kInt8, Tensor::Shape{2},
+                Tensor::QuantizationParameters(1.0f / 256, -128));
+  {
+    auto view = tensor.GetCpuWriteView();
+    int8_t* data = view.buffer<int8_t>();
+    data[0] = -128;
+    data[1] = 64;
+  }
+  auto view = tensor.GetCpuReadView();
+  MP_ASSERT_OK_AND_ASSIGN(auto reader,
+                          DequantizingTensorReader::Create(tensor, view));
+  EXPECT_THAT(reader[0], FloatEq(0.0f));
+  EXPECT_THAT(reader[1], FloatEq(0.75f));
+}
+
+TEST(DequantizingTensorReaderTest, FailsOnUnsupportedType) {
+  Tensor tensor(Tensor::ElementType::kInt32, Tensor::Shape{1});
+  tensor.GetCpuWriteView().buffer<int32_t>()[0] = 1;
+  auto view = tensor.GetCpuReadView();
+  EXPECT_EQ(DequantizingTensorReader::Create(tensor, view).status().code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace mediapipe
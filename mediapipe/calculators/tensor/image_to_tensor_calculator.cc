@@ -21,6 +21,7 @@
 
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_calculator.pb.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
@@ -46,9 +47,10 @@
 
 #if !MEDIAPIPE_DISABLE_OPENCV
 #include "mediapipe/calculators/tensor/image_to_tensor_converter_opencv.h"
-#elif MEDIAPIPE_ENABLE_HALIDE
+#endif  // !MEDIAPIPE_DISABLE_OPENCV
+#if MEDIAPIPE_ENABLE_HALIDE
 #include "mediapipe/calculators/tensor/image_to_tensor_converter_frame_buffer.h"
-#endif
+#endif  // MEDIAPIPE_ENABLE_HALIDE
 
 #if !MEDIAPIPE_DISABLE_GPU
 #include "mediapipe/gpu/gpu_buffer.h"
@@ -191,6 +193,8 @@ class ImageToTensorNodeImpl
     Tensor tensor(
         output_tensor_type,
         {1, tensor_height, tensor_width, GetNumOutputChannels(*image)},
+        params_.quantization_parameters.value_or(
+            Tensor::QuantizationParameters()),
         memory_manager_);
     ABSL_RETURN_IF_ERROR((image->UsesGpu() ? gpu_converter_ : cpu_converter_)
                              ->Convert(*image, roi, params_.range_min,
@@ -256,29 +260,54 @@ class ImageToTensorNodeImpl
       }
     } else {
       if (!cpu_converter_) {
+        ABSL_ASSIGN_OR_RETURN(cpu_converter_, CreateCpuConverter(cc, image));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<std::unique_ptr<ImageToTensorConverter>> CreateCpuConverter(
+      mediapipe::CalculatorContext* cc, const Image& image) {
+    const BorderMode border_mode = GetBorderMode(options_.border_mode());
+    const Tensor::ElementType tensor_type =
+        GetOutputTensorType(/*uses_gpu=*/false, params_);
+    switch (options_.cpu_backend()) {
+      case mediapipe::ImageToTensorCalculatorOptions::CPU_BACKEND_OPENCV:
 #if !MEDIAPIPE_DISABLE_OPENCV
-        ABSL_ASSIGN_OR_RETURN(
-            cpu_converter_,
-            CreateOpenCvConverter(
-                cc, GetBorderMode(options_.border_mode()),
-                GetOutputTensorType(/*uses_gpu=*/false, params_)));
+        return CreateOpenCvConverter(cc, border_mode, tensor_type);
+#else
+        return absl::UnimplementedError(
+            "OpenCV CPU backend requested, but MEDIAPIPE_DISABLE_OPENCV is "
+            "defined.");
+#endif  // !MEDIAPIPE_DISABLE_OPENCV
+      case mediapipe::ImageToTensorCalculatorOptions::CPU_BACKEND_HALIDE:
+#if MEDIAPIPE_ENABLE_HALIDE
+        return CreateFrameBufferConverter(cc, border_mode, tensor_type);
+#else
+        return absl::UnimplementedError(
+            "Halide CPU backend requested, but MEDIAPIPE_ENABLE_HALIDE is not "
+            "defined.");
+#endif  // MEDIAPIPE_ENABLE_HALIDE
+      default:
+#if MEDIAPIPE_ENABLE_HALIDE
+        if (IsYuvImage(image)) {
+          return CreateFrameBufferConverter(cc, border_mode, tensor_type);
+        }
+#endif  // MEDIAPIPE_ENABLE_HALIDE
+#if !MEDIAPIPE_DISABLE_OPENCV
+        return CreateOpenCvConverter(cc, border_mode, tensor_type);
 // TODO: FrameBuffer-based converter needs to call GetGpuBuffer()
 // to get access to a FrameBuffer view. Investigate if GetGpuBuffer() can be
 // made available even with MEDIAPIPE_DISABLE_GPU set.
 #elif MEDIAPIPE_ENABLE_HALIDE
-        ABSL_ASSIGN_OR_RETURN(
-            cpu_converter_,
-            CreateFrameBufferConverter(
-                cc, GetBorderMode(options_.border_mode()),
-                GetOutputTensorType(/*uses_gpu=*/false, params_)));
+        return CreateFrameBufferConverter(cc, border_mode, tensor_type);
 #else
-        ABSL_LOG(FATAL) << "Cannot create image to tensor CPU converter since "
-                           "MEDIAPIPE_DISABLE_OPENCV is defined and "
-                           "MEDIAPIPE_ENABLE_HALIDE is not defined.";
-#endif  // !MEDIAPIPE_DISABLE_HALIDE
-      }
+        return absl::UnimplementedError(
+            "Cannot create image to tensor CPU converter since "
+            "MEDIAPIPE_DISABLE_OPENCV is defined and MEDIAPIPE_ENABLE_HALIDE "
+            "is not defined.");
+#endif  // !MEDIAPIPE_DISABLE_OPENCV
     }
-    return absl::OkStatus();
   }
 
   std::unique_ptr<ImageToTensorConverter> gpu_converter_;
@@ -518,6 +518,80 @@ TEST(ImageToTensorCalculatorTest, CanBeUsedWithoutRect) {
       StatusIs(absl::StatusCode::kOk));
 }
 
+// Whether `backend` is compiled into the calculator.
+bool IsCpuBackendAvailable(ImageToTensorCalculatorOptions::CpuBackend backend) {
+#if !MEDIAPIPE_DISABLE_OPENCV
+  constexpr bool kHasOpenCv = true;
+#else
+  constexpr bool kHasOpenCv = false;
+#endif  // !MEDIAPIPE_DISABLE_OPENCV
+#if MEDIAPIPE_ENABLE_HALIDE
+  constexpr bool kHasHalide = true;
+#else
+  constexpr bool kHasHalide = false;
+#endif  // MEDIAPIPE_ENABLE_HALIDE
+  switch (backend) {
+    case ImageToTensorCalculatorOptions::CPU_BACKEND_OPENCV:
+      return kHasOpenCv;
+    case ImageToTensorCalculatorOptions::CPU_BACKEND_HALIDE:
+      return kHasHalide;
+    default:
+      return kHasOpenCv || kHasHalide;
+  }
+}
+
+using ImageToTensorCalculatorCpuBackendTest =
+    testing::TestWithParam<ImageToTensorCalculatorOptions::CpuBackend>;
+
+TEST_P(ImageToTensorCalculatorCpuBackendTest, ConvertsWithSelectedBackend) {
+  const ImageToTensorCalculatorOptions::CpuBackend backend = GetParam();
+  const Range<float> kRange = {.min = 0.0f, .max = 1.0f};
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      Runner::For([&](GenericGraph& graph, Stream<ImageFrame> image,
+                      Stream<NormalizedRect> norm_rect) -> Stream<Tensor> {
+        auto& node = graph.AddNode<ImageToTensorNode>();
+        {
+          auto& opts = *node.options.Mutable();
+          opts.set_cpu_backend(backend);
+          opts.set_output_tensor_width(256);
+          opts.set_output_tensor_height(256);
+          opts.set_keep_aspect_ratio(true);
+          auto& float_range = *opts.mutable_output_tensor_float_range();
+          float_range.set_min(kRange.min);
+          float_range.set_max(kRange.max);
+        }
+        node.in.Set(image);
+        node.in_norm_rect.Set(norm_rect);
+        return node.out_tensor.Get();
+      }).Create());
+
+  absl::StatusOr<api3::Packet<Tensor>> tensor_packet = runner.Run(
+      api3::MakePacket<ImageFrame>(ReadImageFrameRgb("input.jpg")),
+      api3::MakePacket<NormalizedRect>(MakeRect(0.65f, 0.4f, 0.5f, 0.5f, 0)));
+  if (!IsCpuBackendAvailable(backend)) {
+    EXPECT_THAT(tensor_packet, StatusIs(absl::StatusCode::kUnimplemented));
+    return;
+  }
+  MP_ASSERT_OK(tensor_packet);
+  ASSERT_TRUE(*tensor_packet);
+  EXPECT_THAT(TensorAndExpectedMatch(
+                  tensor_packet->GetOrDie(), kRange,
+                  GetRgb(GetFilePath("medium_sub_rect_keep_aspect.png"))),
+              StatusIs(absl::StatusCode::kOk));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ImageToTensorCalculatorCpuBackendTests,
+    ImageToTensorCalculatorCpuBackendTest,
+    testing::Values(ImageToTensorCalculatorOptions::CPU_BACKEND_DEFAULT,
+                    ImageToTensorCalculatorOptions::CPU_BACKEND_OPENCV,
+                    ImageToTensorCalculatorOptions::CPU_BACKEND_HALIDE),
+    [](const testing::TestParamInfo<
+        ImageToTensorCalculatorCpuBackendTest::ParamType>& info) {
+      return ImageToTensorCalculatorOptions::CpuBackend_Name(info.param);
+    });
+
 TEST(ImageToTensorCalculatorTest, CanBeUsedWithoutGpuServiceSet) {
   auto graph_config =
       mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
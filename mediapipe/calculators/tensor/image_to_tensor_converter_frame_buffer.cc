@@ -14,6 +14,7 @@
 
 #include "mediapipe/calculators/tensor/image_to_tensor_converter_frame_buffer.h"
 
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -45,11 +46,29 @@ int RadiansToDegrees(float radians) {
   return degrees;
 }
 
+// Returns the row-major 2x3 matrix mapping output pixel coordinates of a
+// `output_width` x `output_height` tensor to input pixel coordinates inside
+// the rotated `roi`. Matches the corner correspondence used by the OpenCV
+// converter.
+std::array<float, 6> GetOutputToRoiMatrix(const RotatedRect& roi,
+                                          int output_width,
+                                          int output_height) {
+  const float cos_r = std::cos(roi.rotation);
+  const float sin_r = std::sin(roi.rotation);
+  return {cos_r * roi.width / output_width,
+          -sin_r * roi.height / output_height,
+          roi.center_x - 0.5f * (cos_r * roi.width - sin_r * roi.height),
+          sin_r * roi.width / output_width,
+          cos_r * roi.height / output_height,
+          roi.center_y - 0.5f * (sin_r * roi.width + cos_r * roi.height)};
+}
+
 // FrameBuffer-based implementation of ImageToTensorConverter.
 class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
  public:
-  explicit ImageToTensorFrameBufferConverter(Tensor::ElementType tensor_type)
-      : tensor_type_(tensor_type) {}
+  ImageToTensorFrameBufferConverter(BorderMode border_mode,
+                                    Tensor::ElementType tensor_type)
+      : border_mode_(border_mode), tensor_type_(tensor_type) {}
 
   absl::Status Convert(const mediapipe::Image& input, const RotatedRect& roi,
                        float range_min, float range_max,
@@ -63,12 +82,20 @@ class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
   absl::Status CropRotateResize90Degrees(
       std::shared_ptr<const FrameBuffer> input, const RotatedRect& roi,
       std::shared_ptr<FrameBuffer> output);
+  // Crops an arbitrarily rotated region-of-interest (possibly extending
+  // beyond the input boundaries) and resizes it directly into the output
+  // tensor with a single Halide affine warp. YUV inputs are sampled directly,
+  // so only the pixels inside the region-of-interest are color converted.
+  absl::Status CropWarpAffine(std::shared_ptr<const FrameBuffer> input,
+                              const RotatedRect& roi, float range_min,
+                              float range_max, Tensor& output_tensor);
   // Converts the input FrameBuffer to a float Tensor. Output tensor must have
   // type kFloat32.
   absl::Status ConvertToFloatTensor(
       std::shared_ptr<const FrameBuffer> input_frame, float range_min,
       float range_max, Tensor& output_tensor);
 
+  BorderMode border_mode_;
   Tensor::ElementType tensor_type_;
 
   // Temporary buffers and their respective sizes.
@@ -100,8 +127,13 @@ absl::Status ImageToTensorFrameBufferConverter::Convert(
   FrameBuffer::Dimension output_dimension{/*width=*/output_shape.dims[2],
                                           /*height=*/output_shape.dims[1]};
 
-  // Optimized path for multiples of 90°.
-  if (RadiansToDegrees(roi.rotation) % 90 == 0) {
+  // Optimized path for multiples of 90° that don't require reading pixels
+  // outside of the input.
+  const int rotation_degrees = RadiansToDegrees(roi.rotation);
+  if (rotation_degrees % 90 == 0 &&
+      IsAxisAlignedRoiInsideImage(roi, rotation_degrees,
+                                  input_frame->dimension().width,
+                                  input_frame->dimension().height)) {
     if (tensor_type_ == Tensor::ElementType::kUInt8) {
       auto view = output_tensor.GetCpuWriteView();
       uint8_t* data = view.buffer<uint8_t>();
@@ -122,13 +154,8 @@ absl::Status ImageToTensorFrameBufferConverter::Convert(
       return ConvertToFloatTensor(output_frame, range_min, range_max,
                                   output_tensor);
     }
-  } else {
-    // TODO: add support for arbitrary rotations
-    return absl::UnimplementedError(
-        "FrameBufferConverter doesn't yet support rotations that are not "
-        "multiples of 90°.");
   }
-  return absl::OkStatus();
+  return CropWarpAffine(input_frame, roi, range_min, range_max, output_tensor);
 }
 
 absl::Status ImageToTensorFrameBufferConverter::ValidateTensorShape(
@@ -209,6 +236,34 @@ absl::Status ImageToTensorFrameBufferConverter::CropRotateResize90Degrees(
   return absl::OkStatus();
 }
 
+absl::Status ImageToTensorFrameBufferConverter::CropWarpAffine(
+    std::shared_ptr<const FrameBuffer> input, const RotatedRect& roi,
+    float range_min, float range_max, Tensor& output_tensor) {
+  const auto& output_shape = output_tensor.shape();
+  const std::array<float, 6> matrix = GetOutputToRoiMatrix(
+      roi, /*output_width=*/output_shape.dims[2],
+      /*output_height=*/output_shape.dims[1]);
+  const bool zero_border = border_mode_ == BorderMode::kZero;
+  if (tensor_type_ == Tensor::ElementType::kUInt8) {
+    auto view = output_tensor.GetCpuWriteView();
+    auto output_frame = frame_buffer::CreateFromRgbRawBuffer(
+        view.buffer<uint8_t>(),
+        {/*width=*/output_shape.dims[2], /*height=*/output_shape.dims[1]});
+    return frame_buffer::WarpAffine(*input, matrix, zero_border,
+                                    output_frame.get());
+  }
+  RET_CHECK(output_tensor.element_type() == Tensor::ElementType::kFloat32);
+  constexpr float kInputImageRangeMin = 0.0f;
+  constexpr float kInputImageRangeMax = 255.0f;
+  ABSL_ASSIGN_OR_RETURN(
+      auto transform,
+      GetValueRangeTransformation(kInputImageRangeMin, kInputImageRangeMax,
+                                  range_min, range_max));
+  return frame_buffer::WarpAffineToFloatTensor(*input, matrix, zero_border,
+                                               transform.scale,
+                                               transform.offset, output_tensor);
+}
+
 absl::Status ImageToTensorFrameBufferConverter::ConvertToFloatTensor(
     std::shared_ptr<const FrameBuffer> input_frame, float range_min,
     float range_max, Tensor& output_tensor) {
@@ -235,13 +290,8 @@ CreateFrameBufferConverter(CalculatorContext* cc, BorderMode border_mode,
                         "ImageToTensorFrameBufferConverter, type: %d.",
                         tensor_type));
   }
-  // TODO: add support for BorderMode:kZero.
-  if (border_mode == BorderMode::kZero) {
-    return absl::UnimplementedError(
-        "BorderMode::kZero is not yet supported by "
-        "ImageToTensorFrameBufferConverter");
-  }
-  return std::make_unique<ImageToTensorFrameBufferConverter>(tensor_type);
+  return std::make_unique<ImageToTensorFrameBufferConverter>(border_mode,
+                                                             tensor_type);
 }
 
 }  // namespace mediapipe
@@ -24,11 +24,13 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_opencv.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/canonical_errors.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
+#include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/statusor.h"
 
 namespace mediapipe {
@@ -72,6 +74,16 @@ class ImageToTensorOpenCvConverter : public ImageToTensorConverter {
                        float range_min, float range_max,
                        int tensor_buffer_offset,
                        Tensor& output_tensor) override {
+    if (IsYuvImage(input)) {
+      // OpenCV can't sample YUV planes directly, so fall back to converting
+      // the whole frame through the storage's ImageFrame view.
+      auto image_frame = input.GetGpuBuffer(/*upload_to_gpu=*/false)
+                             .GetReadView<ImageFrame>();
+      RET_CHECK(image_frame) << "Failed to convert YUV image to ImageFrame.";
+      return Convert(
+          mediapipe::Image(std::const_pointer_cast<ImageFrame>(image_frame)),
+          roi, range_min, range_max, tensor_buffer_offset, output_tensor);
+    }
     const bool is_supported_format =
         input.image_format() == mediapipe::ImageFormat::SRGB ||
         input.image_format() == mediapipe::ImageFormat::SRGBA ||
@@ -29,6 +29,7 @@
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/gpu/gpu_buffer_format.h"
 #if !MEDIAPIPE_DISABLE_GPU
 #include "mediapipe/gpu/gpu_buffer.h"
 #endif  // !MEDIAPIPE_DISABLE_GPU
@@ -101,6 +102,17 @@ absl::Status ValidateRoi(const RotatedRect& roi) {
   return absl::OkStatus();
 }
 
+bool IsAxisAlignedRoiInsideImage(const RotatedRect& roi, int rotation_degrees,
+                                 int image_width, int image_height) {
+  const bool swap = rotation_degrees % 180 != 0;
+  const float roi_width = swap ? roi.height : roi.width;
+  const float roi_height = swap ? roi.width : roi.height;
+  const float left = roi.center_x - roi_width / 2;
+  const float top = roi.center_y - roi_height / 2;
+  return left >= 0 && top >= 0 && left + roi_width <= image_width &&
+         top + roi_height <= image_height;
+}
+
 absl::StatusOr<ValueTransformation> GetValueRangeTransformation(
     float from_range_min, float from_range_max, float to_range_min,
     float to_range_max) {
@@ -258,6 +270,10 @@ Tensor::ElementType GetOutputTensorType(bool uses_gpu,
     if (params.is_float_output) {
       return Tensor::ElementType::kFloat32;
     }
+    if (params.quantization_parameters.has_value()) {
+      return params.is_signed_output ? Tensor::ElementType::kInt8
+                                     : Tensor::ElementType::kUInt8;
+    }
     if (params.range_min < 0) {
       return Tensor::ElementType::kInt8;
     } else {
@@ -268,6 +284,21 @@ Tensor::ElementType GetOutputTensorType(bool uses_gpu,
   return Tensor::ElementType::kFloat32;
 }
 
+bool IsYuvImage(const mediapipe::Image& image) {
+  if (image.UsesGpu()) {
+    return false;
+  }
+  switch (image.format()) {
+    case GpuBufferFormat::kNV12:
+    case GpuBufferFormat::kNV21:
+    case GpuBufferFormat::kI420:
+    case GpuBufferFormat::kYV12:
+      return true;
+    default:
+      return false;
+  }
+}
+
 int GetNumOutputChannels(const mediapipe::Image& image) {
 #if !MEDIAPIPE_DISABLE_GPU
 #if MEDIAPIPE_METAL_ENABLED
@@ -276,6 +307,10 @@ int GetNumOutputChannels(const mediapipe::Image& image) {
   }
 #endif  // MEDIAPIPE_METAL_ENABLED
 #endif  // !MEDIAPIPE_DISABLE_GPU
+  // YUV images are converted to RGB while being sampled.
+  if (IsYuvImage(image)) {
+    return 3;
+  }
   // TODO: Add a unittest here to test the behavior on GPU, i.e.
   // failure.
   // Only output channel == 1 when running on CPU and the input image channel
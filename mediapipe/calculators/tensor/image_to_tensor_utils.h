@@ -58,6 +58,11 @@ struct OutputTensorParams {
   bool is_float_output;
   float range_min;
   float range_max;
+  // Set for quantized ranges, see QuantizedRange in
+  // ImageToTensorCalculatorOptions. range_min/range_max are then expressed in
+  // the quantized domain.
+  std::optional<Tensor::QuantizationParameters> quantization_parameters;
+  bool is_signed_output = false;
 };
 
 // Generates a new ROI or converts it from normalized rect.
@@ -74,6 +79,12 @@ absl::StatusOr<std::array<float, 4>> PadRoi(int input_tensor_width,
 // Validates ROI parameters (checks for NaNs and positive dimensions).
 absl::Status ValidateRoi(const RotatedRect& roi);
 
+// Returns whether `roi`, axis-aligned after a rotation by `rotation_degrees`
+// (a multiple of 90), lies fully inside an `image_width` x `image_height`
+// image. Edges are compared unrounded, so sub-pixel overhangs are outside.
+bool IsAxisAlignedRoiInsideImage(const RotatedRect& roi, int rotation_degrees,
+                                 int image_width, int image_height);
+
 // Represents a transformation of value which involves scaling and offsetting.
 // To apply transformation:
 // ValueTransformation transform = ...
@@ -129,14 +140,15 @@ void GetTransposedRotatedSubRectToRectTransformMatrix(
 
 // Validates the output dimensions set in the option proto. The input option
 // proto is expected to have to following fields:
-//  output_tensor_float_range, output_tensor_int_range, output_tensor_uint_range
-//  output_tensor_width, output_tensor_height.
+//  output_tensor_float_range, output_tensor_int_range, output_tensor_uint_range,
+//  output_tensor_quantized_range, output_tensor_width, output_tensor_height.
 // See ImageToTensorCalculatorOptions for the description of each field.
 template <typename T>
 absl::Status ValidateOptionOutputDims(const T& options) {
   RET_CHECK(options.has_output_tensor_float_range() ||
             options.has_output_tensor_int_range() ||
-            options.has_output_tensor_uint_range())
+            options.has_output_tensor_uint_range() ||
+            options.has_output_tensor_quantized_range())
       << "Output tensor range is required.";
   if (options.has_output_tensor_float_range()) {
     RET_CHECK_LT(options.output_tensor_float_range().min(),
@@ -165,6 +177,20 @@ absl::Status ValidateOptionOutputDims(const T& options) {
         << "The maximum of the output int tensor range must be less than or "
            "equal to 127.";
   }
+  if (options.has_output_tensor_quantized_range()) {
+    const auto& range = options.output_tensor_quantized_range();
+    RET_CHECK_LT(range.min(), range.max())
+        << "Valid output quantized tensor range is required.";
+    RET_CHECK_GT(range.scale(), 0.0f)
+        << "The quantization scale must be positive.";
+    if (range.is_signed()) {
+      RET_CHECK(range.zero_point() >= -128 && range.zero_point() <= 127)
+          << "The int8 zero point must be within [-128, 127].";
+    } else {
+      RET_CHECK(range.zero_point() >= 0 && range.zero_point() <= 255)
+          << "The uint8 zero point must be within [0, 255].";
+    }
+  }
   if (options.has_output_tensor_width()) {
     RET_CHECK_GT(options.output_tensor_width(), 0)
         << "Valid output tensor width is required.";
@@ -189,6 +215,13 @@ OutputTensorParams GetOutputTensorParams(const T& options) {
         static_cast<float>(options.output_tensor_int_range().min());
     params.range_max =
         static_cast<float>(options.output_tensor_int_range().max());
+  } else if (options.has_output_tensor_quantized_range()) {
+    const auto& range = options.output_tensor_quantized_range();
+    params.range_min = range.min() / range.scale() + range.zero_point();
+    params.range_max = range.max() / range.scale() + range.zero_point();
+    params.quantization_parameters =
+        Tensor::QuantizationParameters(range.scale(), range.zero_point());
+    params.is_signed_output = range.is_signed();
   } else {
     params.range_min = options.output_tensor_float_range().min();
     params.range_max = options.output_tensor_float_range().max();
@@ -212,6 +245,10 @@ BorderMode GetBorderMode(
 Tensor::ElementType GetOutputTensorType(bool uses_gpu,
                                         const OutputTensorParams& params);
 
+// Returns true if the image is backed by CPU YUV 4:2:0 storage (NV12, NV21,
+// I420 or YV12), e.g. a GpuBufferStorageYuvImage.
+bool IsYuvImage(const mediapipe::Image& image);
+
 // Gets the number of output channels from the input Image format.
 int GetNumOutputChannels(const mediapipe::Image& image);
 
@@ -183,6 +183,44 @@ TEST(ValidateRoi, InvalidDimensions) {
                        HasSubstr("ROI width and height must be > 0")));
 }
 
+TEST(IsAxisAlignedRoiInsideImage, RoiInsideImage) {
+  RotatedRect roi{
+      .center_x = 50, .center_y = 25, .width = 100, .height = 50,
+      .rotation = 0};
+  EXPECT_TRUE(IsAxisAlignedRoiInsideImage(roi, /*rotation_degrees=*/0,
+                                          /*image_width=*/100,
+                                          /*image_height=*/50));
+  // Rotated by 90 degrees, the ROI is 50 wide and 100 high.
+  EXPECT_FALSE(IsAxisAlignedRoiInsideImage(roi, /*rotation_degrees=*/90,
+                                           /*image_width=*/100,
+                                           /*image_height=*/50));
+  EXPECT_TRUE(IsAxisAlignedRoiInsideImage(roi, /*rotation_degrees=*/270,
+                                          /*image_width=*/50,
+                                          /*image_height=*/100));
+}
+
+TEST(IsAxisAlignedRoiInsideImage, SubPixelNegativeEdges) {
+  // The left edge is at -0.5.
+  RotatedRect roi{
+      .center_x = 49.5, .center_y = 25, .width = 100, .height = 50,
+      .rotation = 0};
+  EXPECT_FALSE(IsAxisAlignedRoiInsideImage(roi, /*rotation_degrees=*/0,
+                                           /*image_width=*/100,
+                                           /*image_height=*/50));
+  // The top edge is at -0.5.
+  roi = {.center_x = 50, .center_y = 24.5, .width = 100, .height = 50,
+         .rotation = 0};
+  EXPECT_FALSE(IsAxisAlignedRoiInsideImage(roi, /*rotation_degrees=*/0,
+                                           /*image_width=*/100,
+                                           /*image_height=*/50));
+  // The right edge is at 100.5.
+  roi = {.center_x = 50.5, .center_y = 25, .width = 100, .height = 50,
+         .rotation = 0};
+  EXPECT_FALSE(IsAxisAlignedRoiInsideImage(roi, /*rotation_degrees=*/0,
+                                           /*image_width=*/100,
+                                           /*image_height=*/50));
+}
+
 testing::Matcher<ValueTransformation> EqValueTransformation(float scale,
                                                             float offset) {
   return ::testing::AllOf(
@@ -303,6 +341,53 @@ TEST(GetOutputTensorParams, ImageToTensorCalcOptionsNoTensorDims) {
   EXPECT_EQ(params3.output_height, std::nullopt);
 }
 
+TEST(GetOutputTensorParams, ImageToTensorCalcOptionsQuantizedRange) {
+  // [-1, 1] for an int8 input quantized with scale 1/128 and zero point 0.
+  const auto options =
+      mediapipe::ParseTextProtoOrDie<mediapipe::ImageToTensorCalculatorOptions>(
+          R"pb(
+            output_tensor_quantized_range {
+              min: -1
+              max: 1
+              scale: 0.0078125
+              zero_point: 0
+              is_signed: true
+            }
+          )pb");
+  MP_EXPECT_OK(ValidateOptionOutputDims(options));
+  const auto params = GetOutputTensorParams(options);
+  EXPECT_FALSE(params.is_float_output);
+  EXPECT_EQ(params.range_min, -128.0f);
+  EXPECT_EQ(params.range_max, 128.0f);
+  ASSERT_TRUE(params.quantization_parameters.has_value());
+  EXPECT_EQ(params.quantization_parameters->scale, 0.0078125f);
+  EXPECT_EQ(params.quantization_parameters->zero_point, 0);
+  EXPECT_EQ(Tensor::ElementType::kInt8,
+            GetOutputTensorType(/*uses_gpu=*/false, params));
+}
+
+TEST(ValidateOptionOutputDims, InvalidQuantizedRange) {
+  auto options =
+      mediapipe::ParseTextProtoOrDie<mediapipe::ImageToTensorCalculatorOptions>(
+          R"pb(
+            output_tensor_quantized_range {
+              min: 0
+              max: 1
+              scale: 0
+              zero_point: 0
+            }
+          )pb");
+  EXPECT_THAT(ValidateOptionOutputDims(options),
+              StatusIs(absl::StatusCode::kInternal,
+                       HasSubstr("quantization scale must be positive")));
+
+  options.mutable_output_tensor_quantized_range()->set_scale(1.0f / 255);
+  options.mutable_output_tensor_quantized_range()->set_zero_point(-1);
+  EXPECT_THAT(ValidateOptionOutputDims(options),
+              StatusIs(absl::StatusCode::kInternal,
+                       HasSubstr("uint8 zero point")));
+}
+
 TEST(GetBorderMode, GetBorderMode) {
   // Default to REPLICATE.
   auto border_mode =
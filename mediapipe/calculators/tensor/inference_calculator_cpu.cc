@@ -20,14 +20,21 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
 #include "mediapipe/calculators/tensor/inference_calculator.h"
 #include "mediapipe/calculators/tensor/inference_calculator_utils.h"
 #include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
 #include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+#include "mediapipe/calculators/tensor/inference_runner_shape_cache.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/cpu_thread_budget_service.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/memory_manager_service.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #if defined(MEDIAPIPE_ANDROID)
@@ -50,10 +57,32 @@ class InferenceCalculatorCpuImpl
  private:
   absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateInferenceRunner(
       CalculatorContext* cc);
-  absl::StatusOr<TfLiteDelegatePtr> MaybeCreateDelegate(CalculatorContext* cc);
+  // Returns the number of threads of an interpreter asking for
+  // `num_threads`, charged to the thread budget if any. Interpreters created
+  // with the same `thread_reservation` share its threads, which are reserved
+  // by the first one.
+  int ReserveInterpreterThreads(
+      CalculatorContext* cc, int num_threads,
+      CpuThreadBudget::Reservation* thread_reservation);
+  // Delegates created with the same `thread_reservation` share its threads,
+  // which are reserved by the first one.
+  absl::StatusOr<TfLiteDelegatePtr> MaybeCreateDelegate(
+      CalculatorContext* cc, CpuThreadBudget::Reservation* thread_reservation);
   absl::StatusOr<std::vector<Tensor>> Process(
       CalculatorContext* cc, const TensorSpan& tensor_span) override;
   std::unique_ptr<InferenceRunner> inference_runner_;
+  // Enables pooling of output tensor CPU buffers.
+  MemoryManager* memory_manager_ = nullptr;
+  // Graph-wide CPU thread budget limiting the delegate and interpreter
+  // threads, if any.
+  CpuThreadBudget* thread_budget_ = nullptr;
+  // Threads reserved for one pooled interpreter, shared by its
+  // shape-specialized interpreters as these run one at a time.
+  struct ThreadReservations {
+    CpuThreadBudget::Reservation delegate;
+    CpuThreadBudget::Reservation interpreter;
+  };
+  std::vector<ThreadReservations> thread_reservations_;
 };
 
 absl::Status InferenceCalculatorCpuImpl::UpdateContract(
@@ -61,6 +90,12 @@ absl::Status InferenceCalculatorCpuImpl::UpdateContract(
   const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
   RET_CHECK(!options.model_path().empty() ^ kSideInModel(cc).IsConnected())
       << "Either model as side packet or model path in options is required.";
+  RET_CHECK((options.num_interpreters() == 1 && !options.has_shape_cache()) ||
+            options.input_output_config().feedback_tensor_links().empty())
+      << "num_interpreters > 1 and shape_cache are not supported with feedback "
+         "tensors.";
+  cc->UseService(kMemoryManagerService).Optional();
+  cc->UseService(kCpuThreadBudgetService).Optional();
 
   ABSL_RETURN_IF_ERROR(TensorContractCheck(cc));
 
@@ -68,6 +103,12 @@ absl::Status InferenceCalculatorCpuImpl::UpdateContract(
 }
 
 absl::Status InferenceCalculatorCpuImpl::Open(CalculatorContext* cc) {
+  if (cc->Service(kMemoryManagerService).IsAvailable()) {
+    memory_manager_ = &cc->Service(kMemoryManagerService).GetObject();
+  }
+  if (cc->Service(kCpuThreadBudgetService).IsAvailable()) {
+    thread_budget_ = &cc->Service(kCpuThreadBudgetService).GetObject();
+  }
   ABSL_ASSIGN_OR_RETURN(inference_runner_, CreateInferenceRunner(cc));
   return InferenceCalculatorNodeImpl::UpdateIoMapping(
       cc, inference_runner_->GetInputOutputTensorNames());
@@ -82,6 +123,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorCpuImpl::Process(
 
 absl::Status InferenceCalculatorCpuImpl::Close(CalculatorContext* cc) {
   inference_runner_ = nullptr;
+  thread_reservations_.clear();
   return absl::OkStatus();
 }
 
@@ -92,15 +134,50 @@ InferenceCalculatorCpuImpl::CreateInferenceRunner(CalculatorContext* cc) {
   const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
   const int interpreter_num_threads =
       cc->Options<mediapipe::InferenceCalculatorOptions>().cpu_num_thread();
-  ABSL_ASSIGN_OR_RETURN(TfLiteDelegatePtr delegate, MaybeCreateDelegate(cc));
-  return CreateInferenceInterpreterDelegateRunner(
-      std::move(model_packet), std::move(op_resolver_packet),
-      std::move(delegate), interpreter_num_threads,
-      &options.input_output_config());
+  // Runner factories keep pointers into thread_reservations_.
+  thread_reservations_.reserve(options.num_interpreters());
+  return CreateInferenceRunnerPool(
+      options.num_interpreters(),
+      [&]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+        ThreadReservations* thread_reservations =
+            &thread_reservations_.emplace_back();
+        InferenceRunnerFactory create_runner =
+            [&, thread_reservations]()
+            -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+          ABSL_ASSIGN_OR_RETURN(
+              TfLiteDelegatePtr delegate,
+              MaybeCreateDelegate(cc, &thread_reservations->delegate));
+          return CreateInferenceInterpreterDelegateRunner(
+              model_packet, op_resolver_packet, std::move(delegate),
+              ReserveInterpreterThreads(cc, interpreter_num_threads,
+                                        &thread_reservations->interpreter),
+              &options.input_output_config(),
+              TensorIoMode::kZeroCopyIfPossible, memory_manager_);
+        };
+        if (!options.has_shape_cache()) {
+          return create_runner();
+        }
+        return CreateShapeCachingInferenceRunner(options.shape_cache(),
+                                                 std::move(create_runner));
+      });
+}
+
+int InferenceCalculatorCpuImpl::ReserveInterpreterThreads(
+    CalculatorContext* cc, int num_threads,
+    CpuThreadBudget::Reservation* thread_reservation) {
+  // Non-positive values leave TfLite running the ops on the calling thread
+  // alone, which the budget already accounts for.
+  if (thread_budget_ == nullptr || num_threads <= 1) return num_threads;
+  if (thread_reservation->num_threads() == 0) {
+    *thread_reservation = thread_budget_->ReserveWithCallingThread(
+        absl::StrCat(cc->NodeName(), " interpreter"), num_threads);
+  }
+  return thread_reservation->num_threads();
 }
 
 absl::StatusOr<TfLiteDelegatePtr>
-InferenceCalculatorCpuImpl::MaybeCreateDelegate(CalculatorContext* cc) {
+InferenceCalculatorCpuImpl::MaybeCreateDelegate(
+    CalculatorContext* cc, CpuThreadBudget::Reservation* thread_reservation) {
   const auto& calculator_opts =
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   auto opts_delegate = calculator_opts.delegate();
@@ -156,6 +233,13 @@ InferenceCalculatorCpuImpl::MaybeCreateDelegate(CalculatorContext* cc) {
     auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
     xnnpack_opts.num_threads =
         GetXnnpackNumThreads(opts_has_delegate, opts_delegate);
+    if (thread_budget_ != nullptr) {
+      if (thread_reservation->num_threads() == 0) {
+        *thread_reservation = thread_budget_->ReserveWithCallingThread(
+            cc->NodeName(), xnnpack_opts.num_threads);
+      }
+      xnnpack_opts.num_threads = thread_reservation->num_threads();
+    }
     return TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
                              &TfLiteXNNPackDelegateDelete);
   }
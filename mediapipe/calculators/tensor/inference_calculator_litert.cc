@@ -20,11 +20,16 @@
 #include "absl/status/statusor.h"
 #include "absl/time/time.h"
 #include "mediapipe/calculators/tensor/inference_calculator.h"
+#include "mediapipe/calculators/tensor/inference_calculator_utils.h"
 #include "mediapipe/calculators/tensor/inference_runner.h"
 #include "mediapipe/calculators/tensor/inference_runner_litert.h"
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+#include "mediapipe/calculators/tensor/inference_runner_shape_cache.h"
 #include "mediapipe/calculators/tensor/litert/litert_service.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/cpu_thread_budget_service.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/memory_manager_service.h"
@@ -62,6 +67,9 @@ class InferenceCalculatorLiteRtImpl
   std::unique_ptr<InferenceRunner> inference_runner_;
   // Enable pooling of AHWBs in Tensor instances.
   MemoryManager* memory_manager_ = nullptr;
+  // Graph-wide CPU thread budget limiting the CPU accelerator threads, if any.
+  CpuThreadBudget* thread_budget_ = nullptr;
+  CpuThreadBudget::Reservation thread_reservation_;
 #if MEDIAPIPE_METAL_ENABLED
   MPPMetalHelper* metal_helper_ = nil;
 #endif  // MEDIAPIPE_METAL_ENABLED
@@ -78,8 +86,16 @@ absl::Status InferenceCalculatorLiteRtImpl::UpdateContract(
   const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
   RET_CHECK(!options.model_path().empty() ^ kSideInModel(cc).IsConnected())
       << "Either model as side packet or model path in options is required.";
+  if (options.has_shape_cache()) {
+    // Each compiled model holds its own accelerator resources.
+    RET_CHECK(!UseGpu(options) && !options.delegate().litert().has_npu())
+        << "shape_cache is only supported on CPU.";
+    RET_CHECK(options.input_output_config().feedback_tensor_links().empty())
+        << "shape_cache is not supported with feedback tensors.";
+  }
 
   cc->UseService(kMemoryManagerService).Optional();
+  cc->UseService(kCpuThreadBudgetService).Optional();
   cc->UseService(kLiteRtService).Optional();
   if (UseGpu(options)) {
     ABSL_RETURN_IF_ERROR(mediapipe::GlCalculatorHelper::UpdateContract(cc));
@@ -91,6 +107,9 @@ absl::Status InferenceCalculatorLiteRtImpl::Open(CalculatorContext* cc) {
   if (cc->Service(kMemoryManagerService).IsAvailable()) {
     memory_manager_ = &cc->Service(kMemoryManagerService).GetObject();
   }
+  if (cc->Service(kCpuThreadBudgetService).IsAvailable()) {
+    thread_budget_ = &cc->Service(kCpuThreadBudgetService).GetObject();
+  }
 
   if (UseGpu(cc->Options<mediapipe::InferenceCalculatorOptions>())) {
     ABSL_RETURN_IF_ERROR(gpu_helper_.Open(cc));
@@ -120,6 +139,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorLiteRtImpl::Process(
 
 absl::Status InferenceCalculatorLiteRtImpl::Close(CalculatorContext* cc) {
   inference_runner_ = nullptr;
+  thread_reservation_ = CpuThreadBudget::Reservation();
   return absl::OkStatus();
 }
 
@@ -136,6 +156,13 @@ InferenceCalculatorLiteRtImpl::CreateInferenceRunner(CalculatorContext* cc) {
     litert.mutable_npu()->set_dispatch_library_path(
         litert_service.GetDispatchLibraryPath());
   }
+  if (litert.has_cpu() && thread_budget_ != nullptr) {
+    thread_reservation_ = thread_budget_->ReserveWithCallingThread(
+        cc->NodeName(), litert.cpu().has_num_threads()
+                            ? litert.cpu().num_threads()
+                            : GetCpuDefaultNumThreads());
+    litert.mutable_cpu()->set_num_threads(thread_reservation_.num_threads());
+  }
 #if MEDIAPIPE_METAL_ENABLED
   void* metal_helper = nullptr;
   if (UseGpu(options)) {
@@ -144,19 +171,28 @@ InferenceCalculatorLiteRtImpl::CreateInferenceRunner(CalculatorContext* cc) {
   }
 #endif  // MEDIAPIPE_METAL_ENABLED
 
-  return InferenceRunnerLiteRt::Create(
-      std::move(model_packet), litert,
-      options.has_input_output_config() ? &options.input_output_config()
-                                        : nullptr,
-      memory_manager_,
-      UseGpu(options) ? gpu_helper_.GetSharedGlContext() : nullptr,
+  InferenceRunnerFactory create_runner =
+      [&]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+    return InferenceRunnerLiteRt::Create(
+        model_packet, litert,
+        options.has_input_output_config() ? &options.input_output_config()
+                                          : nullptr,
+        memory_manager_,
+        UseGpu(options) ? gpu_helper_.GetSharedGlContext() : nullptr,
 #if defined(__EMSCRIPTEN__)
-      /*.webgpu_service=*/nullptr,
+        /*.webgpu_service=*/nullptr,
 #endif  // __EMSCRIPTEN__
 #if MEDIAPIPE_METAL_ENABLED
-      metal_helper,
+        metal_helper,
 #endif  // MEDIAPIPE_METAL_ENABLED
-      /*.litert_options=*/std::nullopt);
+        /*.litert_options=*/std::nullopt);
+  };
+  if (!options.has_shape_cache()) {
+    return create_runner();
+  }
+  // The compiled models run one at a time and hence share thread_reservation_.
+  return CreateShapeCachingInferenceRunner(options.shape_cache(),
+                                           std::move(create_runner));
 }
 
 }  // namespace api2
@@ -14,6 +14,7 @@
 
 #include "mediapipe/calculators/tensor/inference_calculator.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -25,6 +26,7 @@
 #include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "flatbuffers/flatbuffers.h"
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
 #include "mediapipe/calculators/tensor/inference_calculator_test_base.h"
 #include "mediapipe/framework/api3/function_runner.h"
@@ -33,6 +35,8 @@
 #include "mediapipe/framework/api3/stream.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/cpu_thread_budget_service.h"
 #include "mediapipe/framework/deps/file_path.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/benchmark.h"
@@ -41,9 +45,11 @@
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"  // NOLINT
 #include "mediapipe/framework/tool/validate_type.h"
+#include "mediapipe/util/tflite/tflite_model_loader.h"
 #include "tflite/error_reporter.h"
 #include "tflite/kernels/register.h"
 #include "tflite/model.h"
+#include "tflite/schema/schema_generated.h"
 #include "tflite/util.h"
 
 #ifdef __APPLE__
@@ -281,6 +287,252 @@ TEST(InferenceCalculatorTest, SmokeTestXnnpackMultithread) {
               /*use_vectors=*/true,
               /*apply_default_tflite_tensor_alignment=*/false);
 }
+TEST(InferenceCalculatorTest, SmokeTestTfliteInterpreterPool) {
+  DoSmokeTest(
+      /*graph_proto=*/absl::StrReplaceAll(
+          kGraphWithModelPathInOption,
+          {{"$delegate", "num_interpreters: 3 delegate { tflite {} }"},
+           {"$mmap", "false"}}),
+      /*use_vectors=*/true, /*apply_default_tflite_tensor_alignment=*/false,
+      /*expected_inference_calculator=*/"InferenceCalculatorCpu");
+}
+TEST(InferenceCalculatorTest, SmokeTestXnnpackInterpreterPool) {
+  DoSmokeTest(
+      /*graph_proto=*/absl::StrReplaceAll(
+          kGraphWithModelPathInOption,
+          {{"$delegate", "num_interpreters: 3 delegate { xnnpack {} }"},
+           {"$mmap", "false"}}),
+      /*use_vectors=*/true, /*apply_default_tflite_tensor_alignment=*/false,
+      /*expected_inference_calculator=*/"InferenceCalculatorXnnpack");
+}
+TEST(InferenceCalculatorTest, SmokeTestXnnpackShapeCache) {
+  DoSmokeTest(
+      /*graph_proto=*/absl::StrReplaceAll(
+          kGraphWithModelPathInOption,
+          {{"$delegate",
+            "num_interpreters: 2 shape_cache { max_entries: 2 } "
+            "delegate { xnnpack {} }"},
+           {"$mmap", "false"}}),
+      /*use_vectors=*/true, /*apply_default_tflite_tensor_alignment=*/false,
+      /*expected_inference_calculator=*/"InferenceCalculatorXnnpack");
+}
+
+// The executor, the XNNPACK delegate and the interpreter all draw from one
+// budget, so together they never use more threads than the budget's cores.
+TEST(InferenceCalculatorTest, GraphAndInterpreterStayWithinCpuThreadBudget) {
+  constexpr int kNumCores = 4;
+  CalculatorGraphConfig graph_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "tensor_in"
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "tensor_in"
+          output_stream: "tensor_a"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "tensor_a"
+          output_stream: "tensor_b"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "tensor_b"
+          output_stream: "tensor_c"
+        }
+        node {
+          name: "inference"
+          calculator: "InferenceCalculator"
+          input_stream: "TENSORS:tensor_c"
+          output_stream: "TENSORS:tensor_out"
+          options {
+            [mediapipe.InferenceCalculatorOptions.ext] {
+              model_path: "mediapipe/calculators/tensor/testdata/add.bin"
+              cpu_num_thread: 8
+              delegate { xnnpack { num_threads: 8 } }
+            }
+          }
+        }
+      )pb");
+  auto budget = std::make_shared<CpuThreadBudget>(kNumCores);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.SetServiceObject(kCpuThreadBudgetService, budget));
+  MP_ASSERT_OK(graph.Initialize(graph_config));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  int num_charged_threads = 0;
+  int num_delegate_threads = 0;
+  bool has_interpreter_reservation = false;
+  for (const CpuThreadBudget::ReservationInfo& reservation :
+       budget->GetReservations()) {
+    num_charged_threads += reservation.charged_threads;
+    if (reservation.owner == "inference") {
+      num_delegate_threads = reservation.granted_threads;
+    } else if (reservation.owner == "inference interpreter") {
+      has_interpreter_reservation = true;
+    }
+  }
+  EXPECT_LE(num_charged_threads, kNumCores);
+  // The executor leaves room for the delegate threads.
+  EXPECT_GT(num_delegate_threads, 1);
+  EXPECT_TRUE(has_interpreter_reservation);
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+}
+
+constexpr int kDynamicModelInputSize = 4;
+constexpr int kDynamicModelOutputSize = 2;
+
+// Returns a model with a single FULLY_CONNECTED op whose input has a dynamic
+// batch dimension: [batch, 4] -> [batch, 2]. The first output channel is the
+// sum of the inputs and the second one weighs input k by k + 1. The constant
+// weights are packed by XNNPACK, into the weights cache if there is one.
+TfLiteModelPtr CreateDynamicBatchFullyConnectedModel() {
+  constexpr float kWeights[kDynamicModelOutputSize][kDynamicModelInputSize] = {
+      {1.0f, 1.0f, 1.0f, 1.0f}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  flatbuffers::FlatBufferBuilder builder;
+  builder.ForceVectorAlignment(sizeof(kWeights), sizeof(uint8_t),
+                               tflite::kDefaultTensorAlignment);
+  const auto weights_data = builder.CreateVector(
+      reinterpret_cast<const uint8_t*>(kWeights), sizeof(kWeights));
+  const std::vector<flatbuffers::Offset<tflite::Buffer>> buffers = {
+      tflite::CreateBuffer(builder),
+      tflite::CreateBuffer(builder, weights_data)};
+
+  const std::vector<int> input_shape = {1, kDynamicModelInputSize};
+  const std::vector<int> input_signature = {-1, kDynamicModelInputSize};
+  const std::vector<int> weights_shape = {kDynamicModelOutputSize,
+                                          kDynamicModelInputSize};
+  const std::vector<int> output_shape = {1, kDynamicModelOutputSize};
+  const std::vector<int> output_signature = {-1, kDynamicModelOutputSize};
+  const std::vector<flatbuffers::Offset<tflite::Tensor>> tensors = {
+      tflite::CreateTensorDirect(builder, &input_shape,
+                                 tflite::TensorType_FLOAT32, /*buffer=*/0,
+                                 "input", /*quantization=*/0,
+                                 /*is_variable=*/false, /*sparsity=*/0,
+                                 &input_signature),
+      tflite::CreateTensorDirect(builder, &weights_shape,
+                                 tflite::TensorType_FLOAT32, /*buffer=*/1,
+                                 "weights"),
+      tflite::CreateTensorDirect(builder, &output_shape,
+                                 tflite::TensorType_FLOAT32, /*buffer=*/0,
+                                 "output", /*quantization=*/0,
+                                 /*is_variable=*/false, /*sparsity=*/0,
+                                 &output_signature)};
+
+  // No bias: optional tensors are referenced by index -1.
+  const std::vector<int> op_inputs = {0, 1, -1};
+  const std::vector<int> op_outputs = {2};
+  const std::vector<flatbuffers::Offset<tflite::Operator>> operators = {
+      tflite::CreateOperatorDirect(
+          builder, /*opcode_index=*/0, &op_inputs, &op_outputs,
+          tflite::BuiltinOptions_FullyConnectedOptions,
+          tflite::CreateFullyConnectedOptions(builder).Union())};
+  const std::vector<int> subgraph_inputs = {0};
+  const std::vector<int> subgraph_outputs = {2};
+  const std::vector<flatbuffers::Offset<tflite::SubGraph>> subgraphs = {
+      tflite::CreateSubGraphDirect(builder, &tensors, &subgraph_inputs,
+                                   &subgraph_outputs, &operators, "main")};
+  const std::vector<flatbuffers::Offset<tflite::OperatorCode>> operator_codes =
+      {tflite::CreateOperatorCode(
+          builder,
+          /*deprecated_builtin_code=*/tflite::BuiltinOperator_FULLY_CONNECTED,
+          /*custom_code=*/0, /*version=*/1,
+          /*builtin_code=*/tflite::BuiltinOperator_FULLY_CONNECTED)};
+  tflite::FinishModelBuffer(
+      builder, tflite::CreateModelDirect(builder, TFLITE_SCHEMA_VERSION,
+                                         &operator_codes, &subgraphs,
+                                         "dynamic batch fully connected",
+                                         &buffers));
+
+  // The model references the flatbuffer, which must outlive it.
+  auto model_buffer =
+      std::make_shared<flatbuffers::DetachedBuffer>(builder.Release());
+  std::unique_ptr<tflite::FlatBufferModel> flatbuffer_model =
+      tflite::FlatBufferModel::BuildFromBuffer(
+          reinterpret_cast<const char*>(model_buffer->data()),
+          model_buffer->size());
+  ABSL_CHECK(flatbuffer_model != nullptr);
+  return TfLiteModelPtr(
+      flatbuffer_model.release(),
+      [model_buffer](tflite::FlatBufferModel* model) { delete model; });
+}
+
+// Runs batches of different sizes, i.e. distinct input shapes, through pooled
+// XNNPACK interpreters that share a weights cache. There are more shapes than
+// shape cache entries, so runners are both reused and resized to new shapes
+// after the weights cache has been finalized.
+TEST(InferenceCalculatorTest, XnnpackShapeCacheRunsDistinctInputShapes) {
+  CalculatorGraphConfig graph_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "tensor_in"
+        input_side_packet: "model"
+        node {
+          calculator: "InferenceCalculator"
+          input_stream: "TENSORS:tensor_in"
+          output_stream: "TENSORS:tensor_out"
+          input_side_packet: "MODEL:model"
+          options {
+            [mediapipe.InferenceCalculatorOptions.ext] {
+              num_interpreters: 2
+              shape_cache { max_entries: 2 }
+              delegate { xnnpack {} }
+            }
+          }
+        }
+      )pb");
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("tensor_out", &graph_config, &output_packets);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(graph_config));
+  MP_ASSERT_OK(graph.StartRun(
+      {{"model",
+        MakePacket<TfLiteModelPtr>(CreateDynamicBatchFullyConnectedModel())}}));
+
+  const std::vector<int> batch_sizes = {1, 3, 5, 3, 1, 5, 3};
+  for (int t = 0; t < batch_sizes.size(); ++t) {
+    Tensor input(Tensor::ElementType::kFloat32,
+                 Tensor::Shape({batch_sizes[t], kDynamicModelInputSize},
+                               /*is_dynamic=*/true));
+    {
+      auto view = input.GetCpuWriteView();
+      float* buffer = view.buffer<float>();
+      for (int i = 0; i < input.shape().num_elements(); ++i) {
+        buffer[i] = t + i;
+      }
+    }
+    std::vector<Tensor> input_vec;
+    input_vec.push_back(std::move(input));
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "tensor_in", MakePacket<std::vector<Tensor>>(std::move(input_vec))
+                         .At(Timestamp(t))));
+  }
+  MP_ASSERT_OK(graph.CloseInputStream("tensor_in"));
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  ASSERT_EQ(output_packets.size(), batch_sizes.size());
+  for (int t = 0; t < batch_sizes.size(); ++t) {
+    const auto& outputs = output_packets[t].Get<std::vector<Tensor>>();
+    ASSERT_EQ(outputs.size(), 1);
+    EXPECT_EQ(outputs[0].shape().dims,
+              std::vector<int>({batch_sizes[t], kDynamicModelOutputSize}));
+    auto view = outputs[0].GetCpuReadView();
+    const float* buffer = view.buffer<float>();
+    for (int b = 0; b < batch_sizes[t]; ++b) {
+      float sum = 0.0f;
+      float weighted_sum = 0.0f;
+      for (int k = 0; k < kDynamicModelInputSize; ++k) {
+        const float x = t + b * kDynamicModelInputSize + k;
+        sum += x;
+        weighted_sum += (k + 1) * x;
+      }
+      EXPECT_FLOAT_EQ(buffer[b * kDynamicModelOutputSize], sum)
+          << "packet " << t << ", batch " << b;
+      EXPECT_FLOAT_EQ(buffer[b * kDynamicModelOutputSize + 1], weighted_sum)
+          << "packet " << t << ", batch " << b;
+    }
+  }
+}
 
 // Run our above CPU inference SmokeTests, but with graphs altered to use the
 // new `TENSOR` inputs and outputs.
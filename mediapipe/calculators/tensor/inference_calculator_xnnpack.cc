@@ -19,14 +19,21 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
 #include "mediapipe/calculators/tensor/inference_calculator.h"
 #include "mediapipe/calculators/tensor/inference_calculator_utils.h"
 #include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
 #include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+#include "mediapipe/calculators/tensor/inference_runner_shape_cache.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/cpu_thread_budget_service.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/memory_manager.h"
+#include "mediapipe/framework/memory_manager_service.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
@@ -48,9 +55,37 @@ class InferenceCalculatorXnnpackImpl
       CalculatorContext* cc, const TensorSpan& tensor_span) override;
   absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateInferenceRunner(
       CalculatorContext* cc);
-  absl::StatusOr<TfLiteDelegatePtr> CreateDelegate(CalculatorContext* cc);
-
+  // Returns the number of threads of an interpreter asking for
+  // `num_threads`, charged to the thread budget if any. Interpreters created
+  // with the same `thread_reservation` share its threads, which are reserved
+  // by the first one.
+  int ReserveInterpreterThreads(
+      CalculatorContext* cc, int num_threads,
+      CpuThreadBudget::Reservation* thread_reservation);
+  // Delegates created with the same `thread_reservation` share its threads,
+  // which are reserved by the first one.
+  absl::StatusOr<TfLiteDelegatePtr> CreateDelegate(
+      CalculatorContext* cc, CpuThreadBudget::Reservation* thread_reservation);
+
+  // Lets the delegates of pooled and shape-specialized interpreters share
+  // packed weights. Must outlive the delegates, hence declared before
+  // inference_runner_.
+  std::unique_ptr<TfLiteXNNPackDelegateWeightsCache,
+                  decltype(&TfLiteXNNPackDelegateWeightsCacheDelete)>
+      weights_cache_{nullptr, &TfLiteXNNPackDelegateWeightsCacheDelete};
   std::unique_ptr<InferenceRunner> inference_runner_;
+  // Enables pooling of output tensor CPU buffers.
+  MemoryManager* memory_manager_ = nullptr;
+  // Graph-wide CPU thread budget limiting the delegate and interpreter
+  // threads, if any.
+  CpuThreadBudget* thread_budget_ = nullptr;
+  // Threads reserved for one pooled interpreter, shared by its
+  // shape-specialized interpreters as these run one at a time.
+  struct ThreadReservations {
+    CpuThreadBudget::Reservation delegate;
+    CpuThreadBudget::Reservation interpreter;
+  };
+  std::vector<ThreadReservations> thread_reservations_;
 };
 
 absl::Status InferenceCalculatorXnnpackImpl::UpdateContract(
@@ -60,11 +95,23 @@ absl::Status InferenceCalculatorXnnpackImpl::UpdateContract(
   const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
   RET_CHECK(!options.model_path().empty() ^ kSideInModel(cc).IsConnected())
       << "Either model as side packet or model path in options is required.";
+  RET_CHECK((options.num_interpreters() == 1 && !options.has_shape_cache()) ||
+            options.input_output_config().feedback_tensor_links().empty())
+      << "num_interpreters > 1 and shape_cache are not supported with feedback "
+         "tensors.";
+  cc->UseService(kMemoryManagerService).Optional();
+  cc->UseService(kCpuThreadBudgetService).Optional();
 
   return absl::OkStatus();
 }
 
 absl::Status InferenceCalculatorXnnpackImpl::Open(CalculatorContext* cc) {
+  if (cc->Service(kMemoryManagerService).IsAvailable()) {
+    memory_manager_ = &cc->Service(kMemoryManagerService).GetObject();
+  }
+  if (cc->Service(kCpuThreadBudgetService).IsAvailable()) {
+    thread_budget_ = &cc->Service(kCpuThreadBudgetService).GetObject();
+  }
   ABSL_ASSIGN_OR_RETURN(inference_runner_, CreateInferenceRunner(cc));
   return InferenceCalculatorNodeImpl::UpdateIoMapping(
       cc, inference_runner_->GetInputOutputTensorNames());
@@ -79,6 +126,8 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorXnnpackImpl::Process(
 
 absl::Status InferenceCalculatorXnnpackImpl::Close(CalculatorContext* cc) {
   inference_runner_ = nullptr;
+  weights_cache_ = nullptr;
+  thread_reservations_.clear();
   return absl::OkStatus();
 }
 
@@ -89,16 +138,80 @@ InferenceCalculatorXnnpackImpl::CreateInferenceRunner(CalculatorContext* cc) {
   const auto& calculator_opts =
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   const int interpreter_num_threads = calculator_opts.cpu_num_thread();
-  ABSL_ASSIGN_OR_RETURN(TfLiteDelegatePtr delegate, CreateDelegate(cc));
-  return CreateInferenceInterpreterDelegateRunner(
-      std::move(model_packet), std::move(op_resolver_packet),
-      std::move(delegate), interpreter_num_threads,
-      &calculator_opts.input_output_config(),
-      calculator_opts.delegate().xnnpack().enable_zero_copy_tensor_io());
+  const int num_interpreters = calculator_opts.num_interpreters();
+  const int num_shape_cache_entries =
+      calculator_opts.has_shape_cache()
+          ? calculator_opts.shape_cache().max_entries()
+          : 1;
+  const auto& xnnpack_opts = calculator_opts.delegate().xnnpack();
+  TensorIoMode tensor_io_mode = TensorIoMode::kZeroCopyIfPossible;
+  if (xnnpack_opts.has_enable_zero_copy_tensor_io()) {
+    tensor_io_mode = xnnpack_opts.enable_zero_copy_tensor_io()
+                         ? TensorIoMode::kZeroCopy
+                         : TensorIoMode::kCopy;
+  }
+  if (num_interpreters * num_shape_cache_entries > 1) {
+    weights_cache_.reset(TfLiteXNNPackDelegateWeightsCacheCreate());
+    RET_CHECK(weights_cache_ != nullptr)
+        << "Failed to create XNNPACK weights cache.";
+  }
+  // Runner factories keep pointers into thread_reservations_.
+  thread_reservations_.reserve(num_interpreters);
+  ABSL_ASSIGN_OR_RETURN(
+      std::unique_ptr<InferenceRunner> runner,
+      CreateInferenceRunnerPool(
+          num_interpreters,
+          [&]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+            ThreadReservations* thread_reservations =
+                &thread_reservations_.emplace_back();
+            InferenceRunnerFactory create_runner =
+                [&, thread_reservations]()
+                -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+              ABSL_ASSIGN_OR_RETURN(
+                  TfLiteDelegatePtr delegate,
+                  CreateDelegate(cc, &thread_reservations->delegate));
+              return CreateInferenceInterpreterDelegateRunner(
+                  model_packet, op_resolver_packet, std::move(delegate),
+                  ReserveInterpreterThreads(cc, interpreter_num_threads,
+                                            &thread_reservations->interpreter),
+                  &calculator_opts.input_output_config(), tensor_io_mode,
+                  memory_manager_);
+            };
+            if (!calculator_opts.has_shape_cache()) {
+              return create_runner();
+            }
+            return CreateShapeCachingInferenceRunner(
+                calculator_opts.shape_cache(), std::move(create_runner));
+          }));
+  if (weights_cache_ != nullptr) {
+    // All delegates are created and have packed the weights for their
+    // current input shapes. Runners may still resize their inputs later
+    // (always so with a shape cache), which re-prepares the delegate and can
+    // insert weights packed for the new shapes, so the cache must stay open
+    // to insertions.
+    RET_CHECK(TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(
+        weights_cache_.get()))
+        << "Failed to finalize XNNPACK weights cache.";
+  }
+  return runner;
+}
+
+int InferenceCalculatorXnnpackImpl::ReserveInterpreterThreads(
+    CalculatorContext* cc, int num_threads,
+    CpuThreadBudget::Reservation* thread_reservation) {
+  // Non-positive values leave TfLite running the ops on the calling thread
+  // alone, which the budget already accounts for.
+  if (thread_budget_ == nullptr || num_threads <= 1) return num_threads;
+  if (thread_reservation->num_threads() == 0) {
+    *thread_reservation = thread_budget_->ReserveWithCallingThread(
+        absl::StrCat(cc->NodeName(), " interpreter"), num_threads);
+  }
+  return thread_reservation->num_threads();
 }
 
 absl::StatusOr<TfLiteDelegatePtr>
-InferenceCalculatorXnnpackImpl::CreateDelegate(CalculatorContext* cc) {
+InferenceCalculatorXnnpackImpl::CreateDelegate(
+    CalculatorContext* cc, CpuThreadBudget::Reservation* thread_reservation) {
   const auto& calculator_opts =
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   auto opts_delegate = calculator_opts.delegate();
@@ -119,6 +232,14 @@ InferenceCalculatorXnnpackImpl::CreateDelegate(CalculatorContext* cc) {
   auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
   xnnpack_opts.num_threads =
       GetXnnpackNumThreads(opts_has_delegate, opts_delegate);
+  if (thread_budget_ != nullptr) {
+    if (thread_reservation->num_threads() == 0) {
+      *thread_reservation = thread_budget_->ReserveWithCallingThread(
+          cc->NodeName(), xnnpack_opts.num_threads);
+    }
+    xnnpack_opts.num_threads = thread_reservation->num_threads();
+  }
+  xnnpack_opts.weights_cache = weights_cache_.get();
   return TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
                            &TfLiteXNNPackDelegateDelete);
 }
@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -28,6 +29,7 @@
 #include "mediapipe/calculators/tensor/inference_io_mapper.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/calculators/tensor/tflite_delegate_ptr.h"
+#include "mediapipe/calculators/tensor/tflite_op_profiler.h"
 #include "mediapipe/framework/api2/packet.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/tensor.h"
@@ -69,9 +71,29 @@ absl::Status VerifyModelTensorsForCustomAllocation(
   return absl::OkStatus();
 }
 
+// Returns true if no input can be resized, i.e. binding tensors once suffices.
+bool HasStaticInputShapes(const Interpreter& interpreter) {
+  for (const int input_tensor_index : interpreter.inputs()) {
+    const TfLiteIntArray* dims_signature =
+        interpreter.tensor(input_tensor_index)->dims_signature;
+    // The signature is omitted if all dimensions are known.
+    if (dims_signature == nullptr) continue;
+    for (int i = 0; i < dims_signature->size; ++i) {
+      if (dims_signature->data[i] < 0) return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the buffer of `tensor` can be replaced by a custom
+// allocation, as opposed to e.g. dynamically allocated string tensors.
+bool CanBindTensor(const TfLiteTensor& tensor) {
+  return tensor.allocation_type == kTfLiteArenaRw;
+}
+
 absl::StatusOr<std::vector<Tensor>> AllocateOutputTensors(
     const std::vector<int>& model_output_indexes,
-    const Interpreter& interpreter) {
+    const Interpreter& interpreter, MemoryManager* memory_manager) {
   std::vector<Tensor> output_tensors;
   output_tensors.reserve(model_output_indexes.size());
   for (int i = 0; i < model_output_indexes.size(); ++i) {
@@ -79,7 +101,7 @@ absl::StatusOr<std::vector<Tensor>> AllocateOutputTensors(
         interpreter.tensor(interpreter.outputs()[model_output_indexes[i]]);
     ABSL_ASSIGN_OR_RETURN(Tensor output_tensor,
                           CreateTensorWithTfLiteTensorSpecs(
-                              *reference_tensor, /*memory_manager=*/nullptr,
+                              *reference_tensor, memory_manager,
                               tflite::kDefaultTensorAlignment));
     output_tensors.push_back(std::move(output_tensor));
   }
@@ -117,13 +139,17 @@ class InferenceInterpreterDelegateRunner : public InferenceRunner {
       std::unique_ptr<Interpreter> interpreter, TfLiteDelegatePtr delegate,
       InputOutputTensorNames&& input_output_tensor_names,
       std::unique_ptr<InferenceFeedbackManager> feedback_manager,
-      bool enable_zero_copy_tensor_io)
+      TensorIoMode tensor_io_mode, std::vector<bool> bind_input_tensors,
+      std::vector<bool> bind_output_tensors, MemoryManager* memory_manager)
       : model_(std::move(model)),
         delegate_(std::move(delegate)),
         interpreter_(std::move(interpreter)),
         input_output_tensor_names_(std::move(input_output_tensor_names)),
         feedback_manager_(std::move(feedback_manager)),
-        enable_zero_copy_tensor_io_(enable_zero_copy_tensor_io) {}
+        tensor_io_mode_(tensor_io_mode),
+        bind_input_tensors_(std::move(bind_input_tensors)),
+        bind_output_tensors_(std::move(bind_output_tensors)),
+        memory_manager_(memory_manager) {}
 
   absl::StatusOr<std::vector<Tensor>> Run(
       CalculatorContext* cc, const TensorSpan& tensor_span) override;
@@ -138,7 +164,18 @@ class InferenceInterpreterDelegateRunner : public InferenceRunner {
   std::unique_ptr<Interpreter> interpreter_;
   InputOutputTensorNames input_output_tensor_names_;
   std::unique_ptr<InferenceFeedbackManager> feedback_manager_;
-  bool enable_zero_copy_tensor_io_ = false;
+  TensorIoMode tensor_io_mode_ = TensorIoMode::kCopy;
+  // Whether the buffers of the model inputs and outputs, by index in
+  // Interpreter::inputs() and outputs(), are bound to the MediaPipe tensors.
+  std::vector<bool> bind_input_tensors_;
+  std::vector<bool> bind_output_tensors_;
+  // Bound in place of input tensors that can't be bound in kZeroCopyIfPossible
+  // mode, e.g. misaligned ones. Keyed by index in Interpreter::inputs().
+  absl::flat_hash_map<int, Tensor> input_staging_tensors_;
+  // Optional pool for the CPU storage of output tensors.
+  MemoryManager* memory_manager_ = nullptr;
+  // Attached to the interpreter on the first run with operator profiling.
+  std::unique_ptr<TfLiteOpProfiler> op_profiler_;
 };
 
 absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
@@ -175,6 +212,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
   // inference call to provide Tensor read access to the interpreter.
   std::vector<Tensor::CpuReadView> input_tensor_views;
   input_tensor_views.reserve(tensor_span.size());
+  std::vector<Tensor::CpuWriteView> staging_tensor_views;
 
   // If the input tensors have dynamic shape, then the tensors need to be
   // resized and reallocated before we can copy the tensor values.
@@ -190,8 +228,9 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
           interpreter_tensor->dims->data,
           interpreter_tensor->dims->data + interpreter_tensor->dims->size};
       if (interpreter_dims != input_tensor.shape().dims) {
-        interpreter_->ResizeInputTensorStrict(input_tensor_index,
-                                              input_tensor.shape().dims);
+        interpreter_->ResizeInputTensorStrict(
+            interpreter_->inputs()[input_tensor_index],
+            input_tensor.shape().dims);
         resized_tensor_shapes = true;
       }
     }
@@ -206,17 +245,46 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
     const Tensor& input_tensor = tensor_span[i];
     // TODO b/329100795 - can TfLite custom allocation work with dynamic
     // tensors?
-    if (enable_zero_copy_tensor_io_) {
+    if (bind_input_tensors_[input_tensor_index]) {
+      const int tflite_tensor_index =
+          interpreter_->inputs()[input_tensor_index];
       auto input_tensor_view = input_tensor.GetCpuReadView();
-      RET_CHECK(IsAlignedWithTFLiteDefaultAlignment(
-          input_tensor_view.buffer<const void>()))
-          << "TfLite custom tensor allocation of input tensors is enabled but "
-             "tensor memory is not aligned to tflite::kDefaultTensorAlignment.";
+      const void* input_buffer = input_tensor_view.buffer<const void>();
+      if (tensor_io_mode_ == TensorIoMode::kZeroCopy ||
+          (IsAlignedWithTFLiteDefaultAlignment(input_buffer) &&
+           TensorDimsAndTypeEqual(input_tensor,
+                                  *interpreter_->tensor(tflite_tensor_index))
+               .ok())) {
+        RET_CHECK(IsAlignedWithTFLiteDefaultAlignment(input_buffer))
+            << "TfLite custom tensor allocation of input tensors is enabled "
+               "but tensor memory is not aligned to "
+               "tflite::kDefaultTensorAlignment.";
+        ABSL_RETURN_IF_ERROR(SetTfLiteCustomAllocation(
+            *interpreter_, input_buffer, input_tensor.bytes(),
+            tflite_tensor_index));
+        input_tensor_views.emplace_back(std::move(input_tensor_view));
+        continue;
+      }
+      // The interpreter tensor may still point to a previous input, so the
+      // input is copied into a staging buffer bound in its place.
+      auto staging_tensor_it = input_staging_tensors_.find(input_tensor_index);
+      if (staging_tensor_it == input_staging_tensors_.end()) {
+        ABSL_ASSIGN_OR_RETURN(Tensor staging_tensor,
+                              CreateTensorWithTfLiteTensorSpecs(
+                                  *interpreter_->tensor(tflite_tensor_index),
+                                  /*memory_manager=*/nullptr,
+                                  tflite::kDefaultTensorAlignment));
+        staging_tensor_it =
+            input_staging_tensors_
+                .emplace(input_tensor_index, std::move(staging_tensor))
+                .first;
+      }
+      Tensor& staging_tensor = staging_tensor_it->second;
+      auto staging_tensor_view = staging_tensor.GetCpuWriteView();
       ABSL_RETURN_IF_ERROR(SetTfLiteCustomAllocation(
-          *interpreter_, input_tensor_view.buffer<const void>(),
-          input_tensor.bytes(), interpreter_->inputs()[input_tensor_index]));
-      input_tensor_views.emplace_back(std::move(input_tensor_view));
-      continue;
+          *interpreter_, staging_tensor_view.buffer<void>(),
+          staging_tensor.bytes(), tflite_tensor_index));
+      staging_tensor_views.push_back(std::move(staging_tensor_view));
     }
 
     ABSL_RETURN_IF_ERROR(CopyCpuInputIntoInterpreterTensor(
@@ -226,49 +294,56 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
   ABSL_ASSIGN_OR_RETURN(
       std::vector<Tensor> output_tensors,
       AllocateOutputTensors(output_indices_excluding_feedback_tensors,
-                            *interpreter_));
+                            *interpreter_, memory_manager_));
 
   std::vector<Tensor::CpuWriteView> output_tensor_views;
-  if (enable_zero_copy_tensor_io_) {
-    for (int i = 0; i < output_indices_excluding_feedback_tensors.size(); ++i) {
-      const int output_tensor_index =
-          output_indices_excluding_feedback_tensors[i];
-      Tensor& tensor = output_tensors[i];
-      auto write_view = output_tensors[i].GetCpuWriteView();
-      ABSL_RETURN_IF_ERROR(SetTfLiteCustomAllocation(
-          *interpreter_, write_view.buffer<void>(), tensor.bytes(),
-          interpreter_->outputs()[output_tensor_index]));
-      output_tensor_views.push_back(std::move(write_view));
-    }
+  for (int i = 0; i < output_indices_excluding_feedback_tensors.size(); ++i) {
+    const int output_tensor_index =
+        output_indices_excluding_feedback_tensors[i];
+    if (!bind_output_tensors_[output_tensor_index]) continue;
+    Tensor& tensor = output_tensors[i];
+    auto write_view = output_tensors[i].GetCpuWriteView();
+    ABSL_RETURN_IF_ERROR(SetTfLiteCustomAllocation(
+        *interpreter_, write_view.buffer<void>(), tensor.bytes(),
+        interpreter_->outputs()[output_tensor_index]));
+    output_tensor_views.push_back(std::move(write_view));
   }
 
   // Reallocation is needed for memory sanity.
   if (resized_tensor_shapes || !input_tensor_views.empty() ||
-      !output_tensor_views.empty()) {
+      !staging_tensor_views.empty() || !output_tensor_views.empty()) {
     interpreter_->AllocateTensors();
   }
 
   // Run inference.
   {
     MEDIAPIPE_PROFILING(CPU_TASK_INVOKE, cc);
+    if (op_profiler_ == nullptr && TfLiteOpProfiler::IsEnabled(cc)) {
+      op_profiler_ = std::make_unique<TfLiteOpProfiler>();
+      interpreter_->SetProfiler(op_profiler_.get());
+    }
+    if (op_profiler_ != nullptr) op_profiler_->StartInvoke(cc);
     RET_CHECK_EQ(interpreter_->Invoke(), kTfLiteOk);
+    if (op_profiler_ != nullptr) op_profiler_->FinishInvoke(cc);
   }
   input_tensor_views.clear();
+  staging_tensor_views.clear();
   output_tensor_views.clear();
 
-  if (enable_zero_copy_tensor_io_) {
-    // TODO b/340643988 -To avoid dangling pointers to Tensors that are not
-    // owned anymore by the InferenceRunner (once output tensors are passed to
-    // downstream calculators), we should invalidate TfLiteCustomAllocation
-    // assignments here.
-  } else {
-    // Copy output tensors from the interpreter.
-    for (int i = 0; i < output_indices_excluding_feedback_tensors.size(); ++i) {
-      const int output_tensor_index =
-          interpreter_->outputs()[output_indices_excluding_feedback_tensors[i]];
-      ABSL_RETURN_IF_ERROR(CopyInterpreterTensorIntoCpuOutput(
-          *interpreter_, output_tensor_index, output_tensors[i]));
+  // TODO b/340643988 -To avoid dangling pointers to Tensors that are not
+  // owned anymore by the InferenceRunner (once output tensors are passed to
+  // downstream calculators), we should invalidate TfLiteCustomAllocation
+  // assignments here. Until then, every run binds all bound tensors anew.
+
+  // Copy the remaining output tensors from the interpreter.
+  for (int i = 0; i < output_indices_excluding_feedback_tensors.size(); ++i) {
+    if (bind_output_tensors_[output_indices_excluding_feedback_tensors[i]]) {
+      continue;
     }
+    const int output_tensor_index =
+        interpreter_->outputs()[output_indices_excluding_feedback_tensors[i]];
+    ABSL_RETURN_IF_ERROR(CopyInterpreterTensorIntoCpuOutput(
+        *interpreter_, output_tensor_index, output_tensors[i]));
   }
   if (feedback_manager_) {
     feedback_manager_->SwapFeedbackTensors();
@@ -283,7 +358,7 @@ CreateInferenceInterpreterDelegateRunner(
     int interpreter_num_threads,
     const mediapipe::InferenceCalculatorOptions::InputOutputConfig*
         input_output_config,
-    bool enable_zero_copy_tensor_io) {
+    TensorIoMode tensor_io_mode, MemoryManager* memory_manager) {
   InterpreterBuilder interpreter_builder(*model.Get(), op_resolver.Get());
   if (delegate) {
     interpreter_builder.AddDelegate(delegate.get());
@@ -308,13 +383,39 @@ CreateInferenceInterpreterDelegateRunner(
     ABSL_RETURN_IF_ERROR(inference_feedback_manager->Init(
         *input_output_config, input_output_tensor_names, interpreter.get()));
   }
-  if (enable_zero_copy_tensor_io) {
-    ABSL_RETURN_IF_ERROR(VerifyModelTensorsForCustomAllocation(*interpreter));
+  std::vector<bool> bind_input_tensors(interpreter->inputs().size(), false);
+  std::vector<bool> bind_output_tensors(interpreter->outputs().size(), false);
+  switch (tensor_io_mode) {
+    case TensorIoMode::kCopy:
+      break;
+    case TensorIoMode::kZeroCopy:
+      ABSL_RETURN_IF_ERROR(
+          VerifyModelTensorsForCustomAllocation(*interpreter));
+      bind_input_tensors.assign(bind_input_tensors.size(), true);
+      bind_output_tensors.assign(bind_output_tensors.size(), true);
+      break;
+    case TensorIoMode::kZeroCopyIfPossible:
+      if (!VerifyModelTensorsForCustomAllocation(*interpreter).ok() ||
+          !HasStaticInputShapes(*interpreter)) {
+        tensor_io_mode = TensorIoMode::kCopy;
+        break;
+      }
+      for (int i = 0; i < interpreter->inputs().size(); ++i) {
+        bind_input_tensors[i] =
+            CanBindTensor(*interpreter->tensor(interpreter->inputs()[i]));
+      }
+      for (int i = 0; i < interpreter->outputs().size(); ++i) {
+        bind_output_tensors[i] =
+            CanBindTensor(*interpreter->tensor(interpreter->outputs()[i]));
+      }
+      break;
   }
   return std::make_unique<InferenceInterpreterDelegateRunner>(
       std::move(model), std::move(interpreter), std::move(delegate),
       std::move(input_output_tensor_names),
-      std::move(inference_feedback_manager), enable_zero_copy_tensor_io);
+      std::move(inference_feedback_manager), tensor_io_mode,
+      std::move(bind_input_tensors), std::move(bind_output_tensors),
+      memory_manager);
 }
 
 }  // namespace mediapipe
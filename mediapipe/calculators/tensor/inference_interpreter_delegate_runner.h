@@ -22,12 +22,30 @@
 #include "mediapipe/calculators/tensor/inference_runner.h"
 #include "mediapipe/calculators/tensor/tflite_delegate_ptr.h"
 #include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/util/tflite/tflite_model_loader.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/core/api/op_resolver.h"
 
 namespace mediapipe {
 
+// How an interpreter runner passes tensors to and from the interpreter.
+enum class TensorIoMode {
+  // Tensors are copied into and out of interpreter owned buffers.
+  kCopy,
+  // Tensor buffers are bound to the interpreter tensors using TfLite's custom
+  // allocation API, which fails unless all tensors can be bound: input
+  // tensors must be aligned to tflite::kDefaultTensorAlignment bytes and the
+  // model must have no duplicate output tensors (tensors with identical TfLite
+  // tensor indices) and no passthrough input->output tensors (input and output
+  // tensors with identical TfLite tensor indices).
+  kZeroCopy,
+  // Like kZeroCopy, but tensors which can't be bound are copied instead. Only
+  // used for models with static input shapes, as binding tensors across
+  // resizes is not supported.
+  kZeroCopyIfPossible,
+};
+
 // Creates inference runner which run inference using newly initialized
 // interpreter and provided `delegate`.
 //
@@ -35,14 +53,10 @@ namespace mediapipe {
 // use what is available by default.
 // `input_output_config` optional config to enable feedback tensors.
 //
-// `enable_zero_copy_tensor_input` and `enable_zero_copy_tensor_output` enable
-// zero copy tensor I/O using TfLite's custom allocator API.
-// Note that `enable_zero_copy_tensor_input` requires *all* input tensors to be
-// aligned to tflite::kDefaultTensorAlignment bytes.
-// `enable_zero_copy_tensor_output` requires that the model has no duplicate
-// output tensors (tensors with identical TfLite tensor indices) and no
-// passthrough input->output tensors (input and output tensors with identical
-// TfLite tensor indices).
+// `tensor_io_mode` selects whether tensors are copied or bound to the
+// interpreter, see TensorIoMode.
+//
+// `memory_manager`, if provided, pools the CPU storage of output tensors.
 absl::StatusOr<std::unique_ptr<InferenceRunner>>
 CreateInferenceInterpreterDelegateRunner(
     api2::Packet<TfLiteModelPtr> model,
@@ -50,7 +64,8 @@ CreateInferenceInterpreterDelegateRunner(
     int interpreter_num_threads,
     const mediapipe::InferenceCalculatorOptions::InputOutputConfig*
         input_output_config = nullptr,
-    bool enable_zero_copy_tensor_io = false);
+    TensorIoMode tensor_io_mode = TensorIoMode::kCopy,
+    MemoryManager* memory_manager = nullptr);
 
 }  // namespace mediapipe
 
@@ -15,6 +15,7 @@
 #include "mediapipe/framework/api2/packet.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
 #include "mediapipe/framework/calculator_state.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/gmock.h"
@@ -34,6 +35,7 @@ namespace {
 
 using ::mediapipe::Tensor;
 using ::testing::HasSubstr;
+using ::testing::MatchesRegex;
 
 constexpr const char kInt32ModelFile[] =
     "mediapipe/calculators/tensor/testdata/"
@@ -69,8 +71,10 @@ REGISTER_CALCULATOR(AnyInvocableCalculator);
 
 class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
  public:
+  // Collects the calculator `profiles` with operator profiling, if not null.
   absl::Status ExecuteAnyInvocableInGraphCalculator(
-      absl::AnyInvocable<absl::Status(CalculatorContext*) const> invokable) {
+      absl::AnyInvocable<absl::Status(CalculatorContext*) const> invokable,
+      std::vector<CalculatorProfile>* profiles = nullptr) {
     mediapipe::api2::builder::Graph graph_builder;
     auto input = graph_builder.In("INPUT")
                      .SetName("input")
@@ -79,6 +83,10 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
         graph_builder.AddNode("AnyInvocableCalculator");
     input >> inference_calculator.In("INPUT")[0];
     auto config = graph_builder.GetConfig();
+    if (profiles != nullptr) {
+      config.mutable_profiler_config()->set_enable_profiler(true);
+      config.mutable_profiler_config()->set_enable_operator_profiling(true);
+    }
     CalculatorGraph graph;
     ABSL_RETURN_IF_ERROR(graph.Initialize(config));
     ABSL_RETURN_IF_ERROR(graph.StartRun({}));
@@ -87,16 +95,21 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
                      CalculatorContext*) const>>(std::move(invokable))
                      .At(mediapipe::Timestamp(0))));
     ABSL_RETURN_IF_ERROR(graph.CloseAllInputStreams());
-    return graph.WaitUntilDone();
+    ABSL_RETURN_IF_ERROR(graph.WaitUntilDone());
+    if (profiles != nullptr) {
+      ABSL_RETURN_IF_ERROR(graph.profiler()->GetCalculatorProfiles(profiles));
+    }
+    return absl::OkStatus();
   }
 
   template <typename VectorT, Tensor::ElementType TensorT>
   absl::Status CreateAndRunInferenceRunner(
       api2::Packet<TfLiteModelPtr> model,
       api2::Packet<tflite::OpResolver> op_resolver, TfLiteDelegatePtr delegate,
-      bool enable_zero_copy_tensor_io,
+      TensorIoMode tensor_io_mode,
       const std::vector<std::vector<VectorT>>& inputs,
-      const std::vector<std::vector<VectorT>>& expected_outputs) {
+      const std::vector<std::vector<VectorT>>& expected_outputs,
+      std::vector<CalculatorProfile>* profiles = nullptr) {
     return ExecuteAnyInvocableInGraphCalculator(
         [&](CalculatorContext* cc) -> absl::Status {
           ABSL_ASSIGN_OR_RETURN(
@@ -104,7 +117,7 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
               CreateInferenceInterpreterDelegateRunner(
                   std::move(model), std::move(op_resolver), std::move(delegate),
                   /*interpreter_num_threads=*/-1,
-                  /*input_output_config=*/nullptr, enable_zero_copy_tensor_io));
+                  /*input_output_config=*/nullptr, tensor_io_mode));
           // Prepare input tensors.
           std::vector<Tensor> input_tensors;
           input_tensors.reserve(inputs.size());
@@ -146,7 +159,8 @@ class InferenceCalculatorDelegateRunnnerTest : public ::testing::Test {
             }
           }
           return absl::OkStatus();
-        });
+        },
+        profiles);
   }
 };
 
@@ -165,7 +179,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<int32_t, Tensor::ElementType::kInt32>(
           std::move(model), std::move(op_resolver), std::move(delegate),
-          /*enable_zero_copy_tensor_io=*/false,
+          TensorIoMode::kCopy,
           /*inputs=*/{{0, 1, 2}},
           /*expected_outputs=*/{{0 * 0, 1 * 1, 2 * 2}})));
 }
@@ -185,7 +199,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
           std::move(model), std::move(op_resolver), std::move(delegate),
-          /*enable_zero_copy_tensor_io=*/false,
+          TensorIoMode::kCopy,
           /*inputs=*/{{0.f, 1.f, 2.f}},
           /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}})));
 }
@@ -205,7 +219,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<int32_t, Tensor::ElementType::kInt32>(
           std::move(model), std::move(op_resolver), std::move(delegate),
-          /*enable_zero_copy_tensor_io=*/true,
+          TensorIoMode::kZeroCopy,
           /*inputs=*/{{0, 1, 2}},
           /*expected_outputs=*/{{0 * 0, 1 * 1, 2 * 2}})));
 }
@@ -225,7 +239,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
           std::move(model), std::move(op_resolver), std::move(delegate),
-          /*enable_zero_copy_tensor_io=*/true,
+          TensorIoMode::kZeroCopy,
           /*inputs=*/{{0.f, 1.f, 2.f}},
           /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}})));
 }
@@ -241,7 +255,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<int32_t, Tensor::ElementType::kInt32>(
           std::move(model), std::move(op_resolver), /*delegate=*/nullptr,
-          /*enable_zero_copy_tensor_io=*/false,
+          TensorIoMode::kCopy,
           /*inputs=*/{{0, 1, 2}},
           /*expected_outputs=*/{{0 * 0, 1 * 1, 2 * 2}})));
 }
@@ -257,7 +271,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
           std::move(model), std::move(op_resolver), /*delegate=*/nullptr,
-          /*enable_zero_copy_tensor_io=*/false,
+          TensorIoMode::kCopy,
           /*inputs=*/{{0.f, 1.f, 2.f}},
           /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}})));
 }
@@ -273,7 +287,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<int32_t, Tensor::ElementType::kInt32>(
           std::move(model), std::move(op_resolver), /*delegate=*/nullptr,
-          /*enable_zero_copy_tensor_io=*/true,
+          TensorIoMode::kZeroCopy,
           /*inputs=*/{{0, 1, 2}},
           /*expected_outputs=*/{{0 * 0, 1 * 1, 2 * 2}})));
 }
@@ -289,7 +303,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
           std::move(model), std::move(op_resolver), /*delegate=*/nullptr,
-          /*enable_zero_copy_tensor_io=*/true,
+          TensorIoMode::kZeroCopy,
           /*inputs=*/{{0.f, 1.f, 2.f}},
           /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}})));
 }
@@ -319,7 +333,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   MP_EXPECT_OK(
       (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
           std::move(model), std::move(op_resolver), std::move(delegate),
-          /*enable_zero_copy_tensor_io=*/false,
+          TensorIoMode::kCopy,
           /*inputs=*/{{1.f}, {2.f}, {3.f}},
           /*expected_outputs=*/{{3.f}, {2.f}, {1.f}})));
 }
@@ -340,7 +354,7 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
   EXPECT_THAT(
       (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
           std::move(model), std::move(op_resolver), std::move(delegate),
-          /*enable_zero_copy_tensor_io=*/true,
+          TensorIoMode::kZeroCopy,
           /*inputs=*/{{1.f}, {2.f}, {3.f}},
           /*expected_outputs=*/{{3.f}, {2.f}, {1.f}})),
       StatusIs(absl::StatusCode::kInternal,
@@ -348,6 +362,105 @@ TEST_F(InferenceCalculatorDelegateRunnnerTest,
                          "input->output passthrough tensors")));
 }
 
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       RunFloatModelWithXNNPackDelegateWithZeroCopyIfPossible) {
+  std::unique_ptr<Resources> resources = CreateDefaultResources();
+  MP_ASSERT_OK_AND_ASSIGN(auto model, TfLiteModelLoader::LoadFromPath(
+                                          *resources, kFloat32ModelFile));
+  // Create XNNPack delegate.
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
+  auto delegate = TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+                                    &TfLiteXNNPackDelegateDelete);
+  MP_EXPECT_OK(
+      (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
+          std::move(model), std::move(op_resolver), std::move(delegate),
+          TensorIoMode::kZeroCopyIfPossible,
+          /*inputs=*/{{0.f, 1.f, 2.f}},
+          /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}})));
+}
+
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       RunPassthroughFloatModelWithXNNPackDelegateWithZeroCopyIfPossible) {
+  std::unique_ptr<Resources> resources = CreateDefaultResources();
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto model,
+      TfLiteModelLoader::LoadFromPath(*resources, k3In3OutSwaps2And0ModelPath));
+  // Create XNNPack delegate.
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
+  auto delegate = TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+                                    &TfLiteXNNPackDelegateDelete);
+  // Passthrough tensors can't be bound, so the runner falls back to copying.
+  MP_EXPECT_OK(
+      (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
+          std::move(model), std::move(op_resolver), std::move(delegate),
+          TensorIoMode::kZeroCopyIfPossible,
+          /*inputs=*/{{1.f}, {2.f}, {3.f}},
+          /*expected_outputs=*/{{3.f}, {2.f}, {1.f}})));
+}
+
+// Runs a real interpreter with operator profiling, so that the ops are
+// reported by the interpreter itself through the attached TfLiteOpProfiler.
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       RunFloatModelWithOperatorProfiling) {
+  std::unique_ptr<Resources> resources = CreateDefaultResources();
+  MP_ASSERT_OK_AND_ASSIGN(auto model, TfLiteModelLoader::LoadFromPath(
+                                          *resources, kFloat32ModelFile));
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  std::vector<CalculatorProfile> profiles;
+  MP_ASSERT_OK(
+      (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
+          std::move(model), std::move(op_resolver), /*delegate=*/nullptr,
+          TensorIoMode::kCopy,
+          /*inputs=*/{{0.f, 1.f, 2.f}},
+          /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}},
+          &profiles)));
+
+  ASSERT_EQ(profiles.size(), 1);
+  EXPECT_EQ(profiles[0].name(), "AnyInvocableCalculator");
+  // The model squares its input with a single op, node 0, run once.
+  ASSERT_EQ(profiles[0].operator_profiles_size(), 1);
+  const OperatorProfile& op_profile = profiles[0].operator_profiles(0);
+  EXPECT_THAT(op_profile.name(), MatchesRegex("[A-Z_0-9]+:0"));
+  EXPECT_EQ(op_profile.runtime().count(), 1);
+}
+
+TEST_F(InferenceCalculatorDelegateRunnnerTest,
+       RunFloatModelWithXNNPackDelegateAndOperatorProfiling) {
+  std::unique_ptr<Resources> resources = CreateDefaultResources();
+  MP_ASSERT_OK_AND_ASSIGN(auto model, TfLiteModelLoader::LoadFromPath(
+                                          *resources, kFloat32ModelFile));
+  auto op_resolver = PacketAdopting<tflite::OpResolver>(
+      std::make_unique<
+          tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>());
+  auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
+  auto delegate = TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+                                    &TfLiteXNNPackDelegateDelete);
+  std::vector<CalculatorProfile> profiles;
+  MP_ASSERT_OK(
+      (CreateAndRunInferenceRunner<float, Tensor::ElementType::kFloat32>(
+          std::move(model), std::move(op_resolver), std::move(delegate),
+          TensorIoMode::kCopy,
+          /*inputs=*/{{0.f, 1.f, 2.f}},
+          /*expected_outputs=*/{{0.f * 0.f, 1.f * 1.f, 2.f * 2.f}},
+          &profiles)));
+
+  // The delegate kernel running the partition is reported at least.
+  ASSERT_EQ(profiles.size(), 1);
+  ASSERT_GE(profiles[0].operator_profiles_size(), 1);
+  for (const OperatorProfile& op_profile : profiles[0].operator_profiles()) {
+    EXPECT_THAT(op_profile.name(), MatchesRegex(".+:[0-9]+"));
+    EXPECT_EQ(op_profile.runtime().count(), 1);
+  }
+}
+
 }  // namespace
 }  // namespace api2
 }  // namespace mediapipe
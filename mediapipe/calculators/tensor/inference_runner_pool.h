@@ -0,0 +1,44 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_RUNNER_POOL_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_RUNNER_POOL_H_
+
+#include <memory>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+
+namespace mediapipe {
+
+using InferenceRunnerFactory =
+    absl::AnyInvocable<absl::StatusOr<std::unique_ptr<InferenceRunner>>()>;
+
+// Creates an InferenceRunner which dispatches each Run call to one of
+// `num_runners` runners created by `factory`. Concurrent Run calls are served
+// by different runners, so up to `num_runners` inferences can be executed in
+// parallel (e.g. for a calculator node with max_in_flight > 1). Each runner is
+// only used by one Run call at a time; further calls block until a runner
+// becomes available.
+//
+// All runners must be created from the same model and hence report the same
+// input/output tensor names. If `num_runners` is 1, the single runner created
+// by `factory` is returned as is.
+absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateInferenceRunnerPool(
+    int num_runners, InferenceRunnerFactory factory);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_RUNNER_POOL_H_
@@ -0,0 +1,159 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/calculators/tensor/inference_io_mapper.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::HasSubstr;
+
+// Tracks how many runs are in progress across all FakeRunners.
+struct RunTracker {
+  absl::Mutex mutex;
+  int active_runs ABSL_GUARDED_BY(mutex) = 0;
+  int max_active_runs ABSL_GUARDED_BY(mutex) = 0;
+  // Runs block until this many runs are in progress or a timeout expires.
+  int wait_for_active_runs ABSL_GUARDED_BY(mutex) = 0;
+  bool reused_busy_runner ABSL_GUARDED_BY(mutex) = false;
+};
+
+class FakeRunner : public InferenceRunner {
+ public:
+  FakeRunner(int id, RunTracker* tracker) : id_(id), tracker_(tracker) {}
+
+  absl::StatusOr<std::vector<Tensor>> Run(
+      CalculatorContext* cc, const TensorSpan& tensor_span) override {
+    absl::MutexLock lock(&tracker_->mutex);
+    if (busy_) {
+      tracker_->reused_busy_runner = true;
+    }
+    busy_ = true;
+    ++tracker_->active_runs;
+    tracker_->max_active_runs =
+        std::max(tracker_->max_active_runs, tracker_->active_runs);
+    tracker_->mutex.AwaitWithTimeout(
+        absl::Condition(
+            +[](RunTracker* t) ABSL_EXCLUSIVE_LOCKS_REQUIRED(t->mutex) {
+              return t->active_runs >= t->wait_for_active_runs;
+            },
+            tracker_),
+        absl::Seconds(5));
+    --tracker_->active_runs;
+    busy_ = false;
+    std::vector<Tensor> outputs;
+    outputs.emplace_back(Tensor::ElementType::kInt32, Tensor::Shape{1});
+    outputs[0].GetCpuWriteView().buffer<int>()[0] = id_;
+    return outputs;
+  }
+
+  const InputOutputTensorNames& GetInputOutputTensorNames() const override {
+    return tensor_names_;
+  }
+
+ private:
+  const int id_;
+  RunTracker* tracker_;
+  bool busy_ = false;
+  InputOutputTensorNames tensor_names_;
+};
+
+InferenceRunnerFactory MakeFactory(RunTracker* tracker, int* num_created) {
+  return [tracker, num_created]()
+             -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+    return std::make_unique<FakeRunner>((*num_created)++, tracker);
+  };
+}
+
+TEST(InferenceRunnerPoolTest, SingleRunnerIsCreatedOnce) {
+  RunTracker tracker;
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      CreateInferenceRunnerPool(1, MakeFactory(&tracker, &num_created)));
+  EXPECT_EQ(num_created, 1);
+  MP_ASSERT_OK_AND_ASSIGN(auto outputs, runner->Run(nullptr, TensorSpan()));
+  ASSERT_EQ(outputs.size(), 1);
+  EXPECT_EQ(outputs[0].GetCpuReadView().buffer<int>()[0], 0);
+}
+
+TEST(InferenceRunnerPoolTest, RunsConcurrentlyOnDistinctRunners) {
+  constexpr int kNumRunners = 3;
+  RunTracker tracker;
+  {
+    absl::MutexLock lock(&tracker.mutex);
+    tracker.wait_for_active_runs = kNumRunners;
+  }
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner, CreateInferenceRunnerPool(
+                       kNumRunners, MakeFactory(&tracker, &num_created)));
+  EXPECT_EQ(num_created, kNumRunners);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumRunners; ++i) {
+    threads.emplace_back([&runner] {
+      MP_EXPECT_OK(runner->Run(nullptr, TensorSpan()));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  absl::MutexLock lock(&tracker.mutex);
+  EXPECT_EQ(tracker.max_active_runs, kNumRunners);
+  EXPECT_FALSE(tracker.reused_busy_runner);
+}
+
+TEST(InferenceRunnerPoolTest, PropagatesFactoryErrors) {
+  int num_calls = 0;
+  auto status_or_runner = CreateInferenceRunnerPool(
+      2, [&num_calls]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+        if (++num_calls == 2) {
+          return absl::InternalError("Failed to create interpreter.");
+        }
+        return std::make_unique<FakeRunner>(0, nullptr);
+      });
+  EXPECT_THAT(status_or_runner.status().message(),
+              HasSubstr("Failed to create interpreter."));
+}
+
+TEST(InferenceRunnerPoolTest, RejectsInvalidNumberOfRunners) {
+  RunTracker tracker;
+  int num_created = 0;
+  EXPECT_FALSE(
+      CreateInferenceRunnerPool(0, MakeFactory(&tracker, &num_created)).ok());
+  EXPECT_EQ(num_created, 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,164 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/inference_runner_shape_cache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_io_mapper.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+namespace {
+
+// Returns a copy of `tensor` whose dimension `dim` is zero-padded to `size`.
+Tensor PadTensor(const Tensor& tensor, int dim, int size) {
+  std::vector<int> dims = tensor.shape().dims;
+  const int unpadded_size = dims[dim];
+  dims[dim] = size;
+  Tensor padded(tensor.element_type(),
+                Tensor::Shape(dims, /*is_dynamic=*/true),
+                tensor.quantization_parameters());
+
+  int64_t num_outer = 1;
+  for (int i = 0; i < dim; ++i) num_outer *= dims[i];
+  int64_t inner_bytes = tensor.element_size();
+  for (int i = dim + 1; i < dims.size(); ++i) inner_bytes *= dims[i];
+  const int64_t src_stride = unpadded_size * inner_bytes;
+  const int64_t dst_stride = size * inner_bytes;
+
+  auto src_view = tensor.GetCpuReadView();
+  auto dst_view = padded.GetCpuWriteView();
+  const char* src = src_view.buffer<char>();
+  char* dst = dst_view.buffer<char>();
+  for (int64_t i = 0; i < num_outer; ++i) {
+    std::memcpy(dst + i * dst_stride, src + i * src_stride, src_stride);
+    std::memset(dst + i * dst_stride + src_stride, 0, dst_stride - src_stride);
+  }
+  return padded;
+}
+
+class ShapeCachingInferenceRunner : public InferenceRunner {
+ public:
+  ShapeCachingInferenceRunner(
+      std::vector<int> bucket_sizes, int bucket_dim,
+      std::vector<std::unique_ptr<InferenceRunner>> runners)
+      : bucket_sizes_(std::move(bucket_sizes)), bucket_dim_(bucket_dim) {
+    for (auto& runner : runners) {
+      entries_.push_back({/*input_shapes=*/{}, std::move(runner)});
+    }
+  }
+
+  absl::StatusOr<std::vector<Tensor>> Run(
+      CalculatorContext* cc, const TensorSpan& tensor_span) override {
+    // Padded copies of the inputs which don't fit their bucket.
+    std::vector<std::optional<Tensor>> padded_tensors(tensor_span.size());
+    std::vector<const Tensor*> input_tensors(tensor_span.size());
+    std::vector<std::vector<int>> input_shapes(tensor_span.size());
+    for (int i = 0; i < tensor_span.size(); ++i) {
+      const Tensor& tensor = tensor_span[i];
+      input_tensors[i] = &tensor;
+      if (!bucket_sizes_.empty() && tensor.shape().is_dynamic) {
+        const int rank = tensor.shape().dims.size();
+        const int dim = bucket_dim_ < 0 ? rank + bucket_dim_ : bucket_dim_;
+        RET_CHECK(dim >= 0 && dim < rank)
+            << "Bucket dimension " << bucket_dim_
+            << " is out of range for input tensor " << i << " of rank "
+            << rank << ".";
+        const int size = tensor.shape().dims[dim];
+        const int bucket_size = GetBucketSize(size);
+        if (bucket_size != size) {
+          padded_tensors[i] = PadTensor(tensor, dim, bucket_size);
+          input_tensors[i] = &*padded_tensors[i];
+        }
+      }
+      input_shapes[i] = input_tensors[i]->shape().dims;
+    }
+
+    // Entries are kept in most recently used order.
+    auto it = absl::c_find_if(entries_, [&input_shapes](const Entry& entry) {
+      return entry.input_shapes == input_shapes;
+    });
+    if (it == entries_.end()) {
+      it = std::prev(entries_.end());
+      it->input_shapes = std::move(input_shapes);
+    }
+    entries_.splice(entries_.begin(), entries_, it);
+    return it->runner->Run(cc, TensorSpan(std::move(input_tensors)));
+  }
+
+  const InputOutputTensorNames& GetInputOutputTensorNames() const override {
+    return entries_.front().runner->GetInputOutputTensorNames();
+  }
+
+ private:
+  struct Entry {
+    std::vector<std::vector<int>> input_shapes;
+    std::unique_ptr<InferenceRunner> runner;
+  };
+
+  // Returns the smallest bucket fitting `size`, or `size` if it exceeds all
+  // buckets.
+  int GetBucketSize(int size) const {
+    auto it = absl::c_lower_bound(bucket_sizes_, size);
+    return it != bucket_sizes_.end() ? *it : size;
+  }
+
+  const std::vector<int> bucket_sizes_;
+  const int bucket_dim_;
+  std::list<Entry> entries_;
+};
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<InferenceRunner>>
+CreateShapeCachingInferenceRunner(
+    const mediapipe::InferenceCalculatorOptions::ShapeCache& options,
+    InferenceRunnerFactory factory) {
+  RET_CHECK_GE(options.max_entries(), 1)
+      << "At least one inference runner is required.";
+  std::vector<int> bucket_sizes(options.bucket_sizes().begin(),
+                                options.bucket_sizes().end());
+  RET_CHECK(absl::c_all_of(bucket_sizes, [](int size) { return size > 0; }))
+      << "Bucket sizes must be positive.";
+  absl::c_sort(bucket_sizes);
+
+  std::vector<std::unique_ptr<InferenceRunner>> runners;
+  runners.reserve(options.max_entries());
+  for (int i = 0; i < options.max_entries(); ++i) {
+    ABSL_ASSIGN_OR_RETURN(std::unique_ptr<InferenceRunner> runner, factory());
+    RET_CHECK(runner != nullptr);
+    runners.push_back(std::move(runner));
+  }
+  return std::make_unique<ShapeCachingInferenceRunner>(
+      std::move(bucket_sizes), options.bucket_dim(), std::move(runners));
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,51 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_RUNNER_SHAPE_CACHE_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_RUNNER_SHAPE_CACHE_H_
+
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+
+namespace mediapipe {
+
+// Creates an InferenceRunner which keeps `options.max_entries()` runners, all
+// created upfront by `factory`, and dispatches each Run call to the runner
+// which last served the same input shapes. Runners thus keep the tensors they
+// allocated for one set of input shapes instead of resizing and reallocating
+// them whenever the shapes of dynamically shaped inputs change. If no runner
+// matches, the least recently used one is taken over for the new shapes.
+//
+// If `options.bucket_sizes()` is set, dimension `options.bucket_dim()` of
+// dynamically shaped inputs (i.e. with Tensor::Shape::is_dynamic set) is
+// zero-padded to the smallest bucket it fits into, so that inputs of similar
+// sizes share a runner. Inputs larger than all buckets are passed as is.
+// Padding must not change the result of the model, e.g. as for BERT-style
+// models taking an input mask, and outputs have the padded shapes.
+//
+// Not thread-safe: the returned runner serves one Run call at a time, like the
+// runners created by `factory`. Use CreateInferenceRunnerPool on top of it to
+// serve concurrent calls.
+absl::StatusOr<std::unique_ptr<InferenceRunner>>
+CreateShapeCachingInferenceRunner(
+    const mediapipe::InferenceCalculatorOptions::ShapeCache& options,
+    InferenceRunnerFactory factory);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_RUNNER_SHAPE_CACHE_H_
@@ -0,0 +1,219 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/inference_runner_shape_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_io_mapper.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/inference_runner_pool.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ShapeCache = ::mediapipe::InferenceCalculatorOptions::ShapeCache;
+
+// Returns the id of the runner and a copy of the first input tensor.
+class FakeRunner : public InferenceRunner {
+ public:
+  explicit FakeRunner(int id) : id_(id) {}
+
+  absl::StatusOr<std::vector<Tensor>> Run(
+      CalculatorContext* cc, const TensorSpan& tensor_span) override {
+    std::vector<Tensor> outputs;
+    outputs.emplace_back(Tensor::ElementType::kInt32, Tensor::Shape{1});
+    outputs[0].GetCpuWriteView().buffer<int>()[0] = id_;
+    const Tensor& input = tensor_span[0];
+    outputs.emplace_back(input.element_type(), input.shape());
+    auto src = input.GetCpuReadView();
+    auto dst = outputs[1].GetCpuWriteView();
+    std::copy_n(src.buffer<char>(), input.bytes(), dst.buffer<char>());
+    return outputs;
+  }
+
+  const InputOutputTensorNames& GetInputOutputTensorNames() const override {
+    return tensor_names_;
+  }
+
+ private:
+  const int id_;
+  InputOutputTensorNames tensor_names_;
+};
+
+InferenceRunnerFactory MakeFactory(int* num_created) {
+  return [num_created]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+    return std::make_unique<FakeRunner>((*num_created)++);
+  };
+}
+
+Tensor MakeInput(const std::vector<int>& values, bool is_dynamic = true) {
+  Tensor tensor(Tensor::ElementType::kInt32,
+                Tensor::Shape({1, static_cast<int>(values.size())},
+                              is_dynamic));
+  auto view = tensor.GetCpuWriteView();
+  std::copy(values.begin(), values.end(), view.buffer<int>());
+  return tensor;
+}
+
+// Runs `runner` on `input` and returns the id of the runner used.
+int RunAndGetRunnerId(InferenceRunner& runner, const Tensor& input) {
+  auto outputs = runner.Run(nullptr, TensorSpan({&input}));
+  EXPECT_TRUE(outputs.ok()) << outputs.status();
+  if (!outputs.ok()) return -1;
+  return (*outputs)[0].GetCpuReadView().buffer<int>()[0];
+}
+
+std::vector<int> GetValues(const Tensor& tensor) {
+  auto view = tensor.GetCpuReadView();
+  const int* values = view.buffer<int>();
+  return std::vector<int>(values, values + tensor.shape().num_elements());
+}
+
+TEST(InferenceRunnerShapeCacheTest, CreatesAllRunnersUpfront) {
+  int num_created = 0;
+  MP_ASSERT_OK(CreateShapeCachingInferenceRunner(
+      ParseTextProtoOrDie<ShapeCache>("max_entries: 3"),
+      MakeFactory(&num_created)));
+  EXPECT_EQ(num_created, 3);
+}
+
+TEST(InferenceRunnerShapeCacheTest, ReusesRunnerForSameShapes) {
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(auto runner,
+                          CreateShapeCachingInferenceRunner(
+                              ParseTextProtoOrDie<ShapeCache>("max_entries: 2"),
+                              MakeFactory(&num_created)));
+  const Tensor short_input = MakeInput({1, 2});
+  const Tensor long_input = MakeInput({1, 2, 3});
+
+  const int short_id = RunAndGetRunnerId(*runner, short_input);
+  const int long_id = RunAndGetRunnerId(*runner, long_input);
+  EXPECT_NE(short_id, long_id);
+  EXPECT_EQ(RunAndGetRunnerId(*runner, short_input), short_id);
+  EXPECT_EQ(RunAndGetRunnerId(*runner, long_input), long_id);
+  EXPECT_EQ(RunAndGetRunnerId(*runner, short_input), short_id);
+}
+
+TEST(InferenceRunnerShapeCacheTest, EvictsLeastRecentlyUsedShapes) {
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(auto runner,
+                          CreateShapeCachingInferenceRunner(
+                              ParseTextProtoOrDie<ShapeCache>("max_entries: 2"),
+                              MakeFactory(&num_created)));
+  const Tensor input_1 = MakeInput({1});
+  const Tensor input_2 = MakeInput({1, 2});
+  const Tensor input_3 = MakeInput({1, 2, 3});
+
+  const int id_1 = RunAndGetRunnerId(*runner, input_1);
+  const int id_2 = RunAndGetRunnerId(*runner, input_2);
+  EXPECT_EQ(RunAndGetRunnerId(*runner, input_1), id_1);
+  // input_2 was used least recently, so its runner is taken over.
+  EXPECT_EQ(RunAndGetRunnerId(*runner, input_3), id_2);
+  EXPECT_EQ(RunAndGetRunnerId(*runner, input_1), id_1);
+  EXPECT_EQ(num_created, 2);
+}
+
+TEST(InferenceRunnerShapeCacheTest, PadsDynamicInputsToBucketSize) {
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      CreateShapeCachingInferenceRunner(ParseTextProtoOrDie<ShapeCache>(R"pb(
+                                          max_entries: 2
+                                          bucket_sizes: [ 8, 4 ]
+                                        )pb"),
+                                        MakeFactory(&num_created)));
+  const Tensor input = MakeInput({1, 2, 3});
+  MP_ASSERT_OK_AND_ASSIGN(auto outputs,
+                          runner->Run(nullptr, TensorSpan({&input})));
+  ASSERT_EQ(outputs.size(), 2);
+  EXPECT_THAT(outputs[1].shape().dims, ElementsAre(1, 4));
+  EXPECT_THAT(GetValues(outputs[1]), ElementsAre(1, 2, 3, 0));
+
+  // Inputs of the same bucket share a runner.
+  const int id = RunAndGetRunnerId(*runner, input);
+  EXPECT_EQ(RunAndGetRunnerId(*runner, MakeInput({1, 2, 3, 4})), id);
+  EXPECT_NE(RunAndGetRunnerId(*runner, MakeInput({1, 2, 3, 4, 5})), id);
+}
+
+TEST(InferenceRunnerShapeCacheTest, PadsInnerBucketDimension) {
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      CreateShapeCachingInferenceRunner(ParseTextProtoOrDie<ShapeCache>(R"pb(
+                                          max_entries: 1
+                                          bucket_sizes: 3
+                                          bucket_dim: 0
+                                        )pb"),
+                                        MakeFactory(&num_created)));
+  Tensor input(Tensor::ElementType::kInt32,
+               Tensor::Shape({2, 2}, /*is_dynamic=*/true));
+  {
+    auto view = input.GetCpuWriteView();
+    std::vector<int> values = {1, 2, 3, 4};
+    std::copy(values.begin(), values.end(), view.buffer<int>());
+  }
+  MP_ASSERT_OK_AND_ASSIGN(auto outputs,
+                          runner->Run(nullptr, TensorSpan({&input})));
+  EXPECT_THAT(outputs[1].shape().dims, ElementsAre(3, 2));
+  EXPECT_THAT(GetValues(outputs[1]), ElementsAre(1, 2, 3, 4, 0, 0));
+}
+
+TEST(InferenceRunnerShapeCacheTest, DoesNotPadStaticOrOversizedInputs) {
+  int num_created = 0;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      CreateShapeCachingInferenceRunner(ParseTextProtoOrDie<ShapeCache>(R"pb(
+                                          max_entries: 1
+                                          bucket_sizes: 4
+                                        )pb"),
+                                        MakeFactory(&num_created)));
+  const Tensor static_input = MakeInput({1, 2}, /*is_dynamic=*/false);
+  MP_ASSERT_OK_AND_ASSIGN(auto outputs,
+                          runner->Run(nullptr, TensorSpan({&static_input})));
+  EXPECT_THAT(outputs[1].shape().dims, ElementsAre(1, 2));
+
+  const Tensor oversized_input = MakeInput({1, 2, 3, 4, 5});
+  MP_ASSERT_OK_AND_ASSIGN(outputs,
+                          runner->Run(nullptr, TensorSpan({&oversized_input})));
+  EXPECT_THAT(GetValues(outputs[1]), ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(InferenceRunnerShapeCacheTest, RejectsInvalidOptions) {
+  int num_created = 0;
+  EXPECT_FALSE(CreateShapeCachingInferenceRunner(
+                   ParseTextProtoOrDie<ShapeCache>("max_entries: 0"),
+                   MakeFactory(&num_created))
+                   .ok());
+  EXPECT_FALSE(CreateShapeCachingInferenceRunner(
+                   ParseTextProtoOrDie<ShapeCache>("bucket_sizes: 0"),
+                   MakeFactory(&num_created))
+                   .ok());
+  EXPECT_EQ(num_created, 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,172 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmark for copying vs. zero-copy tensor I/O of the XNNPACK
+// InferenceCalculator on a model with 1x256x256x3 float input and output.
+// The model's softmax runs on an instrumented TfLite kernel, which reports
+// whether the interpreter worked on the MediaPipe tensor buffers.
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/substitute.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "tflite/c/builtin_op_data.h"
+#include "tflite/c/common.h"
+#include "tflite/core/api/op_resolver.h"
+#include "tflite/kernels/register.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kModelPath[] =
+    "mediapipe/calculators/tensor/testdata/1x256x256x3_softmax.tflite";
+
+// Buffers the softmax kernel read from and wrote to in its last run.
+const void* softmax_input_buffer = nullptr;
+const void* softmax_output_buffer = nullptr;
+TfLiteRegistration builtin_softmax;
+
+TfLiteStatus PrepareRecordingSoftmax(TfLiteContext* context,
+                                     TfLiteNode* node) {
+  // Custom ops get no builtin data; the interpreter frees it with the node.
+  if (node->builtin_data == nullptr) {
+    auto* params = static_cast<TfLiteSoftmaxParams*>(
+        std::calloc(1, sizeof(TfLiteSoftmaxParams)));
+    params->beta = 1.0f;
+    node->builtin_data = params;
+  }
+  return builtin_softmax.prepare(context, node);
+}
+
+TfLiteStatus InvokeRecordingSoftmax(TfLiteContext* context, TfLiteNode* node) {
+  softmax_input_buffer = context->tensors[node->inputs->data[0]].data.raw;
+  softmax_output_buffer = context->tensors[node->outputs->data[0]].data.raw;
+  return builtin_softmax.invoke(context, node);
+}
+
+// Runs SOFTMAX through the builtin kernel, recording the buffers it uses.
+// The op is registered as a custom op so that the XNNPACK delegate leaves it
+// to the interpreter, whose tensors are the ones bound for zero-copy I/O.
+class RecordingOpResolver : public tflite::OpResolver {
+ public:
+  const TfLiteRegistration* FindOp(tflite::BuiltinOperator op,
+                                   int version) const override {
+    const TfLiteRegistration* registration = builtins_.FindOp(op, version);
+    if (op != tflite::BuiltinOperator_SOFTMAX || registration == nullptr) {
+      return registration;
+    }
+    builtin_softmax = *registration;
+    TfLiteRegistration& recording_softmax = recording_softmax_[version];
+    recording_softmax = *registration;
+    recording_softmax.prepare = PrepareRecordingSoftmax;
+    recording_softmax.invoke = InvokeRecordingSoftmax;
+    recording_softmax.builtin_code = tflite::BuiltinOperator_CUSTOM;
+    recording_softmax.custom_name = "RecordingSoftmax";
+    return &recording_softmax;
+  }
+
+  const TfLiteRegistration* FindOp(const char* op,
+                                   int version) const override {
+    return builtins_.FindOp(op, version);
+  }
+
+ private:
+  tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates builtins_;
+  // Keyed by op version. Returned registrations must keep their address.
+  mutable std::map<int, TfLiteRegistration> recording_softmax_;
+};
+
+// Arg: tensor I/O mode, 0 for copy, 1 for zero-copy and 2 for the default
+// zero-copy if possible.
+void BM_InferenceTensorIo(benchmark::State& state) {
+  const char* const kEnableZeroCopyOptions[] = {
+      "enable_zero_copy_tensor_io: false", "enable_zero_copy_tensor_io: true",
+      ""};
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(absl::Substitute(
+      R"pb(
+        input_stream: "tensors_in"
+        output_stream: "tensors_out"
+        input_side_packet: "op_resolver"
+        node {
+          calculator: "InferenceCalculator"
+          input_stream: "TENSORS:tensors_in"
+          output_stream: "TENSORS:tensors_out"
+          input_side_packet: "OP_RESOLVER:op_resolver"
+          options {
+            [mediapipe.InferenceCalculatorOptions.ext] {
+              model_path: "$0"
+              delegate { xnnpack { $1 } }
+            }
+          }
+        }
+      )pb",
+      kModelPath, kEnableZeroCopyOptions[state.range(0)]));
+  CalculatorGraph graph;
+  ABSL_CHECK_OK(graph.Initialize(config));
+  auto poller = graph.AddOutputStreamPoller("tensors_out");
+  ABSL_CHECK_OK(poller.status());
+  ABSL_CHECK_OK(graph.StartRun(
+      {{"op_resolver", api2::PacketAdopting<tflite::OpResolver>(
+                           std::make_unique<RecordingOpResolver>())}}));
+
+  int64_t copied_bytes = 0;
+  int64_t timestamp = 0;
+  for (auto _ : state) {
+    auto input_tensors = std::make_unique<std::vector<Tensor>>();
+    input_tensors->emplace_back(Tensor::ElementType::kFloat32,
+                                Tensor::Shape{1, 256, 256, 3});
+    const void* input_buffer;
+    int64_t input_bytes = input_tensors->back().bytes();
+    {
+      auto view = input_tensors->back().GetCpuWriteView();
+      std::fill_n(view.buffer<float>(),
+                  input_tensors->back().shape().num_elements(), 0.5f);
+      input_buffer = view.buffer<float>();
+    }
+    ABSL_CHECK_OK(graph.AddPacketToInputStream(
+        "tensors_in",
+        Adopt(input_tensors.release()).At(Timestamp(timestamp++))));
+    Packet packet;
+    ABSL_CHECK(poller->Next(&packet));
+    const Tensor& output_tensor = packet.Get<std::vector<Tensor>>()[0];
+    // The kernel ran on the MediaPipe buffers iff they were bound.
+    if (softmax_input_buffer != input_buffer) copied_bytes += input_bytes;
+    if (softmax_output_buffer !=
+        output_tensor.GetCpuReadView().buffer<float>()) {
+      copied_bytes += output_tensor.bytes();
+    }
+  }
+  ABSL_CHECK_OK(graph.CloseAllInputStreams());
+  ABSL_CHECK_OK(graph.WaitUntilDone());
+
+  // Bytes copied between MediaPipe and interpreter tensors per frame.
+  state.counters["copied_bytes_per_frame"] =
+      state.iterations() > 0 ? copied_bytes / state.iterations() : 0;
+}
+BENCHMARK(BM_InferenceTensorIo)->Arg(0)->Arg(1)->Arg(2);
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -20,6 +21,7 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "mediapipe/calculators/tensor/regex_preprocessor_calculator.pb.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/api2/port.h"
@@ -31,12 +33,18 @@
 #include "mediapipe/tasks/cc/metadata/metadata_extractor.h"
 #include "mediapipe/tasks/cc/text/tokenizers/regex_tokenizer.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer_utils.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 #include "mediapipe/tasks/metadata/metadata_schema_generated.h"
 
 namespace mediapipe {
 namespace api2 {
 
 using ::mediapipe::tasks::metadata::ModelMetadataExtractor;
+using ::mediapipe::tasks::text::utils::GetSharedTextCache;
+using ::mediapipe::tasks::text::utils::TextCache;
+
+constexpr char kTokenCacheHitsCounter[] = "Token cache hits";
+constexpr char kTokenCacheMissesCounter[] = "Token cache misses";
 
 // Preprocesses input text into one int32 input tensor for a text model using
 // a RegexTokenizer.
@@ -59,6 +67,10 @@ using ::mediapipe::tasks::metadata::ModelMetadataExtractor;
 //     <PAD> token id to have size equal to the max sequence length for the text
 //     model.
 //
+// If `token_cache_size` is set in the options, the input tokens of recent texts
+// are cached, and the "Token cache hits" and "Token cache misses" counters
+// count the texts found in the cache or tokenized.
+//
 // Example:
 // node {
 //   calculator: "RegexPreprocessorCalculator"
@@ -85,9 +97,14 @@ class RegexPreprocessorCalculator : public Node {
   absl::Status Process(CalculatorContext* cc) override;
 
  private:
+  // Tokenizes the `input_text` into the ids of the input tensor.
+  std::vector<int> TokenizeInputText(const std::string& input_text);
+
   std::unique_ptr<tasks::text::tokenizers::RegexTokenizer> tokenizer_;
   // The max sequence length accepted by the text model.
   int max_seq_len_ = 0;
+  // The input tokens of recent texts, if caching is enabled.
+  std::shared_ptr<TextCache<std::vector<int>>> token_cache_;
   // Enable pooling of AHWBs in Tensor instances.
   MemoryManager* memory_manager_ = nullptr;
 };
@@ -130,12 +147,49 @@ absl::Status RegexPreprocessorCalculator::Open(CalculatorContext* cc) {
   const auto& options =
       cc->Options<mediapipe::RegexPreprocessorCalculatorOptions>();
   max_seq_len_ = options.max_seq_len();
+  if (options.token_cache_size() > 0) {
+    ABSL_ASSIGN_OR_RETURN(
+        size_t tokenizer_fingerprint,
+        tasks::text::tokenizers::GetTokenizerFingerprint(tokenizer_metadata,
+                                                         metadata_extractor));
+    token_cache_ = GetSharedTextCache<std::vector<int>>(
+        absl::StrCat("RegexPreprocessorCalculator/", tokenizer_fingerprint,
+                     "/", max_seq_len_),
+        options.token_cache_size());
+  }
   return absl::OkStatus();
 }
 
 absl::Status RegexPreprocessorCalculator::Process(CalculatorContext* cc) {
+  const std::string& input_text = kTextIn(cc).Get();
+  std::shared_ptr<const std::vector<int>> input_tokens;
+  if (token_cache_ != nullptr) {
+    input_tokens = token_cache_->Lookup(input_text);
+    cc->GetCounter(input_tokens != nullptr ? kTokenCacheHitsCounter
+                                           : kTokenCacheMissesCounter)
+        ->Increment();
+  }
+  if (input_tokens == nullptr) {
+    input_tokens =
+        std::make_shared<const std::vector<int>>(TokenizeInputText(input_text));
+    if (token_cache_ != nullptr) {
+      token_cache_->Insert(input_text, input_tokens);
+    }
+  }
+
+  std::vector<Tensor> result;
+  result.push_back({Tensor::ElementType::kInt32,
+                    Tensor::Shape({1, max_seq_len_}), memory_manager_});
+  std::memcpy(result[0].GetCpuWriteView().buffer<int32_t>(),
+              input_tokens->data(), input_tokens->size() * sizeof(int32_t));
+  kTensorsOut(cc).Send(std::move(result));
+  return absl::OkStatus();
+}
+
+std::vector<int> RegexPreprocessorCalculator::TokenizeInputText(
+    const std::string& input_text) {
   tasks::text::tokenizers::TokenizerResult tokenizer_result =
-      tokenizer_->Tokenize(kTextIn(cc).Get());
+      tokenizer_->Tokenize(input_text);
 
   int unknown_token_id = 0;
   tokenizer_->GetUnknownToken(&unknown_token_id);
@@ -166,13 +220,7 @@ absl::Status RegexPreprocessorCalculator::Process(CalculatorContext* cc) {
   // input_tensor                 <START>, t1, t2... <PAD>, <PAD>...
   // <START> is optional, t1, t2... will be replaced by <UNKNOWN> if it's
   // not found in the tokenizer vocab.
-  std::vector<Tensor> result;
-  result.push_back({Tensor::ElementType::kInt32,
-                    Tensor::Shape({1, max_seq_len_}), memory_manager_});
-  std::memcpy(result[0].GetCpuWriteView().buffer<int32_t>(),
-              input_tokens.data(), input_tokens.size() * sizeof(int32_t));
-  kTensorsOut(cc).Send(std::move(result));
-  return absl::OkStatus();
+  return input_tokens;
 }
 
 MEDIAPIPE_REGISTER_NODE(RegexPreprocessorCalculator);
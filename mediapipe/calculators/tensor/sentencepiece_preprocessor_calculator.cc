@@ -18,10 +18,13 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/calculators/tensor/sentencepiece_preprocessor_calculator.pb.h"
 #include "mediapipe/framework/api3/calculator.h"
@@ -36,6 +39,7 @@
 #include "mediapipe/tasks/cc/text/tokenizers/sentencepiece_tokenizer.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer_utils.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 #include "mediapipe/tasks/metadata/metadata_schema_generated.h"
 
 namespace mediapipe {
@@ -43,6 +47,11 @@ namespace mediapipe {
 using ::mediapipe::tasks::metadata::ModelMetadataExtractor;
 using ::mediapipe::tasks::text::tokenizers::SentencePieceTokenizer;
 using ::mediapipe::tasks::text::tokenizers::Tokenizer;
+using ::mediapipe::tasks::text::utils::GetSharedTextCache;
+using ::mediapipe::tasks::text::utils::TextCache;
+
+constexpr char kTokenCacheHitsCounter[] = "Token cache hits";
+constexpr char kTokenCacheMissesCounter[] = "Token cache misses";
 
 class SentencePiecePreprocessorCalculatorImpl
     : public api3::Calculator<SentencePiecePreprocessorCalculatorNode,
@@ -57,6 +66,11 @@ class SentencePiecePreprocessorCalculatorImpl
 
  private:
   std::vector<int> GetPaddedTokens(const std::vector<int>& token_ids);
+  // Enables caching the padded tokens of recent texts. `tokenizer_fingerprint`
+  // identifies the tokenizer.
+  void CreateTokenCache(
+      const SentencePiecePreprocessorCalculatorOptions& options,
+      size_t tokenizer_fingerprint);
   std::unique_ptr<SentencePieceTokenizer> tokenizer_;
   std::unique_ptr<tasks::core::ExternalFileHandler>
       sentence_piece_model_handler_;
@@ -64,6 +78,8 @@ class SentencePiecePreprocessorCalculatorImpl
   int max_seq_len_ = 0;
   // Enable pooling of AHWBs in Tensor instances.
   MemoryManager* memory_manager_ = nullptr;
+  // The padded tokens of recent texts, if caching is enabled.
+  std::shared_ptr<TextCache<std::vector<int>>> token_cache_;
 };
 
 absl::Status SentencePiecePreprocessorCalculatorImpl::Open(
@@ -93,6 +109,9 @@ absl::Status SentencePiecePreprocessorCalculatorImpl::Open(
       return absl::InternalError(
           "Failed to create SentencePieceTokenizer from ExternalFile.");
     }
+    if (options.token_cache_size() > 0) {
+      CreateTokenCache(options, absl::HashOf(model_content));
+    }
     return absl::OkStatus();
   }
 
@@ -127,9 +146,24 @@ absl::Status SentencePiecePreprocessorCalculatorImpl::Open(
   }
   tokenizer_.reset(dynamic_cast<SentencePieceTokenizer*>(tokenizer.release()));
 
+  if (options.token_cache_size() > 0) {
+    ABSL_ASSIGN_OR_RETURN(size_t tokenizer_fingerprint,
+                          tasks::text::tokenizers::GetTokenizerFingerprint(
+                              tokenizer_process_unit, metadata_extractor));
+    CreateTokenCache(options, tokenizer_fingerprint);
+  }
   return absl::OkStatus();
 }
 
+void SentencePiecePreprocessorCalculatorImpl::CreateTokenCache(
+    const SentencePiecePreprocessorCalculatorOptions& options,
+    size_t tokenizer_fingerprint) {
+  token_cache_ = GetSharedTextCache<std::vector<int>>(
+      absl::StrCat("SentencePiecePreprocessorCalculator/",
+                   tokenizer_fingerprint, "/", max_seq_len_),
+      options.token_cache_size());
+}
+
 std::vector<int> SentencePiecePreprocessorCalculatorImpl::GetPaddedTokens(
     const std::vector<int>& token_ids) {
   const size_t max_token_size = (token_ids.size() <= max_seq_len_ - 2)
@@ -147,21 +181,36 @@ std::vector<int> SentencePiecePreprocessorCalculatorImpl::GetPaddedTokens(
 
 absl::Status SentencePiecePreprocessorCalculatorImpl::Process(
     api3::CalculatorContext<SentencePiecePreprocessorCalculatorNode>& cc) {
-  std::vector<int> token_ids;
-  tokenizer_->Encode(cc.text_in.GetOrDie(), &token_ids);
-
-  RET_CHECK_LE(token_ids.size() + 2, max_seq_len_)
-      << "Input text is too long: " << token_ids.size()
-      << " tokens. size() + 2 <= max_seq_len_ (" << max_seq_len_
-      << ") is required.";
-
-  std::vector<int> input_tokens = GetPaddedTokens(token_ids);
+  const std::string& input_text = cc.text_in.GetOrDie();
+  std::shared_ptr<const std::vector<int>> input_tokens;
+  if (token_cache_ != nullptr) {
+    input_tokens = token_cache_->Lookup(input_text);
+    cc.GetGenericContext()
+        .GetCounter(input_tokens != nullptr ? kTokenCacheHitsCounter
+                                            : kTokenCacheMissesCounter)
+        ->Increment();
+  }
+  if (input_tokens == nullptr) {
+    std::vector<int> token_ids;
+    tokenizer_->Encode(input_text, &token_ids);
+
+    RET_CHECK_LE(token_ids.size() + 2, max_seq_len_)
+        << "Input text is too long: " << token_ids.size()
+        << " tokens. size() + 2 <= max_seq_len_ (" << max_seq_len_
+        << ") is required.";
+
+    input_tokens =
+        std::make_shared<const std::vector<int>>(GetPaddedTokens(token_ids));
+    if (token_cache_ != nullptr) {
+      token_cache_->Insert(input_text, input_tokens);
+    }
+  }
 
   std::vector<Tensor> result;
   result.push_back({Tensor::ElementType::kInt32,
                     Tensor::Shape({1, max_seq_len_}), memory_manager_});
   std::memcpy(result[0].GetCpuWriteView().buffer<int32_t>(),
-              input_tokens.data(), input_tokens.size() * sizeof(int32_t));
+              input_tokens->data(), input_tokens->size() * sizeof(int32_t));
   cc.tensors_out.Send(std::move(result));
   return absl::OkStatus();
 }
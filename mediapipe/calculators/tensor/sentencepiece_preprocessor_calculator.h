@@ -29,6 +29,10 @@ namespace mediapipe {
 // Preprocesses input text into one int32 input tensor for a Gecko model using
 // a SentencePieceTokenizer.
 //
+// If `token_cache_size` is set in the options, the input tokens of recent texts
+// are cached, and the "Token cache hits" and "Token cache misses" counters
+// count the texts found in the cache or tokenized.
+//
 // Example:
 // node {
 //   calculator: "SentencePiecePreprocessorCalculator"
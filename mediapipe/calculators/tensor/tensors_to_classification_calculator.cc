@@ -23,6 +23,7 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "mediapipe/calculators/tensor/dequantizing_tensor_reader.h"
 #include "mediapipe/calculators/tensor/tensors_to_classification_calculator.pb.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/api2/port.h"
@@ -60,8 +61,10 @@ void SetClassificationLabel(const LabelMapItem label_map_item,
 // classifications.
 //
 // Input:
-//  TENSORS - Vector of Tensors of type kFloat32 containing one
-//            tensor, the size of which must be (1, * num_classes).
+//  TENSORS - Vector of Tensors of type kFloat32, kUInt8 or kInt8 containing
+//            one tensor, the size of which must be (1, * num_classes).
+//            Quantized tensors are dequantized using their quantization
+//            parameters.
 // Output:
 //  CLASSIFICATIONS - Result MediaPipe ClassificationList. The score and index
 //                    fields of each classification are set, while the label
@@ -169,7 +172,6 @@ absl::Status TensorsToClassificationCalculator::Open(CalculatorContext* cc) {
 absl::Status TensorsToClassificationCalculator::Process(CalculatorContext* cc) {
   const auto& input_tensors = *kInTensors(cc);
   RET_CHECK_EQ(input_tensors.size(), 1);
-  RET_CHECK(input_tensors[0].element_type() == Tensor::ElementType::kFloat32);
 
   int num_classes = input_tensors[0].shape().num_elements();
 
@@ -181,8 +183,11 @@ absl::Status TensorsToClassificationCalculator::Process(CalculatorContext* cc) {
   if (label_map_loaded_) {
     RET_CHECK_EQ(num_classes, GetLabelMap(cc).size());
   }
+  // Quantized scores are dequantized only for the classes that are emitted.
   auto view = input_tensors[0].GetCpuReadView();
-  auto raw_scores = view.buffer<float>();
+  ABSL_ASSIGN_OR_RETURN(
+      const DequantizingTensorReader raw_scores,
+      DequantizingTensorReader::Create(input_tensors[0], view));
 
   auto classification_list = std::make_unique<ClassificationList>();
   if (is_binary_classification_) {
@@ -202,13 +207,14 @@ absl::Status TensorsToClassificationCalculator::Process(CalculatorContext* cc) {
       if (!IsClassIndexAllowed(i)) {
         continue;
       }
-      if (raw_scores[i] < min_score_threshold_) {
+      const float score = raw_scores[i];
+      if (score < min_score_threshold_) {
         continue;
       }
       Classification* classification =
           classification_list->add_classification();
       classification->set_index(i);
-      classification->set_score(raw_scores[i]);
+      classification->set_score(score);
       if (label_map_loaded_) {
         SetClassificationLabel(GetLabelMap(cc).at(i), classification);
       }
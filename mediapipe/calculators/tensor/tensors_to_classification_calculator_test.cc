@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
@@ -86,6 +87,45 @@ TEST_F(TensorsToClassificationCalculatorTest, CorrectOutput) {
   }
 }
 
+TEST_F(TensorsToClassificationCalculatorTest, CorrectOutputForQuantizedInput) {
+  mediapipe::CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsToClassificationCalculator"
+    input_stream: "TENSORS:tensors"
+    output_stream: "CLASSIFICATIONS:classifications"
+    options {
+      [mediapipe.TensorsToClassificationCalculatorOptions.ext] {
+        min_score_thresh: 0.25
+      }
+    }
+  )pb"));
+
+  auto tensors = std::make_unique<std::vector<Tensor>>();
+  tensors->emplace_back(Tensor::ElementType::kUInt8, Tensor::Shape{1, 3},
+                        Tensor::QuantizationParameters(0.5f, 2));
+  {
+    auto view = tensors->back().GetCpuWriteView();
+    uint8_t* tensor_buffer = view.buffer<uint8_t>();
+    tensor_buffer[0] = 2;  // 0.0
+    tensor_buffer[1] = 3;  // 0.5
+    tensor_buffer[2] = 4;  // 1.0
+  }
+  runner.MutableInputs()->Tag("TENSORS").packets.push_back(
+      mediapipe::Adopt(tensors.release()).At(mediapipe::Timestamp(0)));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& output_packets_ = runner.Outputs().Tag("CLASSIFICATIONS").packets;
+  ASSERT_EQ(1, output_packets_.size());
+
+  // Class 0 is below the score threshold after dequantization.
+  const auto& classification_list =
+      output_packets_[0].Get<ClassificationList>();
+  ASSERT_EQ(2, classification_list.classification_size());
+  for (int i = 0; i < classification_list.classification_size(); ++i) {
+    EXPECT_EQ(i + 1, classification_list.classification(i).index());
+    EXPECT_EQ((i + 1) * 0.5, classification_list.classification(i).score());
+  }
+}
+
 TEST_F(TensorsToClassificationCalculatorTest, CorrectOutputWithLabelMapPath) {
   mediapipe::CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
     calculator: "TensorsToClassificationCalculator"
@@ -17,6 +17,7 @@
 
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
+#include "mediapipe/calculators/tensor/dequantizing_tensor_reader.h"
 #include "mediapipe/calculators/tensor/tensors_to_detections_calculator.pb.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -151,6 +152,9 @@ BoxFormat GetBoxFormat(const TensorsToDetectionsCalculatorOptions& options) {
 //            for anchors (e.g. for SSD models) depend on the outputs of the
 //            detection model. The size of anchor tensor must be (num_boxes *
 //            4).
+//            The box and score tensors may also be kUInt8 or kInt8, in which
+//            case they are processed on CPU and only the top class score and
+//            the boxes passing min_score_thresh are dequantized.
 //
 // Input side packet:
 //  ANCHORS (optional) - The anchors used for decoding the bounding boxes, as a
@@ -294,21 +298,27 @@ absl::Status TensorsToDetectionsCalculator::Open(CalculatorContext* cc) {
 
 absl::Status TensorsToDetectionsCalculator::Process(CalculatorContext* cc) {
   auto output_detections = std::make_unique<std::vector<Detection>>();
+  const auto& input_tensors = *kInTensors(cc);
+  bool has_quantized_input = false;
+  for (const auto& tensor : input_tensors) {
+    RET_CHECK(tensor.element_type() == Tensor::ElementType::kFloat32 ||
+              tensor.element_type() == Tensor::ElementType::kUInt8 ||
+              tensor.element_type() == Tensor::ElementType::kInt8);
+    has_quantized_input |=
+        tensor.element_type() != Tensor::ElementType::kFloat32;
+  }
   bool gpu_processing = false;
-  if (CanUseGpu() && gpu_has_enough_work_groups_) {
+  // Quantized tensors are only supported by CPU processing.
+  if (CanUseGpu() && gpu_has_enough_work_groups_ && !has_quantized_input) {
     // Use GPU processing only if at least one input tensor is already on GPU
     // (to avoid CPU->GPU overhead).
-    for (const auto& tensor : *kInTensors(cc)) {
+    for (const auto& tensor : input_tensors) {
       if (tensor.ready_on_gpu()) {
         gpu_processing = true;
         break;
       }
     }
   }
-  const auto& input_tensors = *kInTensors(cc);
-  for (const auto& tensor : input_tensors) {
-    RET_CHECK(tensor.element_type() == Tensor::ElementType::kFloat32);
-  }
   const int num_input_tensors = input_tensors.size();
   if (!scores_tensor_index_is_set_) {
     if (num_input_tensors == 2 ||
@@ -395,9 +405,13 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
           "The dimensions of score Tensor must be 3 or 4.");
     }
     auto raw_box_view = raw_box_tensor->GetCpuReadView();
-    auto raw_boxes = raw_box_view.buffer<float>();
+    ABSL_ASSIGN_OR_RETURN(
+        const DequantizingTensorReader raw_boxes,
+        DequantizingTensorReader::Create(*raw_box_tensor, raw_box_view));
     auto raw_scores_view = raw_score_tensor->GetCpuReadView();
-    auto raw_scores = raw_scores_view.buffer<float>();
+    ABSL_ASSIGN_OR_RETURN(
+        const DequantizingTensorReader raw_scores,
+        DequantizingTensorReader::Create(*raw_score_tensor, raw_scores_view));
 
     // TODO: Support other options to load anchors.
     if (!anchors_init_) {
@@ -407,6 +421,8 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
         RET_CHECK_EQ(anchor_tensor->shape().dims.size(), 2);
         RET_CHECK_EQ(anchor_tensor->shape().dims[0], num_boxes_);
         RET_CHECK_EQ(anchor_tensor->shape().dims[1], kNumCoordsPerBox);
+        RET_CHECK(anchor_tensor->element_type() ==
+                  Tensor::ElementType::kFloat32);
         auto anchor_view = anchor_tensor->GetCpuReadView();
         auto raw_anchors = anchor_view.buffer<float>();
         ConvertRawValuesToAnchors(raw_anchors, num_boxes_, &anchors_);
@@ -417,41 +433,87 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
       }
       anchors_init_ = true;
     }
-    std::vector<float> boxes(num_boxes_ * num_coords_);
-    ABSL_RETURN_IF_ERROR(DecodeBoxes(raw_boxes, anchors_, &boxes));
-
     std::vector<float> detection_scores(num_boxes_);
     std::vector<int> detection_classes(num_boxes_);
 
+    const auto activate_score = [this](float score) {
+      if (options_.sigmoid_score()) {
+        if (options_.has_score_clipping_thresh()) {
+          score = score < -options_.score_clipping_thresh()
+                      ? -options_.score_clipping_thresh()
+                      : score;
+          score = score > options_.score_clipping_thresh()
+                      ? options_.score_clipping_thresh()
+                      : score;
+        }
+        score = 1.0f / (1.0f + std::exp(-score));
+      }
+      return score;
+    };
+
     // Filter classes by scores.
-    for (int i = 0; i < num_boxes_; ++i) {
-      int class_id = -1;
-      float max_score = -std::numeric_limits<float>::max();
-      // Find the top score for box i.
-      for (int score_idx = 0; score_idx < num_classes_; ++score_idx) {
-        if (IsClassIndexAllowed(score_idx)) {
-          auto score = raw_scores[i * num_classes_ + score_idx];
-          if (options_.sigmoid_score()) {
-            if (options_.has_score_clipping_thresh()) {
-              score = score < -options_.score_clipping_thresh()
-                          ? -options_.score_clipping_thresh()
-                          : score;
-              score = score > options_.score_clipping_thresh()
-                          ? options_.score_clipping_thresh()
-                          : score;
+    if (raw_scores.is_quantized()) {
+      // Score activation is monotonic, so the top class is found on raw
+      // quantized values and only its score is dequantized and activated.
+      for (int i = 0; i < num_boxes_; ++i) {
+        int class_id = -1;
+        float max_raw_score = -std::numeric_limits<float>::max();
+        for (int score_idx = 0; score_idx < num_classes_; ++score_idx) {
+          if (IsClassIndexAllowed(score_idx)) {
+            const float raw_score =
+                raw_scores.Raw(i * num_classes_ + score_idx);
+            if (max_raw_score < raw_score) {
+              max_raw_score = raw_score;
+              class_id = score_idx;
             }
-            score = 1.0f / (1.0f + std::exp(-score));
           }
-          if (max_score < score) {
-            max_score = score;
-            class_id = score_idx;
+        }
+        detection_scores[i] =
+            class_id < 0 ? -std::numeric_limits<float>::max()
+                         : activate_score(raw_scores.Dequantize(max_raw_score));
+        detection_classes[i] = class_id;
+      }
+    } else {
+      for (int i = 0; i < num_boxes_; ++i) {
+        int class_id = -1;
+        float max_score = -std::numeric_limits<float>::max();
+        // Find the top score for box i.
+        for (int score_idx = 0; score_idx < num_classes_; ++score_idx) {
+          if (IsClassIndexAllowed(score_idx)) {
+            const float score =
+                activate_score(raw_scores[i * num_classes_ + score_idx]);
+            if (max_score < score) {
+              max_score = score;
+              class_id = score_idx;
+            }
           }
         }
+        detection_scores[i] = max_score;
+        detection_classes[i] = class_id;
       }
-      detection_scores[i] = max_score;
-      detection_classes[i] = class_id;
     }
 
+    const float* raw_box_data = raw_boxes.float_data();
+    std::vector<float> dequantized_boxes;
+    if (raw_boxes.is_quantized()) {
+      // Only boxes that can survive score filtering are dequantized; the
+      // others are dropped by ConvertToDetections() regardless of their
+      // coordinates.
+      dequantized_boxes.resize(num_boxes_ * num_coords_);
+      for (int i = 0; i < num_boxes_; ++i) {
+        if (options_.has_min_score_thresh() &&
+            detection_scores[i] < options_.min_score_thresh()) {
+          continue;
+        }
+        for (int k = i * num_coords_; k < (i + 1) * num_coords_; ++k) {
+          dequantized_boxes[k] = raw_boxes[k];
+        }
+      }
+      raw_box_data = dequantized_boxes.data();
+    }
+    std::vector<float> boxes(num_boxes_ * num_coords_);
+    ABSL_RETURN_IF_ERROR(DecodeBoxes(raw_box_data, anchors_, &boxes));
+
     ABSL_RETURN_IF_ERROR(
         ConvertToDetections(boxes.data(), detection_scores.data(),
                             detection_classes.data(), output_detections));
@@ -459,6 +521,11 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
     // Postprocessing on CPU with postprocessing op (e.g. anchor decoding and
     // non-maximum suppression) within the model.
     RET_CHECK_EQ(input_tensors.size(), 4);
+    for (const auto& tensor : input_tensors) {
+      RET_CHECK(tensor.element_type() == Tensor::ElementType::kFloat32)
+          << "Quantized tensors are only supported for raw box and score "
+             "tensors.";
+    }
     auto num_boxes_tensor =
         &input_tensors[tensor_mapping_.num_detections_tensor_index()];
     RET_CHECK_EQ(num_boxes_tensor->shape().dims.size(), 1);
@@ -147,15 +147,20 @@ absl::Status TensorsToSegmentationCalculator::Process(
   }
   RET_CHECK_NE(input_tensor, nullptr);
 
+  const bool is_quantized =
+      input_tensor->element_type() == Tensor::ElementType::kUInt8 ||
+      input_tensor->element_type() == Tensor::ElementType::kInt8;
   bool use_gpu = false;
-  if (CanUseGpu()) {
+  // Quantized tensors are only supported by the CPU converter.
+  if (CanUseGpu() && !is_quantized) {
     // Use GPU processing only if at least one input tensor is already on GPU.
     use_gpu = input_tensor->ready_on_gpu();
   }
 
   // Validate tensor channels and activation type.
   {
-    RET_CHECK(input_tensor->element_type() == Tensor::ElementType::kFloat32);
+    RET_CHECK(input_tensor->element_type() == Tensor::ElementType::kFloat32 ||
+              is_quantized);
     ABSL_ASSIGN_OR_RETURN(auto hwc, GetHwcFromDims(input_tensor->shape().dims));
     int tensor_channels = std::get<2>(hwc);
     using Options = ::mediapipe::TensorsToSegmentationCalculatorOptions;
@@ -55,13 +55,15 @@ struct TensorsToSegmentationNode : Node<"TensorsToSegmentationCalculator"> {
   template <typename S>
   struct Contract {
     // Vector of Tensors of type kFloat32. Only the first tensor will be used.
+    // On CPU, kUInt8 and kInt8 tensors are also accepted and dequantized
+    // using their quantization parameters.
     //
     // NOTE: Either TENSORS or TENSOR must be specified.
     Optional<Input<S, std::vector<Tensor>>> tensors_in{"TENSORS"};
 
-    // Tensor of type kFloat32. Use this instead of TENSORS when the
-    // tensors are available as individual Tensor streams, not as a stream
-    // of vector of Tensors.
+    // Tensor of type kFloat32 (or kUInt8/kInt8 on CPU). Use this instead of
+    // TENSORS when the tensors are available as individual Tensor streams,
+    // not as a stream of vector of Tensors.
     //
     // NOTE: Either TENSOR or TENSORS must be specified.
     Optional<Input<S, Tensor>> tensor_in{"TENSOR"};
@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_calculator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -104,6 +106,50 @@ TEST(TensorsToSegmentationCalculatorTest, RunsWithFunctionRunner) {
                   {1.0f, 2.0f, 3.0f, 4.0f}, /*max_diff*/ 1e-6);
 }
 
+TEST(TensorsToSegmentationCalculatorTest, UpsamplesAcrossMultipleRowTiles) {
+  // Output is tall enough to be split into several row tiles on the CPU path;
+  // every tile must match the INTER_LINEAR upsampling of the activated mask.
+  constexpr int kOutputHeight = 100;
+  auto graph_config = test_utils::CreateGraphConfigForTest(
+      /*test_gpu=*/false, Options::SIGMOID, /*use_single_tensor=*/false);
+
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("image_as_mask", &graph_config, &output_packets);
+
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(graph_config));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  const std::vector<float> inputs = {-2.0f, 0.0f, 1.0f, 3.0f};
+  MP_ASSERT_OK(test_utils::AddTensorInput(
+      CreateTensor({.height = 4, .width = 1, .channels = 1}, inputs),
+      /*use_single_tensor=*/false, graph));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "size", mediapipe::Adopt(new std::pair<int, int>(1, kOutputHeight))
+                  .At(Timestamp(0))));
+  MP_ASSERT_OK(graph.WaitUntilIdle());
+  ASSERT_THAT(output_packets, SizeIs(1));
+
+  std::vector<float> activated;
+  for (float value : inputs) activated.push_back(1.0f / (std::exp(-value) + 1));
+  std::vector<float> expected_outputs;
+  const float scale = static_cast<float>(inputs.size()) / kOutputHeight;
+  for (int y = 0; y < kOutputHeight; ++y) {
+    const float src =
+        std::clamp((y + 0.5f) * scale - 0.5f, 0.0f, inputs.size() - 1.0f);
+    const int y0 = std::min(static_cast<int>(src), 2);
+    const float t = src - y0;
+    expected_outputs.push_back(activated[y0] +
+                               (activated[y0 + 1] - activated[y0]) * t);
+  }
+  MatchesExpected(output_packets[0].Get<Image>(),
+                  {.height = kOutputHeight, .width = 1, .channels = 1},
+                  expected_outputs, /*max_diff*/ 1e-5);
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+}
+
 using TensorsToSegmentationCalculatorTest =
     TestWithParam<test_utils::FormattingTestCase>;
 
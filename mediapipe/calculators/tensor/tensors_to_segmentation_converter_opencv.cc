@@ -21,6 +21,7 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "mediapipe/calculators/tensor/dequantizing_tensor_reader.h"
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_calculator.pb.h"
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_converter.h"
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_utils.h"
@@ -37,6 +38,73 @@ namespace mediapipe {
 namespace {
 
 using ::mediapipe::tensors_to_segmentation_utils::GetHwcFromDims;
+using Options = ::mediapipe::TensorsToSegmentationCalculatorOptions;
+
+// Number of output rows processed by one parallel task.
+constexpr int kTileRows = 32;
+
+// Source coordinate and interpolation weight for one output coordinate,
+// following cv::resize INTER_LINEAR (half-pixel centers, clamped at edges).
+struct LinearTap {
+  int index0;
+  int index1;
+  float weight1;
+};
+
+std::vector<LinearTap> ComputeLinearTaps(int src_size, int dst_size) {
+  std::vector<LinearTap> taps(dst_size);
+  const float scale = static_cast<float>(src_size) / dst_size;
+  for (int d = 0; d < dst_size; ++d) {
+    float f = (d + 0.5f) * scale - 0.5f;
+    int s = static_cast<int>(std::floor(f));
+    f -= s;
+    if (s < 0) {
+      s = 0;
+      f = 0.0f;
+    }
+    if (s >= src_size - 1) {
+      s = src_size - 1;
+      f = 0.0f;
+    }
+    taps[d] = {s, std::min(s + 1, src_size - 1), f};
+  }
+  return taps;
+}
+
+// Applies the configured activation to one tensor row. `input(i)` returns the
+// (dequantized) tensor element at flat index `i`, and `offset` is the index of
+// the first element of the row. The activation switch is resolved once per
+// row rather than once per pixel.
+template <typename InputFn>
+void ActivateRow(const InputFn& input, int offset, int width, int channels,
+                 Options::Activation activation, int output_layer_index,
+                 float* output) {
+  switch (activation) {
+    case Options::NONE:
+      for (int x = 0; x < width; ++x) output[x] = input(offset + x * channels);
+      break;
+    case Options::SIGMOID:
+      for (int x = 0; x < width; ++x) {
+        output[x] = 1.0f / (std::exp(-input(offset + x * channels)) + 1.0f);
+      }
+      break;
+    case Options::SOFTMAX:
+      for (int x = 0; x < width; ++x) {
+        const int pixel_offset = offset + x * channels;
+        const float pixel0 = input(pixel_offset);
+        const float pixel1 = input(pixel_offset + 1);
+        const float max_pixel = std::max(pixel0, pixel1);
+        const float min_pixel = std::min(pixel0, pixel1);
+        const float softmax_denom =
+            /*exp(max_pixel - max_pixel)=*/1.0f +
+            std::exp(min_pixel - max_pixel);
+        output[x] =
+            std::exp(input(pixel_offset + output_layer_index) - max_pixel) /
+            softmax_denom;
+      }
+      break;
+  }
+}
 
 class TensorsToSegmentationOpenCvConverter
     : public TensorsToSegmentationConverter {
@@ -51,103 +119,99 @@ class TensorsToSegmentationOpenCvConverter
                                                  int output_height) override;
 
  private:
-  template <class T>
-  absl::Status ApplyActivation(cv::Mat& tensor_mat, cv::Mat* small_mask_mat);
-
   TensorsToSegmentationCalculatorOptions options_;
 };
 
+// Activation and bilinear upsampling are fused and run in parallel over tiles
+// of output rows. Each tile activates only the tensor rows it samples from, so
+// no full-resolution intermediate mask is allocated and the activation is
+// evaluated at tensor resolution, matching the former activate-then-resize
+// pipeline.
 absl::StatusOr<std::unique_ptr<Image>>
 TensorsToSegmentationOpenCvConverter::Convert(const Tensor& input_tensor,
                                               int output_width,
                                               int output_height) {
   ABSL_ASSIGN_OR_RETURN(auto hwc, GetHwcFromDims(input_tensor.shape().dims));
   auto [tensor_height, tensor_width, tensor_channels] = hwc;
-  // Create initial working mask.
-  cv::Mat small_mask_mat(cv::Size(tensor_width, tensor_height), CV_32FC1);
-
-  // Wrap input tensor.
-  auto raw_input_tensor = &input_tensor;
-  auto raw_input_view = raw_input_tensor->GetCpuReadView();
-  const float* raw_input_data = raw_input_view.buffer<float>();
-  cv::Mat tensor_mat(cv::Size(tensor_width, tensor_height),
-                     CV_MAKETYPE(CV_32F, tensor_channels),
-                     const_cast<float*>(raw_input_data));
-
-  // Process mask tensor and apply activation function.
-  if (tensor_channels == 2) {
-    ABSL_RETURN_IF_ERROR(
-        ApplyActivation<cv::Vec2f>(tensor_mat, &small_mask_mat));
-  } else if (tensor_channels == 1) {
-    RET_CHECK(mediapipe::TensorsToSegmentationCalculatorOptions::SOFTMAX !=
-              options_.activation());  // Requires 2 channels.
-    if (mediapipe::TensorsToSegmentationCalculatorOptions::NONE ==
-        options_.activation())  // Pass-through optimization.
-      tensor_mat.copyTo(small_mask_mat);
-    else
-      ABSL_RETURN_IF_ERROR(ApplyActivation<float>(tensor_mat, &small_mask_mat));
-  } else {
-    RET_CHECK_FAIL() << "Unsupported number of tensor channels "
-                     << tensor_channels;
-  }
+  RET_CHECK(tensor_channels == 1 || tensor_channels == 2)
+      << "Unsupported number of tensor channels " << tensor_channels;
+  const Options::Activation activation = options_.activation();
+  // Softmax requires 2 channels.
+  RET_CHECK(tensor_channels == 2 || activation != Options::SOFTMAX);
+  const int output_layer_index = options_.output_layer_index();
+  RET_CHECK(activation != Options::SOFTMAX ||
+            (output_layer_index >= 0 && output_layer_index < tensor_channels))
+      << "Invalid output_layer_index " << output_layer_index;
+
+  // Quantized tensors are dequantized while activating, so only the tensor
+  // rows sampled by the output are ever converted to float.
+  auto raw_input_view = input_tensor.GetCpuReadView();
+  ABSL_ASSIGN_OR_RETURN(
+      const DequantizingTensorReader raw_input,
+      DequantizingTensorReader::Create(input_tensor, raw_input_view));
+  const float* raw_input_data = raw_input.float_data();
 
   // Send out image as CPU packet.
   std::shared_ptr<ImageFrame> mask_frame = std::make_shared<ImageFrame>(
       ImageFormat::VEC32F1, output_width, output_height);
   auto output_mask = std::make_unique<Image>(mask_frame);
   auto output_mat = formats::MatView(output_mask.get());
-  // Upsample small mask into output.
-  cv::resize(small_mask_mat, *output_mat,
-             cv::Size(output_width, output_height));
-  return output_mask;
-}
 
-template <class T>
-absl::Status TensorsToSegmentationOpenCvConverter::ApplyActivation(
-    cv::Mat& tensor_mat, cv::Mat* small_mask_mat) {
-  // Configure activation function.
-  const int output_layer_index = options_.output_layer_index();
-  using Options = ::mediapipe::TensorsToSegmentationCalculatorOptions;
-  const auto activation_fn = [&](const cv::Vec2f& mask_value) {
-    float new_mask_value = 0;
-    // TODO consider moving switch out of the loop,
-    // and also avoid float/Vec2f casting.
-    switch (options_.activation()) {
-      case Options::NONE: {
-        new_mask_value = mask_value[0];
-        break;
-      }
-      case Options::SIGMOID: {
-        const float pixel0 = mask_value[0];
-        new_mask_value = 1.0 / (std::exp(-pixel0) + 1.0);
-        break;
+  const std::vector<LinearTap> x_taps =
+      ComputeLinearTaps(tensor_width, output_width);
+  const std::vector<LinearTap> y_taps =
+      ComputeLinearTaps(tensor_height, output_height);
+  const int num_tiles = (output_height + kTileRows - 1) / kTileRows;
+
+  cv::parallel_for_(cv::Range(0, num_tiles), [&](const cv::Range& range) {
+    std::vector<float> activated;
+    for (int tile = range.start; tile < range.end; ++tile) {
+      const int y_begin = tile * kTileRows;
+      const int y_end = std::min(y_begin + kTileRows, output_height);
+      // Taps are monotonic in the output coordinate, so the source rows
+      // sampled by this tile form a contiguous range.
+      const int src_begin = y_taps[y_begin].index0;
+      const int src_end = y_taps[y_end - 1].index1 + 1;
+      activated.resize(static_cast<size_t>(src_end - src_begin) *
+                       tensor_width);
+      for (int sy = src_begin; sy < src_end; ++sy) {
+        const int offset = sy * tensor_width * tensor_channels;
+        float* output = activated.data() +
+                        static_cast<size_t>(sy - src_begin) * tensor_width;
+        if (raw_input_data != nullptr) {
+          ActivateRow([raw_input_data](int i) { return raw_input_data[i]; },
+                      offset, tensor_width, tensor_channels, activation,
+                      output_layer_index, output);
+        } else {
+          ActivateRow([&raw_input](int i) { return raw_input[i]; }, offset,
+                      tensor_width, tensor_channels, activation,
+                      output_layer_index, output);
+        }
       }
-      case Options::SOFTMAX: {
-        const float pixel0 = mask_value[0];
-        const float pixel1 = mask_value[1];
-        const float max_pixel = std::max(pixel0, pixel1);
-        const float min_pixel = std::min(pixel0, pixel1);
-        const float softmax_denom =
-            /*exp(max_pixel - max_pixel)=*/1.0f +
-            std::exp(min_pixel - max_pixel);
-        new_mask_value = std::exp(mask_value[output_layer_index] - max_pixel) /
-                         softmax_denom;
-        break;
+
+      for (int y = y_begin; y < y_end; ++y) {
+        const LinearTap& y_tap = y_taps[y];
+        const float* src0 =
+            activated.data() +
+            static_cast<size_t>(y_tap.index0 - src_begin) * tensor_width;
+        const float* src1 =
+            activated.data() +
+            static_cast<size_t>(y_tap.index1 - src_begin) * tensor_width;
+        float* dst = output_mat->ptr<float>(y);
+        for (int x = 0; x < output_width; ++x) {
+          const LinearTap& x_tap = x_taps[x];
+          const float top = src0[x_tap.index0] +
+                            (src0[x_tap.index1] - src0[x_tap.index0]) *
+                                x_tap.weight1;
+          const float bottom = src1[x_tap.index0] +
+                               (src1[x_tap.index1] - src1[x_tap.index0]) *
+                                   x_tap.weight1;
+          dst[x] = top + (bottom - top) * y_tap.weight1;
+        }
       }
     }
-    return new_mask_value;
-  };
-
-  // Process mask tensor.
-  for (int i = 0; i < tensor_mat.rows; ++i) {
-    for (int j = 0; j < tensor_mat.cols; ++j) {
-      const T& input_pix = tensor_mat.at<T>(i, j);
-      const float mask_value = activation_fn(input_pix);
-      small_mask_mat->at<float>(i, j) = mask_value;
-    }
-  }
-
-  return absl::OkStatus();
+  });
+  return output_mask;
 }
 
 }  // namespace
@@ -0,0 +1,101 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tflite_op_profiler.h"
+
+#include <cstdint>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/mediapipe_profiling.h"
+#include "tflite/core/api/profiler.h"
+
+namespace mediapipe {
+
+bool TfLiteOpProfiler::IsEnabled(const CalculatorContext* cc) {
+  ProfilingContext* profiling_context =
+      cc != nullptr ? cc->GetProfilingContext() : nullptr;
+  return profiling_context != nullptr &&
+         profiling_context->IsOperatorProfilingEnabled();
+}
+
+void TfLiteOpProfiler::StartInvoke(const CalculatorContext* cc) {
+  ops_.clear();
+  clock_ = IsEnabled(cc) ? cc->GetProfilingContext()->GetClock() : nullptr;
+}
+
+void TfLiteOpProfiler::FinishInvoke(const CalculatorContext* cc) {
+  if (clock_ != nullptr) {
+    ProfilingContext* profiling_context = cc->GetProfilingContext();
+    for (const Op& op : ops_) {
+      if (op.finish_time < op.start_time) continue;  // Never ended.
+      profiling_context->LogOperatorEvent(op.event_type, *cc, op.name,
+                                          op.start_time, op.finish_time);
+    }
+  }
+  ops_.clear();
+  clock_ = nullptr;
+}
+
+uint32_t TfLiteOpProfiler::BeginEvent(const char* tag, EventType event_type,
+                                      int64_t event_metadata1,
+                                      int64_t event_metadata2) {
+  if (clock_ == nullptr) return 0;
+  TraceEvent::EventType op_event_type;
+  switch (event_type) {
+    case EventType::OPERATOR_INVOKE_EVENT:
+      op_event_type = TraceEvent::INFERENCE_OP;
+      break;
+    case EventType::DELEGATE_OPERATOR_INVOKE_EVENT:
+      op_event_type = TraceEvent::INFERENCE_DELEGATE_OP;
+      break;
+    default:
+      // Runtime instrumentation such as AllocateTensors.
+      return 0;
+  }
+  const absl::Time now = clock_->TimeNow();
+  // For op events, event_metadata1 is the node index.
+  ops_.push_back({op_event_type,
+                  absl::StrCat(tag != nullptr ? tag : "", ":", event_metadata1),
+                  now, absl::InfinitePast()});
+  if (op_event_type == TraceEvent::INFERENCE_OP) {
+    next_delegate_op_start_time_ = now;
+  }
+  // Handle 0 denotes ignored events.
+  return ops_.size();
+}
+
+void TfLiteOpProfiler::EndEvent(uint32_t event_handle) {
+  if (clock_ == nullptr || event_handle == 0 || event_handle > ops_.size()) {
+    return;
+  }
+  ops_[event_handle - 1].finish_time = clock_->TimeNow();
+}
+
+void TfLiteOpProfiler::AddEvent(const char* tag, EventType event_type,
+                                uint64_t elapsed_time, int64_t event_metadata1,
+                                int64_t event_metadata2) {
+  if (clock_ == nullptr ||
+      event_type != EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT) {
+    return;
+  }
+  const absl::Time start_time = next_delegate_op_start_time_;
+  next_delegate_op_start_time_ += absl::Microseconds(elapsed_time);
+  ops_.push_back({TraceEvent::INFERENCE_DELEGATE_OP,
+                  absl::StrCat(tag != nullptr ? tag : "", ":", event_metadata1),
+                  start_time, next_delegate_op_start_time_});
+}
+
+}  // namespace mediapipe
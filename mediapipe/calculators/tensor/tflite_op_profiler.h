@@ -0,0 +1,85 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_TFLITE_OP_PROFILER_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_TFLITE_OP_PROFILER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/mediapipe_profiling.h"
+#include "tflite/core/api/profiler.h"
+
+namespace mediapipe {
+
+// TfLite profiler reporting the ops run by an interpreter to the graph
+// profiler, if ProfilerConfig.enable_operator_profiling is set. Ops, including
+// the delegate kernels running whole delegate partitions, are reported as
+// INFERENCE_OP events. Ops within partitions, if the delegate reports them,
+// are reported as INFERENCE_DELEGATE_OP events. Events are named
+// "<op name>:<node index>".
+//
+// Usage:
+//   if (TfLiteOpProfiler::IsEnabled(cc)) {
+//     interpreter->SetProfiler(&op_profiler);
+//   }
+//   ...
+//   op_profiler.StartInvoke(cc);
+//   interpreter->Invoke();
+//   op_profiler.FinishInvoke(cc);
+class TfLiteOpProfiler : public tflite::Profiler {
+ public:
+  // Returns true if the graph running `cc` profiles operators.
+  static bool IsEnabled(const CalculatorContext* cc);
+
+  // Starts recording the ops of an Interpreter::Invoke call, if enabled.
+  void StartInvoke(const CalculatorContext* cc);
+
+  // Reports the ops recorded since StartInvoke and stops recording.
+  void FinishInvoke(const CalculatorContext* cc);
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override;
+  void EndEvent(uint32_t event_handle) override;
+
+  // Receives the ops a delegate timed itself. As only their runtime is known,
+  // they are laid out one after another from the start of the enclosing
+  // delegate kernel.
+  void AddEvent(const char* tag, EventType event_type, uint64_t elapsed_time,
+                int64_t event_metadata1, int64_t event_metadata2) override;
+
+ private:
+  struct Op {
+    TraceEvent::EventType event_type;
+    std::string name;
+    absl::Time start_time;
+    absl::Time finish_time;
+  };
+
+  // Set while recording.
+  std::shared_ptr<Clock> clock_;
+  std::vector<Op> ops_;
+  // Start time of the next op added through AddEvent.
+  absl::Time next_delegate_op_start_time_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_TFLITE_OP_PROFILER_H_
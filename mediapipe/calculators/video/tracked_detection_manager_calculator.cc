@@ -163,6 +163,7 @@ class TrackedDetectionManagerCalculator : public CalculatorBase {
 
   // Manages existing and new detections.
   TrackedDetectionManager tracked_detection_manager_;
+  int64_t max_unconfirmed_duration_ms_ = 0;
 
   // Set of detections that are not up to date yet. These detections will be
   // added to the detection manager until they got updated from the box tracker.
@@ -201,6 +202,7 @@ absl::Status TrackedDetectionManagerCalculator::Open(CalculatorContext* cc) {
       cc->Options<mediapipe::TrackedDetectionManagerCalculatorOptions>();
   tracked_detection_manager_.SetConfig(
       options.tracked_detection_manager_options());
+  max_unconfirmed_duration_ms_ = options.max_unconfirmed_duration_ms();
   return absl::OkStatus();
 }
 
@@ -247,6 +249,12 @@ absl::Status TrackedDetectionManagerCalculator::Process(CalculatorContext* cc) {
     removed_ids = tracked_detection_manager_.RemoveOutOfViewDetections();
     MoveIds(removed_detection_ids.get(), std::move(removed_ids));
 
+    if (max_unconfirmed_duration_ms_ > 0) {
+      removed_ids = tracked_detection_manager_.RemoveUnconfirmedDetections(
+          GetInputTimestampMs(cc) - max_unconfirmed_duration_ms_);
+      MoveIds(removed_detection_ids.get(), std::move(removed_ids));
+    }
+
     if (!removed_detection_ids->empty() &&
         cc->Outputs().HasTag(kCancelObjectIdTag)) {
       auto timestamp = cc->InputTimestamp();
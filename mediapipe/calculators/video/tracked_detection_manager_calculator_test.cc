@@ -0,0 +1,154 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/substitute.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/tracking/box_tracker.pb.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::IsEmpty;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+constexpr int64_t kFrameIntervalMs = 100;
+
+CalculatorRunner CreateRunner(int64_t max_unconfirmed_duration_ms) {
+  return CalculatorRunner(absl::Substitute(
+      R"pb(
+        calculator: "TrackedDetectionManagerCalculator"
+        input_stream: "DETECTIONS:detections"
+        input_stream: "TRACKING_BOXES:boxes"
+        output_stream: "CANCEL_OBJECT_ID:cancel_object_id"
+        output_stream: "DETECTIONS:output_detections"
+        options {
+          [mediapipe.TrackedDetectionManagerCalculatorOptions.ext] {
+            max_unconfirmed_duration_ms: $0
+          }
+        }
+      )pb",
+      max_unconfirmed_duration_ms));
+}
+
+Timestamp TimestampFromMs(int64_t timestamp_ms) {
+  return Timestamp(timestamp_ms * 1000);
+}
+
+// Adds a detection of an object with a fixed location in the middle of the
+// frame.
+void AddDetection(CalculatorRunner& runner, int id, int64_t timestamp_ms) {
+  Detection detection;
+  detection.set_detection_id(id);
+  auto* box =
+      detection.mutable_location_data()->mutable_relative_bounding_box();
+  box->set_xmin(0.4);
+  box->set_ymin(0.4);
+  box->set_width(0.2);
+  box->set_height(0.2);
+  runner.MutableInputs()->Tag("DETECTIONS").packets.push_back(
+      MakePacket<std::vector<Detection>>(std::vector<Detection>{detection})
+          .At(TimestampFromMs(timestamp_ms)));
+}
+
+// Adds the boxes that the tracker outputs for the objects `ids` at the location
+// they were detected at.
+void AddTrackedBoxes(CalculatorRunner& runner, const std::vector<int>& ids,
+                     int64_t timestamp_ms) {
+  TimedBoxProtoList boxes;
+  for (int id : ids) {
+    TimedBoxProto* box = boxes.add_box();
+    box->set_id(id);
+    box->set_time_msec(timestamp_ms);
+    box->set_top(0.4);
+    box->set_left(0.4);
+    box->set_bottom(0.6);
+    box->set_right(0.6);
+  }
+  runner.MutableInputs()->Tag("TRACKING_BOXES").packets.push_back(
+      MakePacket<TimedBoxProtoList>(std::move(boxes))
+          .At(TimestampFromMs(timestamp_ms)));
+}
+
+// Returns the canceled object IDs with the time they were canceled at, in ms.
+std::vector<std::pair<int, int64_t>> GetCanceledIds(
+    const CalculatorRunner& runner) {
+  std::vector<std::pair<int, int64_t>> canceled_ids;
+  for (const Packet& packet :
+       runner.Outputs().Tag("CANCEL_OBJECT_ID").packets) {
+    canceled_ids.emplace_back(packet.Get<int>(),
+                              packet.Timestamp().Microseconds() / 1000);
+  }
+  return canceled_ids;
+}
+
+TEST(TrackedDetectionManagerCalculatorTest, CancelsUnconfirmedDetections) {
+  CalculatorRunner runner = CreateRunner(/*max_unconfirmed_duration_ms=*/1000);
+  AddDetection(runner, /*id=*/7, /*timestamp_ms=*/0);
+  for (int64_t t = kFrameIntervalMs; t <= 1500; t += kFrameIntervalMs) {
+    AddTrackedBoxes(runner, {7}, t);
+  }
+  MP_ASSERT_OK(runner.Run());
+
+  // Tracked for 1000 ms without being detected again.
+  EXPECT_THAT(GetCanceledIds(runner), UnorderedElementsAre(Pair(7, 1100)));
+  const auto& detections = runner.Outputs().Tag("DETECTIONS").packets;
+  ASSERT_FALSE(detections.empty());
+  EXPECT_EQ(detections.back().Timestamp(), TimestampFromMs(1500));
+  EXPECT_THAT(detections.back().Get<std::vector<Detection>>(), IsEmpty());
+}
+
+TEST(TrackedDetectionManagerCalculatorTest, RedetectionDefersCancellation) {
+  CalculatorRunner runner = CreateRunner(/*max_unconfirmed_duration_ms=*/1000);
+  AddDetection(runner, /*id=*/7, /*timestamp_ms=*/0);
+  for (int64_t t = kFrameIntervalMs; t <= 600; t += kFrameIntervalMs) {
+    AddTrackedBoxes(runner, {7}, t);
+  }
+  // The detector finds the object again; the tracker starts tracking the new
+  // detection next to the old one until the old one is canceled.
+  AddDetection(runner, /*id=*/8, /*timestamp_ms=*/600);
+  AddTrackedBoxes(runner, {7, 8}, 700);
+  for (int64_t t = 800; t <= 1700; t += kFrameIntervalMs) {
+    AddTrackedBoxes(runner, {8}, t);
+  }
+  MP_ASSERT_OK(runner.Run());
+
+  // Detection 7 is replaced by its duplicate, and detection 8 is canceled
+  // 1000 ms after it was detected.
+  EXPECT_THAT(GetCanceledIds(runner),
+              UnorderedElementsAre(Pair(7, 700), Pair(8, 1700)));
+}
+
+TEST(TrackedDetectionManagerCalculatorTest, KeepsTrackedDetectionsByDefault) {
+  CalculatorRunner runner = CreateRunner(/*max_unconfirmed_duration_ms=*/0);
+  AddDetection(runner, /*id=*/7, /*timestamp_ms=*/0);
+  for (int64_t t = kFrameIntervalMs; t <= 3000; t += kFrameIntervalMs) {
+    AddTrackedBoxes(runner, {7}, t);
+  }
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_THAT(GetCanceledIds(runner), IsEmpty());
+}
+
+}  // namespace
+}  // namespace mediapipe
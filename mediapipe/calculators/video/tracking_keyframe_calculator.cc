@@ -0,0 +1,162 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+
+#include "mediapipe/calculators/video/tracking_keyframe_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/util/tracking/box_tracker.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kVideoTag[] = "VIDEO";
+constexpr char kBoxesTag[] = "BOXES";
+constexpr char kKeyframeTag[] = "KEYFRAME";
+constexpr char kIsKeyframeTag[] = "IS_KEYFRAME";
+
+}  // namespace
+
+// Selects the keyframes of a detection-tracking cascade, i.e. the frames the
+// expensive detector runs on, while a cheap box tracker follows the detected
+// objects through the frames in between. A frame becomes a keyframe if:
+// - it's the first frame,
+// - the previous keyframe is older than max_keyframe_interval_ms,
+// - the confidence of a tracked box dropped below min_tracking_confidence, or
+// - no box is tracked and keyframe_when_nothing_tracked is set,
+// but never within min_keyframe_interval_ms of the previous keyframe. On
+// mostly static video, the detector this way only runs every
+// max_keyframe_interval_ms.
+//
+// Inputs:
+//   VIDEO: Frames of any type.
+//   BOXES (optional): TimedBoxProtoList of the tracked boxes, usually a back
+//     edge from BoxTrackerCalculator. The latest list received is used.
+//
+// Outputs:
+//   KEYFRAME (optional): The VIDEO packets of keyframes, to run the detector
+//     on.
+//   IS_KEYFRAME (optional): Whether each VIDEO packet is a keyframe.
+//
+// Example config:
+// node {
+//   calculator: "TrackingKeyframeCalculator"
+//   input_stream: "VIDEO:input_video"
+//   input_stream: "BOXES:tracked_boxes"
+//   input_stream_info: { tag_index: "BOXES" back_edge: true }
+//   output_stream: "KEYFRAME:keyframe_video"
+//   input_stream_handler {
+//     input_stream_handler: "SyncSetInputStreamHandler"
+//     options {
+//       [mediapipe.SyncSetInputStreamHandlerOptions.ext] {
+//         sync_set { tag_index: "VIDEO" }
+//         sync_set { tag_index: "BOXES" }
+//       }
+//     }
+//   }
+//   options {
+//     [mediapipe.TrackingKeyframeCalculatorOptions.ext] {
+//       max_keyframe_interval_ms: 2000
+//     }
+//   }
+// }
+class TrackingKeyframeCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc);
+  absl::Status Open(CalculatorContext* cc) override;
+  absl::Status Process(CalculatorContext* cc) override;
+
+ private:
+  bool IsKeyframe(int64_t timestamp_ms) const;
+
+  TrackingKeyframeCalculatorOptions options_;
+  std::optional<int64_t> last_keyframe_ms_;
+  // Summary of the latest tracked boxes.
+  int num_tracked_boxes_ = 0;
+  float min_box_confidence_ = 1.0f;
+};
+REGISTER_CALCULATOR(TrackingKeyframeCalculator);
+
+absl::Status TrackingKeyframeCalculator::GetContract(CalculatorContract* cc) {
+  cc->Inputs().Tag(kVideoTag).SetAny();
+  if (cc->Inputs().HasTag(kBoxesTag)) {
+    cc->Inputs().Tag(kBoxesTag).Set<TimedBoxProtoList>();
+  }
+  if (cc->Outputs().HasTag(kKeyframeTag)) {
+    cc->Outputs().Tag(kKeyframeTag).SetSameAs(&cc->Inputs().Tag(kVideoTag));
+  }
+  if (cc->Outputs().HasTag(kIsKeyframeTag)) {
+    cc->Outputs().Tag(kIsKeyframeTag).Set<bool>();
+  }
+  return absl::OkStatus();
+}
+
+absl::Status TrackingKeyframeCalculator::Open(CalculatorContext* cc) {
+  options_ = cc->Options<TrackingKeyframeCalculatorOptions>();
+  RET_CHECK_LE(options_.min_keyframe_interval_ms(),
+               options_.max_keyframe_interval_ms());
+  return absl::OkStatus();
+}
+
+absl::Status TrackingKeyframeCalculator::Process(CalculatorContext* cc) {
+  if (cc->Inputs().HasTag(kBoxesTag) &&
+      !cc->Inputs().Tag(kBoxesTag).IsEmpty()) {
+    const auto& boxes = cc->Inputs().Tag(kBoxesTag).Get<TimedBoxProtoList>();
+    num_tracked_boxes_ = boxes.box_size();
+    min_box_confidence_ = 1.0f;
+    for (const TimedBoxProto& box : boxes.box()) {
+      min_box_confidence_ = std::min(min_box_confidence_, box.confidence());
+    }
+  }
+
+  if (cc->Inputs().Tag(kVideoTag).IsEmpty()) {
+    return absl::OkStatus();
+  }
+  const int64_t timestamp_ms = cc->InputTimestamp().Microseconds() / 1000;
+  const bool is_keyframe = IsKeyframe(timestamp_ms);
+  if (is_keyframe) {
+    last_keyframe_ms_ = timestamp_ms;
+  }
+  if (cc->Outputs().HasTag(kKeyframeTag)) {
+    if (is_keyframe) {
+      cc->Outputs().Tag(kKeyframeTag).AddPacket(
+          cc->Inputs().Tag(kVideoTag).Value());
+    } else {
+      // Lets the detector's downstream proceed without waiting.
+      cc->Outputs().Tag(kKeyframeTag).SetNextTimestampBound(
+          cc->InputTimestamp().NextAllowedInStream());
+    }
+  }
+  if (cc->Outputs().HasTag(kIsKeyframeTag)) {
+    cc->Outputs().Tag(kIsKeyframeTag).AddPacket(
+        MakePacket<bool>(is_keyframe).At(cc->InputTimestamp()));
+  }
+  return absl::OkStatus();
+}
+
+bool TrackingKeyframeCalculator::IsKeyframe(int64_t timestamp_ms) const {
+  if (!last_keyframe_ms_.has_value()) return true;
+  const int64_t elapsed_ms = timestamp_ms - *last_keyframe_ms_;
+  if (elapsed_ms < options_.min_keyframe_interval_ms()) return false;
+  if (elapsed_ms >= options_.max_keyframe_interval_ms()) return true;
+  if (num_tracked_boxes_ == 0) {
+    return options_.keyframe_when_nothing_tracked();
+  }
+  return min_box_confidence_ < options_.min_tracking_confidence();
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,118 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/tracking/box_tracker.pb.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int64_t kFrameIntervalUs = 100000;  // 10 fps.
+
+CalculatorGraphConfig::Node MakeNode(bool with_boxes) {
+  auto node = ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "TrackingKeyframeCalculator"
+    input_stream: "VIDEO:video"
+    output_stream: "KEYFRAME:keyframe"
+    output_stream: "IS_KEYFRAME:is_keyframe"
+    options {
+      [mediapipe.TrackingKeyframeCalculatorOptions.ext] {
+        max_keyframe_interval_ms: 500
+        min_keyframe_interval_ms: 200
+        min_tracking_confidence: 0.5
+      }
+    }
+  )pb");
+  if (with_boxes) {
+    node.add_input_stream("BOXES:boxes");
+  }
+  return node;
+}
+
+void AddFrames(CalculatorRunner& runner, int num_frames) {
+  for (int i = 0; i < num_frames; ++i) {
+    runner.MutableInputs()->Tag("VIDEO").packets.push_back(
+        MakePacket<int>(i).At(Timestamp(i * kFrameIntervalUs)));
+  }
+}
+
+void AddBoxes(CalculatorRunner& runner, int frame, int num_boxes,
+              float confidence) {
+  TimedBoxProtoList boxes;
+  for (int i = 0; i < num_boxes; ++i) {
+    boxes.add_box()->set_confidence(confidence);
+  }
+  runner.MutableInputs()->Tag("BOXES").packets.push_back(
+      MakePacket<TimedBoxProtoList>(boxes).At(
+          Timestamp(frame * kFrameIntervalUs)));
+}
+
+std::vector<int> GetKeyframes(const CalculatorRunner& runner) {
+  std::vector<int> keyframes;
+  for (const Packet& packet : runner.Outputs().Tag("KEYFRAME").packets) {
+    keyframes.push_back(packet.Get<int>());
+  }
+  return keyframes;
+}
+
+TEST(TrackingKeyframeCalculatorTest, UntrackedFramesAreKeyframesAtMinInterval) {
+  CalculatorRunner runner(MakeNode(/*with_boxes=*/false));
+  AddFrames(runner, 7);
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_THAT(GetKeyframes(runner), ElementsAre(0, 2, 4, 6));
+  EXPECT_EQ(runner.Outputs().Tag("IS_KEYFRAME").packets.size(), 7);
+}
+
+TEST(TrackingKeyframeCalculatorTest, ConfidentTrackingUsesMaxInterval) {
+  CalculatorRunner runner(MakeNode(/*with_boxes=*/true));
+  AddFrames(runner, 12);
+  for (int i = 0; i < 12; ++i) {
+    AddBoxes(runner, i, /*num_boxes=*/2, /*confidence=*/0.9f);
+  }
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_THAT(GetKeyframes(runner), ElementsAre(0, 5, 10));
+}
+
+TEST(TrackingKeyframeCalculatorTest, LowConfidenceTriggersKeyframe) {
+  CalculatorRunner runner(MakeNode(/*with_boxes=*/true));
+  AddFrames(runner, 6);
+  for (int i = 0; i < 6; ++i) {
+    AddBoxes(runner, i, /*num_boxes=*/2, /*confidence=*/i == 3 ? 0.2f : 0.9f);
+  }
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_THAT(GetKeyframes(runner), ElementsAre(0, 3));
+}
+
+TEST(TrackingKeyframeCalculatorTest, LowConfidenceRespectsMinInterval) {
+  CalculatorRunner runner(MakeNode(/*with_boxes=*/true));
+  AddFrames(runner, 4);
+  for (int i = 0; i < 4; ++i) {
+    AddBoxes(runner, i, /*num_boxes=*/1, /*confidence=*/0.1f);
+  }
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_THAT(GetKeyframes(runner), ElementsAre(0, 2));
+}
+
+}  // namespace
+}  // namespace mediapipe
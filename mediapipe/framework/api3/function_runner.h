@@ -42,6 +42,7 @@
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/straight_line_graph.h"
 #include "mediapipe/framework/thread_pool_executor.h"
 #include "mediapipe/framework/timestamp.h"
 
@@ -64,14 +65,21 @@ class FunctionRunnerImpl<BuildGraphFnT, OutputT, std::tuple<InputPacketTs...>>
     : public FunctionRunnerBase {
  public:
   // - Adds all provided input packets
-  // - Waits for graph work completion
+  // - Waits for graph work completion (or runs the nodes in place for
+  //   straight-line execution)
   // - Polls and returns the output packet(s)
   absl::StatusOr<OutputT> Run(InputPacketTs... inputs) {
     mediapipe::Timestamp timestamp = this->NextTimestamp();
-    ABSL_RETURN_IF_ERROR(AddInputPackets(*this->calculator_graph_,
-                                         this->input_names_map_, timestamp,
-                                         inputs...));
-    ABSL_RETURN_IF_ERROR(this->calculator_graph_->WaitUntilIdle());
+    if (this->straight_line_graph_) {
+      ABSL_RETURN_IF_ERROR(SetStraightLineInputPackets(
+          *this->straight_line_graph_, this->straight_line_input_indices_,
+          timestamp, inputs...));
+    } else {
+      ABSL_RETURN_IF_ERROR(AddInputPackets(*this->calculator_graph_,
+                                           this->input_names_map_, timestamp,
+                                           inputs...));
+    }
+    ABSL_RETURN_IF_ERROR(this->RunGraph(timestamp));
 
     if constexpr (kIsTupleV<OutputT>) {
       OutputT output;
@@ -79,10 +87,8 @@ class FunctionRunnerImpl<BuildGraphFnT, OutputT, std::tuple<InputPacketTs...>>
           std::make_index_sequence<std::tuple_size_v<OutputT>>(), output));
       return output;
     } else {
-      ABSL_ASSIGN_OR_RETURN(OutputStreamPoller * poller,
-                            this->GetOutputPoller(0));
       ABSL_ASSIGN_OR_RETURN(mediapipe::Packet packet,
-                            GetOutputPacket(*poller, *this->calculator_graph_));
+                            this->TakeOutputPacket(0));
       return WrapLegacyPacket<typename OutputT::PayloadT>(std::move(packet));
     }
   }
@@ -95,11 +101,8 @@ class FunctionRunnerImpl<BuildGraphFnT, OutputT, std::tuple<InputPacketTs...>>
     absl::Status status = absl::OkStatus();
     ((
          status = [&]() -> absl::Status {
-           ABSL_ASSIGN_OR_RETURN(OutputStreamPoller * poller,
-                                 this->GetOutputPoller(Is));
-           ABSL_ASSIGN_OR_RETURN(
-               mediapipe::Packet packet,
-               GetOutputPacket(*poller, *this->calculator_graph_));
+           ABSL_ASSIGN_OR_RETURN(mediapipe::Packet packet,
+                                 this->TakeOutputPacket(Is));
            using CurrentOutputPacketT = std::tuple_element_t<Is, OutputT>;
            ABSL_ASSIGN_OR_RETURN(
                std::get<Is>(output),
@@ -250,6 +253,23 @@ class FunctionRunnerBuilder {
     return *this;
   }
 
+  // Runs the graph as a straight line of `Process` calls on the thread
+  // calling `Run`, bypassing the scheduler, input stream handlers and output
+  // pollers: nodes are ordered topologically once and invoked in sequence on
+  // preallocated contexts. This brings the framework overhead per `Run` close
+  // to zero for small graphs.
+  //
+  // Only suitable for graphs whose nodes process each input independently and
+  // output at the input timestamp (no loopbacks, source nodes, custom input
+  // stream handlers or output side packets), see `StraightLineGraph` for
+  // details. `Create` fails for other graphs.
+  //
+  // NOTE: incompatible with `SetDefaultExecutor`, since nothing is scheduled.
+  FunctionRunnerBuilder& EnableStraightLineExecution() {
+    straight_line_execution_ = true;
+    return *this;
+  }
+
   // Creates the graph runner according to the provided graph builder function
   // and initializes using all provided parameters.
   //
@@ -319,6 +339,12 @@ class FunctionRunnerBuilder {
     ABSL_ASSIGN_OR_RETURN(CalculatorGraphConfig config, graph.GetConfig());
     VLOG(1) << "Graph config:\n" << config.DebugString();
 
+    if (straight_line_execution_) {
+      return CreateStraightLine(std::move(graph), std::move(config),
+                                side_packets_mapping, input_names_map,
+                                output_names_map);
+    }
+
     auto calculator_graph = std::make_unique<CalculatorGraph>();
 
     // Default to a single thread execution.
@@ -372,6 +398,39 @@ class FunctionRunnerBuilder {
   explicit FunctionRunnerBuilder(BuildGraphFnT fn)
       : build_graph_fn_(std::move(fn)) {}
 
+  absl::StatusOr<FunctionRunner<BuildGraphFnT>> CreateStraightLine(
+      GenericGraph graph, CalculatorGraphConfig config,
+      const std::map<std::string, mediapipe::Packet>& side_packets,
+      const absl::flat_hash_map<int, std::string>& input_names_map,
+      const absl::flat_hash_map<int, std::string>& output_names_map) {
+    RET_CHECK(!default_executor_)
+        << "Straight-line execution doesn't use executors.";
+    auto straight_line_graph = std::make_unique<StraightLineGraph>();
+    for (const auto& [key, value] : services_) {
+      ABSL_RETURN_IF_ERROR(straight_line_graph->SetServicePacket(*key, value));
+    }
+    if (disallow_service_default_initialization_) {
+      ABSL_RETURN_IF_ERROR(
+          straight_line_graph->DisallowServiceDefaultInitialization());
+    }
+    ABSL_RETURN_IF_ERROR(
+        straight_line_graph->Initialize(std::move(config), side_packets));
+
+    std::vector<int> input_indices(input_names_map.size());
+    for (const auto& [index, name] : input_names_map) {
+      ABSL_ASSIGN_OR_RETURN(input_indices[index],
+                            straight_line_graph->GetInputStreamIndex(name));
+    }
+    std::vector<int> output_indices(output_names_map.size());
+    for (const auto& [index, name] : output_names_map) {
+      ABSL_ASSIGN_OR_RETURN(output_indices[index],
+                            straight_line_graph->GetOutputStreamIndex(name));
+    }
+    return FunctionRunner<BuildGraphFnT>(
+        std::move(graph), std::move(straight_line_graph), output_names_map,
+        std::move(input_indices), std::move(output_indices));
+  }
+
   auto InvokeBuildGraphFn(FunctionGraphBuilder& builder) {
     using InputsT = typename RawSignatureT::In;
     return InvokeBuildGraphFnImpl<InputsT>(
@@ -402,6 +461,7 @@ class FunctionRunnerBuilder {
   absl::flat_hash_map<const GraphServiceBase*, mediapipe::Packet> services_;
   std::shared_ptr<Executor> default_executor_;
   bool disallow_service_default_initialization_ = false;
+  bool straight_line_execution_ = false;
 
   friend class Runner;
 };
@@ -0,0 +1,85 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark for the framework overhead of FunctionRunner::Run, with and
+// without straight-line execution, on a chain of trivial nodes.
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/api3/calculator.h"
+#include "mediapipe/framework/api3/calculator_context.h"
+#include "mediapipe/framework/api3/contract.h"
+#include "mediapipe/framework/api3/function_runner.h"
+#include "mediapipe/framework/api3/graph.h"
+#include "mediapipe/framework/api3/node.h"
+#include "mediapipe/framework/api3/packet.h"
+#include "mediapipe/framework/api3/stream.h"
+
+namespace mediapipe::api3 {
+namespace {
+
+struct IncrementNode : Node<"FunctionRunnerBenchmarkIncrement"> {
+  template <typename S>
+  struct Contract {
+    Input<S, int> in{"IN"};
+    Output<S, int> out{"OUT"};
+  };
+};
+
+class IncrementNodeImpl : public Calculator<IncrementNode, IncrementNodeImpl> {
+ public:
+  absl::Status Process(CalculatorContext<IncrementNode>& cc) final {
+    cc.out.Send(cc.in.GetOrDie() + 1);
+    return absl::OkStatus();
+  }
+};
+
+// Args: number of nodes in the chain, whether straight-line execution is
+// enabled.
+void BM_FunctionRunnerRun(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  const bool straight_line = state.range(1) != 0;
+  auto builder = Runner::For(
+      [num_nodes](GenericGraph& graph, Stream<int> in) -> Stream<int> {
+        Stream<int> value = in;
+        for (int i = 0; i < num_nodes; ++i) {
+          auto& node = graph.AddNode<IncrementNode>();
+          node.in.Set(value);
+          value = node.out.Get();
+        }
+        return value;
+      });
+  if (straight_line) {
+    builder.EnableStraightLineExecution();
+  }
+  auto runner = builder.Create();
+  ABSL_CHECK_OK(runner);
+
+  int input = 0;
+  for (auto _ : state) {
+    auto output = runner->Run(MakePacket<int>(input));
+    ABSL_CHECK_OK(output);
+    ABSL_CHECK_EQ(output->GetOrDie(), input + num_nodes);
+    ++input;
+  }
+}
+
+BENCHMARK(BM_FunctionRunnerRun)
+    ->ArgNames({"nodes", "straight_line"})
+    ->ArgsProduct({{1, 4, 16}, {0, 1}});
+
+}  // namespace
+}  // namespace mediapipe::api3
+
+BENCHMARK_MAIN();
@@ -4,8 +4,12 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/output_stream_poller.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe::api3 {
 
@@ -26,4 +30,36 @@ absl::StatusOr<mediapipe::Packet> GetOutputPacket(OutputStreamPoller& poller,
   return std::move(packet).At(Timestamp::Unset());
 }
 
+absl::Status FunctionRunnerBase::RunGraph(Timestamp timestamp) {
+  if (straight_line_graph_) {
+    return straight_line_graph_->Run(timestamp);
+  }
+  return calculator_graph_->WaitUntilIdle();
+}
+
+absl::StatusOr<mediapipe::Packet> FunctionRunnerBase::TakeOutputPacket(
+    int index) {
+  if (straight_line_graph_) {
+    RET_CHECK(index >= 0 && index < straight_line_output_indices_.size());
+    const int stream_index = straight_line_output_indices_[index];
+    mediapipe::Packet& packet =
+        straight_line_graph_->GetOutputPacket(stream_index);
+    // An output neither produced nor settled by the run would block the
+    // poller of a regular graph forever.
+    if (packet.IsEmpty() &&
+        straight_line_graph_->GetOutputTimestampBound(stream_index) <=
+            timestamp_) {
+      return absl::InternalError(
+          absl::StrCat("Failed to poll the output \"",
+                       output_names_map_[index], "\": no packet or ",
+                       "timestamp bound update at ", timestamp_.DebugString(),
+                       "."));
+    }
+    // NOTE: currently supporting timestamp-less execution only.
+    return std::exchange(packet, mediapipe::Packet()).At(Timestamp::Unset());
+  }
+  ABSL_ASSIGN_OR_RETURN(OutputStreamPoller * poller, GetOutputPoller(index));
+  return GetOutputPacket(*poller, *calculator_graph_);
+}
+
 }  // namespace mediapipe::api3
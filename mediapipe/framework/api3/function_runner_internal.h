@@ -23,6 +23,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_log.h"
@@ -36,6 +37,7 @@
 #include "mediapipe/framework/output_stream_poller.h"
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/straight_line_graph.h"
 #include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe::api3 {
@@ -180,6 +182,18 @@ class FunctionRunnerBase {
         output_names_map_(std::move(output_names_map)),
         output_pollers_(std::move(output_pollers)) {}
 
+  FunctionRunnerBase(GenericGraph graph,
+                     std::unique_ptr<StraightLineGraph> straight_line_graph,
+                     absl::flat_hash_map<int, std::string> output_names_map,
+                     std::vector<int> straight_line_input_indices,
+                     std::vector<int> straight_line_output_indices)
+      : graph_(std::move(graph)),
+        output_names_map_(std::move(output_names_map)),
+        straight_line_graph_(std::move(straight_line_graph)),
+        straight_line_input_indices_(std::move(straight_line_input_indices)),
+        straight_line_output_indices_(
+            std::move(straight_line_output_indices)) {}
+
   FunctionRunnerBase(FunctionRunnerBase&& other) = default;
   FunctionRunnerBase& operator=(FunctionRunnerBase&& other) = delete;
 
@@ -205,11 +219,22 @@ class FunctionRunnerBase {
     return &poller_iter->second;
   }
 
+  // Runs the graph for the packets previously added at `timestamp`.
+  absl::Status RunGraph(Timestamp timestamp);
+
+  // Returns the `index`-th output packet of the latest run.
+  absl::StatusOr<mediapipe::Packet> TakeOutputPacket(int index);
+
   GenericGraph graph_;
   std::unique_ptr<mediapipe::CalculatorGraph> calculator_graph_;
   absl::flat_hash_map<int, std::string> input_names_map_;
   absl::flat_hash_map<int, std::string> output_names_map_;
   absl::flat_hash_map<int, OutputStreamPoller> output_pollers_;
+  // Set instead of `calculator_graph_` for straight-line execution, see
+  // `FunctionRunnerBuilder::EnableStraightLineExecution`.
+  std::unique_ptr<StraightLineGraph> straight_line_graph_;
+  std::vector<int> straight_line_input_indices_;
+  std::vector<int> straight_line_output_indices_;
   mediapipe::Timestamp timestamp_ = mediapipe::Timestamp(0);
 };
 
@@ -239,6 +264,32 @@ absl::Status AddInputPackets(
   return status;
 }
 
+// Sets the input packets of a graph run in straight-line execution.
+template <typename... PacketTs>
+absl::Status SetStraightLineInputPackets(
+    StraightLineGraph& graph, const std::vector<int>& input_indices,
+    const Timestamp& timestamp, PacketTs... inputs) {
+  int input_index = 0;
+  absl::Status status;
+  // clang-format off
+  ((
+       status = [&]() -> absl::Status {
+         // NOTE: currently supporting timestamp-less execution only.
+         if (inputs.Timestamp() != Timestamp::Unset()) {
+           return absl::InvalidArgumentError(absl::StrCat(
+               "Timestamp for input [", input_index, "] is [",
+               inputs.Timestamp().DebugString(), "], but must be Unset"));
+         }
+         graph.SetInputPacket(input_indices[input_index++],
+                              inputs.AsLegacyPacket().At(timestamp));
+         return absl::OkStatus();
+       }(),
+       status.ok()) &&
+    ...);
+  // clang-format on
+  return status;
+}
+
 absl::StatusOr<mediapipe::Packet> GetOutputPacket(OutputStreamPoller& poller,
                                                   CalculatorGraph& graph);
 
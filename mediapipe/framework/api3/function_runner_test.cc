@@ -574,5 +574,143 @@ TEST(FunnctionRunnerTest, HandlingEmptyPacketInputs) {
   }
 }
 
+TEST(FunctionRunnerTest, StraightLineExecutionRunsMultiplicationAndAddition) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      Runner::For([](GenericGraph& graph, Stream<int> in) -> Stream<int> {
+        auto& multiplication = graph.AddNode<MultiplicationNode>();
+        multiplication.in.Set(in);
+        auto& addition = graph.AddNode<AdditionNode>();
+        addition.in.Set(multiplication.out.Get());
+        return addition.out.Get();
+      })
+          .EnableStraightLineExecution()
+          .Create());
+
+  for (auto [input, expected] :
+       {std::pair(20, 50), std::pair(40, 90), std::pair(100, 210)}) {
+    MP_ASSERT_OK_AND_ASSIGN(Packet<int> output,
+                            runner.Run(MakePacket<int>(input)));
+    EXPECT_EQ(output.GetOrDie(), expected);
+  }
+}
+
+TEST(FunctionRunnerTest, StraightLineExecutionSupportsServices) {
+  constexpr absl::string_view kServiceValue = "service_value";
+  MP_ASSERT_OK_AND_ASSIGN(
+      FunctionRunner<decltype(&GetServiceValue)> runner,
+      Runner::For(GetServiceValue)
+          .SetService(kTestService,
+                      std::make_shared<std::string>(kServiceValue))
+          .EnableStraightLineExecution()
+          .Create());
+
+  MP_ASSERT_OK_AND_ASSIGN(Packet<std::string> service_value,
+                          runner.Run(MakePacket<int>(1)));
+  EXPECT_EQ(service_value.GetOrDie(), kServiceValue);
+}
+
+TEST(FunctionRunnerTest, StraightLineExecutionReturnsFailureStatus) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      Runner::For([](GenericGraph& graph, Stream<int> tick) -> Stream<int> {
+        auto& node = graph.AddNode<AlwaysFailingNode>();
+        node.tick.Set(tick);
+        return node.output.Get();
+      })
+          .EnableStraightLineExecution()
+          .Create());
+
+  EXPECT_THAT(runner.Run(MakePacket<int>(0)),
+              StatusIs(absl::StatusCode::kUnimplemented,
+                       testing::HasSubstr("unimplemented is expected")));
+}
+
+TEST(FunctionRunnerTest, StraightLineExecutionHandlesEmptyPacketInputs) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      Runner::For([](GenericGraph& graph, Stream<int> a, Stream<std::string> b)
+                      -> std::tuple<Stream<int>, Stream<std::string>> {
+        auto& node = graph.AddNode<PassThroughNode>();
+        node.in.Add(a.Cast<Any>());
+        node.in.Add(b.Cast<Any>());
+        return {node.out.Add().Cast<int>(), node.out.Add().Cast<std::string>()};
+      })
+          .EnableStraightLineExecution()
+          .Create());
+
+  {
+    MP_ASSERT_OK_AND_ASSIGN(
+        (auto [a, b]), runner.Run(MakePacket<int>(42), Packet<std::string>()));
+    ASSERT_TRUE(a);
+    EXPECT_EQ(a.GetOrDie(), 42);
+    ASSERT_FALSE(b);
+  }
+
+  {
+    MP_ASSERT_OK_AND_ASSIGN((auto [a, b]),
+                            runner.Run(Packet<int>(), Packet<std::string>()));
+    ASSERT_FALSE(a);
+    ASSERT_FALSE(b);
+  }
+}
+
+struct EvenPassThroughNode : Node<"EvenPassThrough"> {
+  template <typename S>
+  struct Contract {
+    Input<S, int> in{"IN"};
+    Output<S, int> out{"OUT"};
+
+    static absl::Status UpdateContract(
+        CalculatorContract<EvenPassThroughNode>& cc) {
+      // Without an offset, odd inputs leave the output unsettled.
+      cc.SetTimestampOffset(TimestampDiff::Unset());
+      return absl::OkStatus();
+    }
+  };
+};
+
+class EvenPassThroughNodeImpl
+    : public Calculator<EvenPassThroughNode, EvenPassThroughNodeImpl> {
+ public:
+  absl::Status Process(CalculatorContext<EvenPassThroughNode>& cc) final {
+    RET_CHECK(cc.in);
+    if (cc.in.GetOrDie() % 2 == 0) {
+      cc.out.Send(cc.in.GetOrDie());
+    }
+    return absl::OkStatus();
+  }
+};
+
+TEST(FunctionRunnerTest, StraightLineExecutionReportsMissingOutput) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      Runner::For([](GenericGraph& graph, Stream<int> in) -> Stream<int> {
+        auto& node = graph.AddNode<EvenPassThroughNode>();
+        node.in.Set(in);
+        return node.out.Get();
+      })
+          .EnableStraightLineExecution()
+          .Create());
+
+  MP_ASSERT_OK_AND_ASSIGN(Packet<int> output, runner.Run(MakePacket<int>(2)));
+  EXPECT_EQ(output.GetOrDie(), 2);
+  EXPECT_THAT(runner.Run(MakePacket<int>(3)),
+              StatusIs(absl::StatusCode::kInternal,
+                       testing::HasSubstr("Failed to poll the output")));
+  MP_ASSERT_OK_AND_ASSIGN(output, runner.Run(MakePacket<int>(4)));
+  EXPECT_EQ(output.GetOrDie(), 4);
+}
+
+TEST(FunctionRunnerTest, StraightLineExecutionRejectsDefaultExecutor) {
+  EXPECT_FALSE(Runner::For(GetServiceValue)
+                   .SetService(kTestService,
+                               std::make_shared<std::string>("service_value"))
+                   .SetDefaultExecutor(std::make_shared<ThreadPoolExecutor>(1))
+                   .EnableStraightLineExecution()
+                   .Create()
+                   .ok());
+}
+
 }  // namespace
 }  // namespace mediapipe::api3
@@ -206,6 +206,9 @@ class CalculatorContext {
 
   // Accesses CalculatorContext for setting input timestamp.
   friend class CalculatorContextManager;
+  // Accesses CalculatorContext for setting input timestamp in straight-line
+  // execution.
+  friend class StraightLineGraph;
 };
 
 }  // namespace mediapipe
@@ -39,6 +39,8 @@
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_base.h"
 #include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/cpu_thread_budget_service.h"
 #include "mediapipe/framework/delegating_executor.h"
 #include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/executor.h"
@@ -66,6 +68,7 @@
 #include "mediapipe/framework/thread_pool_executor.pb.h"
 #include "mediapipe/framework/timestamp.h"
 #include "mediapipe/framework/tool/fill_packet_set.h"
+#include "mediapipe/framework/tool/graph_optimization.h"
 #include "mediapipe/framework/tool/graph_runtime_info_logger.h"  // IWYU pragma: keep
 #include "mediapipe/framework/tool/graph_runtime_info_utils.h"  // IWYU pragma: keep
 #include "mediapipe/framework/tool/status_util.h"
@@ -363,6 +366,18 @@ absl::Status CalculatorGraph::InitializeProfiler() {
   return absl::OkStatus();
 }
 
+absl::Status CalculatorGraph::InitializeCpuThreadBudget() {
+  const CpuThreadBudgetConfig& config =
+      validated_graph_->Config().cpu_thread_budget();
+  if (!config.enable() ||
+      service_manager_.GetServiceObject(kCpuThreadBudgetService) != nullptr) {
+    return absl::OkStatus();
+  }
+  return service_manager_.SetServiceObject(
+      kCpuThreadBudgetService,
+      std::make_shared<CpuThreadBudget>(config.num_threads()));
+}
+
 absl::Status CalculatorGraph::InitializeExecutors() {
   // If the ExecutorConfig for the default executor leaves the executor type
   // unspecified, default_executor_options points to the
@@ -455,12 +470,26 @@ absl::Status CalculatorGraph::InitializeDefaultExecutor(
   // If the default (0 or -1) was specified, pick a suitable number of threads
   // depending on the number of processors in this system and the number of
   // calculators and packet generators in the calculator graph.
-  if (num_threads == 0 || num_threads == -1) {
+  const bool use_automatic_num_threads = num_threads == 0 || num_threads == -1;
+  if (use_automatic_num_threads) {
     num_threads = std::min(
         mediapipe::NumCPUCores(),
         std::max({validated_graph_->Config().node().size(),
                   validated_graph_->Config().packet_generator().size(), 1}));
   }
+  std::shared_ptr<CpuThreadBudget> budget =
+      service_manager_.GetServiceObject(kCpuThreadBudgetService);
+  if (budget != nullptr) {
+    if (use_automatic_num_threads) {
+      // Leaves half of the budget to the thread pools of the inference
+      // delegates, which otherwise only get the executor thread calling them.
+      num_threads =
+          std::min(num_threads, std::max(budget->num_threads() / 2, 1));
+    }
+    default_executor_thread_reservation_ =
+        budget->Reserve("default executor", num_threads);
+    num_threads = default_executor_thread_reservation_.num_threads();
+  }
   ABSL_RETURN_IF_ERROR(
       CreateDefaultThreadPool(default_executor_options, num_threads));
   VLOG(1) << absl::StrCat("Using default executor with num_threads: ",
@@ -477,6 +506,25 @@ absl::Status CalculatorGraph::Initialize(
       << "validated_graph is not initialized.";
   validated_graph_ = std::move(validated_graph);
 
+  const tool::GraphOptimizationStats& optimization_stats =
+      validated_graph_->OptimizationStats();
+  if (optimization_stats.NumRemovedNodes() > 0) {
+    // Each removed node is one less Process() call per input timestamp.
+    ABSL_LOG(INFO) << "Graph optimization removed "
+                   << optimization_stats.NumRemovedNodes() << " of "
+                   << optimization_stats.num_input_nodes << " nodes ("
+                   << optimization_stats.pruned_nodes.size()
+                   << " unobserved, " << optimization_stats.elided_nodes.size()
+                   << " pass-through), saving up to "
+                   << optimization_stats.NumRemovedNodes()
+                   << " Process() calls per frame.";
+    VLOG(1) << "Pruned nodes: "
+            << absl::StrJoin(optimization_stats.pruned_nodes, ", ")
+            << "; elided nodes: "
+            << absl::StrJoin(optimization_stats.elided_nodes, ", ");
+  }
+
+  ABSL_RETURN_IF_ERROR(InitializeCpuThreadBudget());
   ABSL_RETURN_IF_ERROR(InitializeExecutors());
   ABSL_RETURN_IF_ERROR(InitializePacketGeneratorGraph(side_packets));
   ABSL_RETURN_IF_ERROR(InitializeStreams());
@@ -981,6 +1029,19 @@ absl::StatusOr<GraphRuntimeInfo> CalculatorGraph::GetGraphRuntimeInfo() {
   for (const auto& node : nodes_) {
     *info.add_calculator_infos() = node->GetStreamMonitoringInfo();
   }
+  std::shared_ptr<CpuThreadBudget> budget =
+      service_manager_.GetServiceObject(kCpuThreadBudgetService);
+  if (budget != nullptr) {
+    CpuThreadBudgetRuntimeInfo& budget_info = *info.mutable_cpu_thread_budget();
+    budget_info.set_num_threads(budget->num_threads());
+    budget_info.set_num_available_threads(budget->num_available_threads());
+    for (const auto& reservation : budget->GetReservations()) {
+      auto& reservation_info = *budget_info.add_reservations();
+      reservation_info.set_owner(reservation.owner);
+      reservation_info.set_requested_threads(reservation.requested_threads);
+      reservation_info.set_granted_threads(reservation.granted_threads);
+    }
+  }
   const absl::Time time_now = mediapipe::Clock::RealClock()->TimeNow();
   info.set_capture_time_unix_us(absl::ToUnixMicros(time_now));
   return info;
@@ -996,6 +1057,17 @@ absl::Status CalculatorGraph::AddPacketToInputStream(
   return AddPacketToInputStreamInternal(stream_name, std::move(packet));
 }
 
+absl::Status CalculatorGraph::AddPacketToInputStream(
+    absl::string_view stream_name, const Packet& packet, absl::Time deadline) {
+  return AddPacketToInputStreamInternal(stream_name, packet, deadline);
+}
+
+absl::Status CalculatorGraph::AddPacketToInputStream(
+    absl::string_view stream_name, Packet&& packet, absl::Time deadline) {
+  return AddPacketToInputStreamInternal(stream_name, std::move(packet),
+                                        deadline);
+}
+
 absl::Status CalculatorGraph::SetInputStreamTimestampBound(
     const std::string& stream_name, Timestamp timestamp) {
   std::unique_ptr<GraphInputStream>* stream =
@@ -1015,7 +1087,7 @@ absl::Status CalculatorGraph::SetInputStreamTimestampBound(
 // std::forward will deduce the correct type as we pass along packet.
 template <typename T>
 absl::Status CalculatorGraph::AddPacketToInputStreamInternal(
-    absl::string_view stream_name, T&& packet) {
+    absl::string_view stream_name, T&& packet, absl::Time deadline) {
   auto stream_it = graph_input_streams_.find(stream_name);
   std::unique_ptr<GraphInputStream>* stream =
       stream_it == graph_input_streams_.end() ? nullptr : &stream_it->second;
@@ -1075,6 +1147,13 @@ absl::Status CalculatorGraph::AddPacketToInputStreamInternal(
                           .set_packet_ts(packet.Timestamp())
                           .set_packet_data_id(&packet));
 
+  // The deadline is recorded only for packets which are let into the graph,
+  // and before they are added so that the scheduler sees it for their tasks.
+  if (deadline != absl::InfiniteFuture() &&
+      packet.Timestamp().IsAllowedInStream()) {
+    scheduler_.SetInputTimestampDeadline(packet.Timestamp(), deadline);
+  }
+
   // InputStreamManager is thread safe. GraphInputStream is not, so this method
   // should not be called by multiple threads concurrently. Note that this could
   // potentially lead to the max queue size being exceeded by one packet at most
@@ -34,10 +34,12 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_base.h"
 #include "mediapipe/framework/calculator_node.h"
 #include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/graph_output_stream.h"
 #include "mediapipe/framework/graph_runtime_info.pb.h"
@@ -293,6 +295,19 @@ class CalculatorGraph {
   absl::Status AddPacketToInputStream(absl::string_view stream_name,
                                       Packet&& packet);
 
+  // Same as above, and attaches a deadline to the packet timestamp: the
+  // wall-clock time by which the graph should be done with this timestamp.
+  // Tasks for earlier deadlines are scheduled first, and nodes which set
+  // drop_inputs_past_deadline skip Process() for timestamps whose deadline
+  // has passed, so that work on stale frames doesn't delay fresh ones. If
+  // several graph input streams get a deadline for the same timestamp, the
+  // earliest one applies. Nothing is recorded if the packet can't be added.
+  absl::Status AddPacketToInputStream(absl::string_view stream_name,
+                                      const Packet& packet,
+                                      absl::Time deadline);
+  absl::Status AddPacketToInputStream(absl::string_view stream_name,
+                                      Packet&& packet, absl::Time deadline);
+
   // Indicates that input will arrive no earlier than a certain timestamp.
   absl::Status SetInputStreamTimestampBound(const std::string& stream_name,
                                             Timestamp timestamp);
@@ -558,10 +573,12 @@ class CalculatorGraph {
 
   // AddPacketToInputStreamInternal template is called by either
   // AddPacketToInputStream(Packet&& packet) or
-  // AddPacketToInputStream(const Packet& packet).
+  // AddPacketToInputStream(const Packet& packet). absl::InfiniteFuture()
+  // stands for no deadline.
   template <typename T>
-  absl::Status AddPacketToInputStreamInternal(absl::string_view stream_name,
-                                              T&& packet);
+  absl::Status AddPacketToInputStreamInternal(
+      absl::string_view stream_name, T&& packet,
+      absl::Time deadline = absl::InfiniteFuture());
 
   // Sets the executor that will run the nodes assigned to the executor
   // named |name|.  If |name| is empty, this sets the default executor.
@@ -589,6 +606,7 @@ class CalculatorGraph {
   static bool IsReservedExecutorName(const std::string& name);
 
   // Helper functions for Initialize().
+  absl::Status InitializeCpuThreadBudget();
   absl::Status InitializeExecutors();
   absl::Status InitializePacketGeneratorGraph(
       const std::map<std::string, Packet>& side_packets);
@@ -730,6 +748,9 @@ class CalculatorGraph {
   // executor's name is the empty string.
   std::map<std::string, std::shared_ptr<Executor>> executors_;
 
+  // Threads of the default executor drawn from the CPU thread budget, if any.
+  CpuThreadBudget::Reservation default_executor_thread_reservation_;
+
   // The processed input side packet map for this run.
   std::map<std::string, Packet> current_run_side_packets_;
 
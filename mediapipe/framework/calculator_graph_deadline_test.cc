@@ -0,0 +1,138 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<Timestamp> PacketTimestamps(const std::vector<Packet>& packets) {
+  std::vector<Timestamp> timestamps;
+  for (const Packet& packet : packets) {
+    timestamps.push_back(packet.Timestamp());
+  }
+  return timestamps;
+}
+
+CalculatorGraphConfig DroppingGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    node {
+      name: "dropper"
+      calculator: "PassThroughCalculator"
+      input_stream: "in"
+      output_stream: "fresh"
+      drop_inputs_past_deadline: true
+    }
+    node {
+      name: "consumer"
+      calculator: "PassThroughCalculator"
+      input_stream: "fresh"
+      output_stream: "out"
+    }
+  )pb");
+}
+
+TEST(CalculatorGraphDeadlineTest, DropsInputsPastDeadline) {
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(DroppingGraphConfig()));
+  std::vector<Packet> outputs;
+  MP_ASSERT_OK(graph.ObserveOutputStream("out", [&outputs](const Packet& p) {
+    outputs.push_back(p);
+    return absl::OkStatus();
+  }));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "in", MakePacket<int>(1).At(Timestamp(1)), absl::InfinitePast()));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "in", MakePacket<int>(2).At(Timestamp(2)),
+      absl::Now() + absl::Hours(1)));
+  MP_ASSERT_OK(
+      graph.AddPacketToInputStream("in", MakePacket<int>(3).At(Timestamp(3))));
+  // The dropped timestamp must not hold back the consumer.
+  MP_ASSERT_OK(graph.WaitUntilIdle());
+  EXPECT_THAT(PacketTimestamps(outputs),
+              ElementsAre(Timestamp(2), Timestamp(3)));
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  EXPECT_EQ(graph.GetCounterFactory()
+                ->GetCounter("dropper-DroppedPastDeadline")
+                ->Get(),
+            1);
+}
+
+TEST(CalculatorGraphDeadlineTest, IgnoresDeadlineOfPacketsNotAdded) {
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(DroppingGraphConfig()));
+  std::vector<Packet> outputs;
+  MP_ASSERT_OK(graph.ObserveOutputStream("out", [&outputs](const Packet& p) {
+    outputs.push_back(p);
+    return absl::OkStatus();
+  }));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  // Fails as "missing" is not a graph input stream.
+  EXPECT_FALSE(graph
+                   .AddPacketToInputStream(
+                       "missing", MakePacket<int>(1).At(Timestamp(1)),
+                       absl::InfinitePast())
+                   .ok());
+  // The deadline of the rejected packet must not apply to timestamp 1.
+  MP_ASSERT_OK(
+      graph.AddPacketToInputStream("in", MakePacket<int>(1).At(Timestamp(1))));
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  EXPECT_THAT(PacketTimestamps(outputs), ElementsAre(Timestamp(1)));
+  EXPECT_EQ(graph.GetCounterFactory()
+                ->GetCounter("dropper-DroppedPastDeadline")
+                ->Get(),
+            0);
+}
+
+TEST(CalculatorGraphDeadlineTest, KeepsInputsPastDeadlineByDefault) {
+  CalculatorGraphConfig config = DroppingGraphConfig();
+  config.mutable_node(0)->clear_drop_inputs_past_deadline();
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  std::vector<Packet> outputs;
+  MP_ASSERT_OK(graph.ObserveOutputStream("out", [&outputs](const Packet& p) {
+    outputs.push_back(p);
+    return absl::OkStatus();
+  }));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "in", MakePacket<int>(1).At(Timestamp(1)), absl::InfinitePast()));
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  EXPECT_THAT(PacketTimestamps(outputs), ElementsAre(Timestamp(1)));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -43,8 +43,11 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/collection_item_id.h"
 #include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/cpu_thread_budget_service.h"
 #include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/graph_runtime_info.pb.h"
 #include "mediapipe/framework/lifetime_tracker.h"
 #include "mediapipe/framework/mediapipe_options.pb.h"
 #include "mediapipe/framework/output_stream_poller.h"
@@ -4406,6 +4409,95 @@ TEST(CalculatorGraph, RunWithNumThreadsInExecutorConfig) {
   }
 }
 
+TEST(CalculatorGraph, DefaultExecutorDrawsFromCpuThreadBudget) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: 'in'
+        cpu_thread_budget { enable: true num_threads: 3 }
+        executor {
+          options {
+            [mediapipe.ThreadPoolExecutorOptions.ext] { num_threads: 8 }
+          }
+        }
+        node {
+          calculator: 'PassThroughCalculator'
+          input_stream: 'in'
+          output_stream: 'out'
+        }
+      )pb");
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+
+  MP_ASSERT_OK_AND_ASSIGN(GraphRuntimeInfo info, graph.GetGraphRuntimeInfo());
+  const CpuThreadBudgetRuntimeInfo& budget_info = info.cpu_thread_budget();
+  EXPECT_EQ(budget_info.num_threads(), 3);
+  EXPECT_EQ(budget_info.num_available_threads(), 0);
+  ASSERT_EQ(budget_info.reservations_size(), 1);
+  EXPECT_EQ(budget_info.reservations(0).owner(), "default executor");
+  EXPECT_EQ(budget_info.reservations(0).requested_threads(), 8);
+  EXPECT_EQ(budget_info.reservations(0).granted_threads(), 3);
+}
+
+TEST(CalculatorGraph, AutomaticDefaultExecutorLeavesCpuThreadBudget) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: 'in'
+        cpu_thread_budget { enable: true num_threads: 4 }
+        node {
+          calculator: 'PassThroughCalculator'
+          input_stream: 'in'
+          output_stream: 'a'
+        }
+        node {
+          calculator: 'PassThroughCalculator'
+          input_stream: 'a'
+          output_stream: 'b'
+        }
+        node {
+          calculator: 'PassThroughCalculator'
+          input_stream: 'b'
+          output_stream: 'c'
+        }
+        node {
+          calculator: 'PassThroughCalculator'
+          input_stream: 'c'
+          output_stream: 'out'
+        }
+      )pb");
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+
+  // Without an explicit num_threads, the executor leaves half of the budget
+  // to the inference delegates called from its threads.
+  MP_ASSERT_OK_AND_ASSIGN(GraphRuntimeInfo info, graph.GetGraphRuntimeInfo());
+  const CpuThreadBudgetRuntimeInfo& budget_info = info.cpu_thread_budget();
+  ASSERT_EQ(budget_info.reservations_size(), 1);
+  EXPECT_LE(budget_info.reservations(0).granted_threads(), 2);
+  EXPECT_GE(budget_info.num_available_threads(), 2);
+}
+
+TEST(CalculatorGraph, UsesCpuThreadBudgetProvidedByApplication) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: 'in'
+        num_threads: 2
+        node {
+          calculator: 'PassThroughCalculator'
+          input_stream: 'in'
+          output_stream: 'out'
+        }
+      )pb");
+  auto budget = std::make_shared<CpuThreadBudget>(/*num_threads=*/5);
+  {
+    CalculatorGraph graph;
+    MP_ASSERT_OK(graph.SetServiceObject(kCpuThreadBudgetService, budget));
+    MP_ASSERT_OK(graph.Initialize(config));
+    EXPECT_EQ(budget->num_available_threads(), 3);
+  }
+  // The threads are returned to the budget once the graph is destroyed.
+  EXPECT_EQ(budget->num_available_threads(), 5);
+}
+
 TEST(CalculatorGraph, CalculatorGraphNotInitialized) {
   CalculatorGraph graph;
   EXPECT_FALSE(graph.Run().ok());
@@ -166,6 +166,7 @@ absl::Status CalculatorNode::Initialize(
     executor_ = node_config->executor();
   }
   source_layer_ = node_config->source_layer();
+  drop_inputs_past_deadline_ = node_config->drop_inputs_past_deadline();
 
   const CalculatorContract& contract = node_type_info_->Contract();
 
@@ -523,6 +524,15 @@ bool CalculatorNode::OutputsAreConstant(CalculatorContext* cc) {
   return true;
 }
 
+bool CalculatorNode::InputDeadlinePassed(Timestamp input_timestamp) const {
+  if (!drop_inputs_past_deadline_ || deadline_table_ == nullptr) {
+    return false;
+  }
+  const absl::Time deadline = deadline_table_->GetDeadline(input_timestamp);
+  return deadline != absl::InfiniteFuture() &&
+         deadline < Clock::RealClock()->TimeNow();
+}
+
 absl::Status CalculatorNode::OpenNode() {
   VLOG(2) << "CalculatorNode::OpenNode() for " << DebugName();
 
@@ -920,6 +930,17 @@ absl::Status CalculatorNode::ProcessNode(
         if (OutputsAreConstant(calculator_context)) {
           // Do nothing.
           result = absl::OkStatus();
+        } else if (InputDeadlinePassed(input_timestamp)) {
+          VLOG(2) << "Dropping inputs past their deadline for node: "
+                  << DebugName() << " timestamp: " << input_timestamp;
+          calculator_state_->GetCounter("DroppedPastDeadline")->Increment();
+          // Downstream nodes must not wait for outputs at this timestamp.
+          for (CollectionItemId id = outputs->BeginId(); id < outputs->EndId();
+               ++id) {
+            outputs->Get(id).SetNextTimestampBound(
+                input_timestamp.NextAllowedInStream());
+          }
+          result = absl::OkStatus();
         } else {
           MEDIAPIPE_PROFILING(PROCESS, calculator_context);
           LegacyCalculatorSupport::Scoped<CalculatorContext> s(
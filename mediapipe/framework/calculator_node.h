@@ -37,6 +37,7 @@
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/calculator_context_manager.h"
 #include "mediapipe/framework/calculator_state.h"
+#include "mediapipe/framework/deadline_table.h"
 #include "mediapipe/framework/graph_runtime_info.pb.h"
 #include "mediapipe/framework/graph_service_manager.h"
 #include "mediapipe/framework/input_side_packet_handler.h"
@@ -208,6 +209,11 @@ class CalculatorNode {
   void SetSchedulerQueue(internal::SchedulerQueue* queue) {
     scheduler_queue_ = queue;
   }
+  // Sets the deadlines of the input timestamps, used to drop stale inputs
+  // when the node config sets drop_inputs_past_deadline.
+  void SetDeadlineTable(const internal::DeadlineTable* deadline_table) {
+    deadline_table_ = deadline_table;
+  }
 
   // Sets callbacks in the scheduler that should be invoked when an input queue
   // becomes full/non-full.
@@ -299,6 +305,10 @@ class CalculatorNode {
   // Returns true if all outputs will be identical to the previous graph run.
   bool OutputsAreConstant(CalculatorContext* cc);
 
+  // Returns true if Process() should be skipped for `input_timestamp` because
+  // its deadline has passed.
+  bool InputDeadlinePassed(Timestamp input_timestamp) const;
+
   // The calculator.
   std::unique_ptr<CalculatorBase> calculator_;
   // Keeps data which a Calculator subclass needs access to.
@@ -323,6 +333,8 @@ class CalculatorNode {
 
   // The max number of invocations that can be scheduled in parallel.
   int max_in_flight_ = 1;
+  // Whether Process() is skipped for inputs past their deadline.
+  bool drop_inputs_past_deadline_ = false;
   // The following two variables are used for the concurrency control of node
   // scheduling.
   //
@@ -384,6 +396,8 @@ class CalculatorNode {
 
   internal::SchedulerQueue* scheduler_queue_ = nullptr;
 
+  const internal::DeadlineTable* deadline_table_ = nullptr;
+
   const ValidatedGraphConfig* validated_graph_ = nullptr;
 
   const NodeTypeInfo* node_type_info_ = nullptr;
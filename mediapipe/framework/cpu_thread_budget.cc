@@ -0,0 +1,137 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/cpu_thread_budget.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/util/cpu_util.h"
+
+namespace mediapipe {
+
+struct CpuThreadBudget::Reservation::State {
+  explicit State(int num_threads) : num_threads(num_threads) {}
+
+  const int num_threads;
+  absl::Mutex mutex;
+  int num_charged_threads ABSL_GUARDED_BY(mutex) = 0;
+  int next_id ABSL_GUARDED_BY(mutex) = 0;
+  // Keyed by increasing id, i.e. in reservation order.
+  absl::btree_map<int, ReservationInfo> reservations ABSL_GUARDED_BY(mutex);
+};
+
+CpuThreadBudget::Reservation::Reservation(std::shared_ptr<State> state, int id,
+                                          int num_threads)
+    : state_(std::move(state)), id_(id), num_threads_(num_threads) {}
+
+CpuThreadBudget::Reservation::~Reservation() { Release(); }
+
+CpuThreadBudget::Reservation::Reservation(Reservation&& other)
+    : state_(std::move(other.state_)),
+      id_(std::exchange(other.id_, -1)),
+      num_threads_(std::exchange(other.num_threads_, 0)) {}
+
+CpuThreadBudget::Reservation& CpuThreadBudget::Reservation::operator=(
+    Reservation&& other) {
+  if (this != &other) {
+    Release();
+    state_ = std::move(other.state_);
+    id_ = std::exchange(other.id_, -1);
+    num_threads_ = std::exchange(other.num_threads_, 0);
+  }
+  return *this;
+}
+
+void CpuThreadBudget::Reservation::Release() {
+  if (state_ == nullptr) return;
+  {
+    absl::MutexLock lock(&state_->mutex);
+    auto it = state_->reservations.find(id_);
+    if (it != state_->reservations.end()) {
+      state_->num_charged_threads -= it->second.charged_threads;
+      state_->reservations.erase(it);
+    }
+  }
+  state_ = nullptr;
+  id_ = -1;
+  num_threads_ = 0;
+}
+
+CpuThreadBudget::CpuThreadBudget(int num_threads)
+    : state_(std::make_shared<Reservation::State>(
+          num_threads > 0 ? num_threads : NumCPUCores())) {}
+
+int CpuThreadBudget::num_threads() const { return state_->num_threads; }
+
+int CpuThreadBudget::num_available_threads() const {
+  absl::MutexLock lock(&state_->mutex);
+  return std::max(state_->num_threads - state_->num_charged_threads, 0);
+}
+
+CpuThreadBudget::Reservation CpuThreadBudget::Reserve(
+    absl::string_view owner, int requested_threads) {
+  return ReserveInternal(owner, requested_threads,
+                         /*includes_calling_thread=*/false);
+}
+
+CpuThreadBudget::Reservation CpuThreadBudget::ReserveWithCallingThread(
+    absl::string_view owner, int requested_threads) {
+  return ReserveInternal(owner, requested_threads,
+                         /*includes_calling_thread=*/true);
+}
+
+CpuThreadBudget::Reservation CpuThreadBudget::ReserveInternal(
+    absl::string_view owner, int requested_threads,
+    bool includes_calling_thread) {
+  requested_threads = std::max(requested_threads, 1);
+  absl::MutexLock lock(&state_->mutex);
+  const int available =
+      std::max(state_->num_threads - state_->num_charged_threads, 0);
+  ReservationInfo info;
+  info.owner = std::string(owner);
+  info.requested_threads = requested_threads;
+  if (includes_calling_thread) {
+    info.charged_threads = std::min(requested_threads - 1, available);
+    info.granted_threads = info.charged_threads + 1;
+  } else {
+    info.granted_threads = std::max(std::min(requested_threads, available), 1);
+    info.charged_threads = info.granted_threads;
+  }
+  state_->num_charged_threads += info.charged_threads;
+  const int id = state_->next_id++;
+  const int granted_threads = info.granted_threads;
+  state_->reservations.emplace(id, std::move(info));
+  return Reservation(state_, id, granted_threads);
+}
+
+std::vector<CpuThreadBudget::ReservationInfo>
+CpuThreadBudget::GetReservations() const {
+  absl::MutexLock lock(&state_->mutex);
+  std::vector<ReservationInfo> reservations;
+  reservations.reserve(state_->reservations.size());
+  for (const auto& [id, info] : state_->reservations) {
+    reservations.push_back(info);
+  }
+  return reservations;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,109 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_CPU_THREAD_BUDGET_H_
+#define MEDIAPIPE_FRAMEWORK_CPU_THREAD_BUDGET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace mediapipe {
+
+// Number of CPU threads shared by all thread pools of a graph: the executors
+// running calculators, the private pools of CPU inference delegates such as
+// XNNPACK or LiteRT, and those of TfLite interpreters. Without a shared budget,
+// every inference node sizes its pools as if it had the machine to itself,
+// which oversubscribes the cores of graphs with several models.
+//
+// Thread pools reserve their threads when they are created and release them
+// when the returned Reservation is destroyed. Reservations never block: once
+// the budget is exhausted, pools are granted the minimum needed to make
+// progress.
+//
+// Thread-safe.
+class CpuThreadBudget {
+ public:
+  // Describes a live reservation.
+  struct ReservationInfo {
+    std::string owner;
+    int requested_threads = 0;
+    int granted_threads = 0;
+    // Threads charged to the budget. Lower than granted_threads for pools
+    // running work on the calling thread, see ReserveWithCallingThread().
+    int charged_threads = 0;
+  };
+
+  // Movable handle releasing the reserved threads upon destruction.
+  class Reservation {
+   public:
+    Reservation() = default;
+    ~Reservation();
+    Reservation(Reservation&& other);
+    Reservation& operator=(Reservation&& other);
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+    // Number of threads the owner may use.
+    int num_threads() const { return num_threads_; }
+
+   private:
+    friend class CpuThreadBudget;
+    struct State;
+
+    Reservation(std::shared_ptr<State> state, int id, int num_threads);
+    void Release();
+
+    std::shared_ptr<State> state_;
+    int id_ = -1;
+    int num_threads_ = 0;
+  };
+
+  // Creates a budget of `num_threads` threads. Non-positive values use the
+  // number of CPU cores.
+  explicit CpuThreadBudget(int num_threads = 0);
+
+  // Total number of threads in the budget.
+  int num_threads() const;
+
+  // Number of threads not reserved yet.
+  int num_available_threads() const;
+
+  // Reserves up to `requested_threads` threads for a dedicated pool, e.g. an
+  // executor. At least one thread is granted.
+  Reservation Reserve(absl::string_view owner, int requested_threads);
+
+  // Reserves threads for a pool which also runs work on the thread calling
+  // into it, e.g. an inference delegate invoked from an executor thread. The
+  // calling thread is already accounted for, so only the additional threads
+  // are charged. The granted count includes the calling thread and hence is at
+  // least one.
+  Reservation ReserveWithCallingThread(absl::string_view owner,
+                                       int requested_threads);
+
+  // Returns the live reservations in the order they were made.
+  std::vector<ReservationInfo> GetReservations() const;
+
+ private:
+  Reservation ReserveInternal(absl::string_view owner, int requested_threads,
+                              bool includes_calling_thread);
+
+  std::shared_ptr<Reservation::State> state_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_CPU_THREAD_BUDGET_H_
@@ -0,0 +1,32 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_CPU_THREAD_BUDGET_SERVICE_H_
+#define MEDIAPIPE_FRAMEWORK_CPU_THREAD_BUDGET_SERVICE_H_
+
+#include "mediapipe/framework/cpu_thread_budget.h"
+#include "mediapipe/framework/graph_service.h"
+
+namespace mediapipe {
+
+// Graph service providing the CPU thread budget shared by the graph's
+// executors and CPU inference delegates. Set up by CalculatorGraph from
+// CalculatorGraphConfig::cpu_thread_budget, or provided by the application,
+// e.g. to share one budget between several graphs.
+inline constexpr GraphService<CpuThreadBudget> kCpuThreadBudgetService(
+    "CpuThreadBudgetService", GraphServiceBase::kDisallowDefaultInitialization);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_CPU_THREAD_BUDGET_SERVICE_H_
@@ -0,0 +1,102 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/cpu_thread_budget.h"
+
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(CpuThreadBudgetTest, DefaultsToAtLeastOneThread) {
+  CpuThreadBudget budget;
+  EXPECT_GE(budget.num_threads(), 1);
+  EXPECT_EQ(budget.num_available_threads(), budget.num_threads());
+}
+
+TEST(CpuThreadBudgetTest, ReserveGrantsRemainingThreads) {
+  CpuThreadBudget budget(/*num_threads=*/6);
+  CpuThreadBudget::Reservation executor = budget.Reserve("executor", 4);
+  EXPECT_EQ(executor.num_threads(), 4);
+  EXPECT_EQ(budget.num_available_threads(), 2);
+
+  CpuThreadBudget::Reservation other = budget.Reserve("other", 4);
+  EXPECT_EQ(other.num_threads(), 2);
+  EXPECT_EQ(budget.num_available_threads(), 0);
+
+  // An exhausted budget still grants one thread to make progress.
+  CpuThreadBudget::Reservation last = budget.Reserve("last", 4);
+  EXPECT_EQ(last.num_threads(), 1);
+  EXPECT_EQ(budget.num_available_threads(), 0);
+}
+
+TEST(CpuThreadBudgetTest, ReserveWithCallingThreadChargesAdditionalThreads) {
+  CpuThreadBudget budget(/*num_threads=*/4);
+  CpuThreadBudget::Reservation executor = budget.Reserve("executor", 2);
+
+  CpuThreadBudget::Reservation delegate =
+      budget.ReserveWithCallingThread("delegate", 2);
+  EXPECT_EQ(delegate.num_threads(), 2);
+  EXPECT_EQ(budget.num_available_threads(), 1);
+
+  CpuThreadBudget::Reservation other =
+      budget.ReserveWithCallingThread("other", 4);
+  EXPECT_EQ(other.num_threads(), 2);
+  EXPECT_EQ(budget.num_available_threads(), 0);
+
+  // Without budget left, the delegate runs on the calling thread only.
+  CpuThreadBudget::Reservation last =
+      budget.ReserveWithCallingThread("last", 4);
+  EXPECT_EQ(last.num_threads(), 1);
+}
+
+TEST(CpuThreadBudgetTest, ReleasesThreadsOnDestruction) {
+  CpuThreadBudget budget(/*num_threads=*/4);
+  {
+    CpuThreadBudget::Reservation reservation = budget.Reserve("executor", 3);
+    EXPECT_EQ(budget.num_available_threads(), 1);
+    CpuThreadBudget::Reservation moved = std::move(reservation);
+    EXPECT_EQ(moved.num_threads(), 3);
+    EXPECT_EQ(reservation.num_threads(), 0);  // NOLINT
+    EXPECT_EQ(budget.num_available_threads(), 1);
+  }
+  EXPECT_EQ(budget.num_available_threads(), 4);
+  EXPECT_TRUE(budget.GetReservations().empty());
+}
+
+TEST(CpuThreadBudgetTest, ListsReservationsInOrder) {
+  CpuThreadBudget budget(/*num_threads=*/4);
+  CpuThreadBudget::Reservation first = budget.Reserve("first", 2);
+  CpuThreadBudget::Reservation second =
+      budget.ReserveWithCallingThread("second", 8);
+
+  const std::vector<CpuThreadBudget::ReservationInfo> reservations =
+      budget.GetReservations();
+  ASSERT_EQ(reservations.size(), 2);
+  EXPECT_EQ(reservations[0].owner, "first");
+  EXPECT_EQ(reservations[0].requested_threads, 2);
+  EXPECT_EQ(reservations[0].granted_threads, 2);
+  EXPECT_EQ(reservations[0].charged_threads, 2);
+  EXPECT_EQ(reservations[1].owner, "second");
+  EXPECT_EQ(reservations[1].requested_threads, 8);
+  EXPECT_EQ(reservations[1].granted_threads, 3);
+  EXPECT_EQ(reservations[1].charged_threads, 2);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,54 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deadline_table.h"
+
+#include <algorithm>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace internal {
+
+void DeadlineTable::SetDeadline(Timestamp timestamp, absl::Time deadline) {
+  absl::MutexLock lock(mutex_);
+  auto [it, inserted] = deadlines_.emplace(timestamp, deadline);
+  if (!inserted) {
+    it->second = std::min(it->second, deadline);
+  }
+  while (deadlines_.size() > kMaxEntries) {
+    deadlines_.erase(deadlines_.begin());
+  }
+  empty_.store(false, std::memory_order_release);
+}
+
+absl::Time DeadlineTable::GetDeadline(Timestamp timestamp) const {
+  if (empty_.load(std::memory_order_acquire)) {
+    return absl::InfiniteFuture();
+  }
+  absl::MutexLock lock(mutex_);
+  auto it = deadlines_.find(timestamp);
+  return it == deadlines_.end() ? absl::InfiniteFuture() : it->second;
+}
+
+void DeadlineTable::Clear() {
+  absl::MutexLock lock(mutex_);
+  deadlines_.clear();
+  empty_.store(true, std::memory_order_release);
+}
+
+}  // namespace internal
+}  // namespace mediapipe
@@ -0,0 +1,64 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_DEADLINE_TABLE_H_
+#define MEDIAPIPE_FRAMEWORK_DEADLINE_TABLE_H_
+
+#include <atomic>
+#include <map>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace internal {
+
+// Maps input timestamps to the wall-clock time by which the graph should have
+// finished processing them. The scheduler runs tasks for earlier deadlines
+// first, and nodes can drop inputs whose deadline has passed.
+//
+// Only the most recent kMaxEntries timestamps are remembered: older entries
+// belong to frames which have long been dropped or output.
+//
+// Thread-safe.
+class DeadlineTable {
+ public:
+  static constexpr int kMaxEntries = 1024;
+
+  // Sets the deadline of `timestamp`. If the timestamp already has a deadline,
+  // e.g. because it was set for several graph input streams, the earliest
+  // deadline is kept.
+  void SetDeadline(Timestamp timestamp, absl::Time deadline)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the deadline of `timestamp`, or absl::InfiniteFuture() if it has
+  // none.
+  absl::Time GetDeadline(Timestamp timestamp) const ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Forgets all deadlines, at the beginning of each graph run.
+  void Clear() ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  // Lets GetDeadline() skip the mutex for graphs which don't use deadlines.
+  std::atomic<bool> empty_{true};
+  mutable absl::Mutex mutex_;
+  std::map<Timestamp, absl::Time> deadlines_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_DEADLINE_TABLE_H_
@@ -0,0 +1,55 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deadline_table.h"
+
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace internal {
+namespace {
+
+TEST(DeadlineTableTest, KeepsEarliestDeadline) {
+  const absl::Time now = absl::Now();
+  DeadlineTable table;
+  EXPECT_EQ(table.GetDeadline(Timestamp(1)), absl::InfiniteFuture());
+
+  table.SetDeadline(Timestamp(1), now + absl::Seconds(2));
+  table.SetDeadline(Timestamp(1), now + absl::Seconds(1));
+  table.SetDeadline(Timestamp(1), now + absl::Seconds(3));
+  table.SetDeadline(Timestamp(2), now);
+  EXPECT_EQ(table.GetDeadline(Timestamp(1)), now + absl::Seconds(1));
+  EXPECT_EQ(table.GetDeadline(Timestamp(2)), now);
+  EXPECT_EQ(table.GetDeadline(Timestamp(3)), absl::InfiniteFuture());
+
+  table.Clear();
+  EXPECT_EQ(table.GetDeadline(Timestamp(1)), absl::InfiniteFuture());
+}
+
+TEST(DeadlineTableTest, ForgetsOldestTimestamps) {
+  const absl::Time now = absl::Now();
+  DeadlineTable table;
+  for (int i = 0; i <= DeadlineTable::kMaxEntries; ++i) {
+    table.SetDeadline(Timestamp(i), now);
+  }
+  EXPECT_EQ(table.GetDeadline(Timestamp(0)), absl::InfiniteFuture());
+  EXPECT_EQ(table.GetDeadline(Timestamp(1)), now);
+  EXPECT_EQ(table.GetDeadline(Timestamp(DeadlineTable::kMaxEntries)), now);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace mediapipe
@@ -0,0 +1,62 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/port/aligned_malloc_and_free.h"  // IWYU pragma: keep
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+
+absl::StatusOr<std::unique_ptr<CpuBuffer>> CpuBuffer::Create(
+    const CpuBufferSpec& spec) {
+  void* data = nullptr;
+  if (spec.alignment > 0) {
+    data = aligned_malloc(
+        std::max(spec.size, static_cast<size_t>(spec.alignment)),
+        spec.alignment);
+  } else {
+    data = malloc(spec.size);
+  }
+  RET_CHECK(data != nullptr) << "Failed to allocate " << spec;
+  return absl::WrapUnique(new CpuBuffer(data, spec));
+}
+
+CpuBuffer::~CpuBuffer() {
+  if (spec_.alignment > 0) {
+    aligned_free(data_);
+  } else {
+    free(data_);
+  }
+}
+
+absl::StatusOr<std::shared_ptr<CpuBuffer>> CpuBufferPool::GetBuffer(
+    const CpuBufferSpec& spec) {
+  ABSL_ASSIGN_OR_RETURN(std::shared_ptr<CpuBuffer> buffer, Get(spec));
+  if (buffer->TakeReused()) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return buffer;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,147 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_CPU_BUFFER_POOL_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_CPU_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/gpu/multi_pool.h"
+#include "mediapipe/gpu/reusable_pool.h"
+
+namespace mediapipe {
+
+// Size and alignment of a pooled CPU buffer. Buffers with identical specs are
+// interchangeable.
+struct CpuBufferSpec {
+  size_t size = 0;
+  // Minimum alignment in bytes, a power of 2. 0 means malloc's default.
+  int alignment = 0;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const CpuBufferSpec& spec) {
+    return H::combine(std::move(h), spec.size, spec.alignment);
+  }
+};
+
+inline bool operator==(const CpuBufferSpec& lhs, const CpuBufferSpec& rhs) {
+  return lhs.size == rhs.size && lhs.alignment == rhs.alignment;
+}
+inline bool operator!=(const CpuBufferSpec& lhs, const CpuBufferSpec& rhs) {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const CpuBufferSpec& spec) {
+  return os << "CpuBufferSpec{size: " << spec.size
+            << ", alignment: " << spec.alignment << "}";
+}
+
+// Owns a block of CPU memory allocated according to a CpuBufferSpec.
+class CpuBuffer {
+ public:
+  static absl::StatusOr<std::unique_ptr<CpuBuffer>> Create(
+      const CpuBufferSpec& spec);
+  ~CpuBuffer();
+
+  CpuBuffer(const CpuBuffer&) = delete;
+  CpuBuffer& operator=(const CpuBuffer&) = delete;
+
+  void* data() const { return data_; }
+  const CpuBufferSpec& spec() const { return spec_; }
+
+  // Called by ReusablePool when the buffer is handed out again.
+  void Reuse() { reused_ = true; }
+
+  // Returns whether the buffer was recycled by the pool since the last call.
+  bool TakeReused() { return std::exchange(reused_, false); }
+
+ private:
+  CpuBuffer(void* data, const CpuBufferSpec& spec) : data_(data), spec_(spec) {}
+
+  void* data_;
+  CpuBufferSpec spec_;
+  bool reused_ = false;
+};
+
+namespace internal {
+
+// Pools CpuBuffers with identical CpuBufferSpec.
+class CpuBufferSpecPool : public ReusablePool<CpuBuffer> {
+ public:
+  static std::shared_ptr<CpuBufferSpecPool> Create(
+      const CpuBufferSpec& spec, const MultiPoolOptions& options) {
+    return std::shared_ptr<CpuBufferSpecPool>(
+        new CpuBufferSpecPool(spec, options));
+  }
+  static absl::StatusOr<std::unique_ptr<CpuBuffer>> CreateBufferWithoutPool(
+      const CpuBufferSpec& spec) {
+    return CpuBuffer::Create(spec);
+  }
+  const CpuBufferSpec& spec() const { return spec_; }
+
+ protected:
+  CpuBufferSpecPool(const CpuBufferSpec& spec, const MultiPoolOptions& options)
+      : ReusablePool<CpuBuffer>(
+            [this] { return CreateBufferWithoutPool(spec_); }, options),
+        spec_(spec) {}
+
+  const CpuBufferSpec spec_;
+};
+
+}  // namespace internal
+
+// Pools CPU buffers by size and alignment, e.g. for Tensor CPU storage. A
+// buffer is returned to the pool when the last reference to it is dropped.
+class CpuBufferPool
+    : public MultiPool<internal::CpuBufferSpecPool, CpuBufferSpec,
+                       std::shared_ptr<CpuBuffer>> {
+ public:
+  struct Stats {
+    // Requests served by recycling a previously returned buffer.
+    int64_t hits = 0;
+    // Requests which required a new allocation.
+    int64_t misses = 0;
+  };
+
+  CpuBufferPool() = default;
+
+  explicit CpuBufferPool(const MultiPoolOptions& options)
+      : MultiPool<internal::CpuBufferSpecPool, CpuBufferSpec,
+                  std::shared_ptr<CpuBuffer>>(options) {}
+
+  absl::StatusOr<std::shared_ptr<CpuBuffer>> GetBuffer(
+      const CpuBufferSpec& spec);
+
+  // Returns allocation counters accumulated since construction. In steady
+  // state, e.g. a video pipeline processing same-sized frames, misses should
+  // stop growing.
+  Stats GetStats() const {
+    return {hits_.load(std::memory_order_relaxed),
+            misses_.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  std::atomic<int64_t> hits_ = 0;
+  std::atomic<int64_t> misses_ = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_CPU_BUFFER_POOL_H_
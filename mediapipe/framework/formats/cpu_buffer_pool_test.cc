@@ -0,0 +1,81 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/gpu/multi_pool.h"
+
+namespace mediapipe {
+namespace {
+
+MultiPoolOptions PoolFromFirstRequestOptions() {
+  MultiPoolOptions options;
+  options.min_requests_before_pool = 0;
+  return options;
+}
+
+TEST(CpuBufferPoolTest, AllocatesAlignedBuffers) {
+  CpuBufferPool pool;
+  MP_ASSERT_OK_AND_ASSIGN(auto buffer,
+                          pool.GetBuffer({.size = 100, .alignment = 64}));
+  ASSERT_NE(buffer->data(), nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer->data()) % 64, 0);
+}
+
+TEST(CpuBufferPoolTest, RecyclesReleasedBuffersWithSameSpec) {
+  CpuBufferPool pool(PoolFromFirstRequestOptions());
+  const CpuBufferSpec spec = {.size = 256, .alignment = 16};
+  void* data = nullptr;
+  {
+    MP_ASSERT_OK_AND_ASSIGN(auto buffer, pool.GetBuffer(spec));
+    data = buffer->data();
+  }
+  MP_ASSERT_OK_AND_ASSIGN(auto buffer, pool.GetBuffer(spec));
+  EXPECT_EQ(buffer->data(), data);
+
+  const CpuBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+}
+
+TEST(CpuBufferPoolTest, DoesNotShareBuffersInUse) {
+  CpuBufferPool pool(PoolFromFirstRequestOptions());
+  const CpuBufferSpec spec = {.size = 64, .alignment = 0};
+  MP_ASSERT_OK_AND_ASSIGN(auto buffer1, pool.GetBuffer(spec));
+  MP_ASSERT_OK_AND_ASSIGN(auto buffer2, pool.GetBuffer(spec));
+  EXPECT_NE(buffer1->data(), buffer2->data());
+  EXPECT_EQ(pool.GetStats().misses, 2);
+  EXPECT_EQ(pool.GetStats().hits, 0);
+}
+
+TEST(CpuBufferPoolTest, KeepsDifferentSpecsSeparate) {
+  CpuBufferPool pool(PoolFromFirstRequestOptions());
+  {
+    MP_ASSERT_OK_AND_ASSIGN(auto buffer,
+                            pool.GetBuffer({.size = 64, .alignment = 0}));
+  }
+  MP_ASSERT_OK_AND_ASSIGN(auto buffer,
+                          pool.GetBuffer({.size = 128, .alignment = 0}));
+  EXPECT_EQ(buffer->spec().size, 128);
+  EXPECT_EQ(pool.GetStats().misses, 2);
+  EXPECT_EQ(pool.GetStats().hits, 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
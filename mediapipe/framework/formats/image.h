@@ -16,6 +16,7 @@
 #define MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_H_
 
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 #include "absl/synchronization/mutex.h"
@@ -77,6 +78,15 @@ class Image {
     use_gpu_ = false;
   }
 
+  // Creates an Image backed by a CPU-resident GpuBuffer storage other than
+  // ImageFrame, e.g. GpuBufferStorageYuvImage. The image stays on the CPU, so
+  // calculators can read it through views such as FrameBuffer without first
+  // converting it to an ImageFrame.
+  explicit Image(std::shared_ptr<internal::GpuBufferStorage> cpu_storage)
+      : gpu_buffer_(std::move(cpu_storage)) {
+    use_gpu_ = false;
+  }
+
   // CPU getters.
   ImageFrameSharedPtr GetImageFrameSharedPtr() const {
     // Write view currently because the return type does not point to const IF.
@@ -455,6 +455,8 @@ void Tensor::Move(Tensor* src) {
   element_type_ = src->element_type();
   src->element_type_ = ElementType::kNone;  // Mark as invalidated.
   cpu_buffer_ = std::exchange(src->cpu_buffer_, nullptr);
+  cpu_buffer_pool_ = std::move(src->cpu_buffer_pool_);
+  pooled_cpu_buffer_ = std::move(src->pooled_cpu_buffer_);
   ahwb_tracking_key_ = src->ahwb_tracking_key_;
   mtl_resources_ = std::move(src->mtl_resources_);
   MoveAhwbStuff(src);
@@ -486,6 +488,9 @@ Tensor::Tensor(ElementType element_type, const Shape& shape,
       shape_(shape),
       memory_alignment_(memory_alignment),
       mtl_resources_(std::make_unique<MtlResources>()) {
+  if (memory_manager) {
+    cpu_buffer_pool_ = memory_manager->GetCpuBufferPool();
+  }
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   if (memory_manager) {
     hardware_buffer_pool_ = memory_manager->GetAndroidHardwareBufferPool();
@@ -501,6 +506,9 @@ Tensor::Tensor(ElementType element_type, const Shape& shape,
       quantization_parameters_(quantization_parameters),
       memory_alignment_(memory_alignment),
       mtl_resources_(std::make_unique<MtlResources>()) {
+  if (memory_manager) {
+    cpu_buffer_pool_ = memory_manager->GetCpuBufferPool();
+  }
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   if (memory_manager) {
     hardware_buffer_pool_ = memory_manager->GetAndroidHardwareBufferPool();
@@ -786,14 +794,25 @@ absl::Status Tensor::AllocateCpuBuffer() const {
     // memory page which should match common alignment requirements.
     cpu_buffer_ = AllocateVirtualMemory(bytes());
 #else
-    if (memory_alignment_ > 0) {
+    if (cpu_buffer_pool_) {
+      // TfLite custom allocation requires at least memory_alignment_ bytes.
+      ABSL_ASSIGN_OR_RETURN(
+          pooled_cpu_buffer_,
+          cpu_buffer_pool_->GetBuffer(
+              {static_cast<size_t>(std::max(memory_alignment_, bytes())),
+               memory_alignment_ > 0 ? memory_alignment_
+                                     : kDefaultCpuBufferAlignment}));
+      cpu_buffer_ = pooled_cpu_buffer_->data();
+    } else if (memory_alignment_ > 0) {
       // TODO b/339271330 - Investigate how aligned memory performs in
       // MP WebAssembly targets.
       // TfLite custom allocation requires at least memory_alignment_ bytes.
       cpu_buffer_ = aligned_malloc(std::max(memory_alignment_, bytes()),
                                    memory_alignment_);
     } else {
-      cpu_buffer_ = malloc(bytes());
+      // Aligned without padding, so that TfLite can use the buffer directly.
+      cpu_buffer_ =
+          aligned_malloc(std::max(bytes(), 1), kDefaultCpuBufferAlignment);
     }
     RET_CHECK(cpu_buffer_) << "Failed to allocate CPU buffer.";
 #endif  // MEDIAPIPE_METAL_ENABLED
@@ -808,10 +827,11 @@ void Tensor::FreeCpuBuffer() const {
 #if MEDIAPIPE_METAL_ENABLED
   free(cpu_buffer_);
 #else
-  if (memory_alignment_ > 0) {
-    aligned_free(cpu_buffer_);
+  if (pooled_cpu_buffer_) {
+    // Returns the buffer to the pool once no other reference is held.
+    pooled_cpu_buffer_.reset();
   } else {
-    free(cpu_buffer_);
+    aligned_free(cpu_buffer_);
   }
 #endif  // MEDIAPIPE_METAL_ENABLED
   cpu_buffer_ = nullptr;
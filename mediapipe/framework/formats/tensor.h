@@ -33,6 +33,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
 #include "mediapipe/framework/formats/tensor/internal.h"
 #include "mediapipe/framework/memory_manager.h"
 // Exports MEDIAPIPE_TENSOR_USE_AHWB macro.
@@ -161,10 +162,16 @@ class Tensor {
     int zero_point = 0;
   };
 
+  // Alignment of CPU buffers allocated without memory_alignment. It matches
+  // tflite::kDefaultTensorAlignment, so that inference calculators can pass
+  // the buffers to TfLite without copying.
+  static constexpr int kDefaultCpuBufferAlignment = 64;
+
   // memory_alignment is an optional argument to tell the API to allocate
   // a buffer that is padded to multiples of memory_alignment bytes.
   // memory_alignment must be power of 2, i.e. 2, 4, 8, 16, 64, etc.
-  // If memory_alignment is 0, then the buffer will not be padded.
+  // If memory_alignment is 0, then the buffer will not be padded but still
+  // aligned to kDefaultCpuBufferAlignment bytes.
   // Note that memory_alignment is only applied to CPU storage (includes AHWBs).
   Tensor(ElementType element_type, const Shape& shape,
          MemoryManager* memory_manager = nullptr, int memory_alignment = 0);
@@ -570,6 +577,11 @@ class Tensor {
   mutable void* cpu_buffer_ = nullptr;
   absl::Status AllocateCpuBuffer() const;
   void FreeCpuBuffer() const;
+  // Recycles CPU buffers across tensors when a MemoryManager is provided.
+  std::shared_ptr<CpuBufferPool> cpu_buffer_pool_;
+  // Pooled storage backing cpu_buffer_, if any. Releasing it returns the
+  // buffer to cpu_buffer_pool_.
+  mutable std::shared_ptr<CpuBuffer> pooled_cpu_buffer_;
   // Forward declaration of the MtlResources provides compile-time verification
   // of ODR if this header includes any actual code that uses MtlResources.
   mutable std::unique_ptr<MtlResources> mtl_resources_;
@@ -73,6 +73,14 @@ TEST(Cpu, TestAlignedMemoryAllocation) {
   }
 }
 
+TEST(Cpu, TestDefaultMemoryAllocationIsAligned) {
+  Tensor t1(Tensor::ElementType::kUInt8, Tensor::Shape{3});
+  auto v1 = t1.GetCpuWriteView();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(v1.buffer<void>()) %
+                Tensor::kDefaultCpuBufferAlignment,
+            0);
+}
+
 TEST(Cpu, TestTensorMove) {
   Tensor t1(Tensor::ElementType::kFloat32, Tensor::Shape{4, 3, 2, 3},
             Tensor::QuantizationParameters(0.5, 127));
@@ -100,6 +108,30 @@ TEST(Cpu, TestViewMove) {
   EXPECT_EQ(v1.buffer<float>(), nullptr);  // NOLINT
 }
 
+#if !MEDIAPIPE_METAL_ENABLED
+TEST(Cpu, TestCpuBuffersAreRecycledThroughMemoryManager) {
+  MultiPoolOptions options;
+  options.min_requests_before_pool = 0;
+  MemoryManager memory_manager(options);
+  void* first_buffer = nullptr;
+  for (int n = 0; n < 3; ++n) {
+    Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{1, 2, 3, 4},
+                  &memory_manager, /*memory_alignment=*/64);
+    void* buffer = tensor.GetCpuWriteView().buffer<void>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % 64, 0);
+    if (n == 0) {
+      first_buffer = buffer;
+    } else {
+      EXPECT_EQ(buffer, first_buffer);
+    }
+  }
+  const CpuBufferPool::Stats stats =
+      memory_manager.GetCpuBufferPool()->GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 2);
+}
+#endif  // !MEDIAPIPE_METAL_ENABLED
+
 TEST(General, PreferAhwbHasNoEffectIfAhwbsAreNotSupported) {
   MemoryManager memory_manager(kDefaultMultiPoolOptions, /*prefer_ahwb=*/true);
   for (int n = 0; n < 2; ++n) {
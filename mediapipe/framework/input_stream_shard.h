@@ -80,6 +80,8 @@ class InputStreamShard : public InputStream {
 
   // Accesses InputStreamShard for setting data.
   friend class InputStreamHandler;
+  // Accesses InputStreamShard for setting data in straight-line execution.
+  friend class StraightLineGraph;
 };
 
 }  // namespace mediapipe
@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "mediapipe/framework/formats/cpu_buffer_pool.h"
 // Defines MEDIAPIPE_TENSOR_USE_AHWB
 #include "mediapipe/framework/port.h"
 #include "mediapipe/gpu/multi_pool.h"
@@ -52,6 +53,10 @@ namespace mediapipe {
 // 3) Pass Calculator::memory_manager_ to the Tensor class constructor:
 //       Tensor tensor(Tensor::ElementType::kFloat32,
 //                     Tensor::Shape{kTensorSize}, &memory_manager_);
+//    The Tensor's CPU buffer is taken from the pool and returned to it when
+//    the Tensor is destroyed.
+// 4) Pool efficiency can be monitored with
+//    memory_manager->GetCpuBufferPool()->GetStats().
 
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
 class MemoryManager {
@@ -63,8 +68,8 @@ class MemoryManager {
   // to avoid unnecessary AHWB allocations.
   explicit MemoryManager(MultiPoolOptions options = kDefaultMultiPoolOptions,
                          bool prefer_ahwb = false) {
-    hardware_buffer_pool_ =
-        std::make_shared<HardwareBufferPool>(std::move(options));
+    hardware_buffer_pool_ = std::make_shared<HardwareBufferPool>(options);
+    cpu_buffer_pool_ = std::make_shared<CpuBufferPool>(options);
     prefer_ahwb_ = prefer_ahwb;
   }
 
@@ -72,20 +77,37 @@ class MemoryManager {
     return hardware_buffer_pool_;
   }
 
+  // Pool backing the CPU storage of Tensors that are not stored in AHWBs.
+  std::shared_ptr<CpuBufferPool> GetCpuBufferPool() const {
+    return cpu_buffer_pool_;
+  }
+
   bool PreferAhwb() const { return prefer_ahwb_; }
 
  private:
   std::shared_ptr<HardwareBufferPool> hardware_buffer_pool_;
+  std::shared_ptr<CpuBufferPool> cpu_buffer_pool_;
   bool prefer_ahwb_ = false;
 };
 #else
 
-// Dummy MemoryManager class for platforms that don't use AHWB.
+// MemoryManager for platforms that don't use AHWB. Only pools Tensor CPU
+// storage.
 class MemoryManager {
  public:
   explicit MemoryManager(MultiPoolOptions options = kDefaultMultiPoolOptions,
-                         bool prefer_ahwb = false) {}
+                         bool prefer_ahwb = false)
+      : cpu_buffer_pool_(std::make_shared<CpuBufferPool>(options)) {}
+
+  // Pool backing the CPU storage of Tensors.
+  std::shared_ptr<CpuBufferPool> GetCpuBufferPool() const {
+    return cpu_buffer_pool_;
+  }
+
   bool PreferAhwb() const { return false; }
+
+ private:
+  std::shared_ptr<CpuBufferPool> cpu_buffer_pool_;
 };
 
 #endif  // MEDIAPIPE_TENSOR_USE_AHWB
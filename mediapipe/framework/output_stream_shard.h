@@ -132,6 +132,9 @@ class OutputStreamShard : public OutputStream {
   friend class PerfettoTraceScope;
   // Accesses OutputStreamShard for post processing.
   friend class OutputStreamManager;
+  // Accesses OutputStreamShard for post processing in straight-line
+  // execution.
+  friend class StraightLineGraph;
 };
 
 }  // namespace mediapipe
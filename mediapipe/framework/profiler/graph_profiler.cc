@@ -20,6 +20,7 @@
 
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
@@ -237,6 +238,10 @@ void GraphProfiler::Reset() {
          *(calculator_profile->mutable_input_stream_profiles())) {
       ResetTimeHistogram(input_stream_profile.mutable_latency());
     }
+    for (auto& operator_profile :
+         *(calculator_profile->mutable_operator_profiles())) {
+      ResetTimeHistogram(operator_profile.mutable_runtime());
+    }
   }
 }
 
@@ -312,6 +317,36 @@ void GraphProfiler::LogEvent(const TraceEvent& event) {
   }
 }
 
+bool GraphProfiler::IsOperatorProfilingEnabled() const {
+  absl::ReaderMutexLock lock(profiler_mutex_);
+  return profiler_config_.enable_operator_profiling() &&
+         (is_profiling_ || is_tracing_);
+}
+
+void GraphProfiler::LogOperatorEvent(
+    TraceEvent::EventType event_type,
+    const CalculatorContext& calculator_context, absl::string_view name,
+    absl::Time start_time, absl::Time finish_time) {
+  const std::string* event_name = GetEventName(name);
+  if (is_tracing_ && packet_tracer_) {
+    TraceEvent event = TraceEvent(event_type)
+                           .set_node_id(calculator_context.NodeId())
+                           .set_input_ts(calculator_context.InputTimestamp())
+                           .set_event_name(event_name);
+    packet_tracer_->LogEvent(
+        TraceEvent(event).set_event_time(start_time).set_is_finish(false));
+    packet_tracer_->LogEvent(
+        event.set_event_time(finish_time).set_is_finish(true));
+  }
+  AddOperatorSample(calculator_context, *event_name, ToUnixMicros(start_time),
+                    ToUnixMicros(finish_time));
+}
+
+const std::string* GraphProfiler::GetEventName(absl::string_view name) {
+  absl::MutexLock lock(&event_names_mutex_);
+  return &*event_names_.emplace(name).first;
+}
+
 void GraphProfiler::AddPacketInfo(const TraceEvent& packet_info) {
   absl::ReaderMutexLock lock(profiler_mutex_);
   if (!is_profiling_) {
@@ -588,6 +623,42 @@ void GraphProfiler::AddProcessSample(
   }
 }
 
+void GraphProfiler::AddOperatorSample(
+    const CalculatorContext& calculator_context, const std::string& name,
+    int64_t start_time_usec, int64_t end_time_usec) {
+  absl::ReaderMutexLock lock(profiler_mutex_);
+  if (!is_profiling_) {
+    return;
+  }
+
+  auto profile_iter = calculator_profiles_.find(calculator_context.NodeName());
+  ABSL_CHECK(profile_iter != calculator_profiles_.end()) << absl::Substitute(
+      "Calculator \"$0\" has not been added during initialization.",
+      calculator_context.NodeName());
+  CalculatorProfile* calculator_profile = &profile_iter->second;
+
+  // Models have at most a few hundred operators, so the linear search is cheap
+  // compared to running them.
+  OperatorProfile* operator_profile = nullptr;
+  for (OperatorProfile& profile :
+       *calculator_profile->mutable_operator_profiles()) {
+    if (profile.name() == name) {
+      operator_profile = &profile;
+      break;
+    }
+  }
+  if (operator_profile == nullptr) {
+    operator_profile = calculator_profile->add_operator_profiles();
+    operator_profile->set_name(name);
+    InitializeTimeHistogram(
+        calculator_profile->process_runtime().interval_size_usec(),
+        calculator_profile->process_runtime().num_intervals(),
+        operator_profile->mutable_runtime());
+  }
+  AddTimeSample(start_time_usec, end_time_usec,
+                operator_profile->mutable_runtime());
+}
+
 std::unique_ptr<GlProfilingHelper> GraphProfiler::CreateGlProfilingHelper() {
   if (!IsTracerEnabled(profiler_config_)) {
     return nullptr;
@@ -23,6 +23,10 @@
 #include <string>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/node_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_context.h"
@@ -140,6 +144,21 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // Record a tracing event.
   void LogEvent(const TraceEvent& event);
 
+  // Returns true if calculators should report the operators of the models they
+  // run through LogOperatorEvent, see ProfilerConfig.enable_operator_profiling.
+  bool IsOperatorProfilingEnabled() const ABSL_LOCKS_EXCLUDED(profiler_mutex_);
+
+  // Records an operator run by a calculator between `start_time` and
+  // `finish_time`, as measured by GetClock(). `event_type` is INFERENCE_OP or
+  // INFERENCE_DELEGATE_OP. The operator is traced as a pair of events nested
+  // in the current calculator invocation and its runtime is added to the
+  // operator profile `name` of the calculator.
+  void LogOperatorEvent(TraceEvent::EventType event_type,
+                        const CalculatorContext& calculator_context,
+                        absl::string_view name, absl::Time start_time,
+                        absl::Time finish_time)
+      ABSL_LOCKS_EXCLUDED(profiler_mutex_);
+
   // Collects the runtime profile for Open(), Process(), and Close() of each
   // calculator in the graph. May be called at any time after the graph has been
   // initialized.
@@ -305,6 +324,17 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
                         int64_t start_time_usec, int64_t end_time_usec)
       ABSL_LOCKS_EXCLUDED(profiler_mutex_);
 
+  // Updates the profile of operator `name` of the calculator.
+  void AddOperatorSample(const CalculatorContext& calculator_context,
+                         const std::string& name, int64_t start_time_usec,
+                         int64_t end_time_usec)
+      ABSL_LOCKS_EXCLUDED(profiler_mutex_);
+
+  // Returns a pointer to a string equal to `name` living as long as the
+  // profiler, as referenced by TraceEvent::event_name.
+  const std::string* GetEventName(absl::string_view name)
+      ABSL_LOCKS_EXCLUDED(event_names_mutex_);
+
   // Helper method to get trace_log_path.  If the trace_log_path is empty and
   // tracing is enabled, this function returns a default platform dependent
   // trace_log_path.
@@ -341,6 +371,11 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // Buffer of recent profile trace events.
   std::unique_ptr<GraphTracer> packet_tracer_;
 
+  // Names referenced by the operator events in packet_tracer_.
+  absl::Mutex event_names_mutex_;
+  absl::node_hash_set<std::string> event_names_
+      ABSL_GUARDED_BY(event_names_mutex_);
+
   // The clock for time measurement, which must be a monotonic real time clock.
   std::shared_ptr<mediapipe::Clock> clock_;
 
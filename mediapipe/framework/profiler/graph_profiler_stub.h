@@ -16,7 +16,11 @@
 #define MEDIAPIPE_FRAMEWORK_PROFILER_MEDIAPIPE_PROFILER_STUB_H_
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/timestamp.h"
 
@@ -32,6 +36,7 @@ using mediapipe::GraphProfile;
 using mediapipe::GraphTrace;
 
 class ValidatedGraphConfig;
+class CalculatorContext;
 class Executor;
 class Packet;
 class Clock;
@@ -57,6 +62,8 @@ class TraceEvent {
     TPU_TASK,
     GPU_CALIBRATION,
     PACKET_QUEUED,
+    INFERENCE_OP,
+    INFERENCE_DELEGATE_OP,
   };
   TraceEvent(const EventType& event_type) {}
   TraceEvent() {}
@@ -74,6 +81,9 @@ class TraceEvent {
   inline TraceEvent& set_thread_id(int thread_id) { return *this; }
   inline TraceEvent& set_is_finish(bool is_finish) { return *this; }
   inline TraceEvent& set_event_data(int64_t data) { return *this; }
+  inline TraceEvent& set_event_name(const std::string* event_name) {
+    return *this;
+  }
 };
 
 // GraphProfiler::CaptureProfile option, see the method for details.
@@ -86,6 +96,11 @@ class GraphProfilerStub {
   inline void Initialize(const ValidatedGraphConfig& validated_graph_config) {}
   inline void SetClock(const std::shared_ptr<mediapipe::Clock>& clock) {}
   inline void LogEvent(const TraceEvent& event) {}
+  inline bool IsOperatorProfilingEnabled() const { return false; }
+  inline void LogOperatorEvent(TraceEvent::EventType event_type,
+                               const CalculatorContext& calculator_context,
+                               absl::string_view name, absl::Time start_time,
+                               absl::Time finish_time) {}
   inline absl::Status GetCalculatorProfiles(
       std::vector<CalculatorProfile>*) const {
     return absl::OkStatus();
@@ -1073,6 +1073,59 @@ TEST_F(GraphProfilerTestPeer, AddProcessSample) {
   ASSERT_EQ(GetPacketsInfoMap()->size(), 0);
 }
 
+// Tests that LogOperatorEvent() aggregates the runtime of each operator.
+TEST_F(GraphProfilerTestPeer, LogOperatorEvent) {
+  InitializeProfilerWithGraphConfig(R"(
+    profiler_config {
+      enable_profiler: true
+      enable_operator_profiling: true
+    }
+    input_stream: "input_stream"
+    node {
+      calculator: "DummyTestCalculator"
+      input_stream: "input_stream"
+      output_stream: "output_stream"
+    })");
+  EXPECT_TRUE(profiler_.IsOperatorProfilingEnabled());
+
+  TestContextBuilder context(kDummyTestCalculatorName, /*node_id=*/0,
+                             {"input_stream"}, {"output_stream"});
+  context.AddInputs({MakePacket<std::string>("5").At(Timestamp(100))});
+  const absl::Time start_time = absl::FromUnixMicros(1000);
+  for (int i = 0; i < 2; ++i) {
+    profiler_.LogOperatorEvent(GraphTrace::INFERENCE_OP, *context.get(),
+                               "CONV_2D:0", start_time,
+                               start_time + absl::Microseconds(300));
+    profiler_.LogOperatorEvent(GraphTrace::INFERENCE_DELEGATE_OP,
+                               *context.get(), "SOFTMAX:1", start_time,
+                               start_time + absl::Microseconds(20));
+  }
+
+  std::vector<CalculatorProfile> profiles = Profiles();
+  ASSERT_EQ(profiles.size(), 1);
+  EXPECT_THAT(profiles[0], Partially(EqualsProto(R"pb(
+                name: "DummyTestCalculator"
+                operator_profiles {
+                  name: "CONV_2D:0"
+                  runtime {
+                    total: 600
+                    interval_size_usec: 1000000
+                    num_intervals: 1
+                    count: 2
+                  }
+                }
+                operator_profiles {
+                  name: "SOFTMAX:1"
+                  runtime {
+                    total: 40
+                    interval_size_usec: 1000000
+                    num_intervals: 1
+                    count: 2
+                  }
+                }
+              )pb")));
+}
+
 // Tests that AddProcessSample() updates |process_runtime| and also updates the
 // packet info map when stream latency is enabled.
 TEST_F(GraphProfilerTestPeer, AddProcessSampleWithStreamLatency) {
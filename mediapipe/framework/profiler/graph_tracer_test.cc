@@ -169,6 +169,54 @@ TEST_F(GraphTracerTest, CalculatorTrace) {
       )pb")));
 }
 
+TEST_F(GraphTracerTest, OperatorTrace) {
+  SetUpGraphTracer();
+  const std::string conv_name = "CONV_2D:0";
+  const std::string softmax_name = "SOFTMAX:1";
+  absl::Time curr_time = start_time_;
+  auto log_op = [&](const std::string* name, absl::Duration duration) {
+    TraceEvent event = TraceEvent(GraphTrace::INFERENCE_OP)
+                           .set_node_id(0)
+                           .set_input_ts(start_timestamp_)
+                           .set_event_name(name);
+    tracer_->LogEvent(
+        TraceEvent(event).set_event_time(curr_time).set_is_finish(false));
+    curr_time += duration;
+    tracer_->LogEvent(event.set_event_time(curr_time).set_is_finish(true));
+  };
+  log_op(&conv_name, absl::Microseconds(300));
+  log_op(&softmax_name, absl::Microseconds(20));
+
+  // Each operator becomes a separate trace nested in the calculator task.
+  EXPECT_THAT(
+      GetTrace(), EqualsProto(mediapipe::ParseTextProtoOrDie<GraphTrace>(R"pb(
+        base_time: 1608911100000000
+        base_timestamp: 1608911100000000
+        stream_name: ""
+        event_name: ""
+        event_name: "CONV_2D:0"
+        event_name: "SOFTMAX:1"
+        calculator_trace {
+          node_id: 0
+          input_timestamp: 0
+          event_type: INFERENCE_OP
+          start_time: 0
+          finish_time: 300
+          thread_id: 0
+          event_name_id: 1
+        }
+        calculator_trace {
+          node_id: 0
+          input_timestamp: 0
+          event_type: INFERENCE_OP
+          start_time: 300
+          finish_time: 320
+          thread_id: 0
+          event_name_id: 2
+        }
+      )pb")));
+}
+
 TEST_F(GraphTracerTest, GraphTrace) {
   // Define the GraphTracer, the CalculatorState, and the stream specs.
   SetUpGraphTracer();
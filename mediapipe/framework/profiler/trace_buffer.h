@@ -38,6 +38,7 @@ struct TraceEvent {
   const std::string* stream_id = nullptr;
   int32_t thread_id = 0;
   int64_t event_data = 0;
+  const std::string* event_name = nullptr;
 
   TraceEvent(const EventType& event_type) : event_type(event_type) {}
   TraceEvent() {}
@@ -87,6 +88,10 @@ struct TraceEvent {
     this->event_data = data;
     return *this;
   }
+  inline TraceEvent& set_event_name(const std::string* event_name) {
+    this->event_name = event_name;
+    return *this;
+  }
 
   // GraphTrace::EventType constants, repeated here to match GraphProfilerStub.
   static constexpr EventType UNKNOWN = GraphTrace::UNKNOWN;
@@ -112,6 +117,9 @@ struct TraceEvent {
       GraphTrace::GPU_TASK_INVOKE_ADVANCED;
   static constexpr EventType TPU_TASK_INVOKE_ASYNC =
       GraphTrace::TPU_TASK_INVOKE_ASYNC;
+  static constexpr EventType INFERENCE_OP = GraphTrace::INFERENCE_OP;
+  static constexpr EventType INFERENCE_DELEGATE_OP =
+      GraphTrace::INFERENCE_DELEGATE_OP;
 };
 
 // Packet trace log buffer.
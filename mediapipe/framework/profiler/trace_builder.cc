@@ -37,10 +37,15 @@ struct TaskId {
   int id;
   mediapipe::Timestamp ts;
   int event_type;
+  // Distinguishes the named events of one task, such as INFERENCE_OP.
+  int name_id = 0;
   inline bool operator==(const TaskId& other) const {
-    return id == other.id && ts == other.ts && event_type == other.event_type;
+    return id == other.id && ts == other.ts && event_type == other.event_type &&
+           name_id == other.name_id;
+  }
+  inline size_t hash() const {
+    return id + ts.Value() + (event_type << 10) + (name_id << 16);
   }
-  inline size_t hash() const { return id + ts.Value() + (event_type << 10); }
 };
 }  // namespace mediapipe
 
@@ -92,6 +97,10 @@ void BasicTraceEventTypes(TraceEventRegistry* result) {
        "interpreter."},
       {TraceEvent::TPU_TASK_INVOKE_ASYNC,
        "CPU timing for async initiation of a TPU task."},
+
+      {TraceEvent::INFERENCE_OP, "An operator of a model.", true, false},
+      {TraceEvent::INFERENCE_DELEGATE_OP,
+       "An operator within a delegate partition of a model.", true, false},
   };
   for (const TraceEventType& t : basic_types) {
     (*result)[t.event_type()] = t;
@@ -171,6 +180,7 @@ class TraceBuilder::Impl {
     // stream, node, or packet.
     static std::string* empty_string = new std::string("");
     stream_id_map_[empty_string];
+    event_name_id_map_[empty_string];
     packet_data_id_map_[0];
     BasicTraceEventTypes(&trace_event_registry_);
   }
@@ -208,7 +218,8 @@ class TraceBuilder::Impl {
       if (!trace_event_registry_[event.event_type].is_packet_event()) {
         continue;
       }
-      TaskId task_id{event.node_id, event.input_ts, event.event_type};
+      TaskId task_id{event.node_id, event.input_ts, event.event_type,
+                     event_name_id_map_[event.event_name]};
       TaskId hop_id{stream_id_map_[event.stream_id], event.packet_ts,
                     event.event_type};
 
@@ -228,7 +239,8 @@ class TraceBuilder::Impl {
         BuildEventLog(event, result->add_calculator_trace());
         continue;
       }
-      TaskId task_id{event.node_id, event.input_ts, event.event_type};
+      TaskId task_id{event.node_id, event.input_ts, event.event_type,
+                     event_name_id_map_[event.event_name]};
       if (task_ids.count(task_id) == 0) {
         task_ids.insert(task_id);
         BuildCalculatorTrace(task_events_[task_id],
@@ -238,6 +250,7 @@ class TraceBuilder::Impl {
     for (std::string& name : GetIdNames(stream_id_map_)) {
       result->add_stream_name(name);
     }
+    AddEventNames(result);
   }
 
   void CreateLog(const TraceBuffer& buffer, absl::Time begin_time,
@@ -264,6 +277,7 @@ class TraceBuilder::Impl {
     for (std::string& name : GetIdNames(stream_id_map_)) {
       result->add_stream_name(name);
     }
+    AddEventNames(result);
   }
 
   void Clear() {
@@ -293,6 +307,14 @@ class TraceBuilder::Impl {
     }
   }
 
+  // Lists the event names, if any events are named.
+  void AddEventNames(GraphTrace* result) {
+    if (event_name_id_map_.map().size() <= 1) return;
+    for (std::string& name : GetIdNames(event_name_id_map_)) {
+      result->add_event_name(name);
+    }
+  }
+
   // Return a timestamp in micros relative to the base timetamp.
   int64_t LogTimestamp(Timestamp ts) { return ts.Value() - base_ts_; }
 
@@ -331,6 +353,9 @@ class TraceBuilder::Impl {
           result->set_input_timestamp(LogTimestamp(event->input_ts));
         }
         result->set_thread_id(event->thread_id);
+        if (event->event_name) {
+          result->set_event_name_id(event_name_id_map_[event->event_name]);
+        }
       }
       if (event->is_finish) {
         finish_time = std::min(finish_time, event->event_time);
@@ -376,6 +401,9 @@ class TraceBuilder::Impl {
       result->set_input_timestamp(LogTimestamp(event.input_ts));
     }
     result->set_thread_id(event.thread_id);
+    if (event.event_name) {
+      result->set_event_name_id(event_name_id_map_[event.event_name]);
+    }
     if (trace_event_registry_[event.event_type].is_stream_event()) {
       if (event.stream_id) {
         auto stream_trace = event.is_finish ? result->add_output_trace()
@@ -391,6 +419,8 @@ class TraceBuilder::Impl {
   std::unordered_map<TaskId, const TraceEvent*> hop_events_;
   // Map from stream name pointers to int32 identifiers.
   StringIdMap stream_id_map_;
+  // Map from event name pointers to int32 identifiers.
+  StringIdMap event_name_id_map_;
   // Map from packet data pointers to int32 identifiers.
   AddressIdMap packet_data_id_map_;
   // The timestamp represented as 0 in the trace.
@@ -439,6 +469,8 @@ const TraceEvent::EventType         //
     TraceEvent::DSP_TASK,           //
     TraceEvent::TPU_TASK,           //
     TraceEvent::GPU_CALIBRATION,    //
-    TraceEvent::PACKET_QUEUED;
+    TraceEvent::PACKET_QUEUED,      //
+    TraceEvent::INFERENCE_OP,       //
+    TraceEvent::INFERENCE_DELEGATE_OP;
 
 }  // namespace mediapipe
@@ -79,6 +79,7 @@ void Scheduler::Reset() {
   }
   shared_.stopping = false;
   shared_.has_error = false;
+  shared_.deadlines.Clear();
 }
 
 void Scheduler::CloseAllSourceNodes() { shared_.stopping = true; }
@@ -452,6 +453,7 @@ void Scheduler::AssignNodeToSchedulerQueue(CalculatorNode* node) {
     queue = &default_queue_;
   }
   node->SetSchedulerQueue(queue);
+  node->SetDeadlineTable(&shared_.deadlines);
 }
 
 void Scheduler::QueueIdleStateChanged(bool idle) {
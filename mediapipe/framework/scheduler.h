@@ -28,10 +28,12 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/calculator_node.h"
 #include "mediapipe/framework/scheduler_queue.h"
 #include "mediapipe/framework/scheduler_shared.h"
+#include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe {
 
@@ -158,6 +160,11 @@ class Scheduler {
 
   void SetHasError(bool error) { shared_.has_error = error; }
 
+  // Sets the deadline of an input timestamp, see DeadlineTable.
+  void SetInputTimestampDeadline(Timestamp timestamp, absl::Time deadline) {
+    shared_.deadlines.SetDeadline(timestamp, deadline);
+  }
+
   // Notifies the scheduler that a packet was added to a graph input stream.
   // The scheduler needs to check whether it is still deadlocked, and
   // unthrottle again if so.
@@ -21,6 +21,7 @@
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/calculator_node.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/port/logging.h"
@@ -34,8 +35,9 @@
 namespace mediapipe {
 namespace internal {
 
-SchedulerQueue::Item::Item(CalculatorNode* node, CalculatorContext* cc)
-    : node_(node), cc_(cc) {
+SchedulerQueue::Item::Item(CalculatorNode* node, CalculatorContext* cc,
+                           absl::Time deadline)
+    : deadline_(deadline), node_(node), cc_(cc) {
   ABSL_CHECK(node);
   ABSL_CHECK(cc);
   is_source_ = node->IsSource();
@@ -81,6 +83,8 @@ bool SchedulerQueue::Item::operator<(const SchedulerQueue::Item& that) const {
   } else {
     // Non-sources run before sources.
     if (that.is_source_) return false;
+    // Later deadlines run after earlier deadlines.
+    if (deadline_ != that.deadline_) return deadline_ > that.deadline_;
     // For non-sources, higher ids run before lower ids.
     return id_ < that.id_;
   }
@@ -120,7 +124,11 @@ void SchedulerQueue::AddNode(CalculatorNode* node, CalculatorContext* cc) {
     ABSL_CHECK(node->IsSource()) << node->DebugName();
     return;
   }
-  AddItemToQueue(Item(node, cc));
+  absl::Time deadline = absl::InfiniteFuture();
+  if (!node->IsSource()) {
+    deadline = shared_->deadlines.GetDeadline(cc->InputTimestamp());
+  }
+  AddItemToQueue(Item(node, cc, deadline));
 }
 
 void SchedulerQueue::AddNodeForOpen(CalculatorNode* node) {
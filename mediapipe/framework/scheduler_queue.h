@@ -24,6 +24,7 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/scheduler_shared.h"
@@ -45,7 +46,9 @@ class SchedulerQueue : public TaskQueue {
   // Item in the queue. Wraps a node pointer and helps with priority sorting.
   class Item {
    public:
-    Item(CalculatorNode* node, CalculatorContext* cc);
+    // `deadline` is the deadline of the input timestamp of `cc`.
+    Item(CalculatorNode* node, CalculatorContext* cc,
+         absl::Time deadline = absl::InfiniteFuture());
     // A null CalculatorContext indicates the task should run OpenNode().
     explicit Item(CalculatorNode* node);
 
@@ -70,12 +73,14 @@ class SchedulerQueue : public TaskQueue {
     // - Sources are sorted by layer (lower layer numbers run first), then by
     //   Calculator::SourceProcessOrder (smaller values run first), then by
     //   node id: smaller ids run first, since they come earlier in the config.
-    // - Non-sources are sorted by node id: larger ids run first, because they
-    //   are closer to the leaves.
+    // - Non-sources are sorted by deadline (earliest deadline first, items
+    //   without a deadline last), then by node id: larger ids run first,
+    //   because they are closer to the leaves.
     bool operator<(const Item& that) const;
 
    private:
     int64_t source_process_order_ = 0;
+    absl::Time deadline_ = absl::InfiniteFuture();
     CalculatorNode* node_;
     CalculatorContext* cc_;
     int id_ = 0;
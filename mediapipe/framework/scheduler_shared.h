@@ -24,6 +24,7 @@
 
 #include "absl/base/macros.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/deadline_table.h"
 #include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/deps/monotonic_clock.h"
 #include "mediapipe/framework/port/status.h"
@@ -108,6 +109,9 @@ struct SchedulerShared {
   std::function<void(const absl::Status& error)> error_callback;
   // Collects timing information for measuring overhead.
   internal::SchedulerTimer timer;
+  // Deadlines of the input timestamps, see
+  // CalculatorGraph::AddPacketToInputStream.
+  internal::DeadlineTable deadlines;
 };
 
 }  // namespace internal
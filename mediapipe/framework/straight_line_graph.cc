@@ -0,0 +1,502 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/straight_line_graph.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/substitute.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_base.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/calculator_contract.h"
+#include "mediapipe/framework/calculator_state.h"
+#include "mediapipe/framework/collection_item_id.h"
+#include "mediapipe/framework/graph_service.h"
+#include "mediapipe/framework/graph_service_manager.h"
+#include "mediapipe/framework/input_stream_shard.h"
+#include "mediapipe/framework/legacy_calculator_support.h"
+#include "mediapipe/framework/output_stream_shard.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_set.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/source_location.h"
+#include "mediapipe/framework/port/status_builder.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/fill_packet_set.h"
+#include "mediapipe/framework/tool/name_util.h"
+#include "mediapipe/framework/tool/status_util.h"
+#include "mediapipe/framework/validated_graph_config.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kDefaultInputStreamHandler[] = "DefaultInputStreamHandler";
+
+bool IsDefaultInputStreamHandler(const std::string& handler) {
+  return handler.empty() || handler == kDefaultInputStreamHandler;
+}
+
+Packet GetServicePacket(const GraphServiceManager& service_manager,
+                        const GraphServiceBase& service) {
+  auto it = service_manager.ServicePackets().find(service.key);
+  return it == service_manager.ServicePackets().end() ? Packet() : it->second;
+}
+
+}  // namespace
+
+// Everything needed to invoke one calculator, allocated once.
+struct StraightLineGraph::NodeRuntime {
+  const NodeTypeInfo* info = nullptr;
+  std::string name;
+  std::unique_ptr<CalculatorState> state;
+  std::unique_ptr<PacketSet> input_side_packets;
+  std::unique_ptr<OutputSidePacketSet> output_side_packets;
+  // Sized once, the output stream shards point into it.
+  std::vector<OutputStreamSpec> output_specs;
+  std::unique_ptr<CalculatorContext> context;
+  std::unique_ptr<CalculatorBase> calculator;
+  // Index into stream_packets_ of the stream feeding each input.
+  std::vector<int> upstream_indices;
+  int output_base_index = 0;
+  bool process_timestamp_bounds = false;
+  bool needs_close = false;
+};
+
+StraightLineGraph::StraightLineGraph() = default;
+
+StraightLineGraph::~StraightLineGraph() {
+  absl::Status status = Close();
+  if (!status.ok()) ABSL_LOG(ERROR) << status;
+}
+
+absl::Status StraightLineGraph::SetServicePacket(
+    const GraphServiceBase& service, Packet p) {
+  RET_CHECK(!validated_graph_)
+      << "Services must be set before the graph is initialized.";
+  return service_manager_.SetServicePacket(service, std::move(p));
+}
+
+absl::Status StraightLineGraph::DisallowServiceDefaultInitialization() {
+  RET_CHECK(!validated_graph_)
+      << "Services must be set up before the graph is initialized.";
+  allow_service_default_initialization_ = false;
+  return absl::OkStatus();
+}
+
+absl::Status StraightLineGraph::Initialize(
+    CalculatorGraphConfig config,
+    const std::map<std::string, Packet>& side_packets) {
+  RET_CHECK(!validated_graph_) << "Initialize() must be called only once.";
+  validated_graph_ = std::make_unique<ValidatedGraphConfig>();
+  ABSL_RETURN_IF_ERROR(validated_graph_->Initialize(
+      std::move(config), /*graph_registry=*/nullptr, /*graph_options=*/nullptr,
+      &service_manager_));
+  const CalculatorGraphConfig& validated_config = validated_graph_->Config();
+  RET_CHECK_EQ(validated_config.packet_generator_size(), 0)
+      << "Straight-line execution does not support packet generators.";
+  RET_CHECK_EQ(validated_config.status_handler_size(), 0)
+      << "Straight-line execution does not support status handlers.";
+  RET_CHECK(IsDefaultInputStreamHandler(
+      validated_config.input_stream_handler().input_stream_handler()))
+      << "Straight-line execution only supports the default input stream "
+         "handler.";
+  for (const EdgeInfo& edge : validated_graph_->InputStreamInfos()) {
+    RET_CHECK(!edge.back_edge)
+        << "Straight-line execution does not support back edges, found one "
+           "for stream \""
+        << edge.name << "\".";
+  }
+
+  const auto& output_stream_infos = validated_graph_->OutputStreamInfos();
+  stream_packets_.resize(output_stream_infos.size());
+  stream_bounds_.assign(output_stream_infos.size(), Timestamp::PreStream());
+  is_graph_input_stream_.resize(output_stream_infos.size());
+  for (int i = 0; i < output_stream_infos.size(); ++i) {
+    is_graph_input_stream_[i] =
+        output_stream_infos[i].parent_node.type ==
+        NodeTypeInfo::NodeType::GRAPH_INPUT_STREAM;
+  }
+
+  ABSL_RETURN_IF_ERROR(InitializeServices());
+  // ValidatedGraphConfig sorts the nodes topologically.
+  nodes_.reserve(validated_config.node_size());
+  for (int i = 0; i < validated_config.node_size(); ++i) {
+    auto node = std::make_unique<NodeRuntime>();
+    ABSL_RETURN_IF_ERROR(InitializeNode(i, side_packets, *node));
+    nodes_.push_back(std::move(node));
+  }
+  opened_ = true;
+  for (auto& node : nodes_) {
+    ABSL_RETURN_IF_ERROR(OpenNode(*node));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status StraightLineGraph::InitializeServices() {
+  for (const NodeTypeInfo& info : validated_graph_->CalculatorInfos()) {
+    for (const auto& [key, request] : info.Contract().ServiceRequests()) {
+      if (!GetServicePacket(service_manager_, request.Service()).IsEmpty()) {
+        continue;
+      }
+      absl::StatusOr<Packet> packet;
+      if (allow_service_default_initialization_) {
+        packet = request.Service().CreateDefaultObject();
+      } else {
+        packet = absl::FailedPreconditionError(
+            "Service default initialization is disallowed.");
+      }
+      if (packet.ok()) {
+        ABSL_RETURN_IF_ERROR(service_manager_.SetServicePacket(
+            request.Service(), *std::move(packet)));
+      } else if (!request.IsOptional()) {
+        return absl::InternalError(absl::StrCat(
+            "Service \"", request.Service().key,
+            "\" was not provided and cannot be created: ",
+            packet.status().message()));
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status StraightLineGraph::InitializeNode(
+    int node_index, const std::map<std::string, Packet>& side_packets,
+    NodeRuntime& node) {
+  const CalculatorGraphConfig& config = validated_graph_->Config();
+  const CalculatorGraphConfig::Node& node_config = config.node(node_index);
+  const NodeTypeInfo& info = validated_graph_->CalculatorInfos()[node_index];
+  const CalculatorContract& contract = info.Contract();
+  node.info = &info;
+  node.name = tool::CanonicalNodeName(config, node_index);
+
+  RET_CHECK_GT(info.InputStreamTypes().NumEntries(), 0)
+      << "Straight-line execution does not support source nodes, found \""
+      << node.name << "\".";
+  RET_CHECK_EQ(info.OutputSidePacketTypes().NumEntries(), 0)
+      << "Straight-line execution does not support output side packets, "
+         "found on node \""
+      << node.name << "\".";
+  const std::string& handler =
+      node_config.input_stream_handler().has_input_stream_handler()
+          ? node_config.input_stream_handler().input_stream_handler()
+          : info.GetInputStreamHandler();
+  RET_CHECK(IsDefaultInputStreamHandler(handler))
+      << "Straight-line execution does not support input stream handler \""
+      << handler << "\" of node \"" << node.name << "\".";
+
+  node.state = std::make_unique<CalculatorState>(
+      node.name, node_index, node_config.calculator(), node_config,
+      /*profiling_context=*/nullptr, &service_manager_);
+  int num_missing_side_packets = 0;
+  ABSL_ASSIGN_OR_RETURN(node.input_side_packets,
+                        tool::FillPacketSet(info.InputSidePacketTypes(),
+                                            side_packets,
+                                            &num_missing_side_packets));
+  for (CollectionItemId id = info.InputSidePacketTypes().BeginId();
+       num_missing_side_packets > 0 && id < info.InputSidePacketTypes().EndId();
+       ++id) {
+    RET_CHECK(!node.input_side_packets->Get(id).IsEmpty() ||
+              info.InputSidePacketTypes().Get(id).IsOptional())
+        << "Missing input side packet \""
+        << info.InputSidePacketTypes().TagMap()->Names()[id.value()]
+        << "\" of node \"" << node.name << "\".";
+  }
+  node.output_side_packets = std::make_unique<OutputSidePacketSet>(
+      info.OutputSidePacketTypes().TagMap());
+  node.state->SetInputSidePackets(node.input_side_packets.get());
+  node.state->SetOutputSidePackets(node.output_side_packets.get());
+  node.state->SetCounterFactory(&counter_factory_);
+  for (const auto& [key, request] : contract.ServiceRequests()) {
+    Packet packet = GetServicePacket(service_manager_, request.Service());
+    if (!packet.IsEmpty()) {
+      ABSL_RETURN_IF_ERROR(
+          node.state->SetServicePacket(request.Service(), std::move(packet)));
+    }
+  }
+
+  node.context = std::make_unique<CalculatorContext>(
+      node.state.get(), info.InputStreamTypes().TagMap(),
+      info.OutputStreamTypes().TagMap());
+  InputStreamShardSet& inputs = node.context->Inputs();
+  node.upstream_indices.reserve(inputs.NumEntries());
+  for (CollectionItemId id = inputs.BeginId(); id < inputs.EndId(); ++id) {
+    const EdgeInfo& edge = validated_graph_->InputStreamInfos()
+                               [info.InputStreamBaseIndex() + id.value()];
+    inputs.Get(id).SetName(&edge.name);
+    node.upstream_indices.push_back(edge.upstream);
+  }
+
+  OutputStreamShardSet& outputs = node.context->Outputs();
+  node.output_base_index = info.OutputStreamBaseIndex();
+  node.output_specs.resize(outputs.NumEntries());
+  for (CollectionItemId id = outputs.BeginId(); id < outputs.EndId(); ++id) {
+    const EdgeInfo& edge = validated_graph_->OutputStreamInfos()
+                               [node.output_base_index + id.value()];
+    OutputStreamSpec& spec = node.output_specs[id.value()];
+    spec.name = edge.name;
+    spec.packet_type = edge.packet_type;
+    spec.error_callback = [this](absl::Status status) {
+      output_error_.Update(status);
+    };
+    spec.locked_intro_data = false;
+    spec.offset = contract.GetTimestampOffset();
+    spec.offset_enabled = spec.offset != TimestampDiff::Unset();
+    outputs.Get(id).SetSpec(&spec);
+  }
+  node.process_timestamp_bounds = contract.GetProcessTimestampBounds();
+
+  ABSL_ASSIGN_OR_RETURN(auto factory,
+                        CalculatorBaseRegistry::CreateByNameInNamespace(
+                            validated_graph_->Package(),
+                            node.state->CalculatorType()));
+  node.calculator = factory->CreateCalculator(node.context.get());
+  return absl::OkStatus();
+}
+
+absl::Status StraightLineGraph::OpenNode(NodeRuntime& node) {
+  CalculatorContext* cc = node.context.get();
+  OutputStreamShardSet& outputs = cc->Outputs();
+  for (OutputStreamShard& output : outputs) {
+    output.Reset(Timestamp::PreStream(), /*close=*/false);
+  }
+  cc->PushInputTimestamp(Timestamp::Unstarted());
+  absl::Status status;
+  {
+    LegacyCalculatorSupport::Scoped<CalculatorContext> s(cc);
+    status = node.calculator->Open(cc);
+  }
+  cc->PopInputTimestamp();
+  status.Update(ConsumeOutputError());
+  ABSL_RETURN_IF_ERROR(status).SetPrepend() << absl::Substitute(
+      "Calculator::Open() for node \"$0\" failed: ", node.name);
+  node.needs_close = true;
+  for (OutputStreamSpec& spec : node.output_specs) {
+    spec.locked_intro_data = true;
+  }
+  int output_index = node.output_base_index;
+  for (const OutputStreamShard& output : outputs) {
+    Timestamp& bound = stream_bounds_[output_index++];
+    bound = std::max(bound, output.updated_next_timestamp_bound_);
+  }
+  // Packets output from Open() precede the first run and cannot be delivered
+  // in straight-line execution.
+  for (const OutputStreamShard& output : outputs) {
+    RET_CHECK(output.IsEmpty())
+        << "Straight-line execution does not support packets output from "
+           "Calculator::Open(), found on stream \""
+        << output.Name() << "\".";
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<int> StraightLineGraph::GetInputStreamIndex(
+    const std::string& name) const {
+  RET_CHECK(validated_graph_) << "The graph is not initialized.";
+  const int index = validated_graph_->OutputStreamIndex(name);
+  RET_CHECK(index >= 0 && is_graph_input_stream_[index])
+      << "\"" << name << "\" is not a graph input stream.";
+  return index;
+}
+
+absl::StatusOr<int> StraightLineGraph::GetOutputStreamIndex(
+    const std::string& name) const {
+  RET_CHECK(validated_graph_) << "The graph is not initialized.";
+  const int index = validated_graph_->OutputStreamIndex(name);
+  RET_CHECK_GE(index, 0) << "Unknown stream \"" << name << "\".";
+  return index;
+}
+
+void StraightLineGraph::SetInputPacket(int index, Packet packet) {
+  stream_packets_[index] = std::move(packet);
+}
+
+absl::Status StraightLineGraph::Run(Timestamp timestamp) {
+  RET_CHECK(opened_) << "The graph is not initialized or already closed.";
+  RET_CHECK(timestamp.IsAllowedInStream() && timestamp > last_timestamp_)
+      << "Timestamp " << timestamp.DebugString()
+      << " is not allowed or not greater than the previous one "
+      << last_timestamp_.DebugString() << ".";
+  last_timestamp_ = timestamp;
+  for (int i = 0; i < stream_packets_.size(); ++i) {
+    if (!is_graph_input_stream_[i]) continue;
+    // Like CalculatorGraph inputs, graph inputs are settled at `timestamp`
+    // whether or not they have a packet.
+    stream_bounds_[i] = timestamp.NextAllowedInStream();
+    const Packet& packet = stream_packets_[i];
+    if (packet.IsEmpty()) continue;
+    const EdgeInfo& edge = validated_graph_->OutputStreamInfos()[i];
+    RET_CHECK(packet.Timestamp() == timestamp)
+        << "Packet for graph input stream \"" << edge.name
+        << "\" has timestamp " << packet.Timestamp().DebugString()
+        << ", expected " << timestamp.DebugString() << ".";
+    ABSL_RETURN_IF_ERROR(edge.packet_type->Validate(packet)).SetPrepend()
+        << "Packet type mismatch on graph input stream \"" << edge.name
+        << "\": ";
+  }
+  absl::Status status;
+  for (auto& node : nodes_) {
+    status = ProcessNode(*node, timestamp);
+    if (!status.ok()) break;
+  }
+  // Graph inputs are consumed by the run.
+  for (int i = 0; i < stream_packets_.size(); ++i) {
+    if (is_graph_input_stream_[i]) stream_packets_[i] = Packet();
+  }
+  return status;
+}
+
+absl::Status StraightLineGraph::ProcessNode(NodeRuntime& node,
+                                            Timestamp timestamp) {
+  CalculatorContext* cc = node.context.get();
+  InputStreamShardSet& inputs = cc->Inputs();
+  OutputStreamShardSet& outputs = cc->Outputs();
+
+  bool has_input_packet = false;
+  Timestamp input_bound = Timestamp::Done();
+  for (int upstream_index : node.upstream_indices) {
+    has_input_packet =
+        has_input_packet || !stream_packets_[upstream_index].IsEmpty();
+    input_bound = std::min(input_bound, stream_bounds_[upstream_index]);
+  }
+  if (!has_input_packet && !node.process_timestamp_bounds) {
+    // As OutputStreamHandler::TryPropagateTimestampBound(), the input bound
+    // only propagates through outputs with a timestamp offset.
+    for (int i = 0; i < outputs.NumEntries(); ++i) {
+      const int output_index = node.output_base_index + i;
+      stream_packets_[output_index] = Packet();
+      const OutputStreamSpec& spec = node.output_specs[i];
+      if (spec.offset_enabled && input_bound.IsRangeValue()) {
+        stream_bounds_[output_index] = std::max(stream_bounds_[output_index],
+                                                input_bound + spec.offset);
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  // The input shards hold exactly one, possibly empty, packet per Process().
+  // Like InputStreamManager::PopPacketAtTimestamp(), an empty input is
+  // timestamped just before the bound of its stream.
+  int input_index = 0;
+  for (InputStreamShard& input : inputs) {
+    const int upstream_index = node.upstream_indices[input_index++];
+    const Packet& packet = stream_packets_[upstream_index];
+    if (packet.IsEmpty()) {
+      input.AddPacket(
+          Packet().At(stream_bounds_[upstream_index].PreviousAllowedInStream()),
+          /*is_done=*/false);
+    } else {
+      input.AddPacket(Packet(packet), /*is_done=*/false);
+    }
+  }
+  int output_index = node.output_base_index;
+  for (OutputStreamShard& output : outputs) {
+    output.Reset(stream_bounds_[output_index++], /*close=*/false);
+  }
+
+  cc->PushInputTimestamp(timestamp);
+  absl::Status status;
+  {
+    LegacyCalculatorSupport::Scoped<CalculatorContext> s(cc);
+    status = node.calculator->Process(cc);
+  }
+  cc->PopInputTimestamp();
+  for (InputStreamShard& input : inputs) {
+    input.ClearCurrentPacket();
+  }
+
+  if (status == tool::StatusStop()) {
+    status = absl::FailedPreconditionError(
+        "Straight-line execution does not support stopping the graph.");
+  }
+  status.Update(ConsumeOutputError());
+  ABSL_RETURN_IF_ERROR(status).SetPrepend() << absl::Substitute(
+      "Calculator::Process() for node \"$0\" failed: ", node.name);
+
+  const Timestamp next_timestamp = timestamp.NextAllowedInStream();
+  output_index = node.output_base_index;
+  for (OutputStreamShard& output : outputs) {
+    // The bound follows OutputStreamManager::ComputeOutputTimestampBound().
+    Timestamp& bound = stream_bounds_[output_index];
+    if (output.OffsetEnabled() && next_timestamp.IsRangeValue()) {
+      bound = std::max(bound, next_timestamp + output.Offset());
+    }
+    bound = std::max(bound, output.updated_next_timestamp_bound_);
+    Packet& packet = stream_packets_[output_index++];
+    std::list<Packet>* queue = output.OutputQueue();
+    if (queue->empty()) {
+      packet = Packet();
+      continue;
+    }
+    bound = std::max(bound, next_timestamp);
+    RET_CHECK(queue->size() == 1 && queue->front().Timestamp() == timestamp)
+        << "Straight-line execution requires at most one output packet at the "
+           "input timestamp per stream, node \""
+        << node.name << "\" output " << queue->size()
+        << " packet(s) starting at "
+        << queue->front().Timestamp().DebugString() << " to stream \""
+        << output.Name() << "\" for input timestamp "
+        << timestamp.DebugString() << ".";
+    packet = std::move(queue->front());
+    queue->clear();
+  }
+  return absl::OkStatus();
+}
+
+absl::Status StraightLineGraph::ConsumeOutputError() {
+  return std::exchange(output_error_, absl::OkStatus());
+}
+
+absl::Status StraightLineGraph::Close() {
+  if (!opened_) return absl::OkStatus();
+  opened_ = false;
+  absl::Status status;
+  for (auto& node : nodes_) {
+    if (!node->needs_close) continue;
+    node->needs_close = false;
+    CalculatorContext* cc = node->context.get();
+    for (OutputStreamShard& output : cc->Outputs()) {
+      output.Reset(Timestamp::Done(), /*close=*/false);
+    }
+    cc->PushInputTimestamp(Timestamp::Done());
+    absl::Status close_status;
+    {
+      LegacyCalculatorSupport::Scoped<CalculatorContext> s(cc);
+      close_status = node->calculator->Close(cc);
+    }
+    cc->PopInputTimestamp();
+    close_status.Update(ConsumeOutputError());
+    if (!close_status.ok()) {
+      status.Update(StatusBuilder(close_status, MEDIAPIPE_LOC).SetPrepend()
+                    << absl::Substitute(
+                           "Calculator::Close() for node \"$0\" failed: ",
+                           node->name));
+    }
+  }
+  return status;
+}
+
+}  // namespace mediapipe
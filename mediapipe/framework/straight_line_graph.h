@@ -0,0 +1,142 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_STRAIGHT_LINE_GRAPH_H_
+#define MEDIAPIPE_FRAMEWORK_STRAIGHT_LINE_GRAPH_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/graph_service.h"
+#include "mediapipe/framework/graph_service_manager.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/validated_graph_config.h"
+
+namespace mediapipe {
+
+// Runs a graph as a straight line of Calculator::Process() calls on the
+// calling thread.
+//
+// The nodes are ordered topologically once, when the graph is initialized,
+// and each call to Run() invokes every node at most once, in that order, on
+// preallocated calculator contexts. There are no input stream handlers, no
+// scheduler queues and no executor hops, so the framework overhead per run is
+// a handful of packet copies.
+//
+// This is only equivalent to CalculatorGraph for graphs whose nodes process
+// each input timestamp independently, which Initialize() verifies as far as it
+// can:
+// - no back edges, source nodes, packet generators or status handlers;
+// - only the default input stream handler;
+// - no output side packets, input side packets must be provided upfront.
+// Run() additionally fails if a node outputs a packet at a timestamp other
+// than the input one, or several packets to the same stream.
+//
+// As with the default input stream handler, a node is skipped when none of its
+// inputs has a packet, unless it enabled timestamp bound processing. Outputs
+// of skipped nodes are empty, and their timestamp bounds only advance through
+// timestamp offsets. Empty inputs are delivered to Process() at the timestamp
+// preceding the bound of their stream, as CalculatorGraph does.
+//
+// Not thread-safe.
+class StraightLineGraph {
+ public:
+  StraightLineGraph();
+  StraightLineGraph(const StraightLineGraph&) = delete;
+  StraightLineGraph& operator=(const StraightLineGraph&) = delete;
+
+  // Closes the calculators, see Close().
+  ~StraightLineGraph();
+
+  // Sets a service object, as CalculatorGraph::SetServicePacket. Must be
+  // called before Initialize().
+  absl::Status SetServicePacket(const GraphServiceBase& service, Packet p);
+
+  // Disallows default initialization of services which were not set, as
+  // CalculatorGraph::DisallowServiceDefaultInitialization.
+  absl::Status DisallowServiceDefaultInitialization();
+
+  // Validates the graph, creates the calculators and opens them.
+  absl::Status Initialize(CalculatorGraphConfig config,
+                          const std::map<std::string, Packet>& side_packets);
+
+  // Returns the index to use with SetInputPacket() for a graph input stream.
+  absl::StatusOr<int> GetInputStreamIndex(const std::string& name) const;
+
+  // Returns the index to use with GetOutputPacket() for any stream of the
+  // graph, typically a graph output stream.
+  absl::StatusOr<int> GetOutputStreamIndex(const std::string& name) const;
+
+  // Sets the packet of a graph input stream for the next Run(). The packet
+  // must be empty or have the timestamp passed to Run(). Packets which are
+  // not set are empty.
+  void SetInputPacket(int index, Packet packet);
+
+  // Processes the input packets at `timestamp` through all nodes. Timestamps
+  // must be increasing across runs.
+  absl::Status Run(Timestamp timestamp);
+
+  // Returns the packet output to a stream by the last Run(), or an empty
+  // packet if the stream only advanced its timestamp bound.
+  Packet& GetOutputPacket(int index) { return stream_packets_[index]; }
+
+  // Returns the next timestamp bound of a stream after the last Run(). A
+  // stream without a packet and with a bound not past the timestamp of the
+  // run was neither output nor settled by it.
+  Timestamp GetOutputTimestampBound(int index) const {
+    return stream_bounds_[index];
+  }
+
+  // Closes all calculators. Called upon destruction if not called before.
+  absl::Status Close();
+
+ private:
+  struct NodeRuntime;
+
+  absl::Status InitializeServices();
+  absl::Status InitializeNode(int node_index,
+                              const std::map<std::string, Packet>& side_packets,
+                              NodeRuntime& node);
+  absl::Status OpenNode(NodeRuntime& node);
+  absl::Status ProcessNode(NodeRuntime& node, Timestamp timestamp);
+  // Returns the error reported through an output stream, if any.
+  absl::Status ConsumeOutputError();
+
+  GraphServiceManager service_manager_;
+  bool allow_service_default_initialization_ = true;
+  BasicCounterFactory counter_factory_;
+  std::unique_ptr<ValidatedGraphConfig> validated_graph_;
+  // In topological order.
+  std::vector<std::unique_ptr<NodeRuntime>> nodes_;
+  // The latest packet of every stream, indexed like
+  // ValidatedGraphConfig::OutputStreamInfos().
+  std::vector<Packet> stream_packets_;
+  // The next timestamp bound of every stream, indexed like `stream_packets_`.
+  std::vector<Timestamp> stream_bounds_;
+  std::vector<bool> is_graph_input_stream_;
+  Timestamp last_timestamp_ = Timestamp::Unstarted();
+  absl::Status output_error_;
+  bool opened_ = false;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_STRAIGHT_LINE_GRAPH_H_
@@ -0,0 +1,267 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/straight_line_graph.h"
+
+#include <cstdint>
+#include <string>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::HasSubstr;
+
+// Forwards its input packets without declaring a timestamp offset.
+class NoOffsetPassThroughCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).SetAny();
+    cc->Outputs().Index(0).SetSameAs(&cc->Inputs().Index(0));
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) final {
+    cc->Outputs().Index(0).AddPacket(cc->Inputs().Index(0).Value());
+    return absl::OkStatus();
+  }
+};
+REGISTER_CALCULATOR(NoOffsetPassThroughCalculator);
+
+// Outputs the timestamp of every empty input packet it is invoked with.
+class EmptyInputTimestampCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).SetAny();
+    cc->Outputs().Index(0).Set<int64_t>();
+    cc->SetProcessTimestampBounds(true);
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) final {
+    const Packet& input = cc->Inputs().Index(0).Value();
+    if (input.IsEmpty()) {
+      cc->Outputs().Index(0).AddPacket(
+          MakePacket<int64_t>(input.Timestamp().Value())
+              .At(cc->InputTimestamp()));
+    }
+    return absl::OkStatus();
+  }
+};
+REGISTER_CALCULATOR(EmptyInputTimestampCalculator);
+
+TEST(StraightLineGraphTest, RunsNodesInTopologicalOrder) {
+  // Nodes are listed in reverse order on purpose.
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "doubled"
+      output_stream: "out"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "doubled"
+    }
+  )pb");
+  StraightLineGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, /*side_packets=*/{}));
+  MP_ASSERT_OK_AND_ASSIGN(int in, graph.GetInputStreamIndex("in"));
+  MP_ASSERT_OK_AND_ASSIGN(int out, graph.GetOutputStreamIndex("out"));
+
+  for (int i = 1; i <= 3; ++i) {
+    graph.SetInputPacket(in, MakePacket<int>(i).At(Timestamp(i)));
+    MP_ASSERT_OK(graph.Run(Timestamp(i)));
+    const Packet& output = graph.GetOutputPacket(out);
+    ASSERT_FALSE(output.IsEmpty());
+    EXPECT_EQ(output.Get<int>(), 4 * i);
+    EXPECT_EQ(output.Timestamp(), Timestamp(i));
+  }
+  MP_EXPECT_OK(graph.Close());
+}
+
+TEST(StraightLineGraphTest, SkipsNodesWithoutInputPackets) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "a"
+    input_stream: "b"
+    output_stream: "b_out"
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "a"
+      input_stream: "b"
+      output_stream: "a_out"
+      output_stream: "b_out"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "a_out"
+      output_stream: "a_doubled"
+    }
+  )pb");
+  StraightLineGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, /*side_packets=*/{}));
+  MP_ASSERT_OK_AND_ASSIGN(int b, graph.GetInputStreamIndex("b"));
+  MP_ASSERT_OK_AND_ASSIGN(int b_out, graph.GetOutputStreamIndex("b_out"));
+  MP_ASSERT_OK_AND_ASSIGN(int a_doubled,
+                          graph.GetOutputStreamIndex("a_doubled"));
+
+  // "a" is left empty, so DoubleIntCalculator must not be invoked.
+  graph.SetInputPacket(b, MakePacket<std::string>("b").At(Timestamp(0)));
+  MP_ASSERT_OK(graph.Run(Timestamp(0)));
+  EXPECT_TRUE(graph.GetOutputPacket(a_doubled).IsEmpty());
+  ASSERT_FALSE(graph.GetOutputPacket(b_out).IsEmpty());
+  EXPECT_EQ(graph.GetOutputPacket(b_out).Get<std::string>(), "b");
+
+  // Input packets are consumed by the run.
+  MP_ASSERT_OK(graph.Run(Timestamp(1)));
+  EXPECT_TRUE(graph.GetOutputPacket(b_out).IsEmpty());
+}
+
+TEST(StraightLineGraphTest, AdvancesTimestampBoundsOfSkippedNodesByOffset) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "doubled"
+    }
+    node {
+      calculator: "NoOffsetPassThroughCalculator"
+      input_stream: "in"
+      output_stream: "forwarded"
+    }
+  )pb");
+  StraightLineGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, /*side_packets=*/{}));
+  MP_ASSERT_OK_AND_ASSIGN(int in, graph.GetInputStreamIndex("in"));
+  MP_ASSERT_OK_AND_ASSIGN(int doubled, graph.GetOutputStreamIndex("doubled"));
+  MP_ASSERT_OK_AND_ASSIGN(int forwarded,
+                          graph.GetOutputStreamIndex("forwarded"));
+
+  graph.SetInputPacket(in, MakePacket<int>(1).At(Timestamp(1)));
+  MP_ASSERT_OK(graph.Run(Timestamp(1)));
+  EXPECT_EQ(graph.GetOutputTimestampBound(doubled), Timestamp(2));
+  EXPECT_EQ(graph.GetOutputTimestampBound(forwarded), Timestamp(2));
+
+  // Only the offset settles the outputs of skipped nodes.
+  MP_ASSERT_OK(graph.Run(Timestamp(5)));
+  EXPECT_TRUE(graph.GetOutputPacket(doubled).IsEmpty());
+  EXPECT_EQ(graph.GetOutputTimestampBound(doubled), Timestamp(6));
+  EXPECT_TRUE(graph.GetOutputPacket(forwarded).IsEmpty());
+  EXPECT_EQ(graph.GetOutputTimestampBound(forwarded), Timestamp(2));
+}
+
+TEST(StraightLineGraphTest, DeliversEmptyInputsBeforeStreamBounds) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "empty_timestamp"
+    node {
+      calculator: "NoOffsetPassThroughCalculator"
+      input_stream: "in"
+      output_stream: "forwarded"
+    }
+    node {
+      calculator: "EmptyInputTimestampCalculator"
+      input_stream: "forwarded"
+      output_stream: "empty_timestamp"
+    }
+  )pb");
+  StraightLineGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, /*side_packets=*/{}));
+  MP_ASSERT_OK_AND_ASSIGN(int in, graph.GetInputStreamIndex("in"));
+  MP_ASSERT_OK_AND_ASSIGN(int empty_timestamp,
+                          graph.GetOutputStreamIndex("empty_timestamp"));
+
+  graph.SetInputPacket(in, MakePacket<int>(1).At(Timestamp(1)));
+  MP_ASSERT_OK(graph.Run(Timestamp(1)));
+  EXPECT_TRUE(graph.GetOutputPacket(empty_timestamp).IsEmpty());
+
+  // As in CalculatorGraph, the empty input precedes the bound of "forwarded",
+  // which its skipped producer left right after the last packet.
+  MP_ASSERT_OK(graph.Run(Timestamp(5)));
+  const Packet& output = graph.GetOutputPacket(empty_timestamp);
+  ASSERT_FALSE(output.IsEmpty());
+  EXPECT_EQ(output.Get<int64_t>(), 1);
+  EXPECT_EQ(output.Timestamp(), Timestamp(5));
+}
+
+TEST(StraightLineGraphTest, RejectsInputPacketsAtOtherTimestamps) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "out"
+    }
+  )pb");
+  StraightLineGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, /*side_packets=*/{}));
+  MP_ASSERT_OK_AND_ASSIGN(int in, graph.GetInputStreamIndex("in"));
+
+  graph.SetInputPacket(in, MakePacket<int>(1).At(Timestamp(5)));
+  EXPECT_THAT(graph.Run(Timestamp(6)),
+              StatusIs(absl::StatusCode::kInternal, HasSubstr("timestamp")));
+  // Timestamps must increase.
+  EXPECT_FALSE(graph.Run(Timestamp(6)).ok());
+}
+
+TEST(StraightLineGraphTest, RejectsBackEdges) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "in"
+      input_stream: "loop"
+      input_stream_info: { tag_index: ":1" back_edge: true }
+      output_stream: "out"
+      output_stream: "unused"
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "out"
+      output_stream: "loop"
+    }
+  )pb");
+  StraightLineGraph graph;
+  EXPECT_THAT(graph.Initialize(config, /*side_packets=*/{}),
+              StatusIs(absl::StatusCode::kInternal, HasSubstr("back edge")));
+}
+
+TEST(StraightLineGraphTest, RejectsSourceNodes) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_side_packet: "value"
+    output_stream: "out"
+    node {
+      calculator: "SidePacketToOutputPacketCalculator"
+      input_side_packet: "value"
+      output_stream: "out"
+    }
+  )pb");
+  StraightLineGraph graph;
+  EXPECT_THAT(graph.Initialize(config, {{"value", MakePacket<int>(1)}}),
+              StatusIs(absl::StatusCode::kInternal, HasSubstr("source nodes")));
+}
+
+}  // namespace
+}  // namespace mediapipe
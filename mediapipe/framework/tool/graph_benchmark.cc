@@ -0,0 +1,314 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/graph_benchmark.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/graph_benchmark.pb.h"
+#include "mediapipe/framework/tool/simulation_clock.h"
+#include "mediapipe/framework/tool/simulation_clock_executor.h"
+#include "mediapipe/framework/tool/validate_name.h"
+
+namespace mediapipe {
+
+namespace tool {
+
+namespace {
+
+// The packets of a recording sharing a timestamp.
+struct Frame {
+  int64_t timestamp = 0;
+  std::vector<std::pair<std::string, Packet>> packets;
+};
+
+absl::StatusOr<std::vector<Frame>> LoadFrames(
+    const GraphBenchmarkRecording& recording) {
+  std::map<int64_t, Frame> frames;
+  for (const auto& recorded : recording.packet()) {
+    const std::string& type_url = recorded.value().type_url();
+    const std::string type_name = type_url.substr(type_url.rfind('/') + 1);
+    ABSL_ASSIGN_OR_RETURN(Packet packet,
+                          packet_internal::PacketFromDynamicProto(
+                              type_name, recorded.value().value()),
+                          _ << "while loading the packet of stream \""
+                            << recorded.stream() << "\" at timestamp "
+                            << recorded.timestamp());
+    Frame& frame = frames[recorded.timestamp()];
+    frame.timestamp = recorded.timestamp();
+    frame.packets.emplace_back(recorded.stream(), std::move(packet));
+  }
+  std::vector<Frame> result;
+  result.reserve(frames.size());
+  for (auto& [timestamp, frame] : frames) {
+    result.push_back(std::move(frame));
+  }
+  return result;
+}
+
+// Summarizes exact latency samples, using nearest-rank percentiles.
+GraphBenchmarkReport::Latency LatencyFromSamples(
+    std::vector<int64_t> samples_usec) {
+  GraphBenchmarkReport::Latency latency;
+  latency.set_count(samples_usec.size());
+  if (samples_usec.empty()) {
+    return latency;
+  }
+  std::sort(samples_usec.begin(), samples_usec.end());
+  double sum = 0;
+  for (int64_t sample : samples_usec) {
+    sum += sample;
+  }
+  auto percentile = [&samples_usec](double p) {
+    const int64_t rank = static_cast<int64_t>(
+        std::ceil(p / 100.0 * static_cast<double>(samples_usec.size())));
+    return samples_usec[std::clamp<int64_t>(rank - 1, 0,
+                                            samples_usec.size() - 1)];
+  };
+  latency.set_mean_usec(sum / samples_usec.size());
+  latency.set_p50_usec(percentile(50));
+  latency.set_p90_usec(percentile(90));
+  latency.set_p99_usec(percentile(99));
+  latency.set_max_usec(samples_usec.back());
+  return latency;
+}
+
+GraphBenchmarkReport::Latency LatencyFromHistogram(
+    const TimeHistogram& histogram) {
+  GraphBenchmarkReport::Latency latency;
+  int64_t count = 0;
+  for (int i = 0; i < histogram.count_size(); ++i) {
+    count += histogram.count(i);
+  }
+  latency.set_count(count);
+  if (count == 0) {
+    return latency;
+  }
+  latency.set_mean_usec(static_cast<double>(histogram.total()) / count);
+  latency.set_p50_usec(HistogramPercentile(histogram, 50));
+  latency.set_p90_usec(HistogramPercentile(histogram, 90));
+  latency.set_p99_usec(HistogramPercentile(histogram, 99));
+  latency.set_max_usec(HistogramPercentile(histogram, 100));
+  return latency;
+}
+
+// Returns the peak resident set size of the process in kilobytes, or -1.
+int64_t PeakRssKb() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#if defined(__APPLE__)
+  // Reported in bytes on macOS.
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif  // defined(__APPLE__)
+#else
+  return -1;
+#endif  // defined(__linux__) || defined(__APPLE__)
+}
+
+}  // namespace
+
+int64_t HistogramPercentile(const TimeHistogram& histogram,
+                            double percentile) {
+  int64_t total = 0;
+  for (int64_t count : histogram.count()) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  const int64_t rank = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(percentile / 100.0 * total)));
+  int64_t cumulative = 0;
+  for (int i = 0; i < histogram.count_size(); ++i) {
+    cumulative += histogram.count(i);
+    if (cumulative >= rank) {
+      const bool is_last = i == histogram.count_size() - 1;
+      return (is_last ? i : i + 1) * histogram.interval_size_usec();
+    }
+  }
+  return (histogram.count_size() - 1) * histogram.interval_size_usec();
+}
+
+absl::StatusOr<GraphBenchmarkReport> RunGraphBenchmark(
+    CalculatorGraphConfig config, const GraphBenchmarkRecording& recording,
+    const GraphBenchmarkOptions& options) {
+  RET_CHECK_GT(options.num_repeats, 0);
+  RET_CHECK_GE(options.rate_hz, 0);
+  ABSL_ASSIGN_OR_RETURN(std::vector<Frame> frames, LoadFrames(recording));
+  RET_CHECK(!frames.empty()) << "The recording has no packets.";
+
+  // Timestamps keep increasing across repetitions of the recording.
+  const int64_t timestamp_span =
+      frames.back().timestamp - frames.front().timestamp + 1;
+  std::vector<int64_t> timestamps;
+  timestamps.reserve(frames.size() * options.num_repeats);
+  for (int repeat = 0; repeat < options.num_repeats; ++repeat) {
+    for (const Frame& frame : frames) {
+      timestamps.push_back(frame.timestamp + repeat * timestamp_span);
+    }
+  }
+
+  ProfilerConfig* profiler_config = config.mutable_profiler_config();
+  profiler_config->set_enable_profiler(true);
+  profiler_config->set_histogram_interval_size_usec(
+      options.histogram_interval_size_usec);
+  profiler_config->set_num_histogram_intervals(options.num_histogram_intervals);
+
+  // Feed times are indexed like `timestamps`. Both are preallocated so that
+  // the observers don't allocate while allocations are counted. They outlive
+  // the graph, which invokes the observers.
+  absl::Mutex mutex;
+  std::vector<absl::Time> feed_times(timestamps.size());
+  std::vector<int64_t> output_latencies_usec;
+  output_latencies_usec.reserve(timestamps.size() *
+                                config.output_stream_size());
+
+  CalculatorGraph graph;
+  std::shared_ptr<SimulationClock> simulation_clock;
+  Clock* clock = Clock::RealClock();
+  if (options.use_simulation_clock) {
+    auto executor =
+        std::make_shared<SimulationClockExecutor>(options.num_threads);
+    simulation_clock = executor->GetClock();
+    clock = simulation_clock.get();
+    ABSL_RETURN_IF_ERROR(graph.SetExecutor("", executor));
+  }
+  ABSL_RETURN_IF_ERROR(graph.Initialize(config));
+
+  for (const std::string& output_stream : graph.Config().output_stream()) {
+    std::string tag, name;
+    int index;
+    ABSL_RETURN_IF_ERROR(ParseTagIndexName(output_stream, &tag, &index, &name));
+    ABSL_RETURN_IF_ERROR(graph.ObserveOutputStream(
+        name, [&](const Packet& packet) {
+          const absl::Time now = absl::Now();
+          auto it = std::lower_bound(timestamps.begin(), timestamps.end(),
+                                     packet.Timestamp().Value());
+          if (it == timestamps.end() || *it != packet.Timestamp().Value()) {
+            return absl::OkStatus();
+          }
+          absl::MutexLock lock(mutex);
+          output_latencies_usec.push_back(absl::ToInt64Microseconds(
+              now - feed_times[it - timestamps.begin()]));
+          return absl::OkStatus();
+        }));
+  }
+
+  const int64_t allocations_before =
+      options.allocation_count ? options.allocation_count() : 0;
+  ABSL_RETURN_IF_ERROR(graph.StartRun(options.input_side_packets));
+  const absl::Time wall_start = absl::Now();
+  const absl::Time clock_start = clock->TimeNow();
+  if (simulation_clock) simulation_clock->ThreadStart();
+  auto feed_frames = [&]() -> absl::Status {
+    for (int i = 0; i < timestamps.size(); ++i) {
+      if (options.rate_hz > 0) {
+        clock->SleepUntil(clock_start + absl::Seconds(i / options.rate_hz));
+      }
+      {
+        absl::MutexLock lock(mutex);
+        feed_times[i] = absl::Now();
+      }
+      const Timestamp timestamp(timestamps[i]);
+      for (const auto& [stream, packet] : frames[i % frames.size()].packets) {
+        ABSL_RETURN_IF_ERROR(
+            graph.AddPacketToInputStream(stream, packet.At(timestamp)));
+      }
+    }
+    return absl::OkStatus();
+  };
+  absl::Status feed_status = feed_frames();
+  // The simulated time must be able to advance while the graph drains.
+  if (simulation_clock) simulation_clock->ThreadFinish();
+  absl::Status close_status = graph.CloseAllInputStreams();
+  absl::Status done_status = graph.WaitUntilDone();
+  ABSL_RETURN_IF_ERROR(done_status);
+  ABSL_RETURN_IF_ERROR(feed_status);
+  ABSL_RETURN_IF_ERROR(close_status);
+  const absl::Duration elapsed = absl::Now() - wall_start;
+  const int64_t allocations_after =
+      options.allocation_count ? options.allocation_count() : 0;
+
+  GraphBenchmarkReport report;
+  const int64_t num_frames = timestamps.size();
+  report.set_num_frames(num_frames);
+  report.set_elapsed_seconds(absl::ToDoubleSeconds(elapsed));
+  if (elapsed > absl::ZeroDuration()) {
+    report.set_frames_per_second(num_frames / absl::ToDoubleSeconds(elapsed));
+  }
+  if (simulation_clock) {
+    report.set_simulated_seconds(
+        absl::ToDoubleSeconds(clock->TimeNow() - clock_start));
+  }
+  {
+    absl::MutexLock lock(mutex);
+    *report.mutable_output_latency() =
+        LatencyFromSamples(std::move(output_latencies_usec));
+  }
+
+  // Per-node latencies are only available in builds with the profiler.
+  std::vector<CalculatorProfile> profiles;
+  if (graph.profiler() != nullptr &&
+      graph.profiler()->GetCalculatorProfiles(&profiles).ok()) {
+    for (const CalculatorProfile& profile : profiles) {
+      auto* node_latency = report.add_node_latency();
+      node_latency->set_name(profile.name());
+      *node_latency->mutable_process() =
+          LatencyFromHistogram(profile.process_runtime());
+    }
+  }
+
+  if (options.allocation_count) {
+    report.set_allocations_per_frame(
+        static_cast<double>(allocations_after - allocations_before) /
+        num_frames);
+  }
+  const int64_t peak_rss_kb = PeakRssKb();
+  if (peak_rss_kb >= 0) {
+    report.set_peak_rss_kb(peak_rss_kb);
+  }
+  return report;
+}
+
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,69 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_BENCHMARK_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_BENCHMARK_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/tool/graph_benchmark.pb.h"
+
+namespace mediapipe {
+
+namespace tool {
+
+struct GraphBenchmarkOptions {
+  // Passed to CalculatorGraph::StartRun.
+  std::map<std::string, Packet> input_side_packets;
+  // The rate at which frames are fed to the graph. If zero, frames are fed as
+  // fast as the graph accepts them.
+  double rate_hz = 0;
+  // The number of times the recording is replayed. Timestamps are shifted so
+  // that they keep increasing across repetitions.
+  int num_repeats = 1;
+  // Runs the graph on a SimulationClockExecutor and paces the frames on its
+  // clock, so that fixed-rate replays don't wait for wall time.
+  bool use_simulation_clock = false;
+  // The number of threads of the SimulationClockExecutor.
+  int num_threads = 4;
+  // The profiler histogram used for per-node latencies.
+  int64_t histogram_interval_size_usec = 100;
+  int64_t num_histogram_intervals = 10000;
+  // If set, returns the number of heap allocations made so far by the
+  // process. Allocations can only be counted by the binary, which owns the
+  // global allocation functions.
+  std::function<int64_t()> allocation_count;
+};
+
+// Replays `recording` through the graph and measures it.
+absl::StatusOr<GraphBenchmarkReport> RunGraphBenchmark(
+    CalculatorGraphConfig config, const GraphBenchmarkRecording& recording,
+    const GraphBenchmarkOptions& options);
+
+// Returns an upper bound of the given percentile, in [0, 100], of the samples
+// counted in `histogram`. The last interval, which extends to infinity, is
+// reported as its lower bound.
+int64_t HistogramPercentile(const TimeHistogram& histogram, double percentile);
+
+}  // namespace tool
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_BENCHMARK_H_
@@ -0,0 +1,122 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/graph_benchmark.h"
+
+#include <cstdint>
+
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_test.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/graph_benchmark.pb.h"
+
+namespace mediapipe {
+namespace tool {
+namespace {
+
+TEST(GraphBenchmarkTest, HistogramPercentile) {
+  auto histogram = ParseTextProtoOrDie<TimeHistogram>(R"pb(
+    interval_size_usec: 10
+    num_intervals: 4
+    count: [ 1, 2, 0, 1 ]
+  )pb");
+  EXPECT_EQ(HistogramPercentile(histogram, 0), 10);
+  EXPECT_EQ(HistogramPercentile(histogram, 25), 10);
+  EXPECT_EQ(HistogramPercentile(histogram, 50), 20);
+  EXPECT_EQ(HistogramPercentile(histogram, 75), 20);
+  // The last interval extends to infinity.
+  EXPECT_EQ(HistogramPercentile(histogram, 100), 30);
+  EXPECT_EQ(HistogramPercentile(TimeHistogram(), 50), 0);
+}
+
+CalculatorGraphConfig PassThroughGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "in"
+      output_stream: "out"
+    }
+  )pb");
+}
+
+GraphBenchmarkRecording SimpleProtoRecording(int num_frames) {
+  // Registers SimpleProto for PacketFromDynamicProto.
+  MakePacket<SimpleProto>();
+  GraphBenchmarkRecording recording;
+  for (int i = 0; i < num_frames; ++i) {
+    SimpleProto value;
+    value.add_value("frame");
+    auto* packet = recording.add_packet();
+    packet->set_stream("in");
+    packet->set_timestamp(i * 1000);
+    packet->mutable_value()->PackFrom(value);
+  }
+  return recording;
+}
+
+TEST(GraphBenchmarkTest, ReportsThroughputAndLatencies) {
+  GraphBenchmarkOptions options;
+  options.num_repeats = 3;
+  int64_t allocations = 0;
+  options.allocation_count = [&allocations]() { return allocations += 30; };
+  MP_ASSERT_OK_AND_ASSIGN(
+      GraphBenchmarkReport report,
+      RunGraphBenchmark(PassThroughGraphConfig(), SimpleProtoRecording(5),
+                        options));
+  EXPECT_EQ(report.num_frames(), 15);
+  EXPECT_GT(report.frames_per_second(), 0);
+  EXPECT_EQ(report.output_latency().count(), 15);
+  EXPECT_LE(report.output_latency().p50_usec(),
+            report.output_latency().p99_usec());
+  // Two calls to the fake counter, 30 allocations apart.
+  EXPECT_DOUBLE_EQ(report.allocations_per_frame(), 2.0);
+  EXPECT_FALSE(report.has_simulated_seconds());
+}
+
+TEST(GraphBenchmarkTest, PacesFramesOnSimulationClock) {
+  GraphBenchmarkOptions options;
+  options.rate_hz = 10;
+  options.use_simulation_clock = true;
+  MP_ASSERT_OK_AND_ASSIGN(
+      GraphBenchmarkReport report,
+      RunGraphBenchmark(PassThroughGraphConfig(), SimpleProtoRecording(20),
+                        options));
+  EXPECT_EQ(report.num_frames(), 20);
+  EXPECT_EQ(report.output_latency().count(), 20);
+  // The last frame is fed 1.9 simulated seconds after the first one, without
+  // waiting for wall time.
+  EXPECT_GE(report.simulated_seconds(), 1.9);
+  EXPECT_LT(report.elapsed_seconds(), 1.9);
+}
+
+TEST(GraphBenchmarkTest, RejectsUnknownPacketTypes) {
+  GraphBenchmarkRecording recording;
+  auto* packet = recording.add_packet();
+  packet->set_stream("in");
+  packet->mutable_value()->set_type_url("type.googleapis.com/NotAType");
+  EXPECT_FALSE(RunGraphBenchmark(PassThroughGraphConfig(), recording,
+                                 GraphBenchmarkOptions())
+                   .ok());
+}
+
+}  // namespace
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,266 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/graph_optimization.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/collection_item_id.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/tool/name_util.h"
+#include "mediapipe/framework/tool/tag_map.h"
+#include "mediapipe/framework/tool/validate_name.h"
+
+namespace mediapipe {
+
+namespace tool {
+
+namespace {
+
+constexpr char kPassThroughCalculator[] = "PassThroughCalculator";
+
+// Returns the name part of a "tag:index:name" stream. The config is not
+// validated yet, so malformed streams are reported rather than CHECK-failed.
+absl::StatusOr<std::string> StreamName(const std::string& stream) {
+  std::string tag, name;
+  int index;
+  ABSL_RETURN_IF_ERROR(ParseTagIndexName(stream, &tag, &index, &name));
+  return name;
+}
+
+// Returns the names of the graph output streams and of the streams listed in
+// GraphOptimizationConfig.observed_stream.
+absl::StatusOr<absl::flat_hash_set<std::string>> ObservedStreams(
+    const CalculatorGraphConfig& config) {
+  absl::flat_hash_set<std::string> observed;
+  for (const auto* streams :
+       {&config.output_stream(),
+        &config.graph_optimization().observed_stream()}) {
+    for (const auto& stream : *streams) {
+      ABSL_ASSIGN_OR_RETURN(std::string name, StreamName(stream));
+      observed.insert(std::move(name));
+    }
+  }
+  return observed;
+}
+
+// Returns the names of the input streams of `node` declared as back edges.
+absl::StatusOr<absl::flat_hash_set<std::string>> BackEdgeStreams(
+    const CalculatorGraphConfig::Node& node) {
+  absl::flat_hash_set<std::string> back_edges;
+  if (node.input_stream_info().empty()) {
+    return back_edges;
+  }
+  ABSL_ASSIGN_OR_RETURN(std::shared_ptr<TagMap> tag_map,
+                        TagMap::Create(node.input_stream()));
+  for (const auto& info : node.input_stream_info()) {
+    if (!info.back_edge()) continue;
+    std::string tag;
+    int index;
+    ABSL_RETURN_IF_ERROR(ParseTagIndex(info.tag_index(), &tag, &index));
+    CollectionItemId id = tag_map->GetId(tag, index);
+    RET_CHECK(id.IsValid()) << "Input stream info \"" << info.tag_index()
+                            << "\" does not match an input stream of node "
+                            << node.calculator();
+    back_edges.insert(tag_map->Names()[id.value()]);
+  }
+  return back_edges;
+}
+
+// Removes the nodes for which `remove` is true, recording their canonical
+// names in `removed_names`. The remaining nodes are named explicitly so that
+// their canonical names don't depend on the removed ones.
+void RemoveNodes(const std::vector<bool>& remove, CalculatorGraphConfig* config,
+                 std::vector<std::string>* removed_names) {
+  std::vector<std::string> names(config->node_size());
+  for (int i = 0; i < config->node_size(); ++i) {
+    names[i] = CanonicalNodeName(*config, i);
+  }
+  int num_kept = 0;
+  for (int i = 0; i < config->node_size(); ++i) {
+    if (remove[i]) {
+      removed_names->push_back(names[i]);
+      continue;
+    }
+    if (num_kept != i) {
+      config->mutable_node()->SwapElements(num_kept, i);
+    }
+    config->mutable_node(num_kept)->set_name(names[i]);
+    ++num_kept;
+  }
+  config->mutable_node()->DeleteSubrange(num_kept,
+                                         config->node_size() - num_kept);
+}
+
+// Removes the nodes none of whose output streams leads to an observed stream.
+// Nodes without output streams and nodes with output side packets are kept.
+absl::Status PruneUnobservedNodes(CalculatorGraphConfig* config,
+                                  GraphOptimizationStats* stats) {
+  const int num_nodes = config->node_size();
+  absl::flat_hash_map<std::string, int> stream_to_producer;
+  for (int i = 0; i < num_nodes; ++i) {
+    for (const auto& stream : config->node(i).output_stream()) {
+      ABSL_ASSIGN_OR_RETURN(std::string name, StreamName(stream));
+      stream_to_producer[name] = i;
+    }
+  }
+
+  std::vector<bool> live(num_nodes, false);
+  std::vector<int> worklist;
+  auto mark_live = [&live, &worklist](int node_id) {
+    if (!live[node_id]) {
+      live[node_id] = true;
+      worklist.push_back(node_id);
+    }
+  };
+  ABSL_ASSIGN_OR_RETURN(absl::flat_hash_set<std::string> observed,
+                        ObservedStreams(*config));
+  for (const std::string& stream : observed) {
+    auto it = stream_to_producer.find(stream);
+    if (it != stream_to_producer.end()) mark_live(it->second);
+  }
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node = config->node(i);
+    if (node.output_stream().empty() || !node.output_side_packet().empty()) {
+      mark_live(i);
+    }
+  }
+  while (!worklist.empty()) {
+    const int node_id = worklist.back();
+    worklist.pop_back();
+    for (const auto& stream : config->node(node_id).input_stream()) {
+      ABSL_ASSIGN_OR_RETURN(std::string name, StreamName(stream));
+      auto it = stream_to_producer.find(name);
+      if (it != stream_to_producer.end()) mark_live(it->second);
+    }
+  }
+
+  std::vector<bool> remove(num_nodes);
+  bool any_removed = false;
+  for (int i = 0; i < num_nodes; ++i) {
+    remove[i] = !live[i];
+    any_removed |= remove[i];
+  }
+  if (any_removed) {
+    RemoveNodes(remove, config, &stats->pruned_nodes);
+  }
+  return absl::OkStatus();
+}
+
+// Returns the mapping from the output streams of a pass-through node to its
+// input streams, or an empty map if the node can't be spliced out.
+absl::StatusOr<std::map<std::string, std::string>> PassThroughStreams(
+    const CalculatorGraphConfig::Node& node,
+    const absl::flat_hash_set<std::string>& protected_streams) {
+  std::map<std::string, std::string> stream_map;
+  if (node.calculator() != kPassThroughCalculator ||
+      !node.input_stream_info().empty() || node.has_input_stream_handler() ||
+      !node.output_side_packet().empty() || node.output_stream().empty()) {
+    return stream_map;
+  }
+  ABSL_ASSIGN_OR_RETURN(std::shared_ptr<TagMap> inputs,
+                        TagMap::Create(node.input_stream()));
+  ABSL_ASSIGN_OR_RETURN(std::shared_ptr<TagMap> outputs,
+                        TagMap::Create(node.output_stream()));
+  for (CollectionItemId id = outputs->BeginId(); id < outputs->EndId(); ++id) {
+    const std::string& output_name = outputs->Names()[id.value()];
+    if (protected_streams.contains(output_name)) {
+      return std::map<std::string, std::string>();
+    }
+    std::pair<std::string, int> tag_index = outputs->TagAndIndexFromId(id);
+    CollectionItemId input_id =
+        inputs->GetId(tag_index.first, tag_index.second);
+    if (!input_id.IsValid()) {
+      return std::map<std::string, std::string>();
+    }
+    stream_map[output_name] = inputs->Names()[input_id.value()];
+  }
+  return stream_map;
+}
+
+// Connects the consumers of pass-through nodes to the streams they forward,
+// then removes the pass-through nodes.
+absl::Status ElidePassThroughNodes(CalculatorGraphConfig* config,
+                                   GraphOptimizationStats* stats) {
+  // Observed streams must keep their producer, and a back edge must not be
+  // shortened into a self-loop, so streams consumed as back edges are kept.
+  ABSL_ASSIGN_OR_RETURN(absl::flat_hash_set<std::string> protected_streams,
+                        ObservedStreams(*config));
+  for (const auto& node : config->node()) {
+    ABSL_ASSIGN_OR_RETURN(absl::flat_hash_set<std::string> back_edges,
+                          BackEdgeStreams(node));
+    protected_streams.insert(back_edges.begin(), back_edges.end());
+  }
+
+  const int num_nodes = config->node_size();
+  std::vector<bool> remove(num_nodes, false);
+  bool any_removed = false;
+  for (int i = 0; i < num_nodes; ++i) {
+    const CalculatorGraphConfig::Node& node = config->node(i);
+    ABSL_ASSIGN_OR_RETURN(auto stream_map,
+                          PassThroughStreams(node, protected_streams));
+    if (stream_map.empty()) continue;
+    remove[i] = true;
+    any_removed = true;
+    // Renaming all nodes, including later pass-through nodes, splices out
+    // chains of pass-through nodes one link at a time.
+    for (auto& consumer : *config->mutable_node()) {
+      for (auto& stream : *consumer.mutable_input_stream()) {
+        std::string tag, name;
+        int index;
+        ABSL_RETURN_IF_ERROR(ParseTagIndexName(stream, &tag, &index, &name));
+        auto it = stream_map.find(name);
+        if (it == stream_map.end()) continue;
+        stream = CatStream({tag, index}, it->second);
+      }
+    }
+  }
+  if (any_removed) {
+    RemoveNodes(remove, config, &stats->elided_nodes);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status OptimizeGraph(CalculatorGraphConfig* config,
+                           GraphOptimizationStats* stats) {
+  GraphOptimizationStats local_stats;
+  if (stats == nullptr) stats = &local_stats;
+  *stats = GraphOptimizationStats();
+  stats->num_input_nodes = config->node_size();
+
+  const GraphOptimizationConfig& options = config->graph_optimization();
+  // Pruning first, so that unobserved pass-through nodes count as pruned.
+  if (options.prune_unobserved_nodes()) {
+    ABSL_RETURN_IF_ERROR(PruneUnobservedNodes(config, stats));
+  }
+  if (options.elide_pass_through_nodes()) {
+    ABSL_RETURN_IF_ERROR(ElidePassThroughNodes(config, stats));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace tool
+}  // namespace mediapipe
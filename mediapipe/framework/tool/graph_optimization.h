@@ -0,0 +1,57 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_OPTIMIZATION_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_OPTIMIZATION_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/calculator.pb.h"
+
+namespace mediapipe {
+
+namespace tool {
+
+// Describes the nodes removed by OptimizeGraph.
+struct GraphOptimizationStats {
+  // The number of calculator nodes before optimization.
+  int num_input_nodes = 0;
+  // The canonical names of the nodes removed because none of their outputs
+  // is observed.
+  std::vector<std::string> pruned_nodes;
+  // The canonical names of the pass-through nodes spliced out of the graph.
+  std::vector<std::string> elided_nodes;
+
+  // Every removed node saves one Process() call per input timestamp, so this
+  // is also the per-frame saving in Process() calls.
+  int NumRemovedNodes() const {
+    return pruned_nodes.size() + elided_nodes.size();
+  }
+};
+
+// Applies the optimizations enabled in config->graph_optimization() to the
+// nodes of an expanded graph config, see GraphOptimizationConfig.
+//
+// Nodes which are kept retain their canonical names, so that per-node
+// settings keyed by node name (e.g. in the profiler output) are unaffected.
+// `stats` is optional.
+absl::Status OptimizeGraph(CalculatorGraphConfig* config,
+                           GraphOptimizationStats* stats = nullptr);
+
+}  // namespace tool
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_OPTIMIZATION_H_
@@ -0,0 +1,253 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/graph_optimization.h"
+
+#include <vector>
+
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(GraphOptimizationTest, PrunesUnobservedNodes) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    graph_optimization { prune_unobserved_nodes: true }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "doubled"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "doubled"
+      output_stream: "unused"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "doubled"
+      output_stream: "out"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "debug"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "debug"
+      output_stream: "debug_unused"
+    }
+  )pb");
+  auto expected_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    graph_optimization { prune_unobserved_nodes: true }
+    node {
+      name: "DoubleIntCalculator_1"
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "doubled"
+    }
+    node {
+      name: "DoubleIntCalculator_3"
+      calculator: "DoubleIntCalculator"
+      input_stream: "doubled"
+      output_stream: "out"
+    }
+  )pb");
+  tool::GraphOptimizationStats stats;
+  MP_ASSERT_OK(tool::OptimizeGraph(&config, &stats));
+  EXPECT_THAT(config, EqualsProto(expected_config));
+  EXPECT_EQ(stats.num_input_nodes, 5);
+  EXPECT_THAT(stats.pruned_nodes,
+              ElementsAre("DoubleIntCalculator_2", "DoubleIntCalculator_4",
+                          "DoubleIntCalculator_5"));
+  EXPECT_THAT(stats.elided_nodes, IsEmpty());
+  EXPECT_EQ(stats.NumRemovedNodes(), 3);
+}
+
+TEST(GraphOptimizationTest, KeepsObservedStreamsAndSideEffects) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    graph_optimization {
+      prune_unobserved_nodes: true
+      observed_stream: "TAG:observed"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "observed"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "in"
+      output_stream: "sunk"
+    }
+    node { calculator: "CallbackCalculator" input_stream: "sunk" }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "in"
+      output_stream: "side"
+      input_side_packet: "side_in"
+      output_side_packet: "side_out"
+    }
+  )pb");
+  CalculatorGraphConfig expected_config = config;
+  tool::GraphOptimizationStats stats;
+  MP_ASSERT_OK(tool::OptimizeGraph(&config, &stats));
+  EXPECT_THAT(config, EqualsProto(expected_config));
+  EXPECT_EQ(stats.NumRemovedNodes(), 0);
+}
+
+TEST(GraphOptimizationTest, ElidesPassThroughNodes) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    input_stream: "in2"
+    output_stream: "out"
+    output_stream: "passed_out"
+    graph_optimization { elide_pass_through_nodes: true }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "A:in"
+      input_stream: "B:in2"
+      output_stream: "A:a"
+      output_stream: "B:b"
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "a"
+      output_stream: "a2"
+    }
+    node {
+      calculator: "MergeCalculator"
+      input_stream: "X:a2"
+      input_stream: "Y:b"
+      output_stream: "out"
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "out"
+      output_stream: "passed_out"
+    }
+  )pb");
+  auto expected_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    input_stream: "in2"
+    output_stream: "out"
+    output_stream: "passed_out"
+    graph_optimization { elide_pass_through_nodes: true }
+    node {
+      name: "MergeCalculator"
+      calculator: "MergeCalculator"
+      input_stream: "X:in"
+      input_stream: "Y:in2"
+      output_stream: "out"
+    }
+    node {
+      name: "PassThroughCalculator_3"
+      calculator: "PassThroughCalculator"
+      input_stream: "out"
+      output_stream: "passed_out"
+    }
+  )pb");
+  tool::GraphOptimizationStats stats;
+  MP_ASSERT_OK(tool::OptimizeGraph(&config, &stats));
+  EXPECT_THAT(config, EqualsProto(expected_config));
+  EXPECT_THAT(stats.elided_nodes, ElementsAre("PassThroughCalculator_1",
+                                              "PassThroughCalculator_2"));
+}
+
+TEST(GraphOptimizationTest, KeepsPassThroughNodesOnBackEdges) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    graph_optimization { elide_pass_through_nodes: true }
+    node {
+      calculator: "MergeCalculator"
+      input_stream: "in"
+      input_stream: "loop"
+      input_stream_info: { tag_index: ":1" back_edge: true }
+      output_stream: "out"
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "out"
+      output_stream: "loop"
+    }
+  )pb");
+  CalculatorGraphConfig expected_config = config;
+  tool::GraphOptimizationStats stats;
+  MP_ASSERT_OK(tool::OptimizeGraph(&config, &stats));
+  EXPECT_THAT(config, EqualsProto(expected_config));
+  EXPECT_EQ(stats.NumRemovedNodes(), 0);
+}
+
+TEST(GraphOptimizationTest, OptimizedGraphRuns) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    output_stream: "out"
+    graph_optimization {
+      prune_unobserved_nodes: true
+      elide_pass_through_nodes: true
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "in"
+      output_stream: "passed"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "passed"
+      output_stream: "out"
+    }
+    node {
+      calculator: "DoubleIntCalculator"
+      input_stream: "passed"
+      output_stream: "unused"
+    }
+  )pb");
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  EXPECT_EQ(graph.Config().node_size(), 1);
+
+  std::vector<Packet> outputs;
+  MP_ASSERT_OK(graph.ObserveOutputStream("out", [&outputs](const Packet& p) {
+    outputs.push_back(p);
+    return absl::OkStatus();
+  }));
+  MP_ASSERT_OK(graph.StartRun({}));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "in", MakePacket<int>(21).At(Timestamp(0))));
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  ASSERT_EQ(outputs.size(), 1);
+  EXPECT_EQ(outputs[0].Get<int>(), 42);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -132,11 +132,24 @@ absl::StatusOr<std::string> GetGraphRuntimeInfoString(
           ? "None"
           : absl::StrCat(" (running calculators: ",
                          absl::StrJoin(running_calculators, ", "), ")");
+  std::string cpu_thread_budget_str;
+  if (graph_runtime_info.has_cpu_thread_budget()) {
+    const auto& budget = graph_runtime_info.cpu_thread_budget();
+    absl::StrAppend(&cpu_thread_budget_str, "CPU thread budget: ",
+                    budget.num_threads(), " threads, ",
+                    budget.num_available_threads(), " available\n");
+    for (const auto& reservation : budget.reservations()) {
+      absl::StrAppend(&cpu_thread_budget_str, " * ", reservation.owner(),
+                      " - requested: ", reservation.requested_threads(),
+                      ", granted: ", reservation.granted_threads(), "\n");
+    }
+  }
   return absl::StrFormat(
       "Graph runtime info: \nRunning calculators: %s\nNum packets in input "
-      "queues: %d\n%s\n%s\n",
+      "queues: %d\n%s\n%s\n%s",
       running_calculators_str, num_total_pending_packets,
-      calulators_with_unprocessed_packets_str, calculators_runtime_info_str);
+      calulators_with_unprocessed_packets_str, calculators_runtime_info_str,
+      cpu_thread_budget_str);
 }
 
 }  // namespace mediapipe::tool
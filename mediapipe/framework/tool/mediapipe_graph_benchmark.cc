@@ -0,0 +1,167 @@
+// Copyright 2025 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Replays recorded input packets through a graph and reports throughput,
+// latencies, allocations and memory as a GraphBenchmarkReport text proto, e.g.
+//
+//   mediapipe_graph_benchmark \
+//     --calculator_graph_config_file=graph.pbtxt \
+//     --recording_file=recording.pbtxt --rate_hz=30 --num_repeats=10 \
+//     --report_file=report.pbtxt
+//
+// The message types of the recorded packets, and the calculators of the
+// graph, must be linked into the binary: add them to the deps of a copy of
+// the mediapipe_graph_benchmark target.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/log/absl_log.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/proto_ns.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/tool/graph_benchmark.h"
+#include "mediapipe/framework/tool/graph_benchmark.pb.h"
+
+ABSL_FLAG(std::string, calculator_graph_config_file, "",
+          "Name of file containing text format CalculatorGraphConfig proto.");
+ABSL_FLAG(std::string, recording_file, "",
+          "Name of file containing a GraphBenchmarkRecording proto, in text "
+          "format if the name ends with .pbtxt, in binary format otherwise.");
+ABSL_FLAG(std::string, input_side_packets, "",
+          "Comma-separated list of key=value pairs specifying string side "
+          "packets for the CalculatorGraph.");
+ABSL_FLAG(double, rate_hz, 0,
+          "The rate at which frames are fed. If 0, frames are fed as fast as "
+          "the graph accepts them.");
+ABSL_FLAG(int, num_repeats, 1, "The number of times the recording is fed.");
+ABSL_FLAG(bool, simulation_clock, false,
+          "Runs the graph on a SimulationClockExecutor and paces the frames on "
+          "its clock instead of the wall clock.");
+ABSL_FLAG(int, num_threads, 4,
+          "The number of threads of the SimulationClockExecutor.");
+ABSL_FLAG(int64_t, histogram_interval_size_usec, 100,
+          "The resolution of the per-node latency histograms.");
+ABSL_FLAG(std::string, report_file, "",
+          "Name of the file to write the GraphBenchmarkReport text proto to. "
+          "The report is written to stdout if empty.");
+
+namespace {
+
+// Counts the calls to the global allocation functions. The array and nothrow
+// variants forward to these ones by default; over-aligned allocations are not
+// counted. Running out of memory aborts.
+std::atomic<int64_t> allocation_count{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) std::abort();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace mediapipe {
+namespace {
+
+absl::Status ReadTextProto(const std::string& path, proto_ns::Message* proto) {
+  std::string contents;
+  ABSL_RETURN_IF_ERROR(file::GetContents(path, &contents));
+  RET_CHECK(proto_ns::TextFormat::ParseFromString(contents, proto))
+      << "could not parse text proto: " << path;
+  return absl::OkStatus();
+}
+
+absl::Status RunGraphBenchmarkMain() {
+  CalculatorGraphConfig config;
+  ABSL_RETURN_IF_ERROR(ReadTextProto(
+      absl::GetFlag(FLAGS_calculator_graph_config_file), &config));
+
+  GraphBenchmarkRecording recording;
+  const std::string recording_file = absl::GetFlag(FLAGS_recording_file);
+  if (absl::EndsWith(recording_file, ".pbtxt")) {
+    ABSL_RETURN_IF_ERROR(ReadTextProto(recording_file, &recording));
+  } else {
+    std::string contents;
+    ABSL_RETURN_IF_ERROR(file::GetContents(recording_file, &contents));
+    RET_CHECK(recording.ParseFromString(contents))
+        << "could not parse binary proto: " << recording_file;
+  }
+
+  tool::GraphBenchmarkOptions options;
+  if (!absl::GetFlag(FLAGS_input_side_packets).empty()) {
+    for (absl::string_view kv_pair :
+         absl::StrSplit(absl::GetFlag(FLAGS_input_side_packets), ',')) {
+      std::vector<std::string> name_and_value = absl::StrSplit(kv_pair, '=');
+      RET_CHECK(name_and_value.size() == 2);
+      options.input_side_packets[name_and_value[0]] =
+          MakePacket<std::string>(name_and_value[1]);
+    }
+  }
+  options.rate_hz = absl::GetFlag(FLAGS_rate_hz);
+  options.num_repeats = absl::GetFlag(FLAGS_num_repeats);
+  options.use_simulation_clock = absl::GetFlag(FLAGS_simulation_clock);
+  options.num_threads = absl::GetFlag(FLAGS_num_threads);
+  options.histogram_interval_size_usec =
+      absl::GetFlag(FLAGS_histogram_interval_size_usec);
+  options.allocation_count = []() {
+    return allocation_count.load(std::memory_order_relaxed);
+  };
+
+  ABSL_ASSIGN_OR_RETURN(
+      GraphBenchmarkReport report,
+      tool::RunGraphBenchmark(std::move(config), recording, options));
+  std::string report_text;
+  RET_CHECK(proto_ns::TextFormat::PrintToString(report, &report_text));
+  const std::string report_file = absl::GetFlag(FLAGS_report_file);
+  if (report_file.empty()) {
+    std::cout << report_text;
+    return absl::OkStatus();
+  }
+  return file::SetContents(report_file, report_text);
+}
+
+}  // namespace
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  absl::Status status = mediapipe::RunGraphBenchmarkMain();
+  if (!status.ok()) {
+    ABSL_LOG(ERROR) << "Graph benchmark failed: " << status;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -43,6 +43,7 @@
 #include "mediapipe/framework/status_handler.h"
 #include "mediapipe/framework/stream_handler.pb.h"
 #include "mediapipe/framework/thread_pool_executor.pb.h"
+#include "mediapipe/framework/tool/graph_optimization.h"
 #include "mediapipe/framework/tool/name_util.h"
 #include "mediapipe/framework/tool/status_util.h"
 #include "mediapipe/framework/tool/subgraph_expansion.h"
@@ -460,6 +461,10 @@ absl::Status ValidatedGraphConfig::PerformBasicTransforms(
 
   ABSL_RETURN_IF_ERROR(AddPredefinedExecutorConfigs(&config_));
 
+  if (config_.has_graph_optimization()) {
+    ABSL_RETURN_IF_ERROR(tool::OptimizeGraph(&config_, &optimization_stats_));
+  }
+
   // Populate each node with the graph level input stream handler if a
   // stream handler wasn't explicitly provided.
   // TODO Instead of pre-populating, handle the graph level
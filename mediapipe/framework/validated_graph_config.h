@@ -32,6 +32,7 @@
 #include "mediapipe/framework/port/status_builder.h"
 #include "mediapipe/framework/status_handler.pb.h"
 #include "mediapipe/framework/subgraph.h"
+#include "mediapipe/framework/tool/graph_optimization.h"
 
 namespace mediapipe {
 
@@ -252,6 +253,12 @@ class ValidatedGraphConfig {
   // The proto configuration (canonicalized).
   const CalculatorGraphConfig& Config() const { return config_; }
 
+  // The nodes removed by the optimizations enabled in
+  // CalculatorGraphConfig.graph_optimization.
+  const tool::GraphOptimizationStats& OptimizationStats() const {
+    return optimization_stats_;
+  }
+
   // Accessors for the info objects.
   const std::vector<NodeTypeInfo>& CalculatorInfos() const {
     return calculators_;
@@ -320,7 +327,7 @@ class ValidatedGraphConfig {
 
  private:
   // Perform transforms such as converting legacy features, expanding
-  // subgraphs, and popluting input stream handler.
+  // subgraphs, optimizing the graph, and popluting input stream handler.
   absl::Status PerformBasicTransforms(
       const GraphRegistry* graph_registry,
       const Subgraph::SubgraphOptions* graph_options,
@@ -424,6 +431,7 @@ class ValidatedGraphConfig {
   bool initialized_ = false;
 
   CalculatorGraphConfig config_;
+  tool::GraphOptimizationStats optimization_stats_;
 
   // The type information for each node type.
   std::vector<NodeTypeInfo> calculators_;
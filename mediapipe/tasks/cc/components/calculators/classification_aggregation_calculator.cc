@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -43,18 +44,24 @@ using ::mediapipe::tasks::components::containers::proto::ClassificationResult;
 //   TIMESTAMPS - std::vector<Timestamp> @Optional
 //     The collection of the timestamps that this calculator should aggregate.
 //     This stream is optional: if provided then the TIMESTAMPED_CLASSIFICATIONS
-//     output is used for results. Otherwise as no timestamp aggregation is
+//     output is used for results, or the CLASSIFICATIONS output if the
+//     classifications are pooled. Otherwise as no timestamp aggregation is
 //     required the CLASSIFICATIONS output is used for results.
 //
 // Outputs:
 //   CLASSIFICATIONS - ClassificationResult @Optional
 //     The classification results aggregated by head. Must be connected if the
 //     TIMESTAMPS input is not connected, as it signals that timestamp
-//     aggregation is not required.
+//     aggregation is not required, or if the classifications are pooled.
 //   TIMESTAMPED_CLASSIFICATIONS - std::vector<ClassificationResult> @Optional
 //     The classification result aggregated by timestamp, then by head. Must be
-//     connected if the TIMESTAMPS input is connected, as it signals that
-//     timestamp aggregation is required.
+//     connected if the TIMESTAMPS input is connected and the classifications
+//     are not pooled, as it signals that timestamp aggregation is required.
+//
+// If `pooling` is set in the options, the classifications of the timestamps
+// are pooled into a single ClassificationResult instead, whose categories are
+// then filtered and sorted by descending pooled score. This is how the scores
+// of the overlapping windows of a long text are combined.
 //
 // Example without timestamp aggregation:
 // node {
@@ -88,6 +95,20 @@ using ::mediapipe::tasks::components::containers::proto::ClassificationResult;
 //    }
 //  }
 // }
+//
+// Example with pooling:
+// node {
+//   calculator: "ClassificationAggregationCalculator"
+//   input_stream: "CLASSIFICATIONS:0:stream_a"
+//   input_stream: "TIMESTAMPS:timestamps"
+//   output_stream: "CLASSIFICATIONS:classifications"
+//   options {
+//    [mediapipe.ClassificationAggregationCalculatorOptions.ext] {
+//      pooling: MEAN
+//      pooled_head_options { top_k: 3 }
+//    }
+//  }
+// }
 class ClassificationAggregationCalculator : public Node {
  public:
   static constexpr Input<ClassificationList>::Multiple kClassificationListIn{
@@ -111,14 +132,98 @@ class ClassificationAggregationCalculator : public Node {
  private:
   std::vector<std::string> head_names_;
   bool time_aggregation_enabled_;
+  ClassificationAggregationCalculatorOptions::Pooling pooling_ =
+      ClassificationAggregationCalculatorOptions::NONE;
   std::unordered_map<int64_t, std::vector<ClassificationList>>
       cached_classifications_;
 
   ClassificationResult ConvertToClassificationResult(CalculatorContext* cc);
   std::vector<ClassificationResult> ConvertToTimestampedClassificationResults(
       CalculatorContext* cc);
+  ClassificationResult PoolClassificationResults(CalculatorContext* cc);
 };
 
+namespace {
+
+// Pools the `classification_lists` of one head at several timestamps into
+// `pooled_list`, then filters and sorts the pooled categories as specified by
+// `head_options`.
+void PoolClassificationLists(
+    const std::vector<const ClassificationList*>& classification_lists,
+    const ClassificationAggregationCalculatorOptions& options,
+    const ClassificationAggregationCalculatorOptions::PooledHeadOptions&
+        head_options,
+    ClassificationList* pooled_list) {
+  const int num_timestamps = classification_lists.size();
+  std::vector<float> weights(num_timestamps, 1.0f / num_timestamps);
+  if (options.pooling() ==
+      ClassificationAggregationCalculatorOptions::ATTENTION) {
+    // Softmax of the top scores, shifted by their maximum for stability.
+    std::vector<float> top_scores(num_timestamps, 0.0f);
+    for (int i = 0; i < num_timestamps; ++i) {
+      for (int j = 0; j < classification_lists[i]->classification_size(); ++j) {
+        const float score = classification_lists[i]->classification(j).score();
+        top_scores[i] = j == 0 ? score : std::max(top_scores[i], score);
+      }
+    }
+    const float max_top_score =
+        *std::max_element(top_scores.begin(), top_scores.end());
+    float sum = 0.0f;
+    for (int i = 0; i < num_timestamps; ++i) {
+      weights[i] = std::exp((top_scores[i] - max_top_score) /
+                            options.attention_temperature());
+      sum += weights[i];
+    }
+    for (float& weight : weights) {
+      weight /= sum;
+    }
+  }
+
+  const bool max_pooling =
+      options.pooling() == ClassificationAggregationCalculatorOptions::MAX;
+  std::unordered_map<int, int> pooled_position_by_index;
+  auto* pooled = pooled_list->mutable_classification();
+  for (int i = 0; i < num_timestamps; ++i) {
+    for (const auto& classification :
+         classification_lists[i]->classification()) {
+      auto [it, inserted] = pooled_position_by_index.try_emplace(
+          classification.index(), pooled->size());
+      if (inserted) {
+        *pooled->Add() = classification;
+        pooled->Mutable(it->second)
+            ->set_score(max_pooling ? classification.score()
+                                    : weights[i] * classification.score());
+        continue;
+      }
+      auto* pooled_classification = pooled->Mutable(it->second);
+      pooled_classification->set_score(
+          max_pooling
+              ? std::max(pooled_classification->score(), classification.score())
+              : pooled_classification->score() +
+                    weights[i] * classification.score());
+    }
+  }
+
+  if (head_options.has_min_score_threshold()) {
+    pooled->erase(std::remove_if(pooled->begin(), pooled->end(),
+                                 [&head_options](const Classification& c) {
+                                   return c.score() <
+                                          head_options.min_score_threshold();
+                                 }),
+                  pooled->end());
+  }
+  std::stable_sort(pooled->begin(), pooled->end(),
+                   [](const Classification& a, const Classification& b) {
+                     return a.score() > b.score();
+                   });
+  if (head_options.top_k() > 0 && pooled->size() > head_options.top_k()) {
+    pooled->DeleteSubrange(head_options.top_k(),
+                           pooled->size() - head_options.top_k());
+  }
+}
+
+}  // namespace
+
 absl::Status ClassificationAggregationCalculator::UpdateContract(
     CalculatorContract* cc) {
   RET_CHECK_GE(kClassificationListIn(cc).Count(), 1);
@@ -129,7 +234,18 @@ absl::Status ClassificationAggregationCalculator::UpdateContract(
         << "The size of classifications input streams should match the "
            "size of head names specified in the calculator options";
   }
-  if (kTimestampsIn(cc).IsConnected()) {
+  if (!options.pooled_head_options().empty()) {
+    RET_CHECK_EQ(kClassificationListIn(cc).Count(),
+                 options.pooled_head_options().size())
+        << "The size of classifications input streams should match the "
+           "size of pooled head options specified in the calculator options";
+  }
+  if (options.pooling() != ClassificationAggregationCalculatorOptions::NONE) {
+    RET_CHECK(kTimestampsIn(cc).IsConnected())
+        << "Pooling requires the TIMESTAMPS input to be connected";
+    RET_CHECK(kClassificationsOut(cc).IsConnected());
+    RET_CHECK_GT(options.attention_temperature(), 0.0f);
+  } else if (kTimestampsIn(cc).IsConnected()) {
     RET_CHECK(kTimestampedClassificationsOut(cc).IsConnected());
   } else {
     RET_CHECK(kClassificationsOut(cc).IsConnected());
@@ -141,6 +257,7 @@ absl::Status ClassificationAggregationCalculator::Open(CalculatorContext* cc) {
   time_aggregation_enabled_ = kTimestampsIn(cc).IsConnected();
   const auto& options =
       cc->Options<ClassificationAggregationCalculatorOptions>();
+  pooling_ = options.pooling();
   if (!options.head_names().empty()) {
     head_names_.assign(options.head_names().begin(),
                        options.head_names().end());
@@ -163,8 +280,12 @@ absl::Status ClassificationAggregationCalculator::Process(
     if (kTimestampsIn(cc).IsEmpty()) {
       return absl::OkStatus();
     }
-    kTimestampedClassificationsOut(cc).Send(
-        ConvertToTimestampedClassificationResults(cc));
+    if (pooling_ != ClassificationAggregationCalculatorOptions::NONE) {
+      kClassificationsOut(cc).Send(PoolClassificationResults(cc));
+    } else {
+      kTimestampedClassificationsOut(cc).Send(
+          ConvertToTimestampedClassificationResults(cc));
+    }
   } else {
     kClassificationsOut(cc).Send(ConvertToClassificationResult(cc));
   }
@@ -218,6 +339,53 @@ ClassificationAggregationCalculator::ConvertToTimestampedClassificationResults(
   return results;
 }
 
+ClassificationResult
+ClassificationAggregationCalculator::PoolClassificationResults(
+    CalculatorContext* cc) {
+  const auto& options =
+      cc->Options<ClassificationAggregationCalculatorOptions>();
+  const auto& timestamps = kTimestampsIn(cc).Get();
+  const int num_heads = kClassificationListIn(cc).Count();
+  std::vector<std::vector<ClassificationList>> timestamped_lists;
+  timestamped_lists.reserve(timestamps.size());
+  for (const auto& timestamp : timestamps) {
+    auto it = cached_classifications_.find(timestamp.Value());
+    if (it != cached_classifications_.end()) {
+      timestamped_lists.push_back(std::move(it->second));
+      cached_classifications_.erase(it);
+    }
+  }
+
+  ClassificationResult result;
+  result.set_timestamp_ms(
+      (timestamps.empty() ? cc->InputTimestamp() : timestamps[0]).Value() /
+      1000);
+  std::vector<const ClassificationList*> head_lists;
+  head_lists.reserve(timestamped_lists.size());
+  for (int i = 0; i < num_heads; ++i) {
+    auto classifications = result.add_classifications();
+    classifications->set_head_index(i);
+    if (!head_names_.empty()) {
+      classifications->set_head_name(head_names_[i]);
+    }
+    if (timestamped_lists.empty()) {
+      continue;
+    }
+    head_lists.clear();
+    for (const auto& lists : timestamped_lists) {
+      head_lists.push_back(&lists[i]);
+    }
+    PoolClassificationLists(
+        head_lists, options,
+        options.pooled_head_options().empty()
+            ? ClassificationAggregationCalculatorOptions::PooledHeadOptions::
+                  default_instance()
+            : options.pooled_head_options(i),
+        classifications->mutable_classification_list());
+  }
+  return result;
+}
+
 MEDIAPIPE_REGISTER_NODE(ClassificationAggregationCalculator);
 
 }  // namespace api2
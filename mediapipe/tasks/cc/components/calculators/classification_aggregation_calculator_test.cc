@@ -18,7 +18,9 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -45,6 +47,7 @@ using ::mediapipe::api2::builder::Graph;
 using ::mediapipe::api2::builder::Source;
 using ::mediapipe::tasks::components::containers::proto::ClassificationResult;
 using ::testing::Pointwise;
+using ::testing::proto::Approximately;
 
 constexpr char kClassificationInput0Tag[] = "CLASSIFICATIONS_0";
 constexpr char kClassificationInput0Name[] = "classifications_0";
@@ -66,17 +69,32 @@ ClassificationList MakeClassificationList(int class_index) {
       class_index));
 }
 
+// Makes a ClassificationList with the given scores of classes 0 and 1.
+ClassificationList MakeScoredClassificationList(float score_0, float score_1) {
+  return ParseTextProtoOrDie<ClassificationList>(absl::StrFormat(
+      R"pb(
+        classification { index: 0 score: %f label: "a" }
+        classification { index: 1 score: %f label: "b" }
+      )pb",
+      score_0, score_1));
+}
+
 class ClassificationAggregationCalculatorTest : public tflite::testing::Test {
  protected:
+  // If `pooling_options` are given, they are added to the calculator options
+  // and the pooled classifications are polled.
   absl::StatusOr<OutputStreamPoller> BuildGraph(
-      bool connect_timestamps = false) {
+      bool connect_timestamps = false,
+      absl::string_view pooling_options = "") {
+    const bool pooling = !pooling_options.empty();
     Graph graph;
     auto& calculator = graph.AddNode("ClassificationAggregationCalculator");
     calculator
         .GetOptions<mediapipe::ClassificationAggregationCalculatorOptions>() =
         ParseTextProtoOrDie<
             mediapipe::ClassificationAggregationCalculatorOptions>(
-            R"pb(head_names: "foo" head_names: "bar")pb");
+            absl::StrCat(R"pb(head_names: "foo" head_names: "bar" )pb",
+                         pooling_options));
     graph[Input<ClassificationList>(kClassificationInput0Tag)].SetName(
         kClassificationInput0Name) >>
         calculator.In(absl::StrFormat("%s:%d", kClassificationsTag, 0));
@@ -87,6 +105,8 @@ class ClassificationAggregationCalculatorTest : public tflite::testing::Test {
       graph[Input<std::vector<Timestamp>>(kTimestampsTag)].SetName(
           kTimestampsName) >>
           calculator.In(kTimestampsTag);
+    }
+    if (connect_timestamps && !pooling) {
       calculator.Out(kTimestampedClassificationsTag)
               .SetName(kTimestampedClassificationsName) >>
           graph[Output<std::vector<ClassificationResult>>(
@@ -97,7 +117,7 @@ class ClassificationAggregationCalculatorTest : public tflite::testing::Test {
     }
 
     ABSL_RETURN_IF_ERROR(calculator_graph_.Initialize(graph.GetConfig()));
-    if (connect_timestamps) {
+    if (connect_timestamps && !pooling) {
       ABSL_ASSIGN_OR_RETURN(auto poller,
                             calculator_graph_.AddOutputStreamPoller(
                                 kTimestampedClassificationsName));
@@ -211,5 +231,114 @@ TEST_F(ClassificationAggregationCalculatorTest, SucceedsWithAggregation) {
                          )pb")}));
 }
 
+TEST_F(ClassificationAggregationCalculatorTest, SucceedsWithMeanPooling) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto poller, BuildGraph(/*connect_timestamps=*/true,
+                              /*pooling_options=*/R"pb(pooling: MEAN)pb"));
+  MP_ASSERT_OK(Send(
+      {MakeScoredClassificationList(0.2, 0.8), MakeClassificationList(2)}));
+  MP_ASSERT_OK(Send(
+      {MakeScoredClassificationList(0.6, 0.4), MakeClassificationList(2)},
+      /*timestamp=*/1000,
+      /*aggregation_timestamps=*/std::optional<std::vector<int>>({0, 1000})));
+  MP_ASSERT_OK_AND_ASSIGN(auto result, GetResult<ClassificationResult>(poller));
+
+  EXPECT_THAT(result, Approximately(EqualsProto(
+                          ParseTextProtoOrDie<ClassificationResult>(R"pb(
+                            timestamp_ms: 0,
+                            classifications {
+                              head_index: 0
+                              head_name: "foo"
+                              classification_list {
+                                classification { index: 1 score: 0.6 label: "b" }
+                                classification { index: 0 score: 0.4 label: "a" }
+                              }
+                            }
+                            classifications {
+                              head_index: 1
+                              head_name: "bar"
+                              classification_list {
+                                classification { index: 2 score: 0 }
+                              }
+                            })pb"))));
+}
+
+TEST_F(ClassificationAggregationCalculatorTest, SucceedsWithMaxPooling) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto poller,
+      BuildGraph(/*connect_timestamps=*/true,
+                 /*pooling_options=*/R"pb(pooling: MAX
+                                          pooled_head_options { top_k: 1 }
+                                          pooled_head_options {})pb"));
+  MP_ASSERT_OK(Send(
+      {MakeScoredClassificationList(0.2, 0.8), MakeClassificationList(2)}));
+  MP_ASSERT_OK(Send(
+      {MakeScoredClassificationList(0.9, 0.4), MakeClassificationList(2)},
+      /*timestamp=*/1000,
+      /*aggregation_timestamps=*/std::optional<std::vector<int>>({0, 1000})));
+  MP_ASSERT_OK_AND_ASSIGN(auto result, GetResult<ClassificationResult>(poller));
+
+  EXPECT_THAT(result, Approximately(EqualsProto(
+                          ParseTextProtoOrDie<ClassificationResult>(R"pb(
+                            timestamp_ms: 0,
+                            classifications {
+                              head_index: 0
+                              head_name: "foo"
+                              classification_list {
+                                classification { index: 0 score: 0.9 label: "a" }
+                              }
+                            }
+                            classifications {
+                              head_index: 1
+                              head_name: "bar"
+                              classification_list {
+                                classification { index: 2 score: 0 }
+                              }
+                            })pb"))));
+}
+
+TEST_F(ClassificationAggregationCalculatorTest, SucceedsWithAttentionPooling) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto poller,
+      BuildGraph(/*connect_timestamps=*/true,
+                 /*pooling_options=*/R"pb(pooling: ATTENTION
+                                          attention_temperature: 0.1
+                                          pooled_head_options {
+                                            min_score_threshold: 0.5
+                                          }
+                                          pooled_head_options {})pb"));
+  MP_ASSERT_OK(Send(
+      {MakeScoredClassificationList(0.2, 0.8), MakeClassificationList(2)}));
+  MP_ASSERT_OK(Send(
+      {MakeScoredClassificationList(0.6, 0.4), MakeClassificationList(2)},
+      /*timestamp=*/1000,
+      /*aggregation_timestamps=*/std::optional<std::vector<int>>({0, 1000})));
+  MP_ASSERT_OK_AND_ASSIGN(auto result, GetResult<ClassificationResult>(poller));
+
+  // The weights of the timestamps are the softmax of {0.8, 0.6} / 0.1, i.e.
+  // about {0.881, 0.119}.
+  EXPECT_THAT(result, Approximately(EqualsProto(
+                          ParseTextProtoOrDie<ClassificationResult>(R"pb(
+                            timestamp_ms: 0,
+                            classifications {
+                              head_index: 0
+                              head_name: "foo"
+                              classification_list {
+                                classification {
+                                  index: 1
+                                  score: 0.7523
+                                  label: "b"
+                                }
+                              }
+                            }
+                            classifications {
+                              head_index: 1
+                              head_name: "bar"
+                              classification_list {
+                                classification { index: 2 score: 0 }
+                              }
+                            })pb")), /*margin=*/1e-4));
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -389,18 +389,23 @@ absl::Status ConfigureClassificationPostprocessingGraph(
 //   TIMESTAMPS - std::vector<Timestamp> @Optional
 //     The collection of the timestamps that this calculator should aggregate.
 //     This stream is optional: if provided then the TIMESTAMPED_CLASSIFICATIONS
-//     output is used for results. Otherwise as no timestamp aggregation is
+//     output is used for results, or the CLASSIFICATIONS output if the
+//     classifications are pooled. Otherwise as no timestamp aggregation is
 //     required the CLASSIFICATIONS output is used for results.
 //
 // Outputs:
 //   CLASSIFICATIONS - ClassificationResult @Optional
 //     The classification results aggregated by head. Must be connected if the
 //     TIMESTAMPS input is not connected, as it signals that timestamp
-//     aggregation is not required.
+//     aggregation is not required, or if the classifications are pooled.
 //   TIMESTAMPED_CLASSIFICATIONS - std::vector<ClassificationResult> @Optional
 //     The classification result aggregated by timestamp, then by head. Must be
-//     connected if the TIMESTAMPS input is connected, as it signals that
-//     timestamp aggregation is required.
+//     connected if the TIMESTAMPS input is connected and the classifications
+//     are not pooled, as it signals that timestamp aggregation is required.
+//
+// If `pooling` is set in the classification aggregation options, the score
+// threshold and maximum number of results of each head are applied to the
+// pooled classifications rather than to the classifications of each timestamp.
 //
 // The recommended way of using this graph is through the GraphBuilder API
 // using the 'ConfigureClassificationPostprocessingGraph()' function. See header
@@ -507,15 +512,27 @@ class ClassificationPostprocessingGraph : public mediapipe::Subgraph {
       }
     }
 
+    // If the classifications of several timestamps are pooled, the categories
+    // are filtered once pooled rather than at each timestamp.
+    const bool pooling =
+        options.classification_aggregation_options().pooling() !=
+        mediapipe::ClassificationAggregationCalculatorOptions::NONE;
+
     // Adds a TensorsToClassificationCalculator for each head.
     std::vector<GenericNode*> tensors_to_classification_nodes;
     tensors_to_classification_nodes.reserve(num_heads);
     for (int i = 0; i < num_heads; ++i) {
       tensors_to_classification_nodes.emplace_back(
           &graph.AddNode("TensorsToClassificationCalculator"));
-      tensors_to_classification_nodes.back()
-          ->GetOptions<TensorsToClassificationCalculatorOptions>()
-          .CopyFrom(options.tensors_to_classifications_options(i));
+      auto& calculator_options =
+          tensors_to_classification_nodes.back()
+              ->GetOptions<TensorsToClassificationCalculatorOptions>();
+      calculator_options.CopyFrom(options.tensors_to_classifications_options(i));
+      if (pooling) {
+        calculator_options.clear_min_score_threshold();
+        calculator_options.clear_top_k();
+        calculator_options.clear_sort_by_descending_score();
+      }
       calibrated_tensors[i] >>
           tensors_to_classification_nodes.back()->In(kTensorsTag);
     }
@@ -523,9 +540,22 @@ class ClassificationPostprocessingGraph : public mediapipe::Subgraph {
     // Aggregates Classifications into a single ClassificationResult.
     auto& result_aggregation =
         graph.AddNode("ClassificationAggregationCalculator");
-    result_aggregation
-        .GetOptions<mediapipe::ClassificationAggregationCalculatorOptions>()
-        .CopyFrom(options.classification_aggregation_options());
+    auto& aggregation_options =
+        result_aggregation
+            .GetOptions<mediapipe::ClassificationAggregationCalculatorOptions>();
+    aggregation_options.CopyFrom(options.classification_aggregation_options());
+    if (pooling && aggregation_options.pooled_head_options().empty()) {
+      for (int i = 0; i < num_heads; ++i) {
+        const auto& calculator_options =
+            options.tensors_to_classifications_options(i);
+        auto* head_options = aggregation_options.add_pooled_head_options();
+        if (calculator_options.has_min_score_threshold()) {
+          head_options->set_min_score_threshold(
+              calculator_options.min_score_threshold());
+        }
+        head_options->set_top_k(calculator_options.top_k());
+      }
+    }
     for (int i = 0; i < num_heads; ++i) {
       tensors_to_classification_nodes[i]->Out(kClassificationsTag) >>
           result_aggregation.In(
@@ -47,17 +47,23 @@ namespace processors {
 //   TIMESTAMPS - std::vector<Timestamp> @Optional
 //     The collection of the timestamps that this calculator should aggregate.
 //     This stream is optional: if provided then the TIMESTAMPED_CLASSIFICATIONS
-//     output is used for results. Otherwise as no timestamp aggregation is
+//     output is used for results, or the CLASSIFICATIONS output if the
+//     classifications are pooled. Otherwise as no timestamp aggregation is
 //     required the CLASSIFICATIONS output is used for results.
 // Outputs:
 //   CLASSIFICATIONS - ClassificationResult @Optional
 //     The classification results aggregated by head. Must be connected if the
 //     TIMESTAMPS input is not connected, as it signals that timestamp
-//     aggregation is not required.
+//     aggregation is not required, or if the classifications are pooled.
 //   TIMESTAMPED_CLASSIFICATIONS - std::vector<ClassificationResult> @Optional
 //     The classification result aggregated by timestamp, then by head. Must be
-//     connected if the TIMESTAMPS input is connected, as it signals that
-//     timestamp aggregation is required.
+//     connected if the TIMESTAMPS input is connected and the classifications
+//     are not pooled, as it signals that timestamp aggregation is required.
+//
+// To pool the classifications of the timestamps, e.g. of the windows of a long
+// text, set `pooling` in the `classification_aggregation_options` once
+// configured: the score threshold and maximum number of results then apply to
+// the pooled classifications.
 absl::Status ConfigureClassificationPostprocessingGraph(
     const tasks::core::ModelResources& model_resources,
     const proto::ClassifierOptions& classifier_options,
@@ -14,7 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "mediapipe/tasks/cc/components/processors/text_preprocessing_graph.h"
 
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -26,6 +28,7 @@ limitations under the License.
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/subgraph.h"
+#include "mediapipe/framework/timestamp.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/components/processors/proto/text_model_type.pb.h"
 #include "mediapipe/tasks/cc/components/processors/proto/text_preprocessing_graph_options.pb.h"
@@ -53,8 +56,17 @@ using ::mediapipe::tasks::text::utils::GetModelType;
 constexpr char kTextTag[] = "TEXT";
 constexpr char kMetadataExtractorTag[] = "METADATA_EXTRACTOR";
 constexpr char kTensorsTag[] = "TENSORS";
+constexpr char kTimestampsTag[] = "TIMESTAMPS";
 constexpr int kEmbeddingGemmaDefaultSeqLen = 512;
 
+// Struct holding the different output streams produced by the graph.
+struct TextPreprocessingOutputStreams {
+  Source<std::vector<Tensor>> tensors;
+  // The timestamps of the windows of each text, if texts are split into
+  // windows.
+  std::optional<Source<std::vector<Timestamp>>> timestamps;
+};
+
 // Gets the name of the MediaPipe preprocessor calculator associated with
 // `model_type`.
 absl::StatusOr<std::string> GetCalculatorNameFromModelType(
@@ -244,6 +256,9 @@ absl::Status ConfigureTextPreprocessingGraph(
 // Outputs:
 //   TENSORS - std::vector<Tensor>
 //     Vector containing the preprocessed input tensors for the TFLite model.
+//   TIMESTAMPS - std::vector<Timestamp> @Optional
+//     The timestamps of the TENSORS of the windows of a text, sent at the last
+//     of them. Only available if `window_stride` is set in the options.
 //
 // The recommended way of using this subgraph is through the GraphBuilder API
 // using the 'ConfigureTextPreprocessingGraph()' function. See header file for
@@ -254,20 +269,33 @@ class TextPreprocessingGraph : public mediapipe::Subgraph {
       mediapipe::SubgraphContext* sc) override {
     Graph graph;
     ABSL_ASSIGN_OR_RETURN(
-        Source<std::vector<Tensor>> tensors_in,
+        TextPreprocessingOutputStreams output_streams,
         BuildTextPreprocessing(
             sc->Options<TextPreprocessingGraphOptions>(),
             graph[Input<std::string>(kTextTag)],
             graph[SideInput<ModelMetadataExtractor>(kMetadataExtractorTag)],
             graph));
-    tensors_in >> graph[Output<std::vector<Tensor>>(kTensorsTag)];
+    output_streams.tensors >> graph[Output<std::vector<Tensor>>(kTensorsTag)];
+    if (output_streams.timestamps.has_value()) {
+      *output_streams.timestamps >>
+          graph[Output<std::vector<Timestamp>>(kTimestampsTag)];
+    }
     return graph.GetConfig();
   }
 
  private:
-  absl::StatusOr<Source<std::vector<Tensor>>> BuildTextPreprocessing(
+  absl::StatusOr<TextPreprocessingOutputStreams> BuildTextPreprocessing(
       const TextPreprocessingGraphOptions& options, Source<std::string> text_in,
       SideSource<ModelMetadataExtractor> metadata_extractor_in, Graph& graph) {
+    if (options.window_stride() > 0 &&
+        (options.model_type() != TextModelType::BERT_MODEL ||
+         options.has_dynamic_input_tensors())) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          "Splitting texts into windows is only supported with BERT models "
+          "with static input tensors.",
+          MediaPipeTasksStatus::kInvalidArgumentError);
+    }
     ABSL_ASSIGN_OR_RETURN(std::string preprocessor_name,
                           GetCalculatorNameFromModelType(options.model_type()));
     auto& text_preprocessor = graph.AddNode(preprocessor_name);
@@ -286,6 +314,10 @@ class TextPreprocessingGraph : public mediapipe::Subgraph {
             .set_bert_max_seq_len(options.max_seq_len());
         text_preprocessor.GetOptions<BertPreprocessorCalculatorOptions>()
             .set_has_dynamic_input_tensors(options.has_dynamic_input_tensors());
+        text_preprocessor.GetOptions<BertPreprocessorCalculatorOptions>()
+            .set_token_cache_size(options.token_cache_size());
+        text_preprocessor.GetOptions<BertPreprocessorCalculatorOptions>()
+            .set_window_stride(options.window_stride());
         metadata_extractor_in >>
             text_preprocessor.SideIn(kMetadataExtractorTag);
         break;
@@ -299,6 +331,9 @@ class TextPreprocessingGraph : public mediapipe::Subgraph {
             .GetOptions<SentencePiecePreprocessorCalculatorOptions>()
             .mutable_sentence_piece_model()
             ->CopyFrom(options.sentence_piece_model());
+        text_preprocessor
+            .GetOptions<SentencePiecePreprocessorCalculatorOptions>()
+            .set_token_cache_size(options.token_cache_size());
         metadata_extractor_in >>
             text_preprocessor.SideIn(kMetadataExtractorTag);
         break;
@@ -306,13 +341,22 @@ class TextPreprocessingGraph : public mediapipe::Subgraph {
       case TextModelType::REGEX_MODEL: {
         text_preprocessor.GetOptions<RegexPreprocessorCalculatorOptions>()
             .set_max_seq_len(options.max_seq_len());
+        text_preprocessor.GetOptions<RegexPreprocessorCalculatorOptions>()
+            .set_token_cache_size(options.token_cache_size());
         metadata_extractor_in >>
             text_preprocessor.SideIn(kMetadataExtractorTag);
         break;
       }
     }
     text_in >> text_preprocessor.In(kTextTag);
-    return text_preprocessor[Output<std::vector<Tensor>>(kTensorsTag)];
+    TextPreprocessingOutputStreams output_streams{
+        /*tensors=*/text_preprocessor[Output<std::vector<Tensor>>(kTensorsTag)],
+        /*timestamps=*/std::nullopt};
+    if (options.window_stride() > 0) {
+      output_streams.timestamps =
+          text_preprocessor[Output<std::vector<Timestamp>>(kTimestampsTag)];
+    }
+    return output_streams;
   }
 };
 REGISTER_MEDIAPIPE_GRAPH(
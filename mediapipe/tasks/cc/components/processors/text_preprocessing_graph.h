@@ -48,6 +48,9 @@ namespace processors {
 // Outputs:
 //   TENSORS - std::vector<Tensor>
 //     Vector containing the preprocessed input tensors for the TFLite model.
+//   TIMESTAMPS - std::vector<Timestamp> @Optional
+//     The timestamps of the TENSORS of the windows of a text, sent at the last
+//     of them. Only available if `window_stride` is set in the options.
 absl::Status ConfigureTextPreprocessingGraph(
     const core::ModelResources& model_resources,
     proto::TextPreprocessingGraphOptions& options);
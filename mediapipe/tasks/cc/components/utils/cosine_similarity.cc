@@ -15,13 +15,19 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/components/utils/cosine_similarity.h"
 
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/status/status_macros.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "absl/types/span.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+#include "mediapipe/tasks/cc/components/utils/dot_product.h"
 
 namespace mediapipe {
 namespace tasks {
@@ -32,30 +38,78 @@ namespace {
 
 using ::mediapipe::tasks::components::containers::Embedding;
 
-template <typename T>
-absl::StatusOr<double> ComputeCosineSimilarity(const T& u, const T& v,
-                                               int num_elements) {
-  if (num_elements <= 0) {
+// Scale applied by the embedding postprocessing when quantizing embeddings.
+constexpr double kQuantizationScale = 128.0;
+
+const int8_t* QuantizedData(const Embedding& embedding) {
+  return reinterpret_cast<const int8_t*>(embedding.quantized_embedding.data());
+}
+
+// Checks that `u` and `v` are non-empty embeddings of the same type and size.
+absl::Status ValidateEmbeddings(const Embedding& u, const Embedding& v) {
+  size_t u_size;
+  size_t v_size;
+  if (!u.float_embedding.empty() && !v.float_embedding.empty()) {
+    u_size = u.float_embedding.size();
+    v_size = v.float_embedding.size();
+  } else if (!u.quantized_embedding.empty() &&
+             !v.quantized_embedding.empty()) {
+    u_size = u.quantized_embedding.size();
+    v_size = v.quantized_embedding.size();
+  } else {
     return CreateStatusWithPayload(
         absl::StatusCode::kInvalidArgument,
-        "Cannot compute cosing similarity on empty embeddings",
+        "Cannot compute cosine similarity between quantized and float "
+        "embeddings",
         MediaPipeTasksStatus::kInvalidArgumentError);
   }
-  double dot_product = 0.0;
-  double norm_u = 0.0;
-  double norm_v = 0.0;
-  for (int i = 0; i < num_elements; ++i) {
-    dot_product += u[i] * v[i];
-    norm_u += u[i] * u[i];
-    norm_v += v[i] * v[i];
+  if (u_size != v_size) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrFormat("Cannot compute cosine similarity between embeddings "
+                        "of different sizes (%d vs. %d)",
+                        u_size, v_size),
+        MediaPipeTasksStatus::kInvalidArgumentError);
   }
-  if (norm_u <= 0.0 || norm_v <= 0.0) {
+  return absl::OkStatus();
+}
+
+// Returns the dot product of `u` and `v`, which must have been validated.
+double EmbeddingDotProduct(const Embedding& u, const Embedding& v) {
+  if (!u.float_embedding.empty()) {
+    return DotProduct(u.float_embedding.data(), v.float_embedding.data(),
+                      u.float_embedding.size());
+  }
+  return DotProduct(QuantizedData(u), QuantizedData(v),
+                    u.quantized_embedding.size());
+}
+
+// Returns the squared L2-norm of `embedding`, which must be non-empty.
+absl::StatusOr<double> SquaredNorm(const Embedding& embedding) {
+  const double squared_norm = EmbeddingDotProduct(embedding, embedding);
+  if (squared_norm <= 0.0) {
     return CreateStatusWithPayload(
         absl::StatusCode::kInvalidArgument,
         "Cannot compute cosine similarity on embedding with 0 norm",
         MediaPipeTasksStatus::kInvalidArgumentError);
   }
-  return dot_product / std::sqrt(norm_u * norm_v);
+  return squared_norm;
+}
+
+// Returns the cosine similarity of `u` and `v`, which must have been
+// validated, given the squared norm of `u`.
+absl::StatusOr<double> ComputeCosineSimilarity(const Embedding& u,
+                                               double squared_norm_u,
+                                               const Embedding& v,
+                                               bool l2_normalized) {
+  const double dot_product = EmbeddingDotProduct(u, v);
+  if (l2_normalized) {
+    return u.float_embedding.empty()
+               ? dot_product / (kQuantizationScale * kQuantizationScale)
+               : dot_product;
+  }
+  ABSL_ASSIGN_OR_RETURN(const double squared_norm_v, SquaredNorm(v));
+  return dot_product / std::sqrt(squared_norm_u * squared_norm_v);
 }
 
 }  // namespace
@@ -68,38 +122,37 @@ absl::StatusOr<double> ComputeCosineSimilarity(const T& u, const T& v,
 // [1]: https://en.wikipedia.org/wiki/Cosine_similarity
 absl::StatusOr<double> CosineSimilarity(const Embedding& u,
                                         const Embedding& v) {
-  if (!u.float_embedding.empty() && !v.float_embedding.empty()) {
-    if (u.float_embedding.size() != v.float_embedding.size()) {
-      return CreateStatusWithPayload(
-          absl::StatusCode::kInvalidArgument,
-          absl::StrFormat("Cannot compute cosine similarity between embeddings "
-                          "of different sizes (%d vs. %d)",
-                          u.float_embedding.size(), v.float_embedding.size()),
-          MediaPipeTasksStatus::kInvalidArgumentError);
-    }
-    return ComputeCosineSimilarity(u.float_embedding.data(),
-                                   v.float_embedding.data(),
-                                   u.float_embedding.size());
-  }
-  if (!u.quantized_embedding.empty() && !v.quantized_embedding.empty()) {
-    if (u.quantized_embedding.size() != v.quantized_embedding.size()) {
-      return CreateStatusWithPayload(
-          absl::StatusCode::kInvalidArgument,
-          absl::StrFormat("Cannot compute cosine similarity between embeddings "
-                          "of different sizes (%d vs. %d)",
-                          u.quantized_embedding.size(),
-                          v.quantized_embedding.size()),
-          MediaPipeTasksStatus::kInvalidArgumentError);
+  ABSL_RETURN_IF_ERROR(ValidateEmbeddings(u, v));
+  ABSL_ASSIGN_OR_RETURN(const double squared_norm_u, SquaredNorm(u));
+  return ComputeCosineSimilarity(u, squared_norm_u, v,
+                                 /*l2_normalized=*/false);
+}
+
+absl::StatusOr<double> NormalizedCosineSimilarity(const Embedding& u,
+                                                  const Embedding& v) {
+  ABSL_RETURN_IF_ERROR(ValidateEmbeddings(u, v));
+  return ComputeCosineSimilarity(u, /*squared_norm_u=*/1.0, v,
+                                 /*l2_normalized=*/true);
+}
+
+absl::StatusOr<std::vector<double>> CosineSimilarities(
+    const Embedding& query, absl::Span<const Embedding> embeddings,
+    bool l2_normalized) {
+  std::vector<double> similarities;
+  similarities.reserve(embeddings.size());
+  double squared_norm_query = 1.0;
+  for (const Embedding& embedding : embeddings) {
+    ABSL_RETURN_IF_ERROR(ValidateEmbeddings(query, embedding));
+    if (!l2_normalized && similarities.empty()) {
+      ABSL_ASSIGN_OR_RETURN(squared_norm_query, SquaredNorm(query));
     }
-    return ComputeCosineSimilarity(
-        reinterpret_cast<const int8_t*>(u.quantized_embedding.data()),
-        reinterpret_cast<const int8_t*>(v.quantized_embedding.data()),
-        u.quantized_embedding.size());
+    ABSL_ASSIGN_OR_RETURN(
+        const double similarity,
+        ComputeCosineSimilarity(query, squared_norm_query, embedding,
+                                l2_normalized));
+    similarities.push_back(similarity);
   }
-  return CreateStatusWithPayload(
-      absl::StatusCode::kInvalidArgument,
-      "Cannot compute cosine similarity between quantized and float embeddings",
-      MediaPipeTasksStatus::kInvalidArgumentError);
+  return similarities;
 }
 
 }  // namespace utils
@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_COSINE_SIMILARITY_H_
 #define MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_COSINE_SIMILARITY_H_
 
+#include <vector>
+
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "mediapipe/tasks/cc/components/containers/embedding_result.h"
 
 namespace mediapipe {
@@ -32,6 +35,22 @@ namespace utils {
 absl::StatusOr<double> CosineSimilarity(const containers::Embedding& u,
                                         const containers::Embedding& v);
 
+// Same as above, but assumes both embeddings are L2-normalized, as produced
+// with `l2_normalize` set in the embedder options, and skips computing their
+// norms. Quantized embeddings are assumed to use the scale of 128 applied by
+// the embedding postprocessing, so their result is approximate.
+absl::StatusOr<double> NormalizedCosineSimilarity(
+    const containers::Embedding& u, const containers::Embedding& v);
+
+// Computes the cosine similarity between `query` and each of `embeddings`,
+// computing the norm of `query` only once. If `l2_normalized` is true, the
+// embeddings are handled as in `NormalizedCosineSimilarity`. Returns the same
+// errors as `CosineSimilarity` if any of the embeddings is invalid.
+absl::StatusOr<std::vector<double>> CosineSimilarities(
+    const containers::Embedding& query,
+    absl::Span<const containers::Embedding> embeddings,
+    bool l2_normalized = false);
+
 }  // namespace utils
 }  // namespace components
 }  // namespace tasks
@@ -31,6 +31,8 @@ namespace utils {
 namespace {
 
 using ::mediapipe::tasks::components::containers::Embedding;
+using ::testing::DoubleNear;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 
 // Helper function to generate float Embedding.
@@ -102,6 +104,87 @@ TEST(CosineSimilarity, SucceedsWithQuantizedEntries) {
   EXPECT_EQ(result, -1);
 }
 
+TEST(NormalizedCosineSimilarity, SucceedsWithFloatEntries) {
+  auto u = BuildFloatEmbedding({0.6, 0.8, 0.0});
+  auto v = BuildFloatEmbedding({0.0, 0.8, 0.6});
+
+  MP_ASSERT_OK_AND_ASSIGN(auto result, NormalizedCosineSimilarity(u, v));
+
+  EXPECT_NEAR(result, 0.64, 1e-6);
+}
+
+TEST(NormalizedCosineSimilarity, SucceedsWithQuantizedEntries) {
+  auto u = BuildQuantizedEmbedding({77, 102, 0});
+  auto v = BuildQuantizedEmbedding({0, 102, 77});
+
+  MP_ASSERT_OK_AND_ASSIGN(auto result, NormalizedCosineSimilarity(u, v));
+
+  EXPECT_NEAR(result, 0.64, 0.01);
+}
+
+TEST(NormalizedCosineSimilarity, FailsWithDifferentSizes) {
+  auto u = BuildFloatEmbedding({1.0, 0.0});
+  auto v = BuildFloatEmbedding({1.0, 0.0, 0.0});
+
+  auto status = NormalizedCosineSimilarity(u, v);
+
+  EXPECT_EQ(status.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.status().message(),
+              HasSubstr("Cannot compute cosine similarity between embeddings "
+                        "of different sizes"));
+}
+
+TEST(CosineSimilarities, MatchesCosineSimilarity) {
+  auto query = BuildFloatEmbedding({1.0, 2.0, 3.0});
+  std::vector<Embedding> embeddings = {BuildFloatEmbedding({1.0, 2.0, 3.0}),
+                                       BuildFloatEmbedding({-3.0, 0.0, 1.0}),
+                                       BuildFloatEmbedding({0.5, 0.1, 0.2})};
+
+  MP_ASSERT_OK_AND_ASSIGN(auto results, CosineSimilarities(query, embeddings));
+
+  ASSERT_EQ(results.size(), embeddings.size());
+  for (size_t i = 0; i < embeddings.size(); ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(auto expected,
+                            CosineSimilarity(query, embeddings[i]));
+    EXPECT_NEAR(results[i], expected, 1e-6);
+  }
+}
+
+TEST(CosineSimilarities, SucceedsWithNormalizedQuantizedEntries) {
+  auto query = BuildQuantizedEmbedding({127, 0});
+  std::vector<Embedding> embeddings = {BuildQuantizedEmbedding({127, 0}),
+                                       BuildQuantizedEmbedding({0, -128}),
+                                       BuildQuantizedEmbedding({-128, 0})};
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto results,
+      CosineSimilarities(query, embeddings, /*l2_normalized=*/true));
+
+  EXPECT_THAT(results, ElementsAre(DoubleNear(1.0, 0.02), DoubleNear(0.0, 0.02),
+                                   DoubleNear(-1.0, 0.02)));
+}
+
+TEST(CosineSimilarities, SucceedsWithNoEmbeddings) {
+  auto query = BuildFloatEmbedding({0.0, 0.0});
+
+  MP_ASSERT_OK_AND_ASSIGN(auto results, CosineSimilarities(query, {}));
+
+  EXPECT_TRUE(results.empty());
+}
+
+TEST(CosineSimilarities, FailsWithAnyInvalidEmbedding) {
+  auto query = BuildFloatEmbedding({0.1, 0.2});
+  std::vector<Embedding> embeddings = {BuildFloatEmbedding({0.1, 0.2}),
+                                       BuildQuantizedEmbedding({0, 1})};
+
+  auto status = CosineSimilarities(query, embeddings);
+
+  EXPECT_EQ(status.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.status().message(),
+              HasSubstr("Cannot compute cosine similarity between quantized "
+                        "and float embeddings"));
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace components
@@ -0,0 +1,178 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/components/utils/dot_product.h"
+
+#include <cstdint>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+
+namespace {
+
+#if defined(__AVX2__) && defined(__FMA__) && !defined(__AVX512F__)
+float HorizontalSum(__m256 v) {
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v),
+                          _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+}
+#endif
+
+#if defined(__AVX2__) && \
+    !(defined(__AVX512VNNI__) && defined(__AVX512BW__))
+int32_t HorizontalSum(__m256i v) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+#endif
+
+}  // namespace
+
+float DotProduct(const float* u, const float* v, int num_elements) {
+  int i = 0;
+  float sum = 0.0f;
+#if defined(__AVX512F__)
+  __m512 accumulator0 = _mm512_setzero_ps();
+  __m512 accumulator1 = _mm512_setzero_ps();
+  for (; i + 32 <= num_elements; i += 32) {
+    accumulator0 = _mm512_fmadd_ps(_mm512_loadu_ps(u + i),
+                                   _mm512_loadu_ps(v + i), accumulator0);
+    accumulator1 = _mm512_fmadd_ps(_mm512_loadu_ps(u + i + 16),
+                                   _mm512_loadu_ps(v + i + 16), accumulator1);
+  }
+  for (; i + 16 <= num_elements; i += 16) {
+    accumulator0 = _mm512_fmadd_ps(_mm512_loadu_ps(u + i),
+                                   _mm512_loadu_ps(v + i), accumulator0);
+  }
+  sum = _mm512_reduce_add_ps(_mm512_add_ps(accumulator0, accumulator1));
+#elif defined(__AVX2__) && defined(__FMA__)
+  __m256 accumulator0 = _mm256_setzero_ps();
+  __m256 accumulator1 = _mm256_setzero_ps();
+  for (; i + 16 <= num_elements; i += 16) {
+    accumulator0 = _mm256_fmadd_ps(_mm256_loadu_ps(u + i),
+                                   _mm256_loadu_ps(v + i), accumulator0);
+    accumulator1 = _mm256_fmadd_ps(_mm256_loadu_ps(u + i + 8),
+                                   _mm256_loadu_ps(v + i + 8), accumulator1);
+  }
+  for (; i + 8 <= num_elements; i += 8) {
+    accumulator0 = _mm256_fmadd_ps(_mm256_loadu_ps(u + i),
+                                   _mm256_loadu_ps(v + i), accumulator0);
+  }
+  sum = HorizontalSum(_mm256_add_ps(accumulator0, accumulator1));
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  float32x4_t accumulator0 = vdupq_n_f32(0.0f);
+  float32x4_t accumulator1 = vdupq_n_f32(0.0f);
+  for (; i + 8 <= num_elements; i += 8) {
+    accumulator0 =
+        vfmaq_f32(accumulator0, vld1q_f32(u + i), vld1q_f32(v + i));
+    accumulator1 =
+        vfmaq_f32(accumulator1, vld1q_f32(u + i + 4), vld1q_f32(v + i + 4));
+  }
+  sum = vaddvq_f32(vaddq_f32(accumulator0, accumulator1));
+#else
+  // Independent accumulators let the compiler vectorize the loop without
+  // reassociating floating-point additions itself.
+  constexpr int kNumAccumulators = 8;
+  float accumulators[kNumAccumulators] = {};
+  for (; i + kNumAccumulators <= num_elements; i += kNumAccumulators) {
+    for (int j = 0; j < kNumAccumulators; ++j) {
+      accumulators[j] += u[i + j] * v[i + j];
+    }
+  }
+  for (int j = 0; j < kNumAccumulators; ++j) {
+    sum += accumulators[j];
+  }
+#endif
+  for (; i < num_elements; ++i) {
+    sum += u[i] * v[i];
+  }
+  return sum;
+}
+
+int32_t DotProduct(const int8_t* u, const int8_t* v, int num_elements) {
+  int i = 0;
+  int32_t sum = 0;
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+  // VPDPBUSD multiplies unsigned by signed bytes: computes (u + 128) . v and
+  // subtracts 128 * sum(v). The former may wrap around, which the subtraction
+  // undoes as long as the result fits.
+  const __m512i sign_flip = _mm512_set1_epi8(static_cast<char>(0x80));
+  const __m512i ones = _mm512_set1_epi8(1);
+  __m512i products = _mm512_setzero_si512();
+  __m512i v_sums = _mm512_setzero_si512();
+  for (; i + 64 <= num_elements; i += 64) {
+    const __m512i u_values = _mm512_loadu_si512(u + i);
+    const __m512i v_values = _mm512_loadu_si512(v + i);
+    products = _mm512_dpbusd_epi32(
+        products, _mm512_xor_si512(u_values, sign_flip), v_values);
+    v_sums = _mm512_dpbusd_epi32(v_sums, ones, v_values);
+  }
+  sum = static_cast<int32_t>(
+      static_cast<uint32_t>(_mm512_reduce_add_epi32(products)) -
+      128u * static_cast<uint32_t>(_mm512_reduce_add_epi32(v_sums)));
+#elif defined(__AVX2__)
+  __m256i accumulator = _mm256_setzero_si256();
+  for (; i + 16 <= num_elements; i += 16) {
+    const __m256i u_values = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + i)));
+    const __m256i v_values = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i)));
+    accumulator =
+        _mm256_add_epi32(accumulator, _mm256_madd_epi16(u_values, v_values));
+  }
+  sum = HorizontalSum(accumulator);
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_DOTPROD)
+  int32x4_t accumulator = vdupq_n_s32(0);
+  for (; i + 16 <= num_elements; i += 16) {
+    accumulator = vdotq_s32(accumulator, vld1q_s8(u + i), vld1q_s8(v + i));
+  }
+  sum = vaddvq_s32(accumulator);
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  int32x4_t accumulator = vdupq_n_s32(0);
+  for (; i + 16 <= num_elements; i += 16) {
+    const int8x16_t u_values = vld1q_s8(u + i);
+    const int8x16_t v_values = vld1q_s8(v + i);
+    accumulator = vpadalq_s16(
+        accumulator,
+        vmull_s8(vget_low_s8(u_values), vget_low_s8(v_values)));
+    accumulator = vpadalq_s16(
+        accumulator,
+        vmull_s8(vget_high_s8(u_values), vget_high_s8(v_values)));
+  }
+  sum = vaddvq_s32(accumulator);
+#endif
+  for (; i < num_elements; ++i) {
+    sum += static_cast<int32_t>(u[i]) * static_cast<int32_t>(v[i]);
+  }
+  return sum;
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
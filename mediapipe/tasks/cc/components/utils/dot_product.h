@@ -0,0 +1,45 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_DOT_PRODUCT_H_
+#define MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_DOT_PRODUCT_H_
+
+#include <cstdint>
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+
+// Returns the dot product of the first `num_elements` elements of `u` and
+// `v`. The elements are accumulated in float, in an unspecified order.
+//
+// These kernels use AVX-512, AVX2 with FMA or NEON instructions when the
+// target architecture supports them, and portable code otherwise.
+float DotProduct(const float* u, const float* v, int num_elements);
+
+// Returns the dot product of the first `num_elements` elements of `u` and
+// `v`, which is exact for fewer than 2^17 elements.
+//
+// These kernels use AVX-512 VNNI, AVX2, NEON dot product or NEON instructions
+// when the target architecture supports them, and portable code otherwise.
+int32_t DotProduct(const int8_t* u, const int8_t* v, int num_elements);
+
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_DOT_PRODUCT_H_
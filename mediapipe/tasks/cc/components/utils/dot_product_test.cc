@@ -0,0 +1,85 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/components/utils/dot_product.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+namespace {
+
+// Sizes covering the vectorized loops and their scalar tails.
+constexpr int kSizes[] = {0, 1, 7, 8, 15, 16, 17, 31, 32, 63, 64, 65, 100,
+                          127, 128, 129, 1000, 1024};
+
+TEST(DotProduct, MatchesReferenceForFloats) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  for (int size : kSizes) {
+    std::vector<float> u(size);
+    std::vector<float> v(size);
+    double expected = 0.0;
+    for (int i = 0; i < size; ++i) {
+      u[i] = distribution(generator);
+      v[i] = distribution(generator);
+      expected += static_cast<double>(u[i]) * v[i];
+    }
+    EXPECT_NEAR(DotProduct(u.data(), v.data(), size), expected, 1e-4)
+        << "size: " << size;
+  }
+}
+
+TEST(DotProduct, MatchesReferenceForInt8) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int> distribution(-128, 127);
+  for (int size : kSizes) {
+    std::vector<int8_t> u(size);
+    std::vector<int8_t> v(size);
+    int32_t expected = 0;
+    for (int i = 0; i < size; ++i) {
+      u[i] = distribution(generator);
+      v[i] = distribution(generator);
+      expected += u[i] * v[i];
+    }
+    EXPECT_EQ(DotProduct(u.data(), v.data(), size), expected)
+        << "size: " << size;
+  }
+}
+
+TEST(DotProduct, IsExactForExtremeInt8Values) {
+  constexpr int kSize = 1000;
+  const std::vector<int8_t> min_values(kSize, -128);
+  const std::vector<int8_t> max_values(kSize, 127);
+  EXPECT_EQ(DotProduct(min_values.data(), min_values.data(), kSize),
+            kSize * 128 * 128);
+  EXPECT_EQ(DotProduct(min_values.data(), max_values.data(), kSize),
+            kSize * -128 * 127);
+  EXPECT_EQ(DotProduct(max_values.data(), min_values.data(), kSize),
+            kSize * 127 * -128);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,552 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/components/utils/embedding_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/cleanup/cleanup.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/deps/file_helpers.h"
+#include "mediapipe/framework/deps/mmapped_file.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/tasks/cc/common.h"
+#include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+#include "mediapipe/tasks/cc/components/utils/dot_product.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+
+namespace {
+
+using ::mediapipe::tasks::components::containers::Embedding;
+
+// Train() clusters at most this many embeddings per cluster, evenly sampled
+// from the index, which is plenty to place the centroids.
+constexpr int kMaxTrainingSamplesPerCluster = 256;
+
+// The file format written by Save(), in the native byte order. Every section
+// following the header starts at a multiple of kSectionAlignment so that it
+// can be accessed in place once memory-mapped:
+// - the embeddings, row-major, as float or int8_t;
+// - their inverse L2-norms, as float;
+// - in IVF mode, the centroids, row-major, as float, the number of embeddings
+//   of each cluster, as uint32_t, and the ids of the embeddings of each
+//   cluster, cluster after cluster, as uint32_t.
+constexpr char kMagic[4] = {'M', 'P', 'E', 'I'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kSectionAlignment = 8;
+
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t dimension;
+  uint32_t quantized;
+  uint32_t size;
+  uint32_t num_clusters;
+  uint32_t num_probes;
+  uint32_t reserved;
+};
+
+size_t AlignSection(size_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+void AppendSection(const void* data, size_t num_bytes, std::string* output) {
+  output->append(static_cast<const char*>(data), num_bytes);
+  output->resize(AlignSection(output->size()), '\0');
+}
+
+// Dot product between float centroids and quantized embeddings.
+float DotProduct(const float* u, const int8_t* v, int num_elements) {
+  float sum = 0.0f;
+  for (int i = 0; i < num_elements; ++i) {
+    sum += u[i] * static_cast<float>(v[i]);
+  }
+  return sum;
+}
+
+// Whether `a` ranks before `b` in search results.
+bool RanksBefore(const EmbeddingSearchResult& a,
+                 const EmbeddingSearchResult& b) {
+  return a.similarity > b.similarity ||
+         (a.similarity == b.similarity && a.id < b.id);
+}
+
+// Keeps the `k` best results offered, in a heap whose front is the worst.
+class TopK {
+ public:
+  explicit TopK(int k) : k_(k) { results_.reserve(k); }
+
+  void Offer(int id, float similarity) {
+    const EmbeddingSearchResult result = {id, similarity};
+    if (results_.size() < k_) {
+      results_.push_back(result);
+      std::push_heap(results_.begin(), results_.end(), RanksBefore);
+    } else if (RanksBefore(result, results_.front())) {
+      std::pop_heap(results_.begin(), results_.end(), RanksBefore);
+      results_.back() = result;
+      std::push_heap(results_.begin(), results_.end(), RanksBefore);
+    }
+  }
+
+  std::vector<EmbeddingSearchResult> Finish() && {
+    std::sort_heap(results_.begin(), results_.end(), RanksBefore);
+    return std::move(results_);
+  }
+
+ private:
+  const size_t k_;
+  std::vector<EmbeddingSearchResult> results_;
+};
+
+absl::Status InvalidArgumentError(absl::string_view message) {
+  return CreateStatusWithPayload(absl::StatusCode::kInvalidArgument, message,
+                                 MediaPipeTasksStatus::kInvalidArgumentError);
+}
+
+}  // namespace
+
+EmbeddingIndex::EmbeddingIndex(int dimension, bool quantized,
+                               EmbeddingIndexOptions options)
+    : dimension_(dimension), quantized_(quantized), options_(options) {}
+
+EmbeddingIndex::~EmbeddingIndex() {
+  if (mapped_file_ != nullptr) {
+    mapped_file_->Close().IgnoreError();
+  }
+}
+
+absl::StatusOr<std::unique_ptr<EmbeddingIndex>> EmbeddingIndex::Create(
+    int dimension, bool quantized, EmbeddingIndexOptions options) {
+  if (dimension <= 0) {
+    return InvalidArgumentError(
+        absl::StrCat("Invalid embedding dimension: ", dimension));
+  }
+  if (options.num_clusters < 0 || options.num_probes <= 0 ||
+      options.num_training_iterations <= 0) {
+    return InvalidArgumentError("Invalid EmbeddingIndexOptions.");
+  }
+  return absl::WrapUnique(new EmbeddingIndex(dimension, quantized, options));
+}
+
+absl::Status EmbeddingIndex::CheckEmbedding(
+    const Embedding& embedding) const {
+  const size_t size = quantized_ ? embedding.quantized_embedding.size()
+                                 : embedding.float_embedding.size();
+  if (size == 0) {
+    return InvalidArgumentError(absl::StrCat(
+        "Expected a ", quantized_ ? "quantized" : "float", " embedding."));
+  }
+  if (size != static_cast<size_t>(dimension_)) {
+    return InvalidArgumentError(
+        absl::StrFormat("Expected an embedding of size %d, got %d.",
+                        dimension_, size));
+  }
+  return absl::OkStatus();
+}
+
+float EmbeddingIndex::Dot(const void* query, int id) const {
+  const size_t offset = static_cast<size_t>(id) * dimension_;
+  if (quantized_) {
+    return DotProduct(static_cast<const int8_t*>(query), int8_data_ + offset,
+                      dimension_);
+  }
+  return DotProduct(static_cast<const float*>(query), float_data_ + offset,
+                    dimension_);
+}
+
+int EmbeddingIndex::ClosestCentroid(int id) const {
+  const size_t offset = static_cast<size_t>(id) * dimension_;
+  int closest = 0;
+  float best_dot = -std::numeric_limits<float>::infinity();
+  for (int c = 0; c < num_clusters_; ++c) {
+    const float* centroid = &centroids_[c * dimension_];
+    const float dot =
+        quantized_ ? DotProduct(centroid, int8_data_ + offset, dimension_)
+                   : DotProduct(centroid, float_data_ + offset, dimension_);
+    if (dot > best_dot) {
+      best_dot = dot;
+      closest = c;
+    }
+  }
+  return closest;
+}
+
+absl::StatusOr<int> EmbeddingIndex::Add(const Embedding& embedding) {
+  if (mapped_file_ != nullptr) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kFailedPrecondition,
+        "Cannot add embeddings to an index loaded from a file.");
+  }
+  ABSL_RETURN_IF_ERROR(CheckEmbedding(embedding));
+
+  const auto* int8_data =
+      reinterpret_cast<const int8_t*>(embedding.quantized_embedding.data());
+  const float* float_data = embedding.float_embedding.data();
+  double squared_norm = 0.0;
+  for (int i = 0; i < dimension_; ++i) {
+    const double value = quantized_ ? int8_data[i] : float_data[i];
+    squared_norm += value * value;
+  }
+  if (squared_norm <= 0.0) {
+    return InvalidArgumentError(
+        "Cannot add an embedding with 0 norm to the index.");
+  }
+  if (quantized_) {
+    int8_storage_.insert(int8_storage_.end(), int8_data,
+                         int8_data + dimension_);
+    int8_data_ = int8_storage_.data();
+  } else {
+    float_storage_.insert(float_storage_.end(), float_data,
+                          float_data + dimension_);
+    float_data_ = float_storage_.data();
+  }
+  inverse_norm_storage_.push_back(1.0 / std::sqrt(squared_norm));
+  inverse_norms_ = inverse_norm_storage_.data();
+  const int id = size_++;
+  if (trained()) {
+    lists_[ClosestCentroid(id)].push_back(id);
+  }
+  return id;
+}
+
+absl::Status EmbeddingIndex::Train() {
+  const int num_clusters = options_.num_clusters;
+  if (num_clusters == 0) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kFailedPrecondition,
+        "Training requires EmbeddingIndexOptions::num_clusters > 0.");
+  }
+  if (mapped_file_ != nullptr) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kFailedPrecondition,
+        "Cannot train an index loaded from a file.");
+  }
+  if (size_ < num_clusters) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kFailedPrecondition,
+        absl::StrFormat("Training %d clusters requires at least as many "
+                        "embeddings, got %d.",
+                        num_clusters, size_));
+  }
+
+  // Spherical k-means on L2-normalized samples.
+  const int num_samples = static_cast<int>(
+      std::min<int64_t>(size_, static_cast<int64_t>(num_clusters) *
+                                   kMaxTrainingSamplesPerCluster));
+  std::vector<float> samples(static_cast<size_t>(num_samples) * dimension_);
+  for (int s = 0; s < num_samples; ++s) {
+    const int id = static_cast<int64_t>(s) * size_ / num_samples;
+    const size_t offset = static_cast<size_t>(id) * dimension_;
+    for (int i = 0; i < dimension_; ++i) {
+      const float value = quantized_ ? int8_data_[offset + i]
+                                     : float_data_[offset + i];
+      samples[static_cast<size_t>(s) * dimension_ + i] =
+          value * inverse_norms_[id];
+    }
+  }
+  std::vector<float> centroids(static_cast<size_t>(num_clusters) *
+                               dimension_);
+  for (int c = 0; c < num_clusters; ++c) {
+    const int s = static_cast<int64_t>(c) * num_samples / num_clusters;
+    std::copy_n(&samples[static_cast<size_t>(s) * dimension_], dimension_,
+                &centroids[static_cast<size_t>(c) * dimension_]);
+  }
+  std::vector<float> sums(centroids.size());
+  std::vector<int> counts(num_clusters);
+  for (int iteration = 0; iteration < options_.num_training_iterations;
+       ++iteration) {
+    std::fill(sums.begin(), sums.end(), 0.0f);
+    std::fill(counts.begin(), counts.end(), 0);
+    for (int s = 0; s < num_samples; ++s) {
+      const float* sample = &samples[static_cast<size_t>(s) * dimension_];
+      int closest = 0;
+      float best_dot = -std::numeric_limits<float>::infinity();
+      for (int c = 0; c < num_clusters; ++c) {
+        const float dot = DotProduct(
+            sample, &centroids[static_cast<size_t>(c) * dimension_],
+            dimension_);
+        if (dot > best_dot) {
+          best_dot = dot;
+          closest = c;
+        }
+      }
+      float* sum = &sums[static_cast<size_t>(closest) * dimension_];
+      for (int i = 0; i < dimension_; ++i) {
+        sum[i] += sample[i];
+      }
+      ++counts[closest];
+    }
+    for (int c = 0; c < num_clusters; ++c) {
+      // Empty clusters keep their previous centroid.
+      if (counts[c] == 0) continue;
+      const float* sum = &sums[static_cast<size_t>(c) * dimension_];
+      const float norm = std::sqrt(DotProduct(sum, sum, dimension_));
+      if (norm <= 0.0f) continue;
+      for (int i = 0; i < dimension_; ++i) {
+        centroids[static_cast<size_t>(c) * dimension_ + i] = sum[i] / norm;
+      }
+    }
+  }
+
+  centroids_ = std::move(centroids);
+  num_clusters_ = num_clusters;
+  lists_.assign(num_clusters, {});
+  for (int id = 0; id < size_; ++id) {
+    lists_[ClosestCentroid(id)].push_back(id);
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<EmbeddingSearchResult>> EmbeddingIndex::Search(
+    const Embedding& query, int k) const {
+  if (k <= 0) {
+    return InvalidArgumentError(absl::StrCat("Invalid k: ", k));
+  }
+  ABSL_RETURN_IF_ERROR(CheckEmbedding(query));
+
+  const void* query_data;
+  // The L2-normalized query, for comparison with the centroids.
+  std::vector<float> normalized_query(dimension_);
+  double squared_norm = 0.0;
+  if (quantized_) {
+    const auto* data =
+        reinterpret_cast<const int8_t*>(query.quantized_embedding.data());
+    query_data = data;
+    std::copy_n(data, dimension_, normalized_query.begin());
+  } else {
+    query_data = query.float_embedding.data();
+    std::copy_n(query.float_embedding.begin(), dimension_,
+                normalized_query.begin());
+  }
+  for (float value : normalized_query) {
+    squared_norm += value * value;
+  }
+  if (squared_norm <= 0.0) {
+    return InvalidArgumentError(
+        "Cannot compute cosine similarity on embedding with 0 norm");
+  }
+  const float inverse_query_norm = 1.0 / std::sqrt(squared_norm);
+
+  TopK top_k(std::min(k, size_));
+  if (!trained()) {
+    for (int id = 0; id < size_; ++id) {
+      top_k.Offer(id, Dot(query_data, id) * inverse_query_norm *
+                          inverse_norms_[id]);
+    }
+    return std::move(top_k).Finish();
+  }
+
+  for (float& value : normalized_query) {
+    value *= inverse_query_norm;
+  }
+  std::vector<float> centroid_dots(num_clusters_);
+  for (int c = 0; c < num_clusters_; ++c) {
+    centroid_dots[c] = DotProduct(
+        normalized_query.data(),
+        &centroids_[static_cast<size_t>(c) * dimension_], dimension_);
+  }
+  std::vector<int> probes(num_clusters_);
+  std::iota(probes.begin(), probes.end(), 0);
+  const int num_probes = std::min(options_.num_probes, num_clusters_);
+  std::partial_sort(probes.begin(), probes.begin() + num_probes, probes.end(),
+                    [&centroid_dots](int a, int b) {
+                      return centroid_dots[a] > centroid_dots[b];
+                    });
+  for (int p = 0; p < num_probes; ++p) {
+    for (int id : lists_[probes[p]]) {
+      top_k.Offer(id, Dot(query_data, id) * inverse_query_norm *
+                          inverse_norms_[id]);
+    }
+  }
+  return std::move(top_k).Finish();
+}
+
+absl::Status EmbeddingIndex::Save(absl::string_view path) const {
+  FileHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dimension = dimension_;
+  header.quantized = quantized_;
+  header.size = size_;
+  header.num_clusters = num_clusters_;
+  header.num_probes = options_.num_probes;
+
+  std::string contents;
+  AppendSection(&header, sizeof(header), &contents);
+  const size_t num_elements = static_cast<size_t>(size_) * dimension_;
+  if (quantized_) {
+    AppendSection(int8_data_, num_elements * sizeof(int8_t), &contents);
+  } else {
+    AppendSection(float_data_, num_elements * sizeof(float), &contents);
+  }
+  AppendSection(inverse_norms_, size_ * sizeof(float), &contents);
+  if (trained()) {
+    AppendSection(centroids_.data(), centroids_.size() * sizeof(float),
+                  &contents);
+    std::vector<uint32_t> list_sizes;
+    std::vector<uint32_t> list_ids;
+    list_ids.reserve(size_);
+    for (const std::vector<int>& list : lists_) {
+      list_sizes.push_back(list.size());
+      list_ids.insert(list_ids.end(), list.begin(), list.end());
+    }
+    AppendSection(list_sizes.data(), list_sizes.size() * sizeof(uint32_t),
+                  &contents);
+    AppendSection(list_ids.data(), list_ids.size() * sizeof(uint32_t),
+                  &contents);
+  }
+  return file::SetContents(path, contents);
+}
+
+absl::StatusOr<std::unique_ptr<EmbeddingIndex>> EmbeddingIndex::Load(
+    absl::string_view path) {
+  auto mapped_file_or = file::MMapFile(path);
+  if (!mapped_file_or.ok()) return mapped_file_or.status();
+  std::unique_ptr<file::MemoryMappedFile> mapped_file =
+      *std::move(mapped_file_or);
+  // Unmaps the file if it turns out to be invalid.
+  absl::Cleanup unmap = [&mapped_file] {
+    if (mapped_file != nullptr) mapped_file->Close().IgnoreError();
+  };
+  const char* const data =
+      static_cast<const char*>(mapped_file->BaseAddress());
+  const size_t length = mapped_file->Length();
+  const auto corrupted = [path](absl::string_view reason) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Invalid embedding index file '", path, "': ", reason));
+  };
+
+  FileHeader header;
+  if (length < sizeof(header)) return corrupted("truncated header");
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return corrupted("bad magic");
+  }
+  if (header.version != kVersion) {
+    return corrupted(absl::StrCat("unsupported version ", header.version));
+  }
+  if (header.dimension == 0 ||
+      header.dimension > std::numeric_limits<int>::max() ||
+      header.size > std::numeric_limits<int>::max() ||
+      header.num_clusters > header.size || header.num_probes == 0) {
+    return corrupted("bad header");
+  }
+
+  // Returns the offset of a section of `num_bytes` bytes, or an error if the
+  // file is too short.
+  size_t offset = AlignSection(sizeof(header));
+  const auto next_section =
+      [&offset, length](size_t num_bytes) -> absl::StatusOr<size_t> {
+    const size_t section_offset = offset;
+    if (section_offset > length || num_bytes > length - section_offset) {
+      return absl::OutOfRangeError("truncated file");
+    }
+    offset = AlignSection(section_offset + num_bytes);
+    return section_offset;
+  };
+
+  EmbeddingIndexOptions options;
+  options.num_clusters = header.num_clusters;
+  options.num_probes = header.num_probes;
+  auto index = absl::WrapUnique(
+      new EmbeddingIndex(header.dimension, header.quantized != 0, options));
+  index->size_ = header.size;
+  const size_t num_elements = static_cast<size_t>(header.size) *
+                              header.dimension;
+  const size_t element_size =
+      index->quantized_ ? sizeof(int8_t) : sizeof(float);
+  if (num_elements / header.dimension != header.size ||
+      num_elements > std::numeric_limits<size_t>::max() / element_size) {
+    return corrupted("bad header");
+  }
+  auto data_offset = next_section(num_elements * element_size);
+  if (!data_offset.ok()) return corrupted(data_offset.status().message());
+  if (index->quantized_) {
+    index->int8_data_ = reinterpret_cast<const int8_t*>(data + *data_offset);
+  } else {
+    index->float_data_ = reinterpret_cast<const float*>(data + *data_offset);
+  }
+  auto norms_offset = next_section(header.size * sizeof(float));
+  if (!norms_offset.ok()) return corrupted(norms_offset.status().message());
+  index->inverse_norms_ =
+      reinterpret_cast<const float*>(data + *norms_offset);
+
+  if (header.num_clusters > 0) {
+    const size_t num_centroid_elements =
+        static_cast<size_t>(header.num_clusters) * header.dimension;
+    auto centroids_offset =
+        next_section(num_centroid_elements * sizeof(float));
+    if (!centroids_offset.ok()) {
+      return corrupted(centroids_offset.status().message());
+    }
+    const auto* centroids =
+        reinterpret_cast<const float*>(data + *centroids_offset);
+    index->centroids_.assign(centroids, centroids + num_centroid_elements);
+
+    auto sizes_offset = next_section(header.num_clusters * sizeof(uint32_t));
+    if (!sizes_offset.ok()) return corrupted(sizes_offset.status().message());
+    auto ids_offset = next_section(header.size * sizeof(uint32_t));
+    if (!ids_offset.ok()) return corrupted(ids_offset.status().message());
+    const auto* list_sizes =
+        reinterpret_cast<const uint32_t*>(data + *sizes_offset);
+    const auto* list_ids =
+        reinterpret_cast<const uint32_t*>(data + *ids_offset);
+    index->lists_.resize(header.num_clusters);
+    size_t num_ids = 0;
+    for (uint32_t c = 0; c < header.num_clusters; ++c) {
+      if (list_sizes[c] > header.size - num_ids) {
+        return corrupted("bad cluster sizes");
+      }
+      std::vector<int>& list = index->lists_[c];
+      list.reserve(list_sizes[c]);
+      for (uint32_t i = 0; i < list_sizes[c]; ++i, ++num_ids) {
+        if (list_ids[num_ids] >= header.size) {
+          return corrupted("bad embedding id");
+        }
+        list.push_back(list_ids[num_ids]);
+      }
+    }
+    if (num_ids != header.size) return corrupted("bad cluster sizes");
+    index->num_clusters_ = header.num_clusters;
+  }
+  index->mapped_file_ = std::move(mapped_file);
+  return index;
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,160 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_EMBEDDING_INDEX_H_
+#define MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_EMBEDDING_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/deps/mmapped_file.h"
+#include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+
+// Options for configuring an EmbeddingIndex.
+struct EmbeddingIndexOptions {
+  // The number of clusters of the inverted file (IVF) mode. If 0, searches
+  // compare the query with every embedding of the index, which is exact.
+  // Otherwise, Train() clusters the embeddings and searches only compare the
+  // query with the embeddings of the `num_probes` clusters closest to it,
+  // which is approximate but much faster for large indices. A good value is
+  // around the square root of the number of embeddings.
+  int num_clusters = 0;
+
+  // The number of clusters searched per query in IVF mode. Higher values
+  // increase recall at the expense of speed.
+  int num_probes = 8;
+
+  // The number of k-means iterations run by Train().
+  int num_training_iterations = 10;
+};
+
+// A search result of an EmbeddingIndex.
+struct EmbeddingSearchResult {
+  // The id returned by EmbeddingIndex::Add() for the embedding.
+  int id;
+  // The cosine similarity between the query and the embedding.
+  float similarity;
+};
+
+// An in-memory index of embeddings, as output by e.g. TextEmbedder or
+// ImageEmbedder, supporting top-k cosine similarity search.
+//
+// The embeddings of an index are all either float or scalar-quantized, and
+// all have the same size. They are stored contiguously along with their
+// inverse L2-norms, so that a search only computes one dot product per
+// embedding. Indices can be saved to a file and loaded back with memory
+// mapping, in which case they are read-only.
+//
+// Search() is thread-safe, as long as no other method is called concurrently.
+//
+// Example:
+//   ABSL_ASSIGN_OR_RETURN(auto index,
+//                         EmbeddingIndex::Create(/*dimension=*/512,
+//                                                /*quantized=*/false));
+//   for (const auto& result : text_embedder_results) {
+//     ABSL_ASSIGN_OR_RETURN(int id, index->Add(result.embeddings[0]));
+//   }
+//   ABSL_ASSIGN_OR_RETURN(auto neighbors,
+//                         index->Search(query.embeddings[0], /*k=*/10));
+class EmbeddingIndex {
+ public:
+  // Creates an empty index of embeddings of `dimension` elements, either
+  // float or scalar-quantized.
+  static absl::StatusOr<std::unique_ptr<EmbeddingIndex>> Create(
+      int dimension, bool quantized, EmbeddingIndexOptions options = {});
+
+  // Loads an index written by Save(). The file is memory-mapped rather than
+  // read, so loading is fast and the pages of the index are shared between
+  // processes. The loaded index can't be modified.
+  static absl::StatusOr<std::unique_ptr<EmbeddingIndex>> Load(
+      absl::string_view path);
+
+  EmbeddingIndex(const EmbeddingIndex&) = delete;
+  EmbeddingIndex& operator=(const EmbeddingIndex&) = delete;
+  ~EmbeddingIndex();
+
+  // Adds an embedding to the index and returns its id. Ids are assigned
+  // sequentially from 0. Fails if the embedding has the wrong type or size,
+  // or an L2-norm of 0.
+  absl::StatusOr<int> Add(const containers::Embedding& embedding);
+
+  // Clusters the embeddings added so far in IVF mode, see
+  // EmbeddingIndexOptions::num_clusters. Embeddings added after training are
+  // assigned to the closest existing cluster, so Train() should be called
+  // again when the index has grown significantly. Until the index is
+  // trained, searches are exact.
+  absl::Status Train();
+
+  // Returns the (at most) `k` embeddings most similar to `query`, by
+  // decreasing cosine similarity.
+  absl::StatusOr<std::vector<EmbeddingSearchResult>> Search(
+      const containers::Embedding& query, int k) const;
+
+  // Writes the index to `path`, see Load().
+  absl::Status Save(absl::string_view path) const;
+
+  int dimension() const { return dimension_; }
+  bool quantized() const { return quantized_; }
+  int size() const { return size_; }
+  bool trained() const { return num_clusters_ > 0; }
+
+ private:
+  EmbeddingIndex(int dimension, bool quantized, EmbeddingIndexOptions options);
+
+  // Returns the (unnormalized) dot product of `query`, which must be float or
+  // int8_t according to the index type, with the embedding `id`.
+  float Dot(const void* query, int id) const;
+  // Returns the id of the centroid closest to the embedding `id`.
+  int ClosestCentroid(int id) const;
+  absl::Status CheckEmbedding(const containers::Embedding& embedding) const;
+
+  const int dimension_;
+  const bool quantized_;
+  EmbeddingIndexOptions options_;
+  int size_ = 0;
+
+  // The embeddings, row-major, and their inverse L2-norms. These point either
+  // to the vectors below or to the memory-mapped file.
+  const float* float_data_ = nullptr;
+  const int8_t* int8_data_ = nullptr;
+  const float* inverse_norms_ = nullptr;
+  std::vector<float> float_storage_;
+  std::vector<int8_t> int8_storage_;
+  std::vector<float> inverse_norm_storage_;
+
+  // IVF mode: the L2-normalized cluster centroids, row-major, and the ids of
+  // the embeddings of each cluster.
+  int num_clusters_ = 0;
+  std::vector<float> centroids_;
+  std::vector<std::vector<int>> lists_;
+
+  std::unique_ptr<file::MemoryMappedFile> mapped_file_;
+};
+
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_EMBEDDING_INDEX_H_
@@ -0,0 +1,289 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/components/utils/embedding_index.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/deps/file_helpers.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+#include "mediapipe/tasks/cc/components/utils/cosine_similarity.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+namespace {
+
+using ::mediapipe::tasks::components::containers::Embedding;
+using ::testing::HasSubstr;
+
+// Helper function to generate float Embedding.
+Embedding BuildFloatEmbedding(std::vector<float> values) {
+  Embedding embedding;
+  embedding.float_embedding = values;
+  return embedding;
+}
+
+// Helper function to generate quantized Embedding.
+Embedding BuildQuantizedEmbedding(std::vector<int8_t> values) {
+  Embedding embedding;
+  uint8_t* data = reinterpret_cast<uint8_t*>(values.data());
+  embedding.quantized_embedding = {data, data + values.size()};
+  return embedding;
+}
+
+std::vector<Embedding> BuildRandomFloatEmbeddings(int num_embeddings,
+                                                  int dimension) {
+  std::mt19937 generator(42);
+  std::normal_distribution<float> distribution;
+  std::vector<Embedding> embeddings;
+  for (int i = 0; i < num_embeddings; ++i) {
+    std::vector<float> values(dimension);
+    for (float& value : values) {
+      value = distribution(generator);
+    }
+    embeddings.push_back(BuildFloatEmbedding(values));
+  }
+  return embeddings;
+}
+
+std::string GetTempPath(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+TEST(EmbeddingIndex, SearchesFloatEmbeddings) {
+  MP_ASSERT_OK_AND_ASSIGN(auto index,
+                          EmbeddingIndex::Create(/*dimension=*/2,
+                                                 /*quantized=*/false));
+  MP_ASSERT_OK_AND_ASSIGN(int id0, index->Add(BuildFloatEmbedding({1, 0})));
+  MP_ASSERT_OK_AND_ASSIGN(int id1, index->Add(BuildFloatEmbedding({0, 2})));
+  MP_ASSERT_OK_AND_ASSIGN(int id2, index->Add(BuildFloatEmbedding({1, 1})));
+  EXPECT_EQ(id0, 0);
+  EXPECT_EQ(id1, 1);
+  EXPECT_EQ(id2, 2);
+  EXPECT_EQ(index->size(), 3);
+
+  MP_ASSERT_OK_AND_ASSIGN(auto results,
+                          index->Search(BuildFloatEmbedding({3, 0}), 2));
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].id, 0);
+  EXPECT_FLOAT_EQ(results[0].similarity, 1.0f);
+  EXPECT_EQ(results[1].id, 2);
+  EXPECT_NEAR(results[1].similarity, 0.70710677f, 1e-6);
+
+  // k larger than the index.
+  MP_ASSERT_OK_AND_ASSIGN(results,
+                          index->Search(BuildFloatEmbedding({0, 1}), 10));
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(results[0].id, 1);
+  EXPECT_EQ(results[1].id, 2);
+  EXPECT_EQ(results[2].id, 0);
+}
+
+TEST(EmbeddingIndex, SearchesQuantizedEmbeddings) {
+  MP_ASSERT_OK_AND_ASSIGN(auto index,
+                          EmbeddingIndex::Create(/*dimension=*/3,
+                                                 /*quantized=*/true));
+  MP_ASSERT_OK(index->Add(BuildQuantizedEmbedding({127, 0, 0})).status());
+  MP_ASSERT_OK(index->Add(BuildQuantizedEmbedding({0, -128, 0})).status());
+  MP_ASSERT_OK(index->Add(BuildQuantizedEmbedding({10, 10, 10})).status());
+
+  const Embedding query = BuildQuantizedEmbedding({1, 2, 3});
+  MP_ASSERT_OK_AND_ASSIGN(auto results, index->Search(query, 3));
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(results[0].id, 2);
+  EXPECT_EQ(results[1].id, 0);
+  EXPECT_EQ(results[2].id, 1);
+  MP_ASSERT_OK_AND_ASSIGN(
+      double expected,
+      CosineSimilarity(query, BuildQuantizedEmbedding({10, 10, 10})));
+  EXPECT_NEAR(results[0].similarity, expected, 1e-6);
+}
+
+TEST(EmbeddingIndex, MatchesCosineSimilarity) {
+  const std::vector<Embedding> embeddings =
+      BuildRandomFloatEmbeddings(/*num_embeddings=*/100, /*dimension=*/37);
+  MP_ASSERT_OK_AND_ASSIGN(auto index,
+                          EmbeddingIndex::Create(/*dimension=*/37,
+                                                 /*quantized=*/false));
+  for (const Embedding& embedding : embeddings) {
+    MP_ASSERT_OK(index->Add(embedding).status());
+  }
+  MP_ASSERT_OK_AND_ASSIGN(auto results, index->Search(embeddings[7], 100));
+  ASSERT_EQ(results.size(), 100);
+  EXPECT_EQ(results[0].id, 7);
+  for (int i = 0; i < results.size(); ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(
+        double expected,
+        CosineSimilarity(embeddings[7], embeddings[results[i].id]));
+    EXPECT_NEAR(results[i].similarity, expected, 1e-5);
+    if (i > 0) {
+      EXPECT_GE(results[i - 1].similarity, results[i].similarity);
+    }
+  }
+}
+
+TEST(EmbeddingIndex, FailsWithInvalidEmbeddings) {
+  MP_ASSERT_OK_AND_ASSIGN(auto index,
+                          EmbeddingIndex::Create(/*dimension=*/2,
+                                                 /*quantized=*/false));
+  auto status = index->Add(BuildFloatEmbedding({0.1, 0.2, 0.3})).status();
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(), HasSubstr("Expected an embedding of size 2"));
+
+  status = index->Add(BuildQuantizedEmbedding({1, 2})).status();
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(), HasSubstr("Expected a float embedding"));
+
+  status = index->Add(BuildFloatEmbedding({0.0, 0.0})).status();
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(), HasSubstr("0 norm"));
+  EXPECT_EQ(index->size(), 0);
+
+  status = index->Search(BuildFloatEmbedding({0.1, 0.2}), 0).status();
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+}
+
+TEST(EmbeddingIndex, SearchesClustersAfterTraining) {
+  constexpr int kDimension = 16;
+  const std::vector<Embedding> embeddings =
+      BuildRandomFloatEmbeddings(/*num_embeddings=*/1000, kDimension);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto index,
+      EmbeddingIndex::Create(kDimension, /*quantized=*/false,
+                             {.num_clusters = 10, .num_probes = 10}));
+  for (int i = 0; i < 500; ++i) {
+    MP_ASSERT_OK(index->Add(embeddings[i]).status());
+  }
+  MP_ASSERT_OK(index->Train());
+  EXPECT_TRUE(index->trained());
+  // Embeddings added after training are assigned to clusters as well.
+  for (int i = 500; i < embeddings.size(); ++i) {
+    MP_ASSERT_OK(index->Add(embeddings[i]).status());
+  }
+
+  // Probing all clusters is exact.
+  MP_ASSERT_OK_AND_ASSIGN(auto exact_index,
+                          EmbeddingIndex::Create(kDimension,
+                                                 /*quantized=*/false));
+  for (const Embedding& embedding : embeddings) {
+    MP_ASSERT_OK(exact_index->Add(embedding).status());
+  }
+  for (int query : {3, 600, 999}) {
+    MP_ASSERT_OK_AND_ASSIGN(auto results,
+                            index->Search(embeddings[query], 5));
+    MP_ASSERT_OK_AND_ASSIGN(auto expected,
+                            exact_index->Search(embeddings[query], 5));
+    ASSERT_EQ(results.size(), expected.size());
+    for (int i = 0; i < results.size(); ++i) {
+      EXPECT_EQ(results[i].id, expected[i].id);
+    }
+    EXPECT_EQ(results[0].id, query);
+  }
+}
+
+TEST(EmbeddingIndex, FailsToTrainWithoutClusters) {
+  MP_ASSERT_OK_AND_ASSIGN(auto index,
+                          EmbeddingIndex::Create(/*dimension=*/2,
+                                                 /*quantized=*/false));
+  EXPECT_EQ(index->Train().code(), absl::StatusCode::kFailedPrecondition);
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      index, EmbeddingIndex::Create(/*dimension=*/2, /*quantized=*/false,
+                                    {.num_clusters = 2}));
+  MP_ASSERT_OK(index->Add(BuildFloatEmbedding({1, 0})).status());
+  EXPECT_EQ(index->Train().code(), absl::StatusCode::kFailedPrecondition);
+}
+
+TEST(EmbeddingIndex, SavesAndLoads) {
+  constexpr int kDimension = 8;
+  const std::vector<Embedding> embeddings =
+      BuildRandomFloatEmbeddings(/*num_embeddings=*/200, kDimension);
+  for (int num_clusters : {0, 4}) {
+    MP_ASSERT_OK_AND_ASSIGN(
+        auto index,
+        EmbeddingIndex::Create(kDimension, /*quantized=*/false,
+                               {.num_clusters = num_clusters,
+                                .num_probes = 2}));
+    for (const Embedding& embedding : embeddings) {
+      MP_ASSERT_OK(index->Add(embedding).status());
+    }
+    if (num_clusters > 0) {
+      MP_ASSERT_OK(index->Train());
+    }
+    const std::string path = GetTempPath("embedding_index");
+    MP_ASSERT_OK(index->Save(path));
+
+    MP_ASSERT_OK_AND_ASSIGN(auto loaded_index, EmbeddingIndex::Load(path));
+    EXPECT_EQ(loaded_index->dimension(), kDimension);
+    EXPECT_FALSE(loaded_index->quantized());
+    EXPECT_EQ(loaded_index->size(), embeddings.size());
+    EXPECT_EQ(loaded_index->trained(), num_clusters > 0);
+    for (int query : {0, 123}) {
+      MP_ASSERT_OK_AND_ASSIGN(auto results,
+                              index->Search(embeddings[query], 10));
+      MP_ASSERT_OK_AND_ASSIGN(auto loaded_results,
+                              loaded_index->Search(embeddings[query], 10));
+      ASSERT_EQ(results.size(), loaded_results.size());
+      for (int i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].id, loaded_results[i].id);
+        EXPECT_EQ(results[i].similarity, loaded_results[i].similarity);
+      }
+    }
+    EXPECT_EQ(loaded_index->Add(embeddings[0]).status().code(),
+              absl::StatusCode::kFailedPrecondition);
+  }
+}
+
+TEST(EmbeddingIndex, SavesAndLoadsQuantizedEmbeddings) {
+  MP_ASSERT_OK_AND_ASSIGN(auto index,
+                          EmbeddingIndex::Create(/*dimension=*/3,
+                                                 /*quantized=*/true));
+  MP_ASSERT_OK(index->Add(BuildQuantizedEmbedding({127, 0, 0})).status());
+  MP_ASSERT_OK(index->Add(BuildQuantizedEmbedding({0, -128, 5})).status());
+  const std::string path = GetTempPath("quantized_embedding_index");
+  MP_ASSERT_OK(index->Save(path));
+
+  MP_ASSERT_OK_AND_ASSIGN(auto loaded_index, EmbeddingIndex::Load(path));
+  EXPECT_TRUE(loaded_index->quantized());
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto results,
+      loaded_index->Search(BuildQuantizedEmbedding({0, -1, 0}), 1));
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0].id, 1);
+}
+
+TEST(EmbeddingIndex, FailsToLoadInvalidFile) {
+  const std::string path = GetTempPath("invalid_embedding_index");
+  MP_ASSERT_OK(file::SetContents(path, "not an embedding index file"));
+  auto status = EmbeddingIndex::Load(path).status();
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(), HasSubstr("Invalid embedding index file"));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
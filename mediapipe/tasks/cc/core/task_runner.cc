@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <map>
@@ -175,8 +176,16 @@ absl::Status TaskRunner::Initialize(
     mediapipe::tool::AddMultiStreamCallback(
         output_stream_names_,
         [this](const std::vector<Packet>& packets) {
-          status_or_output_packets_ =
-              GenerateOutputPacketMap(packets, output_stream_names_);
+          if (batch_output_packets_ != nullptr) {
+            auto output_packets =
+                GenerateOutputPacketMap(packets, output_stream_names_);
+            if (output_packets.ok()) {
+              batch_output_packets_->push_back(*std::move(output_packets));
+            }
+          } else {
+            status_or_output_packets_ =
+                GenerateOutputPacketMap(packets, output_stream_names_);
+          }
           tasks_logger_->RecordInvocationEnd(packets.back().Timestamp());
           return;
         },
@@ -303,6 +312,106 @@ absl::StatusOr<PacketMap> TaskRunner::Process(PacketMap inputs) {
   return status_or_output_packets_;
 }
 
+absl::StatusOr<std::vector<PacketMap>> TaskRunner::ProcessBatch(
+    std::vector<PacketMap> inputs) {
+  if (!is_running_) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "Task runner is currently not running.",
+        MediaPipeTasksStatus::kRunnerNotStartedError);
+  }
+  if (packets_callback_) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "Calling TaskRunner::ProcessBatch method is illegal when the result "
+        "callback is provided.",
+        MediaPipeTasksStatus::kRunnerApiCalledInWrongModeError);
+  }
+  for (const PacketMap& packet_map : inputs) {
+    ABSL_ASSIGN_OR_RETURN(auto input_timestamp,
+                          ValidateAndGetPacketTimestamp(packet_map));
+    if (input_timestamp != Timestamp::Unset()) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          "The input packets of TaskRunner::ProcessBatch must not have a "
+          "timestamp.",
+          MediaPipeTasksStatus::kRunnerInvalidTimestampError);
+    }
+  }
+  std::vector<PacketMap> outputs(inputs.size());
+  if (inputs.empty()) {
+    return outputs;
+  }
+  // See Process() for why only one invocation, here one batch, is processed
+  // at a time.
+  absl::MutexLock lock(mutex_);
+  const Timestamp first_timestamp =
+      last_seen_ == Timestamp::Unset()
+          ? Timestamp(0)
+          : last_seen_ + Timestamp::kTimestampUnitsPerSecond;
+  std::vector<PacketMap> output_packets;
+  output_packets.reserve(inputs.size());
+  batch_output_packets_ = &output_packets;
+  absl::Status add_status;
+  for (int i = 0; i < inputs.size() && add_status.ok(); ++i) {
+    const Timestamp input_timestamp =
+        first_timestamp + i * Timestamp::kTimestampUnitsPerSecond;
+    tasks_logger_->RecordCpuInputArrival(input_timestamp);
+    for (auto& [stream_name, packet] : inputs[i]) {
+      add_status = AddPayload(
+          graph_.AddPacketToInputStream(stream_name,
+                                        std::move(packet).At(input_timestamp)),
+          absl::StrCat("Failed to add packet to the graph input stream: ",
+                       stream_name),
+          MediaPipeTasksStatus::kRunnerUnexpectedInputError);
+      if (!add_status.ok()) break;
+    }
+    last_seen_ = input_timestamp;
+  }
+  // The graph must be idle before the output vector goes out of scope, even if
+  // adding the inputs failed.
+  const bool idle = graph_.WaitUntilIdle().ok();
+  batch_output_packets_ = nullptr;
+  ABSL_RETURN_IF_ERROR(add_status);
+  if (!idle) {
+    absl::Status graph_status;
+    graph_.GetCombinedErrors(&graph_status);
+    return graph_status;
+  }
+
+  for (PacketMap& packet_map : output_packets) {
+    Timestamp timestamp = Timestamp::Unset();
+    for (const auto& [stream_name, packet] : packet_map) {
+      if (!packet.IsEmpty()) {
+        timestamp = packet.Timestamp();
+        break;
+      }
+    }
+    // Only the timestamp bounds advanced.
+    if (timestamp == Timestamp::Unset()) continue;
+    last_seen_ = std::max(timestamp, last_seen_);
+    const int64_t offset = (timestamp - first_timestamp).Value();
+    const int64_t index = offset / Timestamp::kTimestampUnitsPerSecond;
+    if (offset < 0 || offset % Timestamp::kTimestampUnitsPerSecond != 0 ||
+        index >= static_cast<int64_t>(outputs.size())) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInternal,
+          absl::StrCat("Unexpected output timestamp in batch processing: ",
+                       timestamp.DebugString()),
+          MediaPipeTasksStatus::kRunnerUnexpectedOutputError);
+    }
+    outputs[index] = std::move(packet_map);
+  }
+  for (PacketMap& packet_map : outputs) {
+    if (packet_map.empty()) {
+      for (const std::string& stream_name : output_stream_names_) {
+        packet_map[stream_name] = Packet();
+      }
+    }
+  }
+  return outputs;
+}
+
 absl::Status TaskRunner::Send(PacketMap inputs) {
   if (!is_running_) {
     return CreateStatusWithPayload(
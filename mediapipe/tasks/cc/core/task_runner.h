@@ -122,6 +122,19 @@ class TaskRunner {
   // timestamps are in order.
   absl::StatusOr<PacketMap> Process(PacketMap inputs);
 
+  // A synchronous method that processes a batch of unrelated invocations, such
+  // as a set of texts to embed, in one call. Unlike calling Process() for each
+  // of them, all inputs are added to the graph before waiting for it to become
+  // idle, so that different nodes can work on different invocations
+  // concurrently, e.g. an input is preprocessed while inference runs on the
+  // previous one. The input packets must have no timestamp, and the graph must
+  // output the results of an invocation at its input timestamp. Returns the
+  // output packets of each invocation in input order; outputs which were not
+  // produced are empty packets. A runtime error fails the whole batch. Same
+  // thread-safety as Process().
+  absl::StatusOr<std::vector<PacketMap>> ProcessBatch(
+      std::vector<PacketMap> inputs);
+
   // An asynchronous method that is designed for handling live streaming data
   // such as live camera and microphone data. A user-defined PacketsCallback
   // function must be provided in the constructor to receive the output packets.
@@ -176,6 +189,9 @@ class TaskRunner {
   std::atomic_bool is_running_ = false;
 
   absl::StatusOr<PacketMap> status_or_output_packets_;
+  // Collects the outputs of all invocations while ProcessBatch() waits for the
+  // graph to become idle.
+  std::vector<PacketMap>* batch_output_packets_ = nullptr;
   Timestamp last_seen_ ABSL_GUARDED_BY(mutex_);
   absl::Mutex mutex_;
 };
@@ -22,6 +22,7 @@ limitations under the License.
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -332,6 +333,58 @@ TEST_F(TaskRunnerTest, ReportErrorInAsyncAPICall) {
               testing::HasSubstr("An intended error for testing"));
 }
 
+TEST_F(TaskRunnerTest, BatchSyncAPICalls) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner, TaskRunner::Create({.config = GetPassThroughGraphConfig(),
+                                       .task_name = kTaskName,
+                                       .task_running_mode = kRunningMode}));
+  MP_ASSERT_OK(runner->Process({{"in", MakePacket<int>(-1)}}).status());
+  std::vector<PacketMap> inputs;
+  for (int i = 0; i < 100; ++i) {
+    inputs.push_back({{"in", MakePacket<int>(i)}});
+  }
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<PacketMap> outputs,
+                          runner->ProcessBatch(std::move(inputs)));
+  ASSERT_EQ(outputs.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, outputs[i]["out"].Get<int>());
+  }
+  // Synchronous calls can be mixed with batches.
+  auto status_or_result = runner->Process({{"in", MakePacket<int>(100)}});
+  ASSERT_TRUE(status_or_result.ok());
+  EXPECT_EQ(100, status_or_result.value()["out"].Get<int>());
+  MP_ASSERT_OK(runner->Close());
+}
+
+TEST_F(TaskRunnerTest, BatchSyncAPICallsRejectTimestamps) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner, TaskRunner::Create({.config = GetPassThroughGraphConfig(),
+                                       .task_name = kTaskName,
+                                       .task_running_mode = kRunningMode}));
+  std::vector<PacketMap> inputs;
+  inputs.push_back({{"in", MakePacket<int>(0).At(Timestamp(0))}});
+  auto status_or_result = runner->ProcessBatch(std::move(inputs));
+  ASSERT_FALSE(status_or_result.ok());
+  EXPECT_EQ(status_or_result.status().code(),
+            absl::StatusCode::kInvalidArgument);
+  MP_ASSERT_OK(runner->Close());
+}
+
+TEST_F(TaskRunnerTest, ReportErrorInBatchSyncAPICall) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      TaskRunner::Create({.config = GetErrorCalculatorGraphConfig(),
+                          .task_name = kTaskName,
+                          .task_running_mode = kRunningMode}));
+  std::vector<PacketMap> inputs;
+  inputs.push_back({{"in", MakePacket<int>(0)}});
+  inputs.push_back({{"in", MakePacket<int>(1)}});
+  auto status_or_result = runner->ProcessBatch(std::move(inputs));
+  ASSERT_FALSE(status_or_result.ok());
+  ASSERT_THAT(status_or_result.status().message(),
+              testing::HasSubstr("An intended error for testing"));
+}
+
 }  // namespace core
 }  // namespace tasks
 }  // namespace mediapipe
@@ -52,6 +52,15 @@ class DoubleArrayTrie {
   void IteratePrefixMatches(const utils::string_view& input,
                             callback update_fn) const;
 
+  // Returns whether some string in the trie may start with `c`.
+  bool MayStartWith(unsigned char c) const {
+    if (nodes_->size() == 0) {
+      return false;
+    }
+    const uint32_t pos = offset(0) ^ c;
+    return pos < nodes_->size() && label(pos) == c;
+  }
+
   // Finds the longest prefix match of a string.
   Match LongestPrefixMatch(const utils::string_view& input) const {
     Match match;
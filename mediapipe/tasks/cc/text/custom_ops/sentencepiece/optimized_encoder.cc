@@ -16,7 +16,11 @@ limitations under the License.
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/optimized_encoder.h"
 
 #include <algorithm>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/double_array_trie.h"
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/encoder_config_generated.h"
@@ -27,13 +31,23 @@ namespace {
 
 const char kSpaceSymbol[] = "\xe2\x96\x81";
 
+// Below this many strings per thread, starting a thread costs more than it
+// saves.
+constexpr int kMinStringsPerThread = 16;
+
+// Runs one normalization pass over `workspace->normalized`, leaving its
+// result there. The previous contents are kept in the pass buffers, so both
+// keep their capacity.
 template <typename processing_callback>
-std::tuple<std::string, std::vector<int>> process_string(
-    const std::string& input, const std::vector<int>& offsets,
-    const processing_callback& pc) {
-  std::string result_string;
+void process_string(const processing_callback& pc,
+                    EncoderWorkspace* workspace) {
+  const std::string& input = workspace->normalized;
+  const std::vector<int>& offsets = workspace->normalized_offsets;
+  std::string& result_string = workspace->pass_string;
+  std::vector<int>& result_offsets = workspace->pass_offsets;
+  result_string.clear();
   result_string.reserve(input.size());
-  std::vector<int> result_offsets;
+  result_offsets.clear();
   result_offsets.reserve(offsets.size());
   for (int i = 0, j = 0; i < input.size();) {
     auto result = pc(input.data() + i, input.size() - i);
@@ -54,7 +68,8 @@ std::tuple<std::string, std::vector<int>> process_string(
     j += consumed;
     i += consumed;
   }
-  return std::make_tuple(result_string, result_offsets);
+  workspace->normalized.swap(result_string);
+  workspace->normalized_offsets.swap(result_offsets);
 }
 
 inline char is_whitespace(char c) {
@@ -89,148 +104,225 @@ std::tuple<int, utils::string_view> find_replacement(
   }
   return std::make_tuple(0, utils::string_view(nullptr, 0));
 }
-}  // namespace
 
-std::tuple<std::string, std::vector<int>> NormalizeString(
-    const std::string& in_string, const EncoderConfig& config) {
-  std::vector<int> output_offsets;
-  std::string result = in_string;
-  output_offsets.reserve(in_string.length());
-  for (int i = 0; i < in_string.length(); ++i) {
-    output_offsets.push_back(i);
-  }
-  if (in_string.empty()) {
-    return std::make_tuple(result, output_offsets);
-  }
-  if (config.add_dummy_prefix()) {
-    result.insert(result.begin(), ' ');
-    output_offsets.insert(output_offsets.begin(), 0);
-  }
-  // Greedely replace normalized_prefixes with normalized_replacements
-  if (config.normalized_prefixes() != nullptr &&
-      config.normalized_replacements() != nullptr) {
-    const DoubleArrayTrie normalized_prefixes_matcher(
-        config.normalized_prefixes()->nodes());
-    const auto norm_replace = [&config, &normalized_prefixes_matcher](
-                                  const char* data, int len) {
-      return find_replacement(data, len, normalized_prefixes_matcher,
-                              *config.normalized_replacements());
-    };
-    std::tie(result, output_offsets) =
-        process_string(result, output_offsets, norm_replace);
-  }
-  if (config.remove_extra_whitespaces()) {
-    std::tie(result, output_offsets) =
-        process_string(result, output_offsets, remove_extra_whitespaces);
-    if (!result.empty() && is_whitespace(result.back())) {
-      result.pop_back();
-      output_offsets.pop_back();
+// Returns whether `str` is pure ASCII and none of its bytes starts a
+// normalized prefix, so that replacing the prefixes leaves it unchanged.
+bool IsUnchangedAscii(const std::string& str, const DoubleArrayTrie& dat) {
+  for (const char c : str) {
+    const unsigned char byte = c;
+    if (byte >= 0x80 || dat.MayStartWith(byte)) {
+      return false;
     }
   }
-  if (config.escape_whitespaces()) {
-    const auto replace_whitespaces = [](const char* data, int len) {
-      if (len > 0 && is_whitespace(*data)) {
-        return std::make_tuple(1, utils::string_view(kSpaceSymbol));
-      }
-      return std::make_tuple(0, utils::string_view(nullptr, 0));
-    };
-    std::tie(result, output_offsets) =
-        process_string(result, output_offsets, replace_whitespaces);
-  }
-
-  return std::make_tuple(result, output_offsets);
+  return true;
 }
 
-EncoderResult EncodeNormalizedString(const std::string& str,
-                                     const std::vector<int>& offsets,
-                                     const EncoderConfig& config, bool add_bos,
-                                     bool add_eos, bool reverse) {
+// Encodes the normalized string in `workspace` into `result`.
+void EncodeNormalizedString(const EncoderConfig& config, bool add_bos,
+                            bool add_eos, bool reverse,
+                            EncoderWorkspace* workspace,
+                            EncoderResult* result) {
+  const std::string& str = workspace->normalized;
+  const std::vector<int>& offsets = workspace->normalized_offsets;
   const DoubleArrayTrie piece_matcher(config.pieces()->nodes());
   const flatbuffers::Vector<float>* piece_scores = config.pieces_scores();
   const int unknown_code = config.unknown_code();
   const float unknown_penalty = config.unknown_penalty();
-  struct LatticeElement {
-    float score = 0;
-    int code = -1;
-    int prev_position = -1;
-    LatticeElement(float score_, int code_, int prev_position_)
-        : score(score_), code(code_), prev_position(prev_position_) {}
-    LatticeElement() {}
-  };
+  // The lattice element at each position is stored across three vectors, and
+  // is unreached while its previous position is negative.
   const int length = str.length();
-  std::vector<LatticeElement> lattice(length + 1);
+  std::vector<float>& scores = workspace->lattice_scores;
+  std::vector<int>& codes = workspace->lattice_codes;
+  std::vector<int>& prev_positions = workspace->lattice_prev_positions;
+  scores.assign(length + 1, 0);
+  codes.assign(length + 1, -1);
+  prev_positions.assign(length + 1, -1);
   for (int i = 0; i < length; ++i) {
-    if (i > 0 && lattice[i].prev_position < 0) {
+    if (i > 0 && prev_positions[i] < 0) {
       // This state is unreachable.
       continue;
     }
     if (unknown_code >= 0) {
       // Put unknown code.
-      const float penalized_score = lattice[i].score + unknown_penalty;
+      const float penalized_score = scores[i] + unknown_penalty;
       const int pos = i + 1;
-      LatticeElement& current_element = lattice[pos];
-      if (current_element.prev_position < 0 ||
-          current_element.score < penalized_score) {
-        current_element = LatticeElement(
-            penalized_score, unknown_code,
-            // If the current state is already reached by unknown code, merge
-            // states.
-            lattice[i].code == unknown_code ? lattice[i].prev_position : i);
+      if (prev_positions[pos] < 0 || scores[pos] < penalized_score) {
+        scores[pos] = penalized_score;
+        codes[pos] = unknown_code;
+        // If the current state is already reached by unknown code, merge
+        // states.
+        prev_positions[pos] =
+            codes[i] == unknown_code ? prev_positions[i] : i;
       }
     }
-    auto lattice_update = [&lattice, i,
+    auto lattice_update = [&scores, &codes, &prev_positions, i,
                            piece_scores](const DoubleArrayTrie::Match& m) {
-      LatticeElement& target_element = lattice[i + m.match_length];
-      const float score = lattice[i].score + (*piece_scores)[m.id];
-      if (target_element.prev_position < 0 || target_element.score < score) {
-        target_element = LatticeElement(score, m.id, i);
+      const int target = i + m.match_length;
+      const float score = scores[i] + (*piece_scores)[m.id];
+      if (prev_positions[target] < 0 || scores[target] < score) {
+        scores[target] = score;
+        codes[target] = m.id;
+        prev_positions[target] = i;
       }
     };
     piece_matcher.IteratePrefixMatches(
         utils::string_view(str.data() + i, length - i), lattice_update);
   }
 
-  EncoderResult result;
+  result->type = EncoderResultType::SUCCESS;
+  result->codes.clear();
+  result->offsets.clear();
   if (add_eos) {
-    result.codes.push_back(config.end_code());
-    result.offsets.push_back(length);
+    result->codes.push_back(config.end_code());
+    result->offsets.push_back(length);
   }
-  if (lattice[length].prev_position >= 0) {
+  if (prev_positions[length] >= 0) {
     for (int pos = length; pos > 0;) {
-      auto code = lattice[pos].code;
+      auto code = codes[pos];
       if (code != config.unknown_code()) {
         code += config.encoding_offset();
       }
-      result.codes.push_back(code);
-      pos = lattice[pos].prev_position;
-      result.offsets.push_back(offsets[pos]);
+      result->codes.push_back(code);
+      pos = prev_positions[pos];
+      result->offsets.push_back(offsets[pos]);
     }
   }
   if (add_bos) {
-    result.codes.push_back(config.start_code());
-    result.offsets.push_back(0);
+    result->codes.push_back(config.start_code());
+    result->offsets.push_back(0);
   }
   if (!reverse) {
-    std::reverse(result.codes.begin(), result.codes.end());
-    std::reverse(result.offsets.begin(), result.offsets.end());
+    std::reverse(result->codes.begin(), result->codes.end());
+    std::reverse(result->offsets.begin(), result->offsets.end());
+  }
+}
+
+// Returns the configuration in `config_buffer`, or nullptr if it is not a
+// sentencepiece one.
+const EncoderConfig* GetSentencepieceConfig(const void* config_buffer) {
+  const EncoderConfig* config = GetEncoderConfig(config_buffer);
+  if (config->version() != EncoderVersion::EncoderVersion_SENTENCE_PIECE) {
+    return nullptr;
+  }
+  return config;
+}
+
+}  // namespace
+
+std::tuple<std::string, std::vector<int>> NormalizeString(
+    const std::string& in_string, const EncoderConfig& config) {
+  EncoderWorkspace workspace;
+  NormalizeString(utils::string_view(in_string), config, &workspace);
+  return std::make_tuple(std::move(workspace.normalized),
+                         std::move(workspace.normalized_offsets));
+}
+
+void NormalizeString(utils::string_view in_string, const EncoderConfig& config,
+                     EncoderWorkspace* workspace) {
+  std::string& result = workspace->normalized;
+  std::vector<int>& output_offsets = workspace->normalized_offsets;
+  result.clear();
+  output_offsets.clear();
+  if (in_string.empty()) {
+    return;
+  }
+  if (config.add_dummy_prefix()) {
+    result.push_back(' ');
+    output_offsets.push_back(0);
+  }
+  result.append(in_string.data(), in_string.length());
+  for (int i = 0; i < in_string.length(); ++i) {
+    output_offsets.push_back(i);
+  }
+  // Greedely replace normalized_prefixes with normalized_replacements
+  if (config.normalized_prefixes() != nullptr &&
+      config.normalized_replacements() != nullptr) {
+    const DoubleArrayTrie normalized_prefixes_matcher(
+        config.normalized_prefixes()->nodes());
+    if (!IsUnchangedAscii(result, normalized_prefixes_matcher)) {
+      const auto norm_replace = [&config, &normalized_prefixes_matcher](
+                                    const char* data, int len) {
+        return find_replacement(data, len, normalized_prefixes_matcher,
+                                *config.normalized_replacements());
+      };
+      process_string(norm_replace, workspace);
+    }
+  }
+  if (config.remove_extra_whitespaces()) {
+    process_string(remove_extra_whitespaces, workspace);
+    if (!result.empty() && is_whitespace(result.back())) {
+      result.pop_back();
+      output_offsets.pop_back();
+    }
+  }
+  if (config.escape_whitespaces()) {
+    const auto replace_whitespaces = [](const char* data, int len) {
+      if (len > 0 && is_whitespace(*data)) {
+        return std::make_tuple(1, utils::string_view(kSpaceSymbol));
+      }
+      return std::make_tuple(0, utils::string_view(nullptr, 0));
+    };
+    process_string(replace_whitespaces, workspace);
   }
-  return result;
 }
 
 EncoderResult EncodeString(const std::string& string, const void* config_buffer,
                            bool add_bos, bool add_eos, bool reverse) {
+  EncoderWorkspace workspace;
+  EncoderResult result;
+  EncodeString(utils::string_view(string), config_buffer, add_bos, add_eos,
+               reverse, &workspace, &result);
+  return result;
+}
+
+void EncodeString(utils::string_view string, const void* config_buffer,
+                  bool add_bos, bool add_eos, bool reverse,
+                  EncoderWorkspace* workspace, EncoderResult* result) {
   // Get the config from the buffer.
-  const EncoderConfig* config = GetEncoderConfig(config_buffer);
-  if (config->version() != EncoderVersion::EncoderVersion_SENTENCE_PIECE) {
-    EncoderResult result;
-    result.type = EncoderResultType::WRONG_CONFIG;
-    return result;
-  }
-  std::string normalized_string;
-  std::vector<int> offsets;
-  std::tie(normalized_string, offsets) = NormalizeString(string, *config);
-  return EncodeNormalizedString(normalized_string, offsets, *config, add_bos,
-                                add_eos, reverse);
+  const EncoderConfig* config = GetSentencepieceConfig(config_buffer);
+  if (config == nullptr) {
+    result->type = EncoderResultType::WRONG_CONFIG;
+    result->codes.clear();
+    result->offsets.clear();
+    return;
+  }
+  NormalizeString(string, *config, workspace);
+  EncodeNormalizedString(*config, add_bos, add_eos, reverse, workspace,
+                         result);
+}
+
+EncoderResultType BatchEncoder::Encode(
+    const std::vector<utils::string_view>& strings, const void* config_buffer,
+    bool add_bos, bool add_eos, bool reverse, int num_threads) {
+  const EncoderConfig* config = GetSentencepieceConfig(config_buffer);
+  if (config == nullptr) {
+    return EncoderResultType::WRONG_CONFIG;
+  }
+  const int num_strings = strings.size();
+  results_.resize(num_strings);
+  const int num_chunks = std::max(
+      1, std::min(num_threads, num_strings / kMinStringsPerThread));
+  if (workspaces_.size() < static_cast<size_t>(num_chunks)) {
+    workspaces_.resize(num_chunks);
+  }
+  const auto encode_chunk = [&](int chunk) {
+    EncoderWorkspace* workspace = &workspaces_[chunk];
+    const int end = num_strings * (chunk + 1) / num_chunks;
+    for (int i = num_strings * chunk / num_chunks; i < end; ++i) {
+      NormalizeString(strings[i], *config, workspace);
+      EncodeNormalizedString(*config, add_bos, add_eos, reverse, workspace,
+                             &results_[i]);
+    }
+  };
+  for (int chunk = 1; chunk < num_chunks; ++chunk) {
+    threads_.emplace_back(encode_chunk, chunk);
+  }
+  encode_chunk(0);
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+  return EncoderResultType::SUCCESS;
 }
 
 }  // namespace mediapipe::tflite_operations::sentencepiece
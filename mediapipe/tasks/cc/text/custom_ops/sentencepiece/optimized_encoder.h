@@ -19,10 +19,12 @@ limitations under the License.
 // Sentencepiece encoder optimized with memmapped model.
 
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <tuple>
 #include <vector>
 
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/encoder_config_generated.h"
+#include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/utils.h"
 
 namespace mediapipe::tflite_operations::sentencepiece {
 
@@ -33,14 +35,68 @@ struct EncoderResult {
   std::vector<int> codes;
   std::vector<int> offsets;
 };
+
+// Buffers reused across calls to the encoder, so that normalizing or encoding
+// a string no longer than the previous ones does not allocate. A workspace
+// must not be used by several threads at once.
+struct EncoderWorkspace {
+  // The normalized string and, for each of its bytes, the offset in the input
+  // of the byte it was produced from.
+  std::string normalized;
+  std::vector<int> normalized_offsets;
+
+  // Output of the normalization pass in progress, swapped with the above.
+  std::string pass_string;
+  std::vector<int> pass_offsets;
+
+  // The Viterbi lattice over the normalized string.
+  std::vector<float> lattice_scores;
+  std::vector<int> lattice_codes;
+  std::vector<int> lattice_prev_positions;
+};
+
 std::tuple<std::string, std::vector<int>> NormalizeString(
     const std::string& in_string, const EncoderConfig& config);
 
+// Normalizes one string into `workspace->normalized` and
+// `workspace->normalized_offsets`. Pure ASCII strings which no normalization
+// rule applies to skip the lookup of the normalized prefixes.
+void NormalizeString(utils::string_view in_string, const EncoderConfig& config,
+                     EncoderWorkspace* workspace);
+
 // Encodes one string and returns ids and offsets. Takes the configuration as a
 // type-erased buffer.
 EncoderResult EncodeString(const std::string& string, const void* config_buffer,
                            bool add_bos, bool add_eos, bool reverse);
 
+// Encodes one string into `result`, reusing the capacity of its vectors and of
+// `workspace`.
+void EncodeString(utils::string_view string, const void* config_buffer,
+                  bool add_bos, bool add_eos, bool reverse,
+                  EncoderWorkspace* workspace, EncoderResult* result);
+
+// Encodes batches of strings, splitting each batch into contiguous chunks
+// which are encoded on separate threads. The results and a workspace per
+// thread are kept between calls, so that encoding similar batches does not
+// allocate. Not thread-safe.
+class BatchEncoder {
+ public:
+  // Encodes `strings` on up to `num_threads` threads, including the calling
+  // one, and returns WRONG_CONFIG without encoding anything if the
+  // configuration is not a sentencepiece one.
+  EncoderResultType Encode(const std::vector<utils::string_view>& strings,
+                           const void* config_buffer, bool add_bos,
+                           bool add_eos, bool reverse, int num_threads);
+
+  // The results of the last call to Encode(), one per string.
+  const std::vector<EncoderResult>& results() const { return results_; }
+
+ private:
+  std::vector<EncoderWorkspace> workspaces_;
+  std::vector<EncoderResult> results_;
+  std::vector<std::thread> threads_;
+};
+
 }  // namespace mediapipe::tflite_operations::sentencepiece
 
 #endif  // MEDIAPIPE_TASKS_CC_TEXT_CUSTOM_OPS_SENTENCEPIECE_OPTIMIZED_ENCODER_H_
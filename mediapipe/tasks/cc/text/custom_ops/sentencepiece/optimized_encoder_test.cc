@@ -16,6 +16,8 @@ limitations under the License.
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/optimized_encoder.h"
 
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
@@ -144,6 +146,39 @@ TEST(OptimizedEncoder, NormalizeStringWhitespacesRemove) {
   }
 }
 
+TEST(OptimizedEncoder, NormalizeStringReplacesAsciiPrefixes) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  const std::vector<std::string> norm_prefixes = {" ", "B"};
+  const char norm_replacements[] = "_\0b";
+  const auto trie_vector =
+      builder.CreateVector(BuildTrie(norm_prefixes, {0, 2}));
+  const auto norm_r = builder.CreateVector<int8_t>(
+      reinterpret_cast<const signed char*>(norm_replacements),
+      sizeof(norm_replacements));
+  TrieBuilder trie_builder(builder);
+  trie_builder.add_nodes(trie_vector);
+  const auto norm_p = trie_builder.Finish();
+  EncoderConfigBuilder ecb(builder);
+  ecb.add_normalized_prefixes(norm_p);
+  ecb.add_normalized_replacements(norm_r);
+  FinishEncoderConfigBuffer(builder, ecb.Finish());
+  const EncoderConfig* config = GetEncoderConfig(builder.GetBufferPointer());
+  EncoderWorkspace workspace;
+
+  NormalizeString(utils::string_view("A C"), *config, &workspace);
+  EXPECT_EQ(workspace.normalized, "A_C");
+  EXPECT_THAT(workspace.normalized_offsets, ::testing::ElementsAre(0, 1, 2));
+  NormalizeString(utils::string_view("ACA"), *config, &workspace);
+  EXPECT_EQ(workspace.normalized, "ACA");
+  EXPECT_THAT(workspace.normalized_offsets, ::testing::ElementsAre(0, 1, 2));
+  NormalizeString(utils::string_view("AB"), *config, &workspace);
+  EXPECT_EQ(workspace.normalized, "Ab");
+  EXPECT_THAT(workspace.normalized_offsets, ::testing::ElementsAre(0, 1));
+  NormalizeString(utils::string_view("A\xc3\xa9"), *config, &workspace);
+  EXPECT_EQ(workspace.normalized, "A\xc3\xa9");
+  EXPECT_THAT(workspace.normalized_offsets, ::testing::ElementsAre(0, 1, 2));
+}
+
 TEST(OptimizedEncoder, ConfigConverter) {
   std::string config;
   auto status =
@@ -167,5 +202,44 @@ TEST(OptimizedEncoder, ConfigConverter) {
   }
 }
 
+TEST(OptimizedEncoder, EncodesBatchesLikeSingleStrings) {
+  std::string config;
+  auto status =
+      internal::TFReadFileToString(JoinPath("./", kConfigFilePath), &config);
+  ASSERT_TRUE(status.ok());
+  const auto converted_model = ConvertSentencepieceModel(config);
+  const std::vector<std::string> texts = {
+      "Hello world!", "", "  extra   whitespaces ", "caf\xc3\xa9",
+      "\xf0\x9f\x8d\x95 pizza", "A much longer sentence to encode."};
+  std::vector<std::string> batch;
+  for (int i = 0; i < 100; ++i) {
+    batch.push_back(texts[i % texts.size()]);
+  }
+  std::vector<utils::string_view> strings;
+  for (const std::string& text : batch) {
+    strings.emplace_back(text);
+  }
+
+  BatchEncoder encoder;
+  EncoderWorkspace workspace;
+  EncoderResult result;
+  for (const int num_threads : {1, 4}) {
+    ASSERT_EQ(encoder.Encode(strings, converted_model.data(), true, true,
+                             false, num_threads),
+              EncoderResultType::SUCCESS);
+    ASSERT_EQ(encoder.results().size(), batch.size());
+    for (int i = 0; i < batch.size(); ++i) {
+      const auto expected = EncodeString(batch[i], converted_model.data(),
+                                         true, true, false);
+      EncodeString(strings[i], converted_model.data(), true, true, false,
+                   &workspace, &result);
+      EXPECT_EQ(result.codes, expected.codes) << batch[i];
+      EXPECT_EQ(result.offsets, expected.offsets) << batch[i];
+      EXPECT_EQ(encoder.results()[i].codes, expected.codes) << batch[i];
+      EXPECT_EQ(encoder.results()[i].offsets, expected.offsets) << batch[i];
+    }
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe::tflite_operations::sentencepiece
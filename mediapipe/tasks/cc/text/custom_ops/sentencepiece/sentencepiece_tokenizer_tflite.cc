@@ -15,10 +15,13 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/sentencepiece_tokenizer_tflite.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include "flatbuffers/flexbuffers.h"
 #include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/optimized_encoder.h"
+#include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/utils.h"
 #include "tflite/c/common.h"
 #include "tflite/context.h"
 #include "tflite/kernels/internal/tensor.h"
@@ -49,14 +52,22 @@ TfLiteIntArray* CreateSizeArray(const std::initializer_list<int>& sizes) {
   }
   return array_size;
 }
+
+// Per-node state kept between invocations so that their buffers are reused.
+struct OpData {
+  std::vector<utils::string_view> strings;
+  BatchEncoder encoder;
+};
 }  // namespace
 
 // Initializes text encoder object from serialized parameters.
 void* Initialize(TfLiteContext* /*context*/, const char* /*buffer*/,
                  size_t /*length*/) {
-  return nullptr;
+  return new OpData();
+}
+void Free(TfLiteContext* /*context*/, void* buffer) {
+  delete static_cast<OpData*>(buffer);
 }
-void Free(TfLiteContext* /*context*/, void* /*buffer*/) {}
 
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   // TODO: Add checks for input and output tensors.
@@ -87,36 +98,44 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       context->tensors[node->inputs->data[kReverseInput]];
   const bool reverse = reverse_tensor.data.b[0];
 
-  std::vector<int32_t> encoded;
-  std::vector<int32_t> splits;
+  auto* op_data = static_cast<OpData*>(node->user_data);
+  std::vector<utils::string_view>& strings = op_data->strings;
+  strings.clear();
   const int num_strings = tflite::GetStringCount(&input_text);
   for (int i = 0; i < num_strings; ++i) {
     const auto strref = tflite::GetString(&input_text, i);
-    const auto res = EncodeString(std::string(strref.str, strref.len),
-                                  model_buffer_data, add_bos, add_eos, reverse);
-    TF_LITE_ENSURE_MSG(context, res.type == EncoderResultType::SUCCESS,
-                       "Sentencepiece conversion failed");
-    std::copy(res.codes.begin(), res.codes.end(), std::back_inserter(encoded));
-    splits.emplace_back(encoded.size());
+    strings.emplace_back(strref.str, strref.len);
+  }
+  const EncoderResultType result_type =
+      op_data->encoder.Encode(strings, model_buffer_data, add_bos, add_eos,
+                              reverse, context->recommended_num_threads);
+  TF_LITE_ENSURE_MSG(context, result_type == EncoderResultType::SUCCESS,
+                     "Sentencepiece conversion failed");
+  const std::vector<EncoderResult>& results = op_data->encoder.results();
+  int num_codes = 0;
+  for (const EncoderResult& result : results) {
+    num_codes += result.codes.size();
   }
 
   TfLiteTensor& output_values =
       context->tensors[node->outputs->data[kOutputValuesInd]];
   TF_LITE_ENSURE_OK(context,
-                    context->ResizeTensor(
-                        context, &output_values,
-                        CreateSizeArray({static_cast<int>(encoded.size())})));
-  int32_t* output_values_flat = output_values.data.i32;
-  std::copy(encoded.begin(), encoded.end(), output_values_flat);
+                    context->ResizeTensor(context, &output_values,
+                                          CreateSizeArray({num_codes})));
   TfLiteTensor& output_splits =
       context->tensors[node->outputs->data[kOutputSplitsInd]];
-  TF_LITE_ENSURE_OK(
-      context, context->ResizeTensor(
-                   context, &output_splits,
-                   CreateSizeArray({static_cast<int>(splits.size() + 1)})));
+  TF_LITE_ENSURE_OK(context,
+                    context->ResizeTensor(context, &output_splits,
+                                          CreateSizeArray({num_strings + 1})));
+  int32_t* output_values_flat = output_values.data.i32;
   int32_t* output_splits_flat = output_splits.data.i32;
-  *output_splits_flat = 0;
-  std::copy(splits.begin(), splits.end(), output_splits_flat + 1);
+  output_splits_flat[0] = 0;
+  for (int i = 0; i < num_strings; ++i) {
+    const std::vector<int>& codes = results[i].codes;
+    output_values_flat =
+        std::copy(codes.begin(), codes.end(), output_values_flat);
+    output_splits_flat[i + 1] = output_splits_flat[i] + codes.size();
+  }
   return kTfLiteOk;
 }
 }  // namespace sentencepiece::tokenizer
@@ -20,6 +20,8 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 
 #include "absl/base/optimization.h"
@@ -29,6 +31,7 @@ namespace mediapipe::tasks::text::language_detector::custom_ops::hash {
 
 namespace {
 
+using ::mediapipe::little_endian::Load32;
 using ::mediapipe::little_endian::Load64;
 
 // Murmur 2.0 multiplication constant.
@@ -59,14 +62,23 @@ inline uint64_t MurmurStep(uint64_t hash, uint64_t data) {
 // return ToHost64(val);
 //
 // The caller needs to guarantee that 0 <= len <= 8.
+//
+// Reads overlapping 4 byte words or single bytes rather than looping over the
+// bytes, which avoids mispredicted branches on varying lengths.
 uint64_t Load64VariableLength(const void* const p, int len) {
   ABSL_ASSUME(len >= 0 && len <= 8);
-  uint64_t val = 0;
   const uint8_t* const src = static_cast<const uint8_t*>(p);
-  for (int i = 0; i < len; ++i) {
-    val |= static_cast<uint64_t>(src[i]) << (8 * i);
+  if (len >= 4) {
+    // The words overlap on 8 - len bytes, which are the same in both.
+    return Load32(src) |
+           (static_cast<uint64_t>(Load32(src + len - 4)) << (8 * (len - 4)));
+  }
+  if (len == 0) {
+    return 0;
   }
-  return val;
+  // Reads bytes 0, len / 2 and len - 1, which cover all of them.
+  return src[0] | (static_cast<uint64_t>(src[len / 2]) << (8 * (len / 2))) |
+         (static_cast<uint64_t>(src[len - 1]) << (8 * (len - 1)));
 }
 
 }  // namespace
@@ -91,4 +103,36 @@ unsigned long long MurmurHash64WithSeed(const char* buf,  // NOLINT
   return hash;
 }
 
+void MurmurHash64WithSeedX4(const char* const bufs[4], const size_t lens[4],
+                            const uint64_t seed, uint64_t hashes[4]) {
+  // Read by the lanes which have no word left, so that all lanes step
+  // together without branching on their lengths.
+  static constexpr char kZeros[8] = {};
+  uint64_t hash[4];
+  size_t num_words[4];
+  for (int lane = 0; lane < 4; ++lane) {
+    hash[lane] = seed ^ (lens[lane] * kMul);
+    num_words[lane] = lens[lane] >> 3;
+  }
+  const size_t max_words = std::max(std::max(num_words[0], num_words[1]),
+                                    std::max(num_words[2], num_words[3]));
+  for (size_t word = 0; word < max_words; ++word) {
+    for (int lane = 0; lane < 4; ++lane) {
+      const bool has_word = word < num_words[lane];
+      const uint64_t stepped = MurmurStep(
+          hash[lane], Load64(has_word ? bufs[lane] + 8 * word : kZeros));
+      hash[lane] = has_word ? stepped : hash[lane];
+    }
+  }
+  for (int lane = 0; lane < 4; ++lane) {
+    const int tail_len = lens[lane] & 0x7;
+    const uint64_t mixed =
+        (hash[lane] ^ Load64VariableLength(bufs[lane] + 8 * num_words[lane],
+                                           tail_len)) *
+        kMul;
+    hash[lane] = tail_len != 0 ? mixed : hash[lane];
+    hashes[lane] = ShiftMix(ShiftMix(hash[lane]) * kMul);
+  }
+}
+
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops::hash
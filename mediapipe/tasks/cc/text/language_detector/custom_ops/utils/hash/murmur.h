@@ -36,6 +36,13 @@ namespace mediapipe::tasks::text::language_detector::custom_ops::hash {
 // e.g. Minhash.
 unsigned long long MurmurHash64WithSeed(const char* buf, size_t len,  // NOLINT
                                         uint64_t seed);
+
+// Hashes the four byte arrays `bufs` of lengths `lens` at once, interleaving
+// their computations to hide the latency of the multiplications. Sets
+// `hashes[i]` to MurmurHash64WithSeed(bufs[i], lens[i], seed).
+void MurmurHash64WithSeedX4(const char* const bufs[4], const size_t lens[4],
+                            uint64_t seed, uint64_t hashes[4]);
+
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops::hash
 
 #endif  // UTIL_HASH_MURMUR_H_
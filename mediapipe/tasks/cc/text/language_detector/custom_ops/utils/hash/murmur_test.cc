@@ -62,4 +62,34 @@ TEST(Murmur, Idempotence) {
               MurmurHash64WithSeed(next_data, next_dlen, i));
   }
 }
+
+// Hashes of prefixes of a string, covering lengths with and without whole
+// words and tails.
+TEST(Murmur, KnownValues) {
+  const char data[] = "The quick brown fox";
+  EXPECT_EQ(MurmurHash64WithSeed(data, 0, 42), 0x97037e2d10717c74ULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 1, 42), 0x86b65d8ddcc30228ULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 3, 42), 0x41fcae3ae0adb74dULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 4, 42), 0xa6f35a941bf82fd2ULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 7, 42), 0x9777a2dc0a95ec2aULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 8, 42), 0x3340e66c56ad2c47ULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 13, 42), 0x3a6309a8bae966a0ULL);
+  EXPECT_EQ(MurmurHash64WithSeed(data, 19, 42), 0x8f8db6de13be4db5ULL);
+}
+
+TEST(Murmur, X4MatchesSingleHashes) {
+  const std::string data = "abcdefghijklmnopqrstuvwxyz0123456789";
+  for (size_t len = 0; len + 3 <= data.size(); ++len) {
+    // Lanes of different lengths, starting at different alignments.
+    const char* const bufs[4] = {data.data(), data.data() + 1,
+                                 data.data() + 2, data.data() + 3};
+    const size_t lens[4] = {len, data.size() - 1 - len, len / 2, 3};
+    uint64_t hashes[4];
+    MurmurHash64WithSeedX4(bufs, lens, 42, hashes);
+    for (int lane = 0; lane < 4; ++lane) {
+      EXPECT_EQ(hashes[lane], MurmurHash64WithSeed(bufs[lane], lens[lane], 42))
+          << "lane " << lane << " with length " << lens[lane];
+    }
+  }
+}
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops::hash
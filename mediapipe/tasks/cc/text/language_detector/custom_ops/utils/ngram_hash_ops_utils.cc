@@ -15,13 +15,50 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/ngram_hash_ops_utils.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/utf/utf.h"
 
 namespace mediapipe::tasks::text::language_detector::custom_ops {
+namespace {
+
+// Computes remainders of divisions by a fixed divisor, with multiplications
+// by its precomputed inverse where 128-bit integers are available. See
+// "Faster Remainder by Direct Computation", Lemire et al., 2019; the 128-bit
+// inverse makes it exact for all 64-bit dividends and divisors.
+class Remainder {
+ public:
+  explicit Remainder(uint64_t divisor) : divisor_(divisor) {
+#if defined(__SIZEOF_INT128__)
+    inverse_ = ~static_cast<unsigned __int128>(0) / divisor + 1;
+#endif
+  }
+
+  uint64_t Of(uint64_t dividend) const {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 fraction = inverse_ * dividend;
+    const unsigned __int128 low = static_cast<uint64_t>(fraction);
+    const unsigned __int128 high = fraction >> 64;
+    return ((low * divisor_ >> 64) + high * divisor_) >> 64;
+#else
+    return dividend % divisor_;
+#endif
+  }
+
+ private:
+  uint64_t divisor_;
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 inverse_;
+#endif
+};
+
+}  // namespace
 
 TokenizedOutput Tokenize(const char* input_str, int len, int max_tokens,
                          bool exclude_nonalphaspace_tokens) {
@@ -75,6 +112,50 @@ TokenizedOutput Tokenize(const char* input_str, int len, int max_tokens,
   return output;
 }
 
+void GetNGramHashIndices(const TokenizedOutput& tokenized_output,
+                         uint64_t seed, const std::vector<int>& ngram_lengths,
+                         const std::vector<int>& vocab_sizes, int32_t* data) {
+  const auto& tokens = tokenized_output.tokens;
+  const int num_tokens = tokens.size();
+  // The number of bytes in the tokens preceding each token, so that an n-gram
+  // has as many bytes as the difference between its end and its start.
+  std::vector<size_t> bytes_before(num_tokens + 1, 0);
+  for (int i = 0; i < num_tokens; ++i) {
+    bytes_before[i + 1] = bytes_before[i] + tokens[i].second;
+  }
+
+  std::vector<Remainder> vocab_size_remainders;
+  vocab_size_remainders.reserve(vocab_sizes.size());
+  for (const int vocab_size : vocab_sizes) {
+    vocab_size_remainders.emplace_back(vocab_size);
+  }
+
+  for (int start = 0; start < num_tokens; start += 4) {
+    const int num_lanes = std::min(4, num_tokens - start);
+    for (int ngram = 0; ngram < ngram_lengths.size(); ++ngram) {
+      const int ngram_length = std::max(ngram_lengths[ngram], 0);
+      const char* bufs[4];
+      size_t lens[4];
+      for (int lane = 0; lane < 4; ++lane) {
+        // Lanes past the last token repeat it, and their hashes are dropped.
+        const int token = start + std::min(lane, num_lanes - 1);
+        const int end = std::min(num_tokens - token, ngram_length) + token;
+        bufs[lane] = tokenized_output.str.c_str() + tokens[token].first;
+        lens[lane] = bytes_before[end] - bytes_before[token];
+      }
+      uint64_t hashes[4];
+      hash::MurmurHash64WithSeedX4(bufs, lens, seed, hashes);
+
+      // Map the hashes to indices in the vocab.
+      const Remainder& vocab_size_remainder = vocab_size_remainders[ngram];
+      for (int lane = 0; lane < num_lanes; ++lane) {
+        data[ngram * num_tokens + start + lane] =
+            vocab_size_remainder.Of(hashes[lane]) + 1;
+      }
+    }
+  }
+}
+
 void LowercaseUnicodeStr(const char* input_str, int len,
                          std::string* output_str) {
   for (int i = 0; i < len;) {
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_TEXT_LANGUAGE_DETECTOR_CUSTOM_OPS_UTILS_NGRAM_HASH_OPS_UTILS_H_
 #define MEDIAPIPE_TASKS_CC_TEXT_LANGUAGE_DETECTOR_CUSTOM_OPS_UTILS_NGRAM_HASH_OPS_UTILS_H_
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -44,6 +45,19 @@ struct TokenizedOutput {
 TokenizedOutput Tokenize(const char* input_str, int len, int max_tokens,
                          bool exclude_nonalphaspace_tokens);
 
+// Maps each n-gram of the tokens in `tokenized_output` to an index in
+// [1, vocab_size] using MurmurHash64WithSeed(), for each of the n-gram lengths
+// in `ngram_lengths` and their corresponding `vocab_sizes`. N-grams run from
+// each token to the end of the string at most.
+//
+// Writes the index of the n-gram of the i-th length starting at token j to
+// `data[i * tokenized_output.tokens.size() + j]`. All lengths are computed in
+// a single pass over the tokens, hashing the n-grams at four consecutive
+// tokens at once.
+void GetNGramHashIndices(const TokenizedOutput& tokenized_output,
+                         uint64_t seed, const std::vector<int>& ngram_lengths,
+                         const std::vector<int>& vocab_sizes, int32_t* data);
+
 // Converts the given unicode string (`input_str`) with the specified length
 // (`len`) to a lowercase string.
 //
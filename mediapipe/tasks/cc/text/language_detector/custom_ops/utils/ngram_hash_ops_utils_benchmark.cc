@@ -0,0 +1,97 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Measures the tokens per second mapped to n-gram hash indices by hashing
+// each n-gram on its own versus GetNGramHashIndices(), on long documents.
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
+#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/ngram_hash_ops_utils.h"
+
+namespace mediapipe::tasks::text::language_detector::custom_ops {
+namespace {
+
+constexpr uint64_t kSeed = 123;
+
+// A typical configuration of unigrams up to 4-grams.
+const std::vector<int>& NGramLengths() {
+  static const auto* const kNGramLengths = new std::vector<int>{1, 2, 3, 4};
+  return *kNGramLengths;
+}
+const std::vector<int>& VocabSizes() {
+  static const auto* const kVocabSizes =
+      new std::vector<int>{1000, 10000, 100000, 100000};
+  return *kVocabSizes;
+}
+
+// Tokenizes a document of about `num_bytes` bytes mixing Latin and CJK text.
+TokenizedOutput TokenizeDocument(int num_bytes) {
+  constexpr char kSentence[] =
+      "The quick brown fox jumps over the lazy dog. "
+      "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87. ";
+  std::string document;
+  while (document.size() < num_bytes) {
+    document.append(kSentence);
+  }
+  return Tokenize(document.c_str(), document.size(),
+                  /*max_tokens=*/document.size() + 2,
+                  /*exclude_nonalphaspace_tokens=*/true);
+}
+
+// Arg: the document size in bytes.
+void BM_HashEachNGram(benchmark::State& state) {
+  const TokenizedOutput output = TokenizeDocument(state.range(0));
+  const int num_tokens = output.tokens.size();
+  std::vector<int32_t> data(NGramLengths().size() * num_tokens);
+  for (auto _ : state) {
+    for (int ngram = 0; ngram < NGramLengths().size(); ++ngram) {
+      for (int start = 0; start < num_tokens; ++start) {
+        int num_bytes = 0;
+        for (int i = start; i < num_tokens && i < start + NGramLengths()[ngram];
+             ++i) {
+          num_bytes += output.tokens[i].second;
+        }
+        const uint64_t hash = hash::MurmurHash64WithSeed(
+            output.str.c_str() + output.tokens[start].first, num_bytes, kSeed);
+        data[ngram * num_tokens + start] = (hash % VocabSizes()[ngram]) + 1;
+      }
+    }
+    benchmark::DoNotOptimize(data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_tokens);
+}
+BENCHMARK(BM_HashEachNGram)->Arg(1 << 12)->Arg(1 << 16);
+
+// Arg: the document size in bytes.
+void BM_GetNGramHashIndices(benchmark::State& state) {
+  const TokenizedOutput output = TokenizeDocument(state.range(0));
+  const int num_tokens = output.tokens.size();
+  std::vector<int32_t> data(NGramLengths().size() * num_tokens);
+  for (auto _ : state) {
+    GetNGramHashIndices(output, kSeed, NGramLengths(), VocabSizes(),
+                        data.data());
+    benchmark::DoNotOptimize(data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_tokens);
+}
+BENCHMARK(BM_GetNGramHashIndices)->Arg(1 << 12)->Arg(1 << 16);
+
+}  // namespace
+}  // namespace mediapipe::tasks::text::language_detector::custom_ops
+
+BENCHMARK_MAIN();
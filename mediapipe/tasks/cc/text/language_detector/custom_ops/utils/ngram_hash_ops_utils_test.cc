@@ -15,10 +15,14 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/ngram_hash_ops_utils.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
 
 namespace mediapipe::tasks::text::language_detector::custom_ops {
 
@@ -131,5 +135,33 @@ TEST(LowercaseUnicodeTest, TestLowercaseUnicode) {
   }
 }
 
+TEST(GetNGramHashIndicesTest, MatchesHashOfEachNGram) {
+  const std::string input_str = "Hello wörld, ありがとう! 123 abcdefghijk";
+  const TokenizedOutput output =
+      Tokenize(input_str.c_str(), input_str.size(), /*max_tokens=*/100,
+               /*exclude_nonalphaspace_tokens=*/true);
+  const std::vector<int> ngram_lengths = {1, 2, 3, 9, 50};
+  const std::vector<int> vocab_sizes = {1, 1000, 5000, 7, 2147483647};
+  const uint64_t seed = 123;
+  const int num_tokens = output.tokens.size();
+  std::vector<int32_t> data(ngram_lengths.size() * num_tokens);
+
+  GetNGramHashIndices(output, seed, ngram_lengths, vocab_sizes, data.data());
+
+  for (int ngram = 0; ngram < ngram_lengths.size(); ++ngram) {
+    for (int start = 0; start < num_tokens; ++start) {
+      const int end = std::min(start + ngram_lengths[ngram], num_tokens);
+      const size_t num_bytes = output.tokens[end - 1].first +
+                               output.tokens[end - 1].second -
+                               output.tokens[start].first;
+      const uint64_t hash = hash::MurmurHash64WithSeed(
+          output.str.c_str() + output.tokens[start].first, num_bytes, seed);
+      EXPECT_EQ(data[ngram * num_tokens + start],
+                (hash % vocab_sizes[ngram]) + 1)
+          << "ngram length " << ngram_lengths[ngram] << " at " << start;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops
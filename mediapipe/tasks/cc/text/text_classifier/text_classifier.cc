@@ -20,17 +20,22 @@ limitations under the License.
 #include <string>
 #include <utility>
 
+#include "absl/hash/hash.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/packet.h"
+#include "mediapipe/tasks/cc/components/calculators/classification_aggregation_calculator.pb.h"
 #include "mediapipe/tasks/cc/components/containers/classification_result.h"
 #include "mediapipe/tasks/cc/components/containers/proto/classifications.pb.h"
 #include "mediapipe/tasks/cc/components/processors/proto/classifier_options.pb.h"
+#include "mediapipe/tasks/cc/core/external_file_handler.h"
 #include "mediapipe/tasks/cc/core/running_mode.h"
 #include "mediapipe/tasks/cc/core/task_api_factory.h"
 #include "mediapipe/tasks/cc/core/task_runner.h"
 #include "mediapipe/tasks/cc/text/text_classifier/proto/text_classifier_graph_options.pb.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 #include "tflite/core/api/op_resolver.h"
 
 namespace mediapipe {
@@ -64,6 +69,21 @@ CalculatorGraphConfig CreateGraphConfig(
   return graph.GetConfig();
 }
 
+// Converts the user-facing WindowPooling to the pooling of the
+// ClassificationAggregationCalculator.
+mediapipe::ClassificationAggregationCalculatorOptions::Pooling
+ConvertWindowPoolingToProto(TextClassifierOptions::WindowPooling pooling) {
+  switch (pooling) {
+    case TextClassifierOptions::WindowPooling::kMean:
+      return mediapipe::ClassificationAggregationCalculatorOptions::MEAN;
+    case TextClassifierOptions::WindowPooling::kMax:
+      return mediapipe::ClassificationAggregationCalculatorOptions::MAX;
+    case TextClassifierOptions::WindowPooling::kAttention:
+      return mediapipe::ClassificationAggregationCalculatorOptions::ATTENTION;
+  }
+  return mediapipe::ClassificationAggregationCalculatorOptions::MEAN;
+}
+
 // Converts the user-facing TextClassifierOptions struct to the internal
 // TextClassifierGraphOptions proto.
 std::unique_ptr<proto::TextClassifierGraphOptions>
@@ -78,35 +98,84 @@ ConvertTextClassifierOptionsToProto(TextClassifierOptions* options) {
               &(options->classifier_options)));
   options_proto->mutable_classifier_options()->Swap(
       classifier_options_proto.get());
+  options_proto->set_token_cache_size(options->token_cache_size);
+  if (options->window_stride > 0) {
+    options_proto->set_window_stride(options->window_stride);
+    options_proto->set_window_pooling(
+        ConvertWindowPoolingToProto(options->window_pooling));
+  }
   return options_proto;
 }
 
+// Returns the name of the result cache shared by classifiers of the same
+// model and options. The model asset only locates the model, so its content
+// is hashed instead: a path or file descriptor may later hold another model.
+absl::StatusOr<std::string> GetResultCacheName(
+    const proto::TextClassifierGraphOptions& options) {
+  ABSL_ASSIGN_OR_RETURN(std::unique_ptr<core::ExternalFileHandler> model,
+                        core::ExternalFileHandler::CreateFromExternalFile(
+                            &options.base_options().model_asset()));
+  proto::TextClassifierGraphOptions options_without_model = options;
+  options_without_model.mutable_base_options()->clear_model_asset();
+  return absl::StrCat(
+      kTaskName, "/",
+      absl::HashOf(model->GetFileContent(),
+                   options_without_model.SerializeAsString()));
+}
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<TextClassifier>> TextClassifier::Create(
     std::unique_ptr<TextClassifierOptions> options) {
   auto options_proto = ConvertTextClassifierOptionsToProto(options.get());
-  return core::TaskApiFactory::Create<TextClassifier,
-                                      proto::TextClassifierGraphOptions>(
-      core::TaskRunnerOptions{
-          .config = CreateGraphConfig(std::move(options_proto)),
-          .task_name = kTaskName,
-          .task_running_mode = core::RunningMode::kUnspecified,
-          .op_resolver = std::move(options->base_options.op_resolver),
-          .host_environment = options->base_options.host_environment,
-          .host_system = options->base_options.host_system,
-          .host_version = options->base_options.host_version,
-          .ca_bundle_path = options->base_options.ca_bundle_path});
+  std::string cache_name;
+  if (options->result_cache_size > 0) {
+    ABSL_ASSIGN_OR_RETURN(cache_name, GetResultCacheName(*options_proto));
+  }
+  ABSL_ASSIGN_OR_RETURN(
+      std::unique_ptr<TextClassifier> text_classifier,
+      (core::TaskApiFactory::Create<TextClassifier,
+                                    proto::TextClassifierGraphOptions>(
+          core::TaskRunnerOptions{
+              .config = CreateGraphConfig(std::move(options_proto)),
+              .task_name = kTaskName,
+              .task_running_mode = core::RunningMode::kUnspecified,
+              .op_resolver = std::move(options->base_options.op_resolver),
+              .host_environment = options->base_options.host_environment,
+              .host_system = options->base_options.host_system,
+              .host_version = options->base_options.host_version,
+              .ca_bundle_path = options->base_options.ca_bundle_path})));
+  if (options->result_cache_size > 0) {
+    text_classifier->result_cache_ =
+        utils::GetSharedTextCache<TextClassifierResult>(
+            cache_name, options->result_cache_size);
+  }
+  return text_classifier;
 }
 
 absl::StatusOr<TextClassifierResult> TextClassifier::Classify(
     absl::string_view text) {
+  if (result_cache_ != nullptr) {
+    if (auto cached_result = result_cache_->Lookup(text)) {
+      return *cached_result;
+    }
+  }
   ABSL_ASSIGN_OR_RETURN(
       auto output_packets,
       runner_->Process(
           {{kTextStreamName, MakePacket<std::string>(std::string(text))}}));
-  return ConvertToClassificationResult(
+  TextClassifierResult result = ConvertToClassificationResult(
       output_packets[kClassificationsStreamName].Get<ClassificationResult>());
+  if (result_cache_ != nullptr) {
+    result_cache_->Insert(text,
+                          std::make_shared<const TextClassifierResult>(result));
+  }
+  return result;
+}
+
+utils::TextCacheStats TextClassifier::GetResultCacheStats() const {
+  if (result_cache_ == nullptr) return {};
+  return result_cache_->GetStats();
 }
 
 }  // namespace text_classifier
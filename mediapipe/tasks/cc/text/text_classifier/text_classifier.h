@@ -25,6 +25,7 @@ limitations under the License.
 #include "mediapipe/tasks/cc/components/processors/classifier_options.h"
 #include "mediapipe/tasks/cc/core/base_options.h"
 #include "mediapipe/tasks/cc/core/base_task_api.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 
 namespace mediapipe {
 namespace tasks {
@@ -44,6 +45,35 @@ struct TextClassifierOptions {
   // Options for configuring the classifier behavior, such as score threshold,
   // number of results, etc.
   components::processors::ClassifierOptions classifier_options;
+
+  // The maximum number of tokenized input texts to cache, shared with the
+  // other text tasks using the same tokenizer. No texts are cached if 0.
+  int token_cache_size = 0;
+
+  // The maximum number of classification results to cache, shared with the
+  // other TextClassifiers created with the same model and options, so that
+  // repeated texts are classified without running the model. No results are
+  // cached if 0.
+  int result_cache_size = 0;
+
+  // If positive, texts too long for the model are not truncated but split into
+  // overlapping windows of tokens whose first tokens are `window_stride`
+  // tokens apart, and the scores of the windows are pooled with
+  // `window_pooling`. The text is tokenized once. Only supported with BERT
+  // models with static input tensors.
+  int window_stride = 0;
+
+  // How the scores of the windows of a text are pooled.
+  enum class WindowPooling {
+    // The mean score of each category over the windows.
+    kMean,
+    // The maximum score of each category over the windows.
+    kMax,
+    // The mean score of each category over the windows, weighted towards the
+    // windows with the highest top scores.
+    kAttention,
+  };
+  WindowPooling window_pooling = WindowPooling::kMean;
 };
 
 // Performs classification on text.
@@ -87,8 +117,16 @@ class TextClassifier : core::BaseTaskApi {
   // Performs classification on the input `text`.
   absl::StatusOr<TextClassifierResult> Classify(absl::string_view text);
 
+  // Returns the lookup counts of the result cache, which are all 0 if results
+  // aren't cached.
+  utils::TextCacheStats GetResultCacheStats() const;
+
   // Shuts down the TextClassifier when all the work is done.
   absl::Status Close() { return runner_->Close(); }
+
+ private:
+  // The results of recent texts, if caching is enabled.
+  std::shared_ptr<utils::TextCache<TextClassifierResult>> result_cache_;
 };
 
 }  // namespace text_classifier
@@ -22,6 +22,8 @@ limitations under the License.
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/tasks/cc/common.h"
+#include "mediapipe/tasks/cc/components/calculators/classification_aggregation_calculator.pb.h"
 #include "mediapipe/tasks/cc/components/containers/proto/classifications.pb.h"
 #include "mediapipe/tasks/cc/components/processors/classification_postprocessing_graph.h"
 #include "mediapipe/tasks/cc/components/processors/proto/classification_postprocessing_graph_options.pb.h"
@@ -50,12 +52,16 @@ constexpr char kClassificationsTag[] = "CLASSIFICATIONS";
 constexpr char kTextTag[] = "TEXT";
 constexpr char kMetadataExtractorTag[] = "METADATA_EXTRACTOR";
 constexpr char kTensorsTag[] = "TENSORS";
+constexpr char kTimestampsTag[] = "TIMESTAMPS";
 
 }  // namespace
 
 // A "TextClassifierGraph" performs Natural Language classification (including
 // BERT-based text classification).
 // - Accepts input text and outputs classification results on CPU.
+// - If `window_stride` is set in the options, texts too long for the model are
+//   classified by pooling the classifications of overlapping windows of their
+//   tokens, which are tokenized once.
 //
 // Inputs:
 //   TEXT - std::string
@@ -113,15 +119,27 @@ class TextClassifierGraph : public core::ModelTaskGraph {
       const proto::TextClassifierGraphOptions& task_options,
       const ModelResources& model_resources, Source<std::string> text_in,
       Graph& graph) {
+    const bool windowed = task_options.window_stride() > 0;
+    if (windowed &&
+        task_options.window_pooling() ==
+            mediapipe::ClassificationAggregationCalculatorOptions::NONE) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          "window_pooling must be set if window_stride is set.",
+          MediaPipeTasksStatus::kInvalidArgumentError);
+    }
+
     // Adds preprocessing calculators and connects them to the text input
     // stream.
     auto& preprocessing = graph.AddNode(
         "mediapipe.tasks.components.processors.TextPreprocessingGraph");
+    auto* preproc_options = &preprocessing.GetOptions<
+        components::processors::proto::TextPreprocessingGraphOptions>();
     ABSL_RETURN_IF_ERROR(
         components::processors::ConfigureTextPreprocessingGraph(
-            model_resources,
-            preprocessing.GetOptions<components::processors::proto::
-                                         TextPreprocessingGraphOptions>()));
+            model_resources, *preproc_options));
+    preproc_options->set_token_cache_size(task_options.token_cache_size());
+    preproc_options->set_window_stride(task_options.window_stride());
     text_in >> preprocessing.In(kTextTag);
 
     // Adds both InferenceCalculator and ModelResourcesCalculator.
@@ -137,13 +155,20 @@ class TextClassifierGraph : public core::ModelTaskGraph {
     auto& postprocessing = graph.AddNode(
         "mediapipe.tasks.components.processors."
         "ClassificationPostprocessingGraph");
+    auto* postproc_options =
+        &postprocessing.GetOptions<components::processors::proto::
+                                       ClassificationPostprocessingGraphOptions>();
     ABSL_RETURN_IF_ERROR(
         components::processors::ConfigureClassificationPostprocessingGraph(
             model_resources, task_options.classifier_options(),
-            &postprocessing
-                 .GetOptions<components::processors::proto::
-                                 ClassificationPostprocessingGraphOptions>()));
+            postproc_options));
     inference.Out(kTensorsTag) >> postprocessing.In(kTensorsTag);
+    // The classifications of the windows of each text are pooled into one.
+    if (windowed) {
+      postproc_options->mutable_classification_aggregation_options()
+          ->set_pooling(task_options.window_pooling());
+      preprocessing.Out(kTimestampsTag) >> postprocessing.In(kTimestampsTag);
+    }
 
     // Outputs the aggregated classification result as the subgraph output
     // stream.
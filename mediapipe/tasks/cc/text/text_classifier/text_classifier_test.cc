@@ -15,16 +15,19 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/text_classifier/text_classifier.h"
 
+#include <cstdio>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "mediapipe/framework/deps/file_helpers.h"
 #include "mediapipe/framework/deps/file_path.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -172,6 +175,84 @@ TEST_F(TextClassifierTest, TextClassifierWithBert) {
   MP_ASSERT_OK(classifier->Close());
 }
 
+TEST_F(TextClassifierTest, TextClassifierWithCaches) {
+  auto create_classifier = []() {
+    auto options = std::make_unique<TextClassifierOptions>();
+    options->base_options.model_asset_path = GetFullPath(kTestBertModelPath);
+    options->token_cache_size = 16;
+    options->result_cache_size = 16;
+    return TextClassifier::Create(std::move(options));
+  };
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextClassifier> classifier,
+                          create_classifier());
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextClassifier> other_classifier,
+                          create_classifier());
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextClassifierResult result,
+      classifier->Classify("it's a charming and often affecting journey"));
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextClassifierResult cached_result,
+      other_classifier->Classify(
+          "it's a charming and often affecting journey"));
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextClassifierResult other_result,
+      other_classifier->Classify("unflinchingly bleak and desperate"));
+
+  ExpectApproximatelyEqual(cached_result, result);
+  EXPECT_EQ(other_result.classifications[0].categories[0].category_name,
+            "negative");
+  utils::TextCacheStats stats = other_classifier->GetResultCacheStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+
+  MP_ASSERT_OK(classifier->Close());
+  MP_ASSERT_OK(other_classifier->Close());
+}
+
+TEST_F(TextClassifierTest, TextClassifierResultCacheFollowsModelContent) {
+  const std::string model_path =
+      JoinPath(::testing::TempDir(), "replaced_text_classifier.tflite");
+  // Replaces the file at `model_path` with a copy of `model_file_name`. The
+  // copy is renamed over the old file, which stays mapped by its classifier.
+  auto replace_model = [&](absl::string_view model_file_name) {
+    std::string model;
+    MP_ASSERT_OK(file::GetContents(GetFullPath(model_file_name), &model));
+    const std::string tmp_path = absl::StrCat(model_path, ".tmp");
+    MP_ASSERT_OK(file::SetContents(tmp_path, model));
+    ASSERT_EQ(std::rename(tmp_path.c_str(), model_path.c_str()), 0);
+  };
+  auto create_classifier = [&]() {
+    auto options = std::make_unique<TextClassifierOptions>();
+    options->base_options.model_asset_path = model_path;
+    options->result_cache_size = 16;
+    return TextClassifier::Create(std::move(options));
+  };
+
+  replace_model(kTestBertModelPath);
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextClassifier> bert_classifier,
+                          create_classifier());
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextClassifierResult bert_result,
+      bert_classifier->Classify("What a waste of my time."));
+  replace_model(kTestRegexModelPath);
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextClassifier> regex_classifier,
+                          create_classifier());
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextClassifierResult regex_result,
+      regex_classifier->Classify("What a waste of my time."));
+
+  // Both models are loaded from the same path, but don't share results.
+  EXPECT_EQ(bert_result.classifications[0].categories[0].category_name,
+            "negative");
+  EXPECT_EQ(regex_result.classifications[0].categories[0].category_name,
+            "Negative");
+  EXPECT_EQ(regex_classifier->GetResultCacheStats().hits, 0);
+
+  MP_ASSERT_OK(bert_classifier->Close());
+  MP_ASSERT_OK(regex_classifier->Close());
+}
+
 TEST_F(TextClassifierTest, TextClassifierWithIntInputs) {
   auto options = std::make_unique<TextClassifierOptions>();
   options->base_options.model_asset_path = GetFullPath(kTestRegexModelPath);
@@ -262,4 +343,57 @@ TEST_F(TextClassifierTest, BertLongPositive) {
   MP_ASSERT_OK(classifier->Close());
 }
 
+TEST_F(TextClassifierTest, TextClassifierWithWindows) {
+  auto options = std::make_unique<TextClassifierOptions>();
+  options->base_options.model_asset_path = GetFullPath(kTestBertModelPath);
+  options->window_stride = kMaxSeqLen / 2;
+  options->window_pooling = TextClassifierOptions::WindowPooling::kMean;
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextClassifier> classifier,
+                          TextClassifier::Create(std::move(options)));
+
+  // A text that fits in a single window is classified as without windows.
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextClassifierResult negative_result,
+      classifier->Classify("unflinchingly bleak and desperate"));
+  TextClassifierResult negative_expected;
+  negative_expected.classifications.emplace_back(Classifications{
+      /*categories=*/{{0, 0.963325, "negative"}, {1, 0.036674, "positive"}},
+      /*head_index=*/0,
+      /*head_name=*/"probability"});
+  ExpectApproximatelyEqual(negative_result, negative_expected);
+  EXPECT_NEAR(negative_result.classifications[0].categories[0].score, 0.963325,
+              1e-3);
+
+  // The mean scores of the windows of a long text still sum to 1.
+  std::stringstream long_review;
+  long_review << "unflinchingly bleak and desperate";
+  for (int i = 0; i < 2 * kMaxSeqLen; ++i) {
+    long_review << " long";
+  }
+  long_review << " but it's a charming and often affecting journey";
+  MP_ASSERT_OK_AND_ASSIGN(TextClassifierResult long_result,
+                          classifier->Classify(long_review.str()));
+  ASSERT_EQ(long_result.classifications.size(), 1);
+  const std::vector<Category>& categories =
+      long_result.classifications[0].categories;
+  ASSERT_EQ(categories.size(), 2);
+  EXPECT_GE(categories[0].score, categories[1].score);
+  EXPECT_NEAR(categories[0].score + categories[1].score, 1, kPrecision);
+
+  MP_ASSERT_OK(classifier->Close());
+}
+
+TEST_F(TextClassifierTest, CreateFailsWithWindowsForRegexModel) {
+  auto options = std::make_unique<TextClassifierOptions>();
+  options->base_options.model_asset_path = GetFullPath(kTestRegexModelPath);
+  options->window_stride = 16;
+  StatusOr<std::unique_ptr<TextClassifier>> classifier =
+      TextClassifier::Create(std::move(options));
+
+  EXPECT_EQ(classifier.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(classifier.status().message(),
+              HasSubstr("Splitting texts into windows is only supported with "
+                        "BERT models"));
+}
+
 }  // namespace mediapipe::tasks::text::text_classifier
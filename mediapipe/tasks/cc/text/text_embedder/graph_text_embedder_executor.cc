@@ -18,10 +18,12 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/calculator.pb.h"
@@ -67,6 +69,30 @@ absl::StatusOr<TextEmbedderResult> GraphTextEmbedderExecutor::Embed(
       output_packets[kEmbeddingsStreamName].Get<EmbeddingResult>());
 }
 
+absl::StatusOr<std::vector<TextEmbedderResult>>
+GraphTextEmbedderExecutor::EmbedBatch(
+    absl::Span<const absl::string_view> texts) {
+  std::vector<tasks::core::PacketMap> inputs;
+  inputs.reserve(texts.size());
+  for (absl::string_view text : texts) {
+    inputs.push_back(
+        {{kTextInStreamName, MakePacket<std::string>(std::string(text))}});
+  }
+  ABSL_ASSIGN_OR_RETURN(auto output_packets,
+                        runner_->ProcessBatch(std::move(inputs)));
+  std::vector<TextEmbedderResult> results;
+  results.reserve(output_packets.size());
+  for (auto& outputs : output_packets) {
+    const Packet& embeddings = outputs[kEmbeddingsStreamName];
+    if (embeddings.IsEmpty()) {
+      return absl::InternalError("No embeddings were output for a text.");
+    }
+    results.push_back(
+        ConvertToEmbeddingResult(embeddings.Get<EmbeddingResult>()));
+  }
+  return results;
+}
+
 absl::Status GraphTextEmbedderExecutor::Close() { return runner_->Close(); }
 
 absl::StatusOr<std::unique_ptr<GraphTextEmbedderExecutor>>
@@ -17,10 +17,12 @@ limitations under the License.
 #define MEDIAPIPE_TASKS_CC_TEXT_TEXT_EMBEDDER_GRAPH_TEXT_EMBEDDER_EXECUTOR_H_
 
 #include <memory>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "mediapipe/tasks/cc/core/task_runner.h"
 #include "mediapipe/tasks/cc/text/text_embedder/text_embedder_executor.h"
 
@@ -36,6 +38,11 @@ class GraphTextEmbedderExecutor : public TextEmbedderExecutor {
   explicit GraphTextEmbedderExecutor(
       std::unique_ptr<tasks::core::TaskRunner> runner);
   absl::StatusOr<TextEmbedderResult> Embed(absl::string_view text) override;
+  // Runs all texts through the graph in a single TaskRunner::ProcessBatch()
+  // call, so that tokenization, inference and postprocessing of different
+  // texts are pipelined across the graph's threads.
+  absl::StatusOr<std::vector<TextEmbedderResult>> EmbedBatch(
+      absl::Span<const absl::string_view> texts) override;
   absl::Status Close() override;
 
  private:
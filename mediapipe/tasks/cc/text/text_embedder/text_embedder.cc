@@ -15,16 +15,21 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/text_embedder/text_embedder.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/status_macros.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/calculator.pb.h"
@@ -34,12 +39,14 @@ limitations under the License.
 #include "mediapipe/tasks/cc/components/processors/proto/embedder_options.pb.h"
 #include "mediapipe/tasks/cc/components/utils/cosine_similarity.h"
 #include "mediapipe/tasks/cc/core/base_options.h"
+#include "mediapipe/tasks/cc/core/external_file_handler.h"
 #include "mediapipe/tasks/cc/core/proto/base_options.pb.h"
 #include "mediapipe/tasks/cc/core/running_mode.h"
 #include "mediapipe/tasks/cc/core/task_runner.h"
 #include "mediapipe/tasks/cc/text/text_embedder/graph_text_embedder_executor.h"
 #include "mediapipe/tasks/cc/text/text_embedder/proto/text_embedder_graph_options.pb.h"
 #include "mediapipe/tasks/cc/text/text_embedder/text_embedder_executor.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 
 namespace mediapipe::tasks::text::text_embedder {
 namespace {
@@ -127,14 +134,36 @@ ConvertTextEmbedderOptionsToProto(TextEmbedderOptions* options) {
           components::processors::ConvertEmbedderOptionsToProto(
               &(options->embedder_options)));
   options_proto->mutable_embedder_options()->Swap(embedder_options_proto.get());
+  options_proto->set_token_cache_size(options->token_cache_size);
   return options_proto;
 }
 
+// Returns the name of the result cache shared by embedders loading the same
+// model bytes with the same options. Unlike the model asset, which may point
+// to a file rewritten or a descriptor reused later, the bytes identify the
+// model.
+absl::StatusOr<std::string> GetResultCacheName(
+    const proto::TextEmbedderGraphOptions& options) {
+  ABSL_ASSIGN_OR_RETURN(std::unique_ptr<core::ExternalFileHandler> model,
+                        core::ExternalFileHandler::CreateFromExternalFile(
+                            &options.base_options().model_asset()));
+  proto::TextEmbedderGraphOptions options_without_model = options;
+  options_without_model.mutable_base_options()->clear_model_asset();
+  return absl::StrCat(
+      kTaskName, "/",
+      absl::HashOf(model->GetFileContent(),
+                   options_without_model.SerializeAsString()));
+}
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<TextEmbedder>> TextEmbedder::Create(
     std::unique_ptr<TextEmbedderOptions> options) {
   auto options_proto = ConvertTextEmbedderOptionsToProto(options.get());
+  std::string cache_name;
+  if (options->result_cache_size > 0) {
+    ABSL_ASSIGN_OR_RETURN(cache_name, GetResultCacheName(*options_proto));
+  }
   auto task_runner_options = core::TaskRunnerOptions{
       .config = CreateGraphConfig(std::move(options_proto)),
       .task_name = kTaskName,
@@ -153,19 +182,91 @@ absl::StatusOr<std::unique_ptr<TextEmbedder>> TextEmbedder::Create(
     return graph_executor_or.status();
   }
   text_embedder->executor_ = std::move(*graph_executor_or);
+  if (options->result_cache_size > 0) {
+    text_embedder->result_cache_ =
+        utils::GetSharedTextCache<TextEmbedderResult>(
+            cache_name, options->result_cache_size);
+  }
   return text_embedder;
 }
 
 TextEmbedder::~TextEmbedder() = default;
 
 absl::StatusOr<TextEmbedderResult> TextEmbedder::Embed(absl::string_view text) {
-  return executor_->Embed(text);
+  return EmbedFormattedText(text);
 }
 
 absl::StatusOr<TextEmbedderResult> TextEmbedder::Embed(
     absl::string_view text, const TextFormatContext& format_context) {
   std::string processed_text = GetFormattedEmbeddingText(text, format_context);
-  return executor_->Embed(processed_text);
+  return EmbedFormattedText(processed_text);
+}
+
+absl::StatusOr<std::vector<TextEmbedderResult>> TextEmbedder::EmbedBatch(
+    absl::Span<const absl::string_view> texts) {
+  return EmbedFormattedTexts(texts);
+}
+
+absl::StatusOr<std::vector<TextEmbedderResult>> TextEmbedder::EmbedBatch(
+    absl::Span<const absl::string_view> texts,
+    const TextFormatContext& format_context) {
+  std::vector<std::string> processed_texts;
+  processed_texts.reserve(texts.size());
+  for (absl::string_view text : texts) {
+    processed_texts.push_back(GetFormattedEmbeddingText(text, format_context));
+  }
+  std::vector<absl::string_view> processed_text_views(
+      processed_texts.begin(), processed_texts.end());
+  return EmbedFormattedTexts(processed_text_views);
+}
+
+absl::StatusOr<TextEmbedderResult> TextEmbedder::EmbedFormattedText(
+    absl::string_view text) {
+  if (result_cache_ == nullptr) {
+    return executor_->Embed(text);
+  }
+  if (auto cached_result = result_cache_->Lookup(text)) {
+    return *cached_result;
+  }
+  ABSL_ASSIGN_OR_RETURN(TextEmbedderResult result, executor_->Embed(text));
+  result_cache_->Insert(text,
+                        std::make_shared<const TextEmbedderResult>(result));
+  return result;
+}
+
+absl::StatusOr<std::vector<TextEmbedderResult>>
+TextEmbedder::EmbedFormattedTexts(absl::Span<const absl::string_view> texts) {
+  if (result_cache_ == nullptr) {
+    return executor_->EmbedBatch(texts);
+  }
+  std::vector<TextEmbedderResult> results(texts.size());
+  std::vector<absl::string_view> uncached_texts;
+  std::vector<size_t> uncached_indices;
+  for (size_t i = 0; i < texts.size(); ++i) {
+    if (auto cached_result = result_cache_->Lookup(texts[i])) {
+      results[i] = *cached_result;
+    } else {
+      uncached_texts.push_back(texts[i]);
+      uncached_indices.push_back(i);
+    }
+  }
+  if (uncached_texts.empty()) {
+    return results;
+  }
+  ABSL_ASSIGN_OR_RETURN(std::vector<TextEmbedderResult> uncached_results,
+                        executor_->EmbedBatch(uncached_texts));
+  for (size_t i = 0; i < uncached_results.size(); ++i) {
+    result_cache_->Insert(uncached_texts[i],
+                          std::make_shared<const TextEmbedderResult>(
+                              uncached_results[i]));
+    results[uncached_indices[i]] = std::move(uncached_results[i]);
+  }
+  return results;
+}
+
+utils::TextCacheStats TextEmbedder::GetResultCacheStats() const {
+  if (result_cache_ == nullptr) return {};
+  return result_cache_->GetStats();
 }
 
 absl::StatusOr<double> TextEmbedder::CosineSimilarity(
@@ -19,15 +19,18 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "mediapipe/tasks/cc/components/containers/embedding_result.h"
 #include "mediapipe/tasks/cc/components/processors/embedder_options.h"
 #include "mediapipe/tasks/cc/core/base_options.h"
 #include "mediapipe/tasks/cc/core/base_task_api.h"
 #include "mediapipe/tasks/cc/text/text_embedder/text_embedder_executor.h"
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
 
 namespace mediapipe::tasks::text::text_embedder {
 
@@ -44,6 +47,15 @@ struct TextEmbedderOptions {
   // Options for configuring the embedder behavior, such as L2-normalization or
   // scalar-quantization.
   components::processors::EmbedderOptions embedder_options;
+
+  // The maximum number of tokenized input texts to cache, shared with the
+  // other text tasks using the same tokenizer. No texts are cached if 0.
+  int token_cache_size = 0;
+
+  // The maximum number of embedding results to cache, shared with the other
+  // TextEmbedders created with the same model and options, so that repeated
+  // texts are embedded without running the model. No results are cached if 0.
+  int result_cache_size = 0;
 };
 
 // The embedding task type, used to format input text.
@@ -135,6 +147,20 @@ class TextEmbedder : core::BaseTaskApi {
   absl::StatusOr<TextEmbedderResult> Embed(
       absl::string_view text, const TextFormatContext& format_context);
 
+  // Performs embedding extraction on each of the input `texts`, returning the
+  // results in the same order. This is equivalent to calling Embed() for each
+  // text, but much faster for large numbers of texts such as when indexing
+  // documents, as the texts are pipelined through the model: a text is
+  // tokenized while inference runs on the previous one.
+  absl::StatusOr<std::vector<TextEmbedderResult>> EmbedBatch(
+      absl::Span<const absl::string_view> texts);
+
+  // Performs embedding extraction on each of the input `texts` with
+  // formatting options, see EmbedBatch() above.
+  absl::StatusOr<std::vector<TextEmbedderResult>> EmbedBatch(
+      absl::Span<const absl::string_view> texts,
+      const TextFormatContext& format_context);
+
   ~TextEmbedder();
 
   // Shuts down the TextEmbedder when all the work is done.
@@ -155,8 +181,22 @@ class TextEmbedder : core::BaseTaskApi {
       const components::containers::Embedding& u,
       const components::containers::Embedding& v);
 
+  // Returns the lookup counts of the result cache, which are all 0 if results
+  // aren't cached.
+  utils::TextCacheStats GetResultCacheStats() const;
+
  private:
+  // Embeds the formatted `text`, looking it up in `result_cache_` first.
+  absl::StatusOr<TextEmbedderResult> EmbedFormattedText(absl::string_view text);
+
+  // Embeds the formatted `texts`, only running the model on those missing
+  // from `result_cache_`.
+  absl::StatusOr<std::vector<TextEmbedderResult>> EmbedFormattedTexts(
+      absl::Span<const absl::string_view> texts);
+
   std::unique_ptr<TextEmbedderExecutor> executor_;
+  // The results of recent texts, if caching is enabled.
+  std::shared_ptr<utils::TextCache<TextEmbedderResult>> result_cache_;
 };
 
 }  // namespace mediapipe::tasks::text::text_embedder
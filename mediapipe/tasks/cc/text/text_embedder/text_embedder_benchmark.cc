@@ -0,0 +1,94 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Measures the documents per second embedded by TextEmbedder::Embed() called
+// in a loop versus TextEmbedder::EmbedBatch().
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/tasks/cc/text/text_embedder/text_embedder.h"
+
+namespace mediapipe::tasks::text::text_embedder {
+namespace {
+
+constexpr char kTestDataDirectory[] = "/mediapipe/tasks/testdata/text/";
+constexpr char kMobileBert[] = "mobilebert_embedding_with_metadata.tflite";
+
+std::unique_ptr<TextEmbedder> CreateTextEmbedder() {
+  auto options = std::make_unique<TextEmbedderOptions>();
+  options->base_options.model_asset_path =
+      file::JoinPath("./", kTestDataDirectory, kMobileBert);
+  auto text_embedder = TextEmbedder::Create(std::move(options));
+  ABSL_CHECK_OK(text_embedder);
+  return *std::move(text_embedder);
+}
+
+// Documents of varying lengths.
+std::vector<std::string> CreateDocuments(int num_documents) {
+  std::vector<std::string> documents;
+  documents.reserve(num_documents);
+  for (int i = 0; i < num_documents; ++i) {
+    std::string document = absl::StrCat("document ", i, ":");
+    for (int j = 0; j <= i % 8; ++j) {
+      absl::StrAppend(&document, " it's a charming and often affecting trip");
+    }
+    documents.push_back(std::move(document));
+  }
+  return documents;
+}
+
+// Arg: number of documents per iteration.
+void BM_Embed(benchmark::State& state) {
+  auto text_embedder = CreateTextEmbedder();
+  const std::vector<std::string> documents = CreateDocuments(state.range(0));
+  for (auto _ : state) {
+    for (const std::string& document : documents) {
+      auto result = text_embedder->Embed(document);
+      ABSL_CHECK_OK(result);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+  ABSL_CHECK_OK(text_embedder->Close());
+}
+BENCHMARK(BM_Embed)->Arg(1)->Arg(16)->Arg(64);
+
+// Arg: number of documents per EmbedBatch() call.
+void BM_EmbedBatch(benchmark::State& state) {
+  auto text_embedder = CreateTextEmbedder();
+  const std::vector<std::string> documents = CreateDocuments(state.range(0));
+  const std::vector<absl::string_view> document_views(documents.begin(),
+                                                      documents.end());
+  for (auto _ : state) {
+    auto results = text_embedder->EmbedBatch(document_views);
+    ABSL_CHECK_OK(results);
+    benchmark::DoNotOptimize(results);
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+  ABSL_CHECK_OK(text_embedder->Close());
+}
+BENCHMARK(BM_EmbedBatch)->Arg(1)->Arg(16)->Arg(64);
+
+}  // namespace
+}  // namespace mediapipe::tasks::text::text_embedder
+
+BENCHMARK_MAIN();
@@ -16,9 +16,13 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_TEXT_TEXT_EMBEDDER_TEXT_EMBEDDER_EXECUTOR_H_
 #define MEDIAPIPE_TASKS_CC_TEXT_TEXT_EMBEDDER_TEXT_EMBEDDER_EXECUTOR_H_
 
+#include <utility>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "mediapipe/tasks/cc/components/containers/embedding_result.h"
 
 namespace mediapipe::tasks::text::text_embedder {
@@ -31,6 +35,22 @@ class TextEmbedderExecutor {
  public:
   virtual ~TextEmbedderExecutor() = default;
   virtual absl::StatusOr<TextEmbedderResult> Embed(absl::string_view text) = 0;
+
+  // Embeds several texts, returning their results in order. Executors which
+  // can amortize per-call overhead across texts should override this; the
+  // default implementation calls Embed() for each text.
+  virtual absl::StatusOr<std::vector<TextEmbedderResult>> EmbedBatch(
+      absl::Span<const absl::string_view> texts) {
+    std::vector<TextEmbedderResult> results;
+    results.reserve(texts.size());
+    for (absl::string_view text : texts) {
+      absl::StatusOr<TextEmbedderResult> result = Embed(text);
+      if (!result.ok()) return result.status();
+      results.push_back(*std::move(result));
+    }
+    return results;
+  }
+
   virtual absl::Status Close() = 0;
 };
 
@@ -224,6 +224,7 @@ class TextEmbedderGraph : public core::ModelTaskGraph {
     ABSL_RETURN_IF_ERROR(
         components::processors::ConfigureTextPreprocessingGraph(
             model_resources, *preproc_options));
+    preproc_options->set_token_cache_size(task_options.token_cache_size());
     text_in >> preprocessing.In(kTextTag);
 
     // Adds both InferenceCalculator and ModelResourcesCalculator.
@@ -15,16 +15,20 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/text_embedder/text_embedder.h"
 
+#include <cstdio>
 #include <fstream>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/deps/file_helpers.h"
 #include "mediapipe/framework/deps/file_path.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -102,6 +106,107 @@ TEST_F(EmbedderTest, SucceedsWithMobileBert) {
   MP_ASSERT_OK(text_embedder->Close());
 }
 
+TEST_F(EmbedderTest, SucceedsWithMobileBertBatch) {
+  auto options = std::make_unique<TextEmbedderOptions>();
+  options->base_options.model_asset_path =
+      JoinPath("./", kTestDataDirectory, kMobileBert);
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextEmbedder> text_embedder,
+                          TextEmbedder::Create(std::move(options)));
+  const std::vector<absl::string_view> texts = {
+      "it's a charming and often affecting journey",
+      "what a great and fantastic trip",
+      "When you go to this restaurant, they hold the pancake upside-down "
+      "before they hand it to you. It's a great gimmick."};
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<TextEmbedderResult> results,
+                          text_embedder->EmbedBatch(texts));
+  ASSERT_EQ(results.size(), texts.size());
+  for (int i = 0; i < texts.size(); ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(TextEmbedderResult expected,
+                            text_embedder->Embed(texts[i]));
+    ASSERT_EQ(results[i].embeddings.size(), 1);
+    ASSERT_EQ(results[i].embeddings[0].float_embedding.size(), 512);
+    MP_ASSERT_OK_AND_ASSIGN(
+        double similarity,
+        TextEmbedder::CosineSimilarity(results[i].embeddings[0],
+                                       expected.embeddings[0]));
+    EXPECT_NEAR(similarity, 1.0, 1e-6);
+  }
+
+  MP_ASSERT_OK_AND_ASSIGN(results, text_embedder->EmbedBatch({}));
+  EXPECT_TRUE(results.empty());
+
+  MP_ASSERT_OK(text_embedder->Close());
+}
+
+TEST_F(EmbedderTest, SucceedsWithMobileBertBatchAndCaches) {
+  auto options = std::make_unique<TextEmbedderOptions>();
+  options->base_options.model_asset_path =
+      JoinPath("./", kTestDataDirectory, kMobileBert);
+  options->token_cache_size = 16;
+  options->result_cache_size = 16;
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextEmbedder> text_embedder,
+                          TextEmbedder::Create(std::move(options)));
+  const std::vector<absl::string_view> texts = {
+      "it's a charming and often affecting journey",
+      "what a great and fantastic trip"};
+
+  MP_ASSERT_OK_AND_ASSIGN(TextEmbedderResult result,
+                          text_embedder->Embed(texts[0]));
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<TextEmbedderResult> results,
+                          text_embedder->EmbedBatch(texts));
+
+  ASSERT_EQ(results.size(), texts.size());
+  EXPECT_EQ(results[0].embeddings[0].float_embedding,
+            result.embeddings[0].float_embedding);
+  ASSERT_EQ(results[1].embeddings[0].float_embedding.size(), 512);
+  utils::TextCacheStats stats = text_embedder->GetResultCacheStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+
+  MP_ASSERT_OK(text_embedder->Close());
+}
+
+TEST_F(EmbedderTest, DoesNotShareResultsOfModelsAtTheSamePath) {
+  const std::string model_path =
+      JoinPath(::testing::TempDir(), "replaced_text_embedder.tflite");
+  // Renames a copy of the model over `model_path`, so that an embedder
+  // created earlier keeps the model it mapped.
+  auto replace_model = [&](absl::string_view model_file_name) {
+    std::string model;
+    MP_ASSERT_OK(file::GetContents(
+        JoinPath("./", kTestDataDirectory, model_file_name), &model));
+    const std::string tmp_path = absl::StrCat(model_path, ".tmp");
+    MP_ASSERT_OK(file::SetContents(tmp_path, model));
+    ASSERT_EQ(std::rename(tmp_path.c_str(), model_path.c_str()), 0);
+  };
+  auto create_embedder = [&]() {
+    auto options = std::make_unique<TextEmbedderOptions>();
+    options->base_options.model_asset_path = model_path;
+    options->result_cache_size = 16;
+    return TextEmbedder::Create(std::move(options));
+  };
+
+  replace_model(kMobileBert);
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextEmbedder> mobile_bert_embedder,
+                          create_embedder());
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextEmbedderResult mobile_bert_result,
+      mobile_bert_embedder->Embed("what a great and fantastic trip"));
+  replace_model(kRegexOneEmbeddingModel);
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TextEmbedder> regex_embedder,
+                          create_embedder());
+  MP_ASSERT_OK_AND_ASSIGN(
+      TextEmbedderResult regex_result,
+      regex_embedder->Embed("what a great and fantastic trip"));
+
+  EXPECT_EQ(mobile_bert_result.embeddings[0].float_embedding.size(), 512);
+  EXPECT_EQ(regex_result.embeddings[0].float_embedding.size(), 16);
+  EXPECT_EQ(regex_embedder->GetResultCacheStats().hits, 0);
+
+  MP_ASSERT_OK(mobile_bert_embedder->Close());
+  MP_ASSERT_OK(regex_embedder->Close());
+}
+
 TEST(EmbedTest, SucceedsWithRegexOneEmbeddingModel) {
   auto options = std::make_unique<TextEmbedderOptions>();
   options->base_options.model_asset_path =
@@ -16,6 +16,10 @@ limitations under the License.
 #include "mediapipe/tasks/cc/text/tokenizers/bert_tokenizer.h"
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "tensorflow_text/core/kernels/regex_split.h"
 
@@ -57,6 +61,18 @@ bool FlatHashMapBackedWordpiece::LookupWord(int vocab_id,
   return true;
 }
 
+BertTokenizer::BertTokenizer(std::unique_ptr<TrieBackedWordpiece> vocab,
+                             const BertTokenizerOptions& options)
+    : vocab_{std::move(vocab)},
+      options_{options},
+      use_trie_tokenization_{
+          !options.split_unknown_chars &&
+          (options.max_chars_per_subtoken <= 0 ||
+           options.max_chars_per_subtoken >= options.max_bytes_per_token) &&
+          vocab_->suffix_indicator() == options.suffix_indicator},
+      delim_re_{options.delim_str},
+      include_delim_re_{options.include_delim_str} {}
+
 TokenizerResult BertTokenizer::Tokenize(const std::string& input) {
   return TokenizeWordpiece(input);
 }
@@ -76,15 +92,40 @@ WordpieceTokenizerResult BertTokenizer::TokenizeWordpiece(
   tensorflow::text::RegexSplit(input, delim_re_, true, include_delim_re_,
                                &tokens, &begin_offsets, &end_offsets);
 
+  std::vector<int> ids;
   for (int token_index = 0; token_index < tokens.size(); token_index++) {
     auto& token = tokens[token_index];
     int num_word_pieces = 0;
-    tensorflow::text::LookupStatus status = WordpieceTokenize(
-        token, options_.max_bytes_per_token, options_.max_chars_per_subtoken,
-        options_.suffix_indicator, options_.use_unknown_token,
-        options_.unknown_token, options_.split_unknown_chars, &vocab_,
-        &subwords, &wp_absolute_begin_offset, &wp_absolute_end_offset,
-        &num_word_pieces);
+    tensorflow::text::LookupStatus status;
+    if (use_trie_tokenization_ &&
+        static_cast<int>(token.size()) <= options_.max_bytes_per_token) {
+      // Same results as WordpieceTokenize() below, in linear time.
+      ids.clear();
+      if (vocab_->TokenizeWord(token, &ids, &wp_absolute_begin_offset,
+                               &wp_absolute_end_offset)) {
+        for (const int id : ids) {
+          absl::string_view subword;
+          vocab_->LookupWord(id, &subword);
+          subwords.emplace_back(subword);
+        }
+        num_word_pieces = ids.size();
+      } else {
+        subwords.emplace_back(options_.use_unknown_token
+                                  ? absl::string_view(options_.unknown_token)
+                                  : token);
+        wp_absolute_begin_offset.push_back(0);
+        wp_absolute_end_offset.push_back(token.size());
+        num_word_pieces = 1;
+      }
+    } else {
+      status = WordpieceTokenize(
+          token, options_.max_bytes_per_token,
+          options_.max_chars_per_subtoken, options_.suffix_indicator,
+          options_.use_unknown_token, options_.unknown_token,
+          options_.split_unknown_chars, vocab_.get(), &subwords,
+          &wp_absolute_begin_offset, &wp_absolute_end_offset,
+          &num_word_pieces);
+    }
 
     result.row_lengths.emplace_back(num_word_pieces);
     // for the last num_word_pieces added into wp_absolute_begin_offset and
@@ -18,12 +18,14 @@ limitations under the License.
 
 #include <cstddef>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer.h"
+#include "mediapipe/tasks/cc/text/tokenizers/trie_backed_wordpiece.h"
 #include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
 #include "re2/re2.h"
 #include "tensorflow_text/core/kernels/wordpiece_tokenizer.h"
@@ -87,15 +89,24 @@ class FlatHashMapBackedWordpiece : public tensorflow::text::WordpieceVocab {
 };
 
 // Wordpiece tokenizer for bert models. Initialized with a vocab file or vector.
+//
+// Words are tokenized in linear time with TrieBackedWordpiece, unless the
+// options require the split of unknown characters or limit subtokens to fewer
+// characters than words have bytes, which only
+// tensorflow::text::WordpieceTokenize supports.
 class BertTokenizer : public mediapipe::tasks::text::tokenizers::Tokenizer {
  public:
   // Initialize the tokenizer from vocab vector and tokenizer configs.
   explicit BertTokenizer(const std::vector<std::string>& vocab,
                          const BertTokenizerOptions& options = {})
-      : vocab_{FlatHashMapBackedWordpiece(vocab)},
-        options_{options},
-        delim_re_{options.delim_str},
-        include_delim_re_{options.include_delim_str} {}
+      : BertTokenizer(std::make_unique<TrieBackedWordpiece>(
+                          vocab, options.suffix_indicator),
+                      options) {}
+
+  // Initialize the tokenizer from a prebuilt vocab trie, e.g. loaded with
+  // TrieBackedWordpiece::CreateFromBuffer(), and tokenizer configs.
+  explicit BertTokenizer(std::unique_ptr<TrieBackedWordpiece> vocab,
+                         const BertTokenizerOptions& options = {});
 
   // Initialize the tokenizer from file path to vocab and tokenizer configs.
   explicit BertTokenizer(const std::string& path_to_vocab,
@@ -121,24 +132,26 @@ class BertTokenizer : public mediapipe::tasks::text::tokenizers::Tokenizer {
   // Check if a certain key is included in the vocab.
   tensorflow::text::LookupStatus Contains(const absl::string_view key,
                                           bool* value) const {
-    return vocab_.Contains(key, value);
+    return vocab_->Contains(key, value);
   }
 
   // Find the id of a wordpiece.
   bool LookupId(absl::string_view key, int* result) const override {
-    return vocab_.LookupId(key, result);
+    return vocab_->LookupId(key, result);
   }
 
   // Find the wordpiece from an id.
   bool LookupWord(int vocab_id, absl::string_view* result) const override {
-    return vocab_.LookupWord(vocab_id, result);
+    return vocab_->LookupWord(vocab_id, result);
   }
 
-  int VocabularySize() const { return vocab_.VocabularySize(); }
+  int VocabularySize() const { return vocab_->VocabularySize(); }
 
  private:
-  mediapipe::tasks::text::tokenizers::FlatHashMapBackedWordpiece vocab_;
+  std::unique_ptr<TrieBackedWordpiece> vocab_;
   BertTokenizerOptions options_;
+  // Whether words can be tokenized with TrieBackedWordpiece::TokenizeWord().
+  bool use_trie_tokenization_;
   RE2 delim_re_;
   RE2 include_delim_re_;
 };
@@ -73,6 +73,38 @@ TEST(TokenizerTest, TestTokenizerCreationFromVector) {
   AssertTokenizerResults(std::move(tokenizer));
 }
 
+TEST(TokenizerTest, TestTokenizerCreationFromPrebuiltTrie) {
+  std::vector<std::string> vocab;
+  vocab.emplace_back("i");
+  vocab.emplace_back("'");
+  vocab.emplace_back("m");
+  vocab.emplace_back("question");
+  TrieBackedWordpiece built_trie(vocab, kDefaultSuffixIndicator);
+  const std::string buffer(built_trie.buffer());
+  auto trie = TrieBackedWordpiece::CreateFromBuffer(buffer);
+  ASSERT_TRUE(trie.ok());
+  auto tokenizer = absl::make_unique<BertTokenizer>(*std::move(trie));
+
+  AssertTokenizerResults(std::move(tokenizer));
+}
+
+TEST(TokenizerTest, TestTokenizerWithLimitedCharsPerSubtoken) {
+  std::vector<std::string> vocab;
+  vocab.emplace_back("i");
+  vocab.emplace_back("'");
+  vocab.emplace_back("m");
+  vocab.emplace_back("question");
+  BertTokenizerOptions options;
+  options.max_chars_per_subtoken = 4;
+  auto tokenizer = absl::make_unique<BertTokenizer>(vocab, options);
+
+  auto results = tokenizer->TokenizeWordpiece("i'm question");
+
+  EXPECT_THAT(results.subwords, ElementsAre("i", "'", "m", "[UNK]"));
+  EXPECT_THAT(results.wp_begin_offset, ElementsAre(0, 1, 2, 4));
+  EXPECT_THAT(results.wp_end_offset, ElementsAre(1, 2, 3, 12));
+}
+
 TEST(TokenizerTest, TestTokenizerMultipleRows) {
 #ifdef _WIN32
   // TODO: Investigate why these tests are failing
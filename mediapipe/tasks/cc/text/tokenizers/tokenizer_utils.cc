@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer_utils.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -139,6 +141,58 @@ absl::StatusOr<std::unique_ptr<Tokenizer>> CreateTokenizerFromProcessUnit(
   }
 }
 
+absl::StatusOr<size_t> GetTokenizerFingerprint(
+    const tflite::ProcessUnit* tokenizer_process_unit,
+    const metadata::ModelMetadataExtractor* metadata_extractor) {
+  if (metadata_extractor == nullptr || tokenizer_process_unit == nullptr) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "No metadata or input process unit found.",
+        MediaPipeTasksStatus::kMetadataInvalidTokenizerError);
+  }
+  const int options_type = tokenizer_process_unit->options_type();
+  switch (tokenizer_process_unit->options_type()) {
+    case tflite::ProcessUnitOptions_BertTokenizerOptions: {
+      const tflite::BertTokenizerOptions* options =
+          tokenizer_process_unit->options_as<tflite::BertTokenizerOptions>();
+      ABSL_ASSIGN_OR_RETURN(absl::string_view vocab_buffer,
+                            CheckAndLoadFirstAssociatedFile(
+                                options->vocab_file(), metadata_extractor));
+      return absl::HashOf(options_type, vocab_buffer);
+    }
+    case tflite::ProcessUnitOptions_SentencePieceTokenizerOptions: {
+      const tflite::SentencePieceTokenizerOptions* options =
+          tokenizer_process_unit
+              ->options_as<tflite::SentencePieceTokenizerOptions>();
+      ABSL_ASSIGN_OR_RETURN(
+          absl::string_view model_buffer,
+          CheckAndLoadFirstAssociatedFile(options->sentencePiece_model(),
+                                          metadata_extractor));
+      return absl::HashOf(options_type, model_buffer);
+    }
+    case tflite::ProcessUnitOptions_RegexTokenizerOptions: {
+      const tflite::RegexTokenizerOptions* options =
+          tokenizer_process_unit->options_as<tflite::RegexTokenizerOptions>();
+      ABSL_ASSIGN_OR_RETURN(absl::string_view vocab_buffer,
+                            CheckAndLoadFirstAssociatedFile(
+                                options->vocab_file(), metadata_extractor));
+      if (options->delim_regex_pattern() == nullptr) {
+        return CreateStatusWithPayload(
+            absl::StatusCode::kInvalidArgument,
+            "Invalid delim_regex_pattern from input process unit.",
+            MediaPipeTasksStatus::kMetadataInvalidTokenizerError);
+      }
+      return absl::HashOf(options_type, vocab_buffer,
+                          options->delim_regex_pattern()->str());
+    }
+    default:
+      return CreateStatusWithPayload(
+          absl::StatusCode::kNotFound,
+          absl::StrCat("Incorrect options_type:", options_type),
+          MediaPipeTasksStatus::kMetadataInvalidTokenizerError);
+  }
+}
+
 }  // namespace tokenizers
 }  // namespace text
 }  // namespace tasks
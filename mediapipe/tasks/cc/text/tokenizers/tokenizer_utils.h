@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_TEXT_TOKENIZERS_TOKENIZER_UTILS_H_
 #define MEDIAPIPE_TASKS_CC_TEXT_TOKENIZERS_TOKENIZER_UTILS_H_
 
+#include <cstddef>
 #include <memory>
 
 #include "absl/status/statusor.h"
@@ -39,6 +40,13 @@ absl::StatusOr<std::unique_ptr<Tokenizer>> CreateTokenizerFromProcessUnit(
     const tflite::ProcessUnit* tokenizer_process_unit,
     const metadata::ModelMetadataExtractor* metadata_extractor);
 
+// Returns a hash of the tokenizer options and vocab / model files in the
+// process unit, which is equal for tokenizers splitting text in the same way,
+// e.g. to share caches of token ids. It is only stable within a process.
+absl::StatusOr<size_t> GetTokenizerFingerprint(
+    const tflite::ProcessUnit* tokenizer_process_unit,
+    const metadata::ModelMetadataExtractor* metadata_extractor);
+
 }  // namespace tokenizers
 }  // namespace text
 }  // namespace tasks
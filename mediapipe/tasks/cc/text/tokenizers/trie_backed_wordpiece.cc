@@ -0,0 +1,464 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/text/tokenizers/trie_backed_wordpiece.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/tasks/cc/common.h"
+#include "mediapipe/tasks/cc/text/custom_ops/sentencepiece/double_array_trie_builder.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace text {
+namespace tokenizers {
+
+namespace {
+
+using ::mediapipe::tflite_operations::sentencepiece::BuildTrie;
+
+// Failure link of the nodes from which tokenization can't recover.
+constexpr uint32_t kNullNode = std::numeric_limits<uint32_t>::max();
+// Suffix root of a vocabulary without suffix wordpieces. Like kNullNode, it
+// is out of range of the trie nodes and so has no children.
+constexpr uint32_t kNoSuffixRoot = kNullNode - 1;
+constexpr uint32_t kRoot = 0;
+
+// Suffix wordpieces are stored in the trie under this byte, which never
+// occurs in UTF-8, rather than under the suffix indicator. This keeps them
+// apart from the vocabulary entries that merely start with the indicator.
+constexpr uint8_t kSuffixMarker = 0xff;
+
+// The layout of the buffer, in the native byte order. Every section
+// following the header starts at a multiple of kSectionAlignment:
+// - the nodes of the trie, as uint32_t;
+// - the failure link of each node, as uint32_t;
+// - the offsets of the failure pops of each node, plus the total number of
+//   failure pops, as uint32_t;
+// - the failure pops, as uint32_t vocabulary ids;
+// - the offsets of the vocabulary entries, plus the total number of
+//   characters, as uint32_t;
+// - the characters of the vocabulary entries;
+// - the suffix indicator.
+constexpr char kMagic[4] = {'M', 'P', 'W', 'P'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kSectionAlignment = sizeof(uint32_t);
+
+struct Header {
+  char magic[4];
+  uint32_t version;
+  uint32_t num_units;
+  uint32_t suffix_root;
+  uint32_t num_failure_pops;
+  uint32_t vocab_size;
+  uint32_t num_word_chars;
+  uint32_t suffix_indicator_size;
+};
+
+size_t AlignSection(size_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+void AppendSection(const void* data, size_t num_bytes, std::string* output) {
+  output->append(static_cast<const char*>(data), num_bytes);
+  output->resize(AlignSection(output->size()), '\0');
+}
+
+// Accessors of the darts-clone node format, see DoubleArrayTrie.
+bool HasLeaf(uint32_t unit) { return unit & 0x100; }
+uint32_t Value(uint32_t unit) { return unit & 0x7fffffff; }
+uint32_t Label(uint32_t unit) { return unit & 0x800000ff; }
+uint32_t Offset(uint32_t unit) {
+  return (unit >> 10) << ((unit & 0x200) >> 6);
+}
+
+}  // namespace
+
+TrieBackedWordpiece::TrieBackedWordpiece(
+    const std::vector<std::string>& vocab,
+    absl::string_view suffix_indicator) {
+  // Keeps the last id of each key. Empty keys can't be stored, and neither
+  // can keys containing kSuffixMarker or '\0', which don't occur in text.
+  std::vector<std::pair<std::string, int>> entries;
+  entries.reserve(vocab.size());
+  for (int i = 0; i < vocab.size(); ++i) {
+    const absl::string_view word = vocab[i];
+    if (word.empty() ||
+        word.find_first_of(absl::string_view("\xff\0", 2)) !=
+            absl::string_view::npos) {
+      continue;
+    }
+    entries.emplace_back(std::string(word), i);
+    if (word.size() > suffix_indicator.size() &&
+        absl::StartsWith(word, suffix_indicator)) {
+      entries.emplace_back(
+          absl::StrCat(absl::string_view("\xff", 1),
+                       word.substr(suffix_indicator.size())),
+          i);
+    }
+  }
+  std::stable_sort(
+      entries.begin(), entries.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  std::vector<std::string> keys;
+  std::vector<int> ids;
+  keys.reserve(entries.size());
+  ids.reserve(entries.size());
+  for (auto& [key, id] : entries) {
+    if (!keys.empty() && keys.back() == key) {
+      ids.back() = id;
+    } else {
+      keys.push_back(std::move(key));
+      ids.push_back(id);
+    }
+  }
+  std::vector<uint32_t> units;
+  if (!keys.empty()) {
+    units = BuildTrie(keys, ids);
+  }
+  units_ = units.data();
+  num_units_ = units.size();
+
+  // Visits the nodes breadth-first, so that the failure links and pops of a
+  // node are computed after those of all shallower nodes.
+  std::vector<uint32_t> parents(num_units_, kNullNode);
+  std::vector<uint8_t> labels(num_units_, 0);
+  std::vector<std::vector<uint32_t>> nodes_by_depth(1, {kRoot});
+  for (const std::string& key : keys) {
+    uint32_t node = kRoot;
+    for (size_t i = 0; i < key.size(); ++i) {
+      const uint8_t label = key[i];
+      const uint32_t child = Child(node, label);
+      if (parents[child] == kNullNode) {
+        parents[child] = node;
+        labels[child] = label;
+        if (nodes_by_depth.size() <= i + 1) nodes_by_depth.emplace_back();
+        nodes_by_depth[i + 1].push_back(child);
+      }
+      node = child;
+    }
+  }
+  suffix_root_ = Child(kRoot, kSuffixMarker);
+  if (suffix_root_ == kNullNode) suffix_root_ = kNoSuffixRoot;
+
+  // A node matching a vocabulary entry pops it and fails over to the suffix
+  // root. Any other node fails over to the longest suffix wordpiece, as in
+  // Aho-Corasick, popping what lies before it.
+  std::vector<uint32_t> failure_links(num_units_, kNullNode);
+  std::vector<std::vector<uint32_t>> failure_pops(num_units_);
+  for (size_t depth = 1; depth < nodes_by_depth.size(); ++depth) {
+    for (const uint32_t node : nodes_by_depth[depth]) {
+      const uint32_t leaf = node ^ Offset(units_[node]);
+      if (HasLeaf(units_[node])) {
+        failure_links[node] = suffix_root_;
+        failure_pops[node] = {Value(units_[leaf])};
+        continue;
+      }
+      const uint32_t parent = parents[node];
+      const uint8_t label = labels[node];
+      std::vector<uint32_t> pops = failure_pops[parent];
+      uint32_t link = failure_links[parent];
+      while (link < num_units_ && Child(link, label) == kNullNode) {
+        pops.insert(pops.end(), failure_pops[link].begin(),
+                    failure_pops[link].end());
+        link = failure_links[link];
+      }
+      if (link < num_units_) {
+        failure_links[node] = Child(link, label);
+        failure_pops[node] = std::move(pops);
+      }
+    }
+  }
+
+  std::vector<uint32_t> failure_pop_offsets;
+  std::vector<uint32_t> flat_failure_pops;
+  failure_pop_offsets.reserve(num_units_ + 1);
+  for (const std::vector<uint32_t>& pops : failure_pops) {
+    failure_pop_offsets.push_back(flat_failure_pops.size());
+    flat_failure_pops.insert(flat_failure_pops.end(), pops.begin(),
+                             pops.end());
+  }
+  failure_pop_offsets.push_back(flat_failure_pops.size());
+  std::vector<uint32_t> word_offsets;
+  std::string word_chars;
+  word_offsets.reserve(vocab.size() + 1);
+  for (const std::string& word : vocab) {
+    word_offsets.push_back(word_chars.size());
+    word_chars.append(word);
+  }
+  word_offsets.push_back(word_chars.size());
+
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_units = num_units_;
+  header.suffix_root = suffix_root_;
+  header.num_failure_pops = flat_failure_pops.size();
+  header.vocab_size = vocab.size();
+  header.num_word_chars = word_chars.size();
+  header.suffix_indicator_size = suffix_indicator.size();
+  AppendSection(&header, sizeof(header), &owned_buffer_);
+  AppendSection(units.data(), units.size() * sizeof(uint32_t),
+                &owned_buffer_);
+  AppendSection(failure_links.data(), failure_links.size() * sizeof(uint32_t),
+                &owned_buffer_);
+  AppendSection(failure_pop_offsets.data(),
+                failure_pop_offsets.size() * sizeof(uint32_t), &owned_buffer_);
+  AppendSection(flat_failure_pops.data(),
+                flat_failure_pops.size() * sizeof(uint32_t), &owned_buffer_);
+  AppendSection(word_offsets.data(), word_offsets.size() * sizeof(uint32_t),
+                &owned_buffer_);
+  AppendSection(word_chars.data(), word_chars.size(), &owned_buffer_);
+  AppendSection(suffix_indicator.data(), suffix_indicator.size(),
+                &owned_buffer_);
+  Initialize(owned_buffer_);
+}
+
+absl::StatusOr<std::unique_ptr<TrieBackedWordpiece>>
+TrieBackedWordpiece::CreateFromBuffer(absl::string_view buffer) {
+  const auto invalid = [](absl::string_view reason) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Invalid wordpiece trie: ", reason),
+        MediaPipeTasksStatus::kInvalidArgumentError);
+  };
+  if (reinterpret_cast<uintptr_t>(buffer.data()) % alignof(uint32_t) != 0) {
+    return invalid("buffer is not aligned to 4 bytes");
+  }
+  Header header;
+  if (buffer.size() < sizeof(header)) return invalid("truncated header");
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return invalid("bad magic");
+  }
+  if (header.version != kVersion) {
+    return invalid(absl::StrCat("unsupported version ", header.version));
+  }
+  if (header.num_units >= kNoSuffixRoot ||
+      header.vocab_size > std::numeric_limits<int>::max()) {
+    return invalid("bad header");
+  }
+
+  // Returns the next section, of `num_elements` elements of `element_size`
+  // bytes, or nullptr if the buffer is too short.
+  size_t offset = AlignSection(sizeof(header));
+  const auto next_section = [&offset, buffer](
+                                size_t num_elements,
+                                size_t element_size) -> const char* {
+    const size_t section_offset = offset;
+    if (section_offset > buffer.size() ||
+        num_elements > (buffer.size() - section_offset) / element_size) {
+      return nullptr;
+    }
+    offset = AlignSection(section_offset + num_elements * element_size);
+    return buffer.data() + section_offset;
+  };
+  const auto* units = reinterpret_cast<const uint32_t*>(
+      next_section(header.num_units, sizeof(uint32_t)));
+  const auto* failure_links = reinterpret_cast<const uint32_t*>(
+      next_section(header.num_units, sizeof(uint32_t)));
+  const auto* failure_pop_offsets = reinterpret_cast<const uint32_t*>(
+      next_section(size_t{header.num_units} + 1, sizeof(uint32_t)));
+  const auto* failure_pops = reinterpret_cast<const uint32_t*>(
+      next_section(header.num_failure_pops, sizeof(uint32_t)));
+  const auto* word_offsets = reinterpret_cast<const uint32_t*>(
+      next_section(size_t{header.vocab_size} + 1, sizeof(uint32_t)));
+  const char* word_chars = next_section(header.num_word_chars, sizeof(char));
+  const char* suffix_indicator =
+      next_section(header.suffix_indicator_size, sizeof(char));
+  if (units == nullptr || failure_links == nullptr ||
+      failure_pop_offsets == nullptr || failure_pops == nullptr ||
+      word_offsets == nullptr || word_chars == nullptr ||
+      suffix_indicator == nullptr) {
+    return invalid("truncated buffer");
+  }
+
+  if (header.suffix_root >= header.num_units &&
+      header.suffix_root != kNoSuffixRoot) {
+    return invalid("bad suffix root");
+  }
+  if (failure_pop_offsets[0] != 0) return invalid("bad failure pops");
+  for (uint32_t i = 0; i < header.num_units; ++i) {
+    if (failure_links[i] >= header.num_units &&
+        failure_links[i] != kNullNode &&
+        failure_links[i] != header.suffix_root) {
+      return invalid("bad failure link");
+    }
+    if (failure_pop_offsets[i + 1] < failure_pop_offsets[i]) {
+      return invalid("bad failure pops");
+    }
+  }
+  if (failure_pop_offsets[header.num_units] != header.num_failure_pops) {
+    return invalid("bad failure pops");
+  }
+  for (uint32_t i = 0; i < header.num_failure_pops; ++i) {
+    if (failure_pops[i] >= header.vocab_size) {
+      return invalid("bad failure pops");
+    }
+  }
+  if (word_offsets[0] != 0) return invalid("bad vocabulary");
+  for (uint32_t i = 0; i < header.vocab_size; ++i) {
+    if (word_offsets[i + 1] < word_offsets[i]) {
+      return invalid("bad vocabulary");
+    }
+  }
+  if (word_offsets[header.vocab_size] != header.num_word_chars) {
+    return invalid("bad vocabulary");
+  }
+
+  auto wordpiece = absl::WrapUnique(new TrieBackedWordpiece());
+  wordpiece->Initialize(buffer);
+  return wordpiece;
+}
+
+void TrieBackedWordpiece::Initialize(absl::string_view buffer) {
+  Header header;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  const char* data = buffer.data() + AlignSection(sizeof(header));
+  const auto next_section = [&data](size_t num_bytes) {
+    const char* section = data;
+    data += AlignSection(num_bytes);
+    return section;
+  };
+  buffer_ = buffer;
+  num_units_ = header.num_units;
+  suffix_root_ = header.suffix_root;
+  vocab_size_ = header.vocab_size;
+  units_ = reinterpret_cast<const uint32_t*>(
+      next_section(num_units_ * sizeof(uint32_t)));
+  failure_links_ = reinterpret_cast<const uint32_t*>(
+      next_section(num_units_ * sizeof(uint32_t)));
+  failure_pop_offsets_ = reinterpret_cast<const uint32_t*>(
+      next_section((num_units_ + 1) * sizeof(uint32_t)));
+  failure_pops_ = reinterpret_cast<const uint32_t*>(
+      next_section(header.num_failure_pops * sizeof(uint32_t)));
+  word_offsets_ = reinterpret_cast<const uint32_t*>(
+      next_section((header.vocab_size + 1) * sizeof(uint32_t)));
+  word_chars_ = next_section(header.num_word_chars);
+  suffix_indicator_ = absl::string_view(
+      next_section(header.suffix_indicator_size),
+      header.suffix_indicator_size);
+}
+
+uint32_t TrieBackedWordpiece::Child(uint32_t node, uint8_t label) const {
+  if (node >= num_units_) return kNullNode;
+  const uint32_t child = node ^ Offset(units_[node]) ^ label;
+  if (child >= num_units_ || Label(units_[child]) != label) return kNullNode;
+  return child;
+}
+
+tensorflow::text::LookupStatus TrieBackedWordpiece::Contains(
+    absl::string_view key, bool* value) const {
+  int id;
+  *value = LookupId(key, &id);
+  return tensorflow::text::LookupStatus();
+}
+
+bool TrieBackedWordpiece::LookupId(absl::string_view key, int* result) const {
+  uint32_t node = kRoot;
+  for (const char c : key) {
+    const uint8_t label = c;
+    if (label == kSuffixMarker) return false;
+    node = Child(node, label);
+    if (node == kNullNode) return false;
+  }
+  if (node >= num_units_ || !HasLeaf(units_[node])) return false;
+  const uint32_t leaf = node ^ Offset(units_[node]);
+  if (leaf >= num_units_) return false;
+  const int id = Value(units_[leaf]);
+  if (id >= vocab_size_) return false;
+  *result = id;
+  return true;
+}
+
+bool TrieBackedWordpiece::LookupWord(int vocab_id,
+                                     absl::string_view* result) const {
+  if (vocab_id >= vocab_size_ || vocab_id < 0) {
+    return false;
+  }
+  *result = absl::string_view(word_chars_ + word_offsets_[vocab_id],
+                              word_offsets_[vocab_id + 1] -
+                                  word_offsets_[vocab_id]);
+  return true;
+}
+
+bool TrieBackedWordpiece::TokenizeWord(absl::string_view word,
+                                       std::vector<int>* ids,
+                                       std::vector<int>* begin_offsets,
+                                       std::vector<int>* end_offsets) const {
+  if (word.empty()) return true;
+  const size_t num_ids = ids->size();
+  // Moves `node` along its failure link, popping the wordpieces matched so
+  // far. Returns false if the word can't be tokenized.
+  const auto fail_over = [this, ids](uint32_t& node) {
+    const uint32_t link =
+        node < num_units_ ? failure_links_[node] : kNullNode;
+    if (link == kNullNode) return false;
+    ids->insert(ids->end(), failure_pops_ + failure_pop_offsets_[node],
+                failure_pops_ + failure_pop_offsets_[node + 1]);
+    node = link;
+    return true;
+  };
+  uint32_t node = kRoot;
+  for (size_t i = 0; i < word.size();) {
+    const uint8_t label = word[i];
+    const uint32_t child =
+        label == kSuffixMarker ? kNullNode : Child(node, label);
+    if (child != kNullNode) {
+      node = child;
+      ++i;
+    } else if (!fail_over(node)) {
+      ids->resize(num_ids);
+      return false;
+    }
+  }
+  while (node != suffix_root_) {
+    if (!fail_over(node)) {
+      ids->resize(num_ids);
+      return false;
+    }
+  }
+
+  int begin_offset = 0;
+  for (size_t i = num_ids; i < ids->size(); ++i) {
+    const int id = (*ids)[i];
+    int length = word_offsets_[id + 1] - word_offsets_[id];
+    if (i > num_ids) length -= suffix_indicator_.size();
+    begin_offsets->push_back(begin_offset);
+    end_offsets->push_back(begin_offset + length);
+    begin_offset += length;
+  }
+  return true;
+}
+
+}  // namespace tokenizers
+}  // namespace text
+}  // namespace tasks
+}  // namespace mediapipe
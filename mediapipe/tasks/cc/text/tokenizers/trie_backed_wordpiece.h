@@ -0,0 +1,115 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_TEXT_TOKENIZERS_TRIE_BACKED_WORDPIECE_H_
+#define MEDIAPIPE_TASKS_CC_TEXT_TOKENIZERS_TRIE_BACKED_WORDPIECE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow_text/core/kernels/wordpiece_tokenizer.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace text {
+namespace tokenizers {
+
+// A WordPiece vocabulary stored in a double-array trie, augmented with the
+// failure links and failure pops of LinMaxMatch [1]. TokenizeWord() performs
+// greedy longest-match-first tokenization of a word in time linear in its
+// length, where a hash map needs a lookup for every candidate substring.
+//
+// The vocabulary is kept in a single flat buffer, which can be saved with
+// buffer() and later used in place, e.g. from a memory-mapped file, with
+// CreateFromBuffer(). Vocabulary entries are expected to be valid UTF-8.
+//
+// [1]: Song et al., Fast WordPiece Tokenization, EMNLP 2021.
+class TrieBackedWordpiece : public tensorflow::text::WordpieceVocab {
+ public:
+  // Builds the trie for `vocab`, whose entries starting with `suffix_indicator`
+  // are also matched as suffix wordpieces. As with a hash map, the last id of
+  // a duplicated entry wins.
+  TrieBackedWordpiece(const std::vector<std::string>& vocab,
+                      absl::string_view suffix_indicator);
+
+  // Uses the trie in `buffer`, previously returned by buffer(), in place. The
+  // buffer must be aligned to 4 bytes and outlive the returned object.
+  static absl::StatusOr<std::unique_ptr<TrieBackedWordpiece>>
+  CreateFromBuffer(absl::string_view buffer);
+
+  TrieBackedWordpiece(const TrieBackedWordpiece&) = delete;
+  TrieBackedWordpiece& operator=(const TrieBackedWordpiece&) = delete;
+
+  tensorflow::text::LookupStatus Contains(absl::string_view key,
+                                          bool* value) const override;
+  bool LookupId(absl::string_view key, int* result) const;
+  bool LookupWord(int vocab_id, absl::string_view* result) const;
+  int VocabularySize() const { return vocab_size_; }
+
+  // The suffix indicator the trie was built with.
+  absl::string_view suffix_indicator() const { return suffix_indicator_; }
+
+  // The serialized trie, which can be passed to CreateFromBuffer().
+  absl::string_view buffer() const { return buffer_; }
+
+  // Appends the ids of the wordpieces of `word` to `ids`, and their byte
+  // offsets in `word` to `begin_offsets` and `end_offsets`. Returns false,
+  // appending nothing, if `word` can't be tokenized with the vocabulary.
+  bool TokenizeWord(absl::string_view word, std::vector<int>* ids,
+                    std::vector<int>* begin_offsets,
+                    std::vector<int>* end_offsets) const;
+
+ private:
+  TrieBackedWordpiece() = default;
+
+  // Points the accessors below into `buffer`, which must have been validated.
+  void Initialize(absl::string_view buffer);
+
+  // Returns the child of `node` labeled `label`, or kNullNode.
+  uint32_t Child(uint32_t node, uint8_t label) const;
+
+  // Owns the buffer if the trie was built rather than loaded.
+  std::string owned_buffer_;
+  absl::string_view buffer_;
+
+  // Nodes of the double-array trie, in the format of darts-clone.
+  const uint32_t* units_ = nullptr;
+  uint32_t num_units_ = 0;
+  // Root of the suffix wordpieces, or kNoSuffixRoot if there are none.
+  uint32_t suffix_root_ = 0;
+  // Failure link of each node, or kNullNode.
+  const uint32_t* failure_links_ = nullptr;
+  // The failure pops of node i are failure_pops_[failure_pop_offsets_[i]]
+  // through failure_pops_[failure_pop_offsets_[i + 1] - 1].
+  const uint32_t* failure_pop_offsets_ = nullptr;
+  const uint32_t* failure_pops_ = nullptr;
+  // Entry i of the vocabulary is word_chars_[word_offsets_[i]] through
+  // word_chars_[word_offsets_[i + 1] - 1].
+  int vocab_size_ = 0;
+  const uint32_t* word_offsets_ = nullptr;
+  const char* word_chars_ = nullptr;
+  absl::string_view suffix_indicator_;
+};
+
+}  // namespace tokenizers
+}  // namespace text
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_TEXT_TOKENIZERS_TRIE_BACKED_WORDPIECE_H_
@@ -0,0 +1,120 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Measures the tokens per second split into wordpieces by
+// tensorflow::text::WordpieceTokenize() over the hash map vocabulary versus
+// TrieBackedWordpiece::TokenizeWord(). Both produce the subword strings and
+// their offsets, as BertTokenizer needs them.
+#include <string>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/tasks/cc/text/tokenizers/bert_tokenizer.h"
+#include "mediapipe/tasks/cc/text/tokenizers/trie_backed_wordpiece.h"
+#include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
+#include "tensorflow_text/core/kernels/wordpiece_tokenizer.h"
+
+namespace mediapipe::tasks::text::tokenizers {
+namespace {
+
+constexpr char kTestVocabPath[] =
+    "/mediapipe/tasks/testdata/text/mobilebert_vocab.txt";
+
+// Tokens as split by BertTokenizer, from short common words to long words
+// made of many wordpieces.
+constexpr char kShortTokens[] =
+    "it ' s a charming and often affecting journey . the movie is full of "
+    "life and it has a great cast";
+constexpr char kLongTokens[] =
+    "unaffable tokenization questionansweraskask internationalization "
+    "counterrevolutionaries electroencephalographically "
+    "pneumonoultramicroscopicsilicovolcanoconiosis";
+
+std::vector<std::string> LoadVocab() {
+  std::vector<std::string> vocab =
+      LoadVocabFromFile(file::JoinPath("./", kTestVocabPath));
+  ABSL_CHECK(!vocab.empty());
+  return vocab;
+}
+
+std::vector<std::string> GetTokens(int64_t arg) {
+  return absl::StrSplit(arg == 0 ? kShortTokens : kLongTokens, ' ');
+}
+
+// Arg: 0 for short tokens, 1 for long tokens.
+void BM_FlatHashMapWordpiece(benchmark::State& state) {
+  const FlatHashMapBackedWordpiece vocab(LoadVocab());
+  const std::vector<std::string> tokens = GetTokens(state.range(0));
+  std::vector<std::string> subwords;
+  std::vector<int> begin_offsets;
+  std::vector<int> end_offsets;
+  for (auto _ : state) {
+    for (const std::string& token : tokens) {
+      subwords.clear();
+      begin_offsets.clear();
+      end_offsets.clear();
+      int num_word_pieces;
+      tensorflow::text::WordpieceTokenize(
+          token, kDefaultMaxBytesPerToken, kDefaultMaxCharsPerSubToken,
+          kDefaultSuffixIndicator, kDefaultUseUnknownToken,
+          kDefaultUnknownToken, kDefaultSplitUnknownChars, &vocab, &subwords,
+          &begin_offsets, &end_offsets, &num_word_pieces);
+      benchmark::DoNotOptimize(subwords.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(BM_FlatHashMapWordpiece)->Arg(0)->Arg(1);
+
+// Arg: 0 for short tokens, 1 for long tokens.
+void BM_TrieBackedWordpiece(benchmark::State& state) {
+  const TrieBackedWordpiece vocab(LoadVocab(), kDefaultSuffixIndicator);
+  const std::vector<std::string> tokens = GetTokens(state.range(0));
+  std::vector<int> ids;
+  std::vector<std::string> subwords;
+  std::vector<int> begin_offsets;
+  std::vector<int> end_offsets;
+  for (auto _ : state) {
+    for (const std::string& token : tokens) {
+      ids.clear();
+      subwords.clear();
+      begin_offsets.clear();
+      end_offsets.clear();
+      // Builds the same subword strings as WordpieceTokenize(), as
+      // BertTokenizer does.
+      if (vocab.TokenizeWord(token, &ids, &begin_offsets, &end_offsets)) {
+        for (const int id : ids) {
+          absl::string_view subword;
+          vocab.LookupWord(id, &subword);
+          subwords.emplace_back(subword);
+        }
+      } else {
+        subwords.emplace_back(kDefaultUnknownToken);
+      }
+      benchmark::DoNotOptimize(subwords.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(BM_TrieBackedWordpiece)->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace mediapipe::tasks::text::tokenizers
+
+BENCHMARK_MAIN();
@@ -0,0 +1,193 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/text/tokenizers/trie_backed_wordpiece.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/text/tokenizers/bert_tokenizer.h"
+#include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
+#include "tensorflow_text/core/kernels/wordpiece_tokenizer.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace text {
+namespace tokenizers {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+constexpr char kTestVocabPath[] =
+    "mediapipe/tasks/testdata/text/mobilebert_vocab.txt";
+
+struct Wordpieces {
+  std::vector<int> ids;
+  std::vector<int> begin_offsets;
+  std::vector<int> end_offsets;
+};
+
+Wordpieces Tokenize(const TrieBackedWordpiece& vocab, absl::string_view word) {
+  Wordpieces wordpieces;
+  EXPECT_TRUE(vocab.TokenizeWord(word, &wordpieces.ids,
+                                 &wordpieces.begin_offsets,
+                                 &wordpieces.end_offsets));
+  return wordpieces;
+}
+
+TEST(TrieBackedWordpieceTest, TokenizesWithLongestMatchFirst) {
+  TrieBackedWordpiece vocab(
+      {"i", "'", "m", "question", "##ans", "##wer", "##ask", "##answer"},
+      "##");
+
+  Wordpieces wordpieces = Tokenize(vocab, "questionansweraskask");
+
+  EXPECT_THAT(wordpieces.ids, ElementsAre(3, 7, 6, 6));
+  EXPECT_THAT(wordpieces.begin_offsets, ElementsAre(0, 8, 14, 17));
+  EXPECT_THAT(wordpieces.end_offsets, ElementsAre(8, 14, 17, 20));
+}
+
+TEST(TrieBackedWordpieceTest, FailsWithUnknownWord) {
+  TrieBackedWordpiece vocab({"question", "##ans"}, "##");
+  std::vector<int> ids = {42};
+  std::vector<int> begin_offsets;
+  std::vector<int> end_offsets;
+
+  EXPECT_FALSE(
+      vocab.TokenizeWord("questionask", &ids, &begin_offsets, &end_offsets));
+  EXPECT_FALSE(vocab.TokenizeWord("ans", &ids, &begin_offsets, &end_offsets));
+
+  EXPECT_THAT(ids, ElementsAre(42));
+  EXPECT_THAT(begin_offsets, IsEmpty());
+  EXPECT_THAT(end_offsets, IsEmpty());
+}
+
+TEST(TrieBackedWordpieceTest, MatchesEntriesStartingWithSuffixIndicator) {
+  TrieBackedWordpiece vocab({"#", "##", "##a", "a", "##b"}, "##");
+
+  Wordpieces wordpieces = Tokenize(vocab, "##ab");
+
+  EXPECT_THAT(wordpieces.ids, ElementsAre(2, 4));
+  EXPECT_THAT(wordpieces.begin_offsets, ElementsAre(0, 3));
+  EXPECT_THAT(wordpieces.end_offsets, ElementsAre(3, 4));
+  EXPECT_THAT(Tokenize(vocab, "aab").ids, ElementsAre(3, 2, 4));
+}
+
+TEST(TrieBackedWordpieceTest, SucceedsWithoutSuffixWordpieces) {
+  TrieBackedWordpiece vocab({"ab", "a"}, "##");
+  std::vector<int> ids;
+  std::vector<int> begin_offsets;
+  std::vector<int> end_offsets;
+
+  EXPECT_THAT(Tokenize(vocab, "ab").ids, ElementsAre(0));
+  EXPECT_FALSE(vocab.TokenizeWord("aba", &ids, &begin_offsets, &end_offsets));
+}
+
+TEST(TrieBackedWordpieceTest, LooksUpIdsAndWords) {
+  TrieBackedWordpiece vocab({"a", "##b", "a"}, "##");
+  int id;
+  absl::string_view word;
+
+  ASSERT_TRUE(vocab.LookupId("a", &id));
+  EXPECT_EQ(id, 2);
+  ASSERT_TRUE(vocab.LookupId("##b", &id));
+  EXPECT_EQ(id, 1);
+  EXPECT_FALSE(vocab.LookupId("b", &id));
+  EXPECT_FALSE(vocab.LookupId("", &id));
+  ASSERT_TRUE(vocab.LookupWord(1, &word));
+  EXPECT_EQ(word, "##b");
+  EXPECT_FALSE(vocab.LookupWord(3, &word));
+  EXPECT_EQ(vocab.VocabularySize(), 3);
+}
+
+TEST(TrieBackedWordpieceTest, MatchesWordpieceTokenize) {
+  const std::vector<std::string> vocab_entries =
+      LoadVocabFromFile(kTestVocabPath);
+  FlatHashMapBackedWordpiece hash_map_vocab(vocab_entries);
+  TrieBackedWordpiece vocab(vocab_entries, kDefaultSuffixIndicator);
+
+  for (absl::string_view word :
+       {"question", "questionansweraskask", "unaffable", "tokenization",
+        "xquestion", "##ing", "caf\xc3\xa9", "\xe4\xb8\xad\xe6\x96\x87",
+        "\xff", "zzzzzzzzzzzzzzzzzz"}) {
+    std::vector<std::string> expected_subwords;
+    Wordpieces expected;
+    int num_word_pieces;
+    tensorflow::text::WordpieceTokenize(
+        word, kDefaultMaxBytesPerToken, kDefaultMaxCharsPerSubToken,
+        kDefaultSuffixIndicator, /*use_unknown_token=*/false,
+        kDefaultUnknownToken, /*split_unknown_characters=*/false,
+        &hash_map_vocab, &expected_subwords, &expected.begin_offsets,
+        &expected.end_offsets, &num_word_pieces);
+    Wordpieces wordpieces;
+    if (!vocab.TokenizeWord(word, &wordpieces.ids, &wordpieces.begin_offsets,
+                            &wordpieces.end_offsets)) {
+      EXPECT_THAT(expected_subwords, ElementsAre(word));
+      continue;
+    }
+    std::vector<std::string> subwords;
+    for (const int id : wordpieces.ids) {
+      absl::string_view subword;
+      ASSERT_TRUE(vocab.LookupWord(id, &subword));
+      subwords.emplace_back(subword);
+    }
+    EXPECT_EQ(subwords, expected_subwords) << word;
+    EXPECT_EQ(wordpieces.begin_offsets, expected.begin_offsets) << word;
+    EXPECT_EQ(wordpieces.end_offsets, expected.end_offsets) << word;
+  }
+}
+
+TEST(TrieBackedWordpieceTest, SucceedsFromBuffer) {
+  TrieBackedWordpiece built_vocab({"question", "##ans", "##wer"}, "##");
+  const std::string buffer(built_vocab.buffer());
+
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TrieBackedWordpiece> vocab,
+                          TrieBackedWordpiece::CreateFromBuffer(buffer));
+
+  EXPECT_EQ(vocab->suffix_indicator(), "##");
+  EXPECT_EQ(vocab->VocabularySize(), 3);
+  Wordpieces wordpieces = Tokenize(*vocab, "questionanswer");
+  EXPECT_THAT(wordpieces.ids, ElementsAre(0, 1, 2));
+  EXPECT_THAT(wordpieces.end_offsets, ElementsAre(8, 11, 14));
+}
+
+TEST(TrieBackedWordpieceTest, FailsFromInvalidBuffer) {
+  TrieBackedWordpiece built_vocab({"question", "##ans", "##wer"}, "##");
+  std::string buffer(built_vocab.buffer());
+
+  auto truncated = TrieBackedWordpiece::CreateFromBuffer(
+      absl::string_view(buffer).substr(0, buffer.size() - 8));
+  EXPECT_EQ(truncated.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(truncated.status().message(), HasSubstr("truncated buffer"));
+
+  buffer[0] = 'X';
+  auto bad_magic = TrieBackedWordpiece::CreateFromBuffer(buffer);
+  EXPECT_EQ(bad_magic.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(bad_magic.status().message(), HasSubstr("bad magic"));
+}
+
+}  // namespace
+}  // namespace tokenizers
+}  // namespace text
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,89 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/deps/no_destructor.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace text {
+namespace utils {
+namespace {
+
+// The shared caches, by name and value type. Expired entries are pruned
+// whenever a cache is registered.
+struct Registry {
+  absl::Mutex mutex;
+  absl::btree_map<std::pair<std::string, std::type_index>,
+                  std::weak_ptr<TextCacheBase>>
+      caches ABSL_GUARDED_BY(mutex);
+};
+
+Registry& GetRegistry() {
+  static NoDestructor<Registry> registry;
+  return *registry;
+}
+
+}  // namespace
+
+namespace internal {
+
+std::shared_ptr<TextCacheBase> GetOrCreateSharedTextCache(
+    const std::type_info& value_type, absl::string_view name,
+    const std::function<std::shared_ptr<TextCacheBase>()>& create) {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  std::weak_ptr<TextCacheBase>& entry =
+      registry.caches[{std::string(name), std::type_index(value_type)}];
+  std::shared_ptr<TextCacheBase> cache = entry.lock();
+  if (cache != nullptr) return cache;
+  absl::erase_if(registry.caches,
+                 [](const auto& item) { return item.second.expired(); });
+  cache = create();
+  registry.caches[{std::string(name), std::type_index(value_type)}] = cache;
+  return cache;
+}
+
+}  // namespace internal
+
+std::vector<std::pair<std::string, TextCacheStats>> GetSharedTextCacheStats() {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  std::vector<std::pair<std::string, TextCacheStats>> stats;
+  for (const auto& [key, weak_cache] : registry.caches) {
+    if (std::shared_ptr<TextCacheBase> cache = weak_cache.lock()) {
+      stats.emplace_back(key.first, cache->GetStats());
+    }
+  }
+  return stats;
+}
+
+}  // namespace utils
+}  // namespace text
+}  // namespace tasks
+}  // namespace mediapipe
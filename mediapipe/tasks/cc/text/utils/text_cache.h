@@ -0,0 +1,177 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_TEXT_UTILS_TEXT_CACHE_H_
+#define MEDIAPIPE_TASKS_CC_TEXT_UTILS_TEXT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace text {
+namespace utils {
+
+// Lookup counts of a TextCache.
+struct TextCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  int64_t evictions = 0;
+
+  // The fraction of lookups which were hits, or 0 if there were none.
+  double HitRate() const {
+    const int64_t lookups = hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+  }
+};
+
+// The untyped part of a TextCache, which keeps its lookup counts.
+class TextCacheBase {
+ public:
+  explicit TextCacheBase(int max_entries) : max_entries_(max_entries) {}
+  virtual ~TextCacheBase() = default;
+
+  TextCacheBase(const TextCacheBase&) = delete;
+  TextCacheBase& operator=(const TextCacheBase&) = delete;
+
+  // The maximum number of values kept in the cache.
+  int max_entries() const { return max_entries_; }
+
+  TextCacheStats GetStats() const ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    return stats_;
+  }
+
+ protected:
+  const int max_entries_;
+  mutable absl::Mutex mutex_;
+  TextCacheStats stats_ ABSL_GUARDED_BY(mutex_);
+};
+
+// A thread-safe, bounded cache of values computed from input texts, such as
+// the token ids of a text or a model's result for it, which evicts the least
+// recently used value when full.
+//
+// Entries are keyed by the hash of their text. The text is kept as well, so a
+// hash collision is a miss rather than a wrong value.
+template <typename Value>
+class TextCache : public TextCacheBase {
+ public:
+  // Creates a cache holding up to `max_entries` values, which must be
+  // positive.
+  explicit TextCache(int max_entries) : TextCacheBase(max_entries) {}
+
+  // Returns the value cached for `text`, or nullptr if there is none.
+  std::shared_ptr<const Value> Lookup(absl::string_view text)
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    const size_t hash = absl::Hash<absl::string_view>{}(text);
+    absl::MutexLock lock(&mutex_);
+    auto it = index_.find(hash);
+    if (it == index_.end() || it->second->text != text) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->value;
+  }
+
+  // Caches `value` for `text`, replacing any value cached for it or for a
+  // text with the same hash.
+  void Insert(absl::string_view text, std::shared_ptr<const Value> value)
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    const size_t hash = absl::Hash<absl::string_view>{}(text);
+    absl::MutexLock lock(&mutex_);
+    auto it = index_.find(hash);
+    if (it != index_.end()) {
+      it->second->text = std::string(text);
+      it->second->value = std::move(value);
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    if (entries_.size() >= static_cast<size_t>(max_entries_)) {
+      index_.erase(entries_.back().hash);
+      entries_.pop_back();
+      ++stats_.evictions;
+    }
+    entries_.push_front({hash, std::string(text), std::move(value)});
+    index_[hash] = entries_.begin();
+  }
+
+  // The number of values currently cached.
+  int size() const ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    size_t hash;
+    std::string text;
+    std::shared_ptr<const Value> value;
+  };
+
+  // Most recently used first.
+  std::list<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<size_t, typename std::list<Entry>::iterator> index_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+namespace internal {
+
+// Returns the live cache of values of type `value_type` registered under
+// `name`, or registers and returns the one made by `create`.
+std::shared_ptr<TextCacheBase> GetOrCreateSharedTextCache(
+    const std::type_info& value_type, absl::string_view name,
+    const std::function<std::shared_ptr<TextCacheBase>()>& create);
+
+}  // namespace internal
+
+// Returns the cache of `Value`s named `name`, creating it with room for
+// `max_entries` values if no such cache is alive. Task instances using the
+// same model and options should use the same name, so that they share the
+// cache; the cache is destroyed with its last user.
+template <typename Value>
+std::shared_ptr<TextCache<Value>> GetSharedTextCache(absl::string_view name,
+                                                     int max_entries) {
+  return std::static_pointer_cast<TextCache<Value>>(
+      internal::GetOrCreateSharedTextCache(
+          typeid(Value), name, [max_entries]() {
+            return std::make_shared<TextCache<Value>>(max_entries);
+          }));
+}
+
+// Returns the name and lookup counts of each live shared cache.
+std::vector<std::pair<std::string, TextCacheStats>> GetSharedTextCacheStats();
+
+}  // namespace utils
+}  // namespace text
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_TEXT_UTILS_TEXT_CACHE_H_
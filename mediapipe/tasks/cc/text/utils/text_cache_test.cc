@@ -0,0 +1,119 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/text/utils/text_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe::tasks::text::utils {
+namespace {
+
+using ::testing::Contains;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Key;
+using ::testing::Not;
+using ::testing::Pair;
+using ::testing::Pointee;
+
+TEST(TextCacheTest, ReturnsInsertedValues) {
+  TextCache<std::vector<int>> cache(/*max_entries=*/2);
+
+  EXPECT_EQ(cache.Lookup("hello"), nullptr);
+  cache.Insert("hello", std::make_shared<std::vector<int>>(
+                            std::vector<int>{1, 2, 3}));
+
+  EXPECT_THAT(cache.Lookup("hello"), Pointee(ElementsAre(1, 2, 3)));
+  EXPECT_EQ(cache.Lookup("world"), nullptr);
+  const TextCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.evictions, 0);
+  EXPECT_DOUBLE_EQ(stats.HitRate(), 1.0 / 3);
+}
+
+TEST(TextCacheTest, ReplacesValues) {
+  TextCache<int> cache(/*max_entries=*/2);
+
+  cache.Insert("a", std::make_shared<int>(1));
+  cache.Insert("a", std::make_shared<int>(2));
+
+  EXPECT_THAT(cache.Lookup("a"), Pointee(2));
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(TextCacheTest, EvictsLeastRecentlyUsedValue) {
+  TextCache<int> cache(/*max_entries=*/2);
+
+  cache.Insert("a", std::make_shared<int>(1));
+  cache.Insert("b", std::make_shared<int>(2));
+  EXPECT_NE(cache.Lookup("a"), nullptr);
+  cache.Insert("c", std::make_shared<int>(3));
+
+  EXPECT_THAT(cache.Lookup("a"), Pointee(1));
+  EXPECT_EQ(cache.Lookup("b"), nullptr);
+  EXPECT_THAT(cache.Lookup("c"), Pointee(3));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.GetStats().evictions, 1);
+}
+
+TEST(TextCacheTest, KeepsEvictedValuesAliveForTheirUsers) {
+  TextCache<std::string> cache(/*max_entries=*/1);
+
+  cache.Insert("a", std::make_shared<std::string>("first"));
+  std::shared_ptr<const std::string> value = cache.Lookup("a");
+  cache.Insert("b", std::make_shared<std::string>("second"));
+
+  EXPECT_EQ(cache.Lookup("a"), nullptr);
+  EXPECT_THAT(value, Pointee(std::string("first")));
+}
+
+TEST(SharedTextCacheTest, SharesCachesByNameAndValueType) {
+  auto cache = GetSharedTextCache<int>("shared", /*max_entries=*/4);
+  auto same_cache = GetSharedTextCache<int>("shared", /*max_entries=*/8);
+  auto other_name = GetSharedTextCache<int>("other", /*max_entries=*/4);
+  auto other_type = GetSharedTextCache<float>("shared", /*max_entries=*/4);
+
+  cache->Insert("a", std::make_shared<int>(1));
+
+  EXPECT_EQ(same_cache, cache);
+  EXPECT_EQ(same_cache->max_entries(), 4);
+  EXPECT_EQ(other_name->Lookup("a"), nullptr);
+  EXPECT_EQ(other_type->Lookup("a"), nullptr);
+  EXPECT_THAT(same_cache->Lookup("a"), Pointee(1));
+}
+
+TEST(SharedTextCacheTest, DestroysCachesWithTheirLastUser) {
+  auto cache = GetSharedTextCache<int>("short_lived", /*max_entries=*/4);
+  cache->Insert("a", std::make_shared<int>(1));
+  EXPECT_NE(cache->Lookup("a"), nullptr);
+
+  EXPECT_THAT(GetSharedTextCacheStats(),
+              Contains(Pair("short_lived", Field(&TextCacheStats::hits, 1))));
+  cache.reset();
+  cache = GetSharedTextCache<int>("short_lived", /*max_entries=*/4);
+
+  EXPECT_EQ(cache->Lookup("a"), nullptr);
+  cache.reset();
+  EXPECT_THAT(GetSharedTextCacheStats(), Not(Contains(Key("short_lived"))));
+}
+
+}  // namespace
+}  // namespace mediapipe::tasks::text::utils
@@ -34,6 +34,7 @@ limitations under the License.
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
@@ -138,57 +139,80 @@ Image ProcessForCategoryMaskCpu(const Shape& input_shape,
       ImageFormat::GRAY8, output_shape.width, output_shape.height, 1);
   Image category_mask(image_frame_ptr);
 
-  // Fill in the maximum category in the category mask image.
+  // Interpolation taps only depend on the output column, so they are computed
+  // once and shared by every row.
+  struct Tap {
+    int i0;
+    int i1;
+    float t;
+  };
+  std::vector<Tap> x_taps(output_shape.width);
+  for (int x = 0; x < output_shape.width; ++x) {
+    const int x0 = static_cast<int>(std::max(std::floor(x * width_scale), 0.f));
+    const int x1 = static_cast<int>(
+        std::min(std::ceil(x * width_scale), input_shape.width - 1.f));
+    const float t = std::max(std::min(x * width_scale - x0, 1.f), 0.f);
+    x_taps[x] = {x0, x1, t};
+  }
+
+  // Fill in the maximum category in the category mask image. Rows are
+  // processed in parallel, each worker reusing a single scratch buffer for
+  // the per-pixel confidence scores.
   cv::Mat category_mask_mat_view =
       mediapipe::formats::MatView(image_frame_ptr.get());
   const int input_channels = input_shape.channels;
-  category_mask_mat_view.forEach<uint8_t>([&tensors_buffer, &input_shape,
-                                           &width_scale, &height_scale,
-                                           &input_channels,
-                                           &options](uint8_t& pixel,
-                                                     const int position[]) {
-    std::vector<float> confidence_scores(input_channels);
-    int y0 =
-        static_cast<int>(std::max(std::floor(position[0] * height_scale), 0.f));
-    int x0 =
-        static_cast<int>(std::max(std::floor(position[1] * width_scale), 0.f));
-    int y1 = static_cast<int>(std::min(std::ceil(position[0] * height_scale),
-                                       input_shape.height - 1.f));
-    int x1 = static_cast<int>(std::min(std::ceil(position[1] * width_scale),
-                                       input_shape.width - 1.f));
-    float t0 = std::max(std::min(position[0] * height_scale - y0, 1.f), 0.f);
-    float t1 = std::max(std::min(position[1] * width_scale - x0, 1.f), 0.f);
-    for (int i = 0; i < input_channels; ++i) {
-      confidence_scores[i] = BilinearInterpolate(
-          GetTensorElement(input_shape, tensors_buffer, x0, y0, i),
-          GetTensorElement(input_shape, tensors_buffer, x0, y1, i),
-          GetTensorElement(input_shape, tensors_buffer, x1, y0, i),
-          GetTensorElement(input_shape, tensors_buffer, x1, y1, i), t0, t1);
-    }
-    absl::Span<float> confidence_scores_span(confidence_scores.data(),
-                                             confidence_scores.size());
-
-    // Only process the activation function if it is SIGMOID. If NONE,
-    // we do nothing for activation, If SOFTMAX, it is required
-    // to have input_channels > 1, and for input_channels > 1, we don't need
-    // activation to find the maximum value.
-    if (options.activation() == SegmenterOptions::SIGMOID) {
-      Sigmoid(confidence_scores_span, confidence_scores_span);
-    }
-    if (input_channels == 1) {
-      // if the input tensor is a single mask, it is assumed to be a binary
-      // foreground segmentation mask. For such a mask, instead of a true
-      // argmax, we simply use 0.5 as the cutoff, assigning 0 (foreground) or
-      // 255 (background) based on whether the confidence value reaches this
-      // cutoff or not, respectively.
-      pixel = confidence_scores[0] > 0.5f ? 0 : kUnLabeledPixelValue;
-    } else {
-      const int maximum_category_idx =
-          std::max_element(confidence_scores.begin(), confidence_scores.end()) -
-          confidence_scores.begin();
-      pixel = maximum_category_idx;
-    }
-  });
+  const bool apply_sigmoid =
+      options.activation() == SegmenterOptions::SIGMOID;
+  cv::parallel_for_(
+      cv::Range(0, output_shape.height), [&](const cv::Range& range) {
+        std::vector<float> confidence_scores(input_channels);
+        absl::Span<float> confidence_scores_span(confidence_scores.data(),
+                                                 confidence_scores.size());
+        for (int y = range.start; y < range.end; ++y) {
+          const int y0 =
+              static_cast<int>(std::max(std::floor(y * height_scale), 0.f));
+          const int y1 = static_cast<int>(
+              std::min(std::ceil(y * height_scale), input_shape.height - 1.f));
+          const float t0 =
+              std::max(std::min(y * height_scale - y0, 1.f), 0.f);
+          uint8_t* row = category_mask_mat_view.ptr<uint8_t>(y);
+          for (int x = 0; x < output_shape.width; ++x) {
+            const Tap& x_tap = x_taps[x];
+            for (int i = 0; i < input_channels; ++i) {
+              confidence_scores[i] = BilinearInterpolate(
+                  GetTensorElement(input_shape, tensors_buffer, x_tap.i0, y0,
+                                   i),
+                  GetTensorElement(input_shape, tensors_buffer, x_tap.i0, y1,
+                                   i),
+                  GetTensorElement(input_shape, tensors_buffer, x_tap.i1, y0,
+                                   i),
+                  GetTensorElement(input_shape, tensors_buffer, x_tap.i1, y1,
+                                   i),
+                  t0, x_tap.t);
+            }
+
+            // Only process the activation function if it is SIGMOID. If NONE,
+            // we do nothing for activation, If SOFTMAX, it is required
+            // to have input_channels > 1, and for input_channels > 1, we don't
+            // need activation to find the maximum value.
+            if (apply_sigmoid) {
+              Sigmoid(confidence_scores_span, confidence_scores_span);
+            }
+            if (input_channels == 1) {
+              // if the input tensor is a single mask, it is assumed to be a
+              // binary foreground segmentation mask. For such a mask, instead
+              // of a true argmax, we simply use 0.5 as the cutoff, assigning 0
+              // (foreground) or 255 (background) based on whether the
+              // confidence value reaches this cutoff or not, respectively.
+              row[x] = confidence_scores[0] > 0.5f ? 0 : kUnLabeledPixelValue;
+            } else {
+              row[x] = std::max_element(confidence_scores.begin(),
+                                        confidence_scores.end()) -
+                       confidence_scores.begin();
+            }
+          }
+        }
+      });
   return category_mask;
 }
 
@@ -255,38 +279,44 @@ std::vector<Image> ProcessForConfidenceMaskCpu(
     confidence_masks.back().GetImageFrameSharedPtr()->SetToZero();
   }
 
-  // Apply activation function and write output streams.
+  // Apply activation function and write output streams. Tensor elements are
+  // independent, so they are processed in parallel, each worker reusing its
+  // own activation scratch buffer.
   const int tensor_size = input_shape.height * input_shape.width;
-  std::vector<float> activated_values(input_shape.channels);
-  absl::Span<float> activated_values_span(activated_values);
-  for (int i = 0; i < tensor_size; ++i) {
-    activation_fn(absl::MakeConstSpan(&tensors_buffer[i * input_shape.channels],
-                                      input_shape.channels),
-                  activated_values_span);
-
-    for (int j = 0; j < output_channels.size(); ++j) {
-      float value = activated_values[output_channels[j]];
-      if (use_uint8) {
-        uint8_t int_value = static_cast<uint8_t>(
-            std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
-        if (pack4) {
-          confidence_mask_mats[j / 4].ptr<uint8_t>(
-              i / input_shape.width, i % input_shape.width)[j & 3] = int_value;
-        } else {
-          confidence_mask_mats[j].at<uint8_t>(
-              i / input_shape.width, i % input_shape.width) = int_value;
-        }
-      } else {
-        if (pack4) {
-          confidence_mask_mats[j / 4].ptr<float>(
-              i / input_shape.width, i % input_shape.width)[j & 3] = value;
+  cv::parallel_for_(cv::Range(0, tensor_size), [&](const cv::Range& range) {
+    std::vector<float> activated_values(input_shape.channels);
+    absl::Span<float> activated_values_span(activated_values);
+    for (int i = range.start; i < range.end; ++i) {
+      activation_fn(
+          absl::MakeConstSpan(&tensors_buffer[i * input_shape.channels],
+                              input_shape.channels),
+          activated_values_span);
+
+      for (int j = 0; j < output_channels.size(); ++j) {
+        float value = activated_values[output_channels[j]];
+        if (use_uint8) {
+          uint8_t int_value = static_cast<uint8_t>(
+              std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+          if (pack4) {
+            confidence_mask_mats[j / 4].ptr<uint8_t>(
+                i / input_shape.width, i % input_shape.width)[j & 3] =
+                int_value;
+          } else {
+            confidence_mask_mats[j].at<uint8_t>(
+                i / input_shape.width, i % input_shape.width) = int_value;
+          }
         } else {
-          confidence_mask_mats[j].at<float>(i / input_shape.width,
-                                            i % input_shape.width) = value;
+          if (pack4) {
+            confidence_mask_mats[j / 4].ptr<float>(
+                i / input_shape.width, i % input_shape.width)[j & 3] = value;
+          } else {
+            confidence_mask_mats[j].at<float>(i / input_shape.width,
+                                              i % input_shape.width) = value;
+          }
         }
       }
     }
-  }
+  });
 
   if (output_shape.height == input_shape.height &&
       output_shape.width == input_shape.width) {
@@ -14,6 +14,7 @@
 
 #include "mediapipe/util/frame_buffer/frame_buffer_util.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -253,6 +254,29 @@ absl::Status ValidateFloatTensorInputs(const FrameBuffer& buffer,
   return absl::OkStatus();
 }
 
+absl::Status ValidateWarpAffineInputs(const FrameBuffer& buffer,
+                                      int output_channels) {
+  if (IsSupportedYuvBuffer(buffer)) {
+    return output_channels == kRgbChannels || output_channels == kRgbaChannels
+               ? absl::OkStatus()
+               : absl::InvalidArgumentError(absl::StrFormat(
+                     "Affine warp can't produce %i channels from YUV input.",
+                     output_channels));
+  }
+  if (buffer.format() != FrameBuffer::Format::kRGB &&
+      buffer.format() != FrameBuffer::Format::kRGBA) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Affine warp does not support format: %i.", buffer.format()));
+  }
+  ABSL_ASSIGN_OR_RETURN(int channels, NumberOfChannels(buffer));
+  if (output_channels > channels) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Affine warp can't produce %i channels from %i input channels.",
+        output_channels, channels));
+  }
+  return absl::OkStatus();
+}
+
 // Construct buffer helper functions.
 //------------------------------------------------------------------------------
 
@@ -430,6 +454,33 @@ absl::Status ToFloatTensorRgb(const FrameBuffer& buffer, float scale,
              : absl::UnknownError("Halide rgb[a] to float conversion failed.");
 }
 
+absl::Status WarpAffineRgb(const FrameBuffer& buffer,
+                           const std::array<float, 6>& matrix,
+                           bool zero_border, FrameBuffer* output_buffer) {
+  ABSL_ASSIGN_OR_RETURN(auto input, CreateRgbBuffer(buffer));
+  ABSL_ASSIGN_OR_RETURN(auto output, CreateRgbBuffer(*output_buffer));
+  return input.WarpAffine(matrix.data(), zero_border, &output)
+             ? absl::OkStatus()
+             : absl::UnknownError("Halide rgb[a] affine warp failed.");
+}
+
+absl::Status WarpAffineToFloatTensorRgb(const FrameBuffer& buffer,
+                                        const std::array<float, 6>& matrix,
+                                        bool zero_border, float scale,
+                                        float offset, Tensor& tensor) {
+  ABSL_ASSIGN_OR_RETURN(auto input, CreateRgbBuffer(buffer));
+  const auto& shape = tensor.shape();
+  auto view = tensor.GetCpuWriteView();
+  float* data = view.buffer<float>();
+  FloatBuffer output(data, /*width=*/shape.dims[2], /*height=*/shape.dims[1],
+                     /*channels=*/shape.dims[3]);
+  return input.WarpAffineToFloat(matrix.data(), zero_border, scale, offset,
+                                 &output)
+             ? absl::OkStatus()
+             : absl::UnknownError(
+                   "Halide rgb[a] affine warp to float conversion failed.");
+}
+
 // Yuv transformation functions.
 //------------------------------------------------------------------------------
 
@@ -465,6 +516,33 @@ absl::Status RotateYuv(const FrameBuffer& buffer, int angle_deg,
              : absl::UnknownError("Halide YUV rotate operation failed.");
 }
 
+absl::Status WarpAffineYuv(const FrameBuffer& buffer,
+                           const std::array<float, 6>& matrix,
+                           bool zero_border, FrameBuffer* output_buffer) {
+  ABSL_ASSIGN_OR_RETURN(auto input, CreateYuvBuffer(buffer));
+  ABSL_ASSIGN_OR_RETURN(auto output, CreateRgbBuffer(*output_buffer));
+  return input.WarpAffine(matrix.data(), zero_border, &output)
+             ? absl::OkStatus()
+             : absl::UnknownError("Halide YUV affine warp failed.");
+}
+
+absl::Status WarpAffineToFloatTensorYuv(const FrameBuffer& buffer,
+                                        const std::array<float, 6>& matrix,
+                                        bool zero_border, float scale,
+                                        float offset, Tensor& tensor) {
+  ABSL_ASSIGN_OR_RETURN(auto input, CreateYuvBuffer(buffer));
+  const auto& shape = tensor.shape();
+  auto view = tensor.GetCpuWriteView();
+  float* data = view.buffer<float>();
+  FloatBuffer output(data, /*width=*/shape.dims[2], /*height=*/shape.dims[1],
+                     /*channels=*/shape.dims[3]);
+  return input.WarpAffineToFloat(matrix.data(), zero_border, scale, offset,
+                                 &output)
+             ? absl::OkStatus()
+             : absl::UnknownError(
+                   "Halide YUV affine warp to float conversion failed.");
+}
+
 absl::Status FlipHorizontallyYuv(const FrameBuffer& buffer,
                                  FrameBuffer* output_buffer) {
   ABSL_ASSIGN_OR_RETURN(auto input, CreateYuvBuffer(buffer));
@@ -779,6 +857,44 @@ absl::Status ToFloatTensor(const FrameBuffer& buffer, float scale, float offset,
   }
 }
 
+absl::Status WarpAffine(const FrameBuffer& buffer,
+                        const std::array<float, 6>& matrix, bool zero_border,
+                        FrameBuffer* output_buffer) {
+  ABSL_ASSIGN_OR_RETURN(int output_channels, NumberOfChannels(*output_buffer));
+  ABSL_RETURN_IF_ERROR(ValidateWarpAffineInputs(buffer, output_channels));
+  if (output_buffer->format() != FrameBuffer::Format::kRGB &&
+      output_buffer->format() != FrameBuffer::Format::kRGBA) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Affine warp does not support output format: %i.",
+                        output_buffer->format()));
+  }
+  if (IsSupportedYuvBuffer(buffer)) {
+    return WarpAffineYuv(buffer, matrix, zero_border, output_buffer);
+  }
+  return WarpAffineRgb(buffer, matrix, zero_border, output_buffer);
+}
+
+absl::Status WarpAffineToFloatTensor(const FrameBuffer& buffer,
+                                     const std::array<float, 6>& matrix,
+                                     bool zero_border, float scale,
+                                     float offset, Tensor& tensor) {
+  if (tensor.element_type() != Tensor::ElementType::kFloat32) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Tensor type %i is not supported.", tensor.element_type()));
+  }
+  const auto& shape = tensor.shape();
+  if (shape.dims.size() != 4 || shape.dims[0] != 1) {
+    return absl::InvalidArgumentError("Expected tensor with batch size of 1.");
+  }
+  ABSL_RETURN_IF_ERROR(ValidateWarpAffineInputs(buffer, shape.dims[3]));
+  if (IsSupportedYuvBuffer(buffer)) {
+    return WarpAffineToFloatTensorYuv(buffer, matrix, zero_border, scale,
+                                      offset, tensor);
+  }
+  return WarpAffineToFloatTensorRgb(buffer, matrix, zero_border, scale, offset,
+                                    tensor);
+}
+
 int GetFrameBufferByteSize(FrameBuffer::Dimension dimension,
                            FrameBuffer::Format format) {
   switch (format) {
@@ -15,6 +15,7 @@
 #ifndef MEDIAPIPE_UTIL_FRAME_BUFFER_FRAME_BUFFER_UTIL_H_
 #define MEDIAPIPE_UTIL_FRAME_BUFFER_FRAME_BUFFER_UTIL_H_
 
+#include <array>
 #include <cstdint>
 #include <memory>
 
@@ -107,6 +108,29 @@ absl::Status Convert(const FrameBuffer& buffer, FrameBuffer* output_buffer);
 absl::Status ToFloatTensor(const FrameBuffer& buffer, float scale, float offset,
                            Tensor& tensor);
 
+// Samples `buffer` through an affine transform into `output_buffer` using
+// bilinear interpolation. `matrix` is a row-major 2x3 matrix mapping output
+// pixel coordinates to `buffer` pixel coordinates, so that a rotated crop and
+// resize can be performed in a single pass. Pixels sampled outside of `buffer`
+// read as zero if `zero_border` is true, otherwise the nearest edge pixel is
+// replicated.
+//
+// RGB/RGBA and YUV (NV12/NV21/YV12/YV21) inputs are supported. YUV inputs are
+// sampled directly, so color conversion only happens for the output pixels.
+// The output must be RGB/RGBA and, for RGB/RGBA inputs, can't have more
+// channels than the input.
+absl::Status WarpAffine(const FrameBuffer& buffer,
+                        const std::array<float, 6>& matrix, bool zero_border,
+                        FrameBuffer* output_buffer);
+
+// Same as `WarpAffine`, but writes into the provided float Tensor of shape
+// [1, height, width, channels], converting each value using:
+//   output = input * scale + offset
+absl::Status WarpAffineToFloatTensor(const FrameBuffer& buffer,
+                                     const std::array<float, 6>& matrix,
+                                     bool zero_border, float scale,
+                                     float offset, Tensor& tensor);
+
 // Miscellaneous Methods
 // -----------------------------------------------------------------
 
@@ -14,6 +14,8 @@
 
 #include "mediapipe/util/frame_buffer/frame_buffer_util.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -543,6 +545,50 @@ TEST(FrameBufferUtil, RgbToFloatTensor) {
   EXPECT_EQ(output_data[5], 0.7f);
 }
 
+TEST(FrameBufferUtil, RgbWarpAffineRotates90Degrees) {
+  constexpr FrameBuffer::Dimension kBufferDimension = {.width = 2, .height = 1},
+                                   kOutputDimension = {.width = 1, .height = 2};
+  uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  uint8_t output_data[6];
+  auto input = CreateFromRgbRawBuffer(data, kBufferDimension);
+  auto output = CreateFromRgbRawBuffer(output_data, kOutputDimension);
+  // Output (x, y) samples input (y, x).
+  constexpr std::array<float, 6> kMatrix = {0.0f, 1.0f, 0.0f,
+                                            1.0f, 0.0f, 0.0f};
+
+  MP_ASSERT_OK(WarpAffine(*input, kMatrix, /*zero_border=*/false,
+                          output.get()));
+  EXPECT_EQ(output_data[0], 1);
+  EXPECT_EQ(output_data[1], 2);
+  EXPECT_EQ(output_data[2], 3);
+  EXPECT_EQ(output_data[3], 4);
+  EXPECT_EQ(output_data[4], 5);
+  EXPECT_EQ(output_data[5], 6);
+}
+
+TEST(FrameBufferUtil, RgbaWarpAffineToFloatTensorWithZeroBorder) {
+  constexpr FrameBuffer::Dimension kBufferDimension = {.width = 1, .height = 1};
+  constexpr float kScale = 0.5f, kOffset = 1.0f;
+  uint8_t data[] = {2, 4, 6, 8};
+  auto input = CreateFromRgbaRawBuffer(data, kBufferDimension);
+  Tensor output(Tensor::ElementType::kFloat32, Tensor::Shape{1, 1, 2, 3});
+  // Output x=0 samples the only input pixel, x=1 falls outside the image.
+  constexpr std::array<float, 6> kMatrix = {1.0f, 0.0f, 0.0f,
+                                            0.0f, 1.0f, 0.0f};
+
+  MP_ASSERT_OK(WarpAffineToFloatTensor(*input, kMatrix, /*zero_border=*/true,
+                                       kScale, kOffset, output));
+
+  auto view = output.GetCpuReadView();
+  const float* output_data = view.buffer<float>();
+  EXPECT_EQ(output_data[0], 2.0f);
+  EXPECT_EQ(output_data[1], 3.0f);
+  EXPECT_EQ(output_data[2], 4.0f);
+  EXPECT_EQ(output_data[3], 1.0f);
+  EXPECT_EQ(output_data[4], 1.0f);
+  EXPECT_EQ(output_data[5], 1.0f);
+}
+
 TEST(FrameBufferUtil, RgbaCrop) {
   constexpr FrameBuffer::Dimension kBufferDimension = {.width = 3, .height = 2},
                                    kOutputDimension = {.width = 1, .height = 1};
@@ -1062,6 +1108,65 @@ TEST(FrameBufferUtil, NV21ConvertRgb) {
   EXPECT_EQ(output->plane(0).buffer()[1], 122);
 }
 
+TEST(FrameBufferUtil, NV21WarpAffineToFloatTensor) {
+  constexpr FrameBuffer::Dimension kBufferDimension = {.width = 32,
+                                                       .height = 8};
+  constexpr int kBlocksX = kBufferDimension.width / 2;
+  constexpr int kBlocksY = kBufferDimension.height / 2;
+  const int kInputSize =
+      GetFrameBufferByteSize(kBufferDimension, FrameBuffer::Format::kNV21);
+  // Every 2x2 block gets its own luma and chroma so that misplaced chroma
+  // samples show up in the output.
+  std::vector<uint8_t> input_data(kInputSize);
+  uint8_t* vu_data = input_data.data() + kBufferDimension.Size();
+  for (int by = 0; by < kBlocksY; ++by) {
+    for (int bx = 0; bx < kBlocksX; ++bx) {
+      const int block = by * kBlocksX + bx;
+      for (int y = 2 * by; y < 2 * by + 2; ++y) {
+        for (int x = 2 * bx; x < 2 * bx + 2; ++x) {
+          input_data[y * kBufferDimension.width + x] = 40 + 2 * block;
+        }
+      }
+      vu_data[by * kBufferDimension.width + 2 * bx] = 190 - 2 * block;
+      vu_data[by * kBufferDimension.width + 2 * bx + 1] = 64 + 2 * block;
+    }
+  }
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto input, CreateFromRawBuffer(input_data.data(), kBufferDimension,
+                                      FrameBuffer::Format::kNV21));
+  // Reference: the full-frame RGB conversion.
+  std::vector<uint8_t> rgb_data(kBufferDimension.Size() * 3);
+  auto rgb = CreateFromRgbRawBuffer(rgb_data.data(), kBufferDimension);
+  MP_ASSERT_OK(Convert(*input, rgb.get()));
+  // Samples the center of each 2x2 block, where both the luma and the chroma
+  // samples are exact. The last output column falls outside of the input.
+  Tensor output(Tensor::ElementType::kFloat32,
+                Tensor::Shape{1, kBlocksY, kBlocksX + 1, 3});
+  constexpr std::array<float, 6> kMatrix = {2.0f, 0.0f, 0.5f,
+                                            0.0f, 2.0f, 0.5f};
+
+  MP_ASSERT_OK(WarpAffineToFloatTensor(*input, kMatrix, /*zero_border=*/true,
+                                       /*scale=*/1.0f, /*offset=*/0.0f,
+                                       output));
+
+  auto view = output.GetCpuReadView();
+  const float* output_data = view.buffer<float>();
+  for (int by = 0; by < kBlocksY; ++by) {
+    for (int bx = 0; bx <= kBlocksX; ++bx) {
+      const float* pixel = output_data + (by * (kBlocksX + 1) + bx) * 3;
+      for (int c = 0; c < 3; ++c) {
+        const float expected =
+            bx < kBlocksX
+                ? rgb_data[(2 * by * kBufferDimension.width + 2 * bx) * 3 + c]
+                : 0.0f;
+        // The reference conversion rounds to integers.
+        EXPECT_NEAR(pixel[c], expected, 1.0f)
+            << "block (" << bx << ", " << by << ") channel " << c;
+      }
+    }
+  }
+}
+
 TEST(FrameBufferUtil, NV21ConvertHalfRgb) {
   constexpr FrameBuffer::Dimension kBufferDimension = {.width = 64,
                                                        .height = 16},
@@ -69,6 +69,49 @@ void resize_bilinear_int(Halide::Func input, Halide::Func result,
   result(x, y, _) = lerp(y0, y1, yr);
 }
 
+void warp_affine_bilinear(Halide::Func input, Halide::Func result,
+                          Halide::Expr m00, Halide::Expr m01, Halide::Expr m02,
+                          Halide::Expr m10, Halide::Expr m11,
+                          Halide::Expr m12) {
+  Halide::Var x{"x"}, y{"y"};
+  Halide::Expr src_x = m00 * x + m01 * y + m02;
+  Halide::Expr src_y = m10 * x + m11 * y + m12;
+
+  Halide::Expr xi = Halide::cast<int>(Halide::floor(src_x));
+  Halide::Expr yi = Halide::cast<int>(Halide::floor(src_y));
+  Halide::Expr xr = src_x - xi;
+  Halide::Expr yr = src_y - yi;
+
+  Halide::Expr p00 = Halide::cast<float>(input(xi + 0, yi + 0, _));
+  Halide::Expr p10 = Halide::cast<float>(input(xi + 1, yi + 0, _));
+  Halide::Expr p01 = Halide::cast<float>(input(xi + 0, yi + 1, _));
+  Halide::Expr p11 = Halide::cast<float>(input(xi + 1, yi + 1, _));
+  result(x, y, _) = lerp(lerp(p00, p10, xr), lerp(p01, p11, xr), yr);
+}
+
+void yuv_warp_affine_rgb(Halide::Func y_plane, Halide::Func uv_plane,
+                         Halide::Func result, Halide::Expr m00,
+                         Halide::Expr m01, Halide::Expr m02, Halide::Expr m10,
+                         Halide::Expr m11, Halide::Expr m12) {
+  Halide::Var x{"x"}, y{"y"}, c{"c"};
+  Halide::Func y_warped("y_warped"), uv_warped("uv_warped");
+  warp_affine_bilinear(y_plane, y_warped, m00, m01, m02, m10, m11, m12);
+  // Chroma samples are centered between each 2x2 block of luma samples.
+  warp_affine_bilinear(uv_plane, uv_warped, 0.5f * m00, 0.5f * m01,
+                       0.5f * m02 - 0.25f, 0.5f * m10, 0.5f * m11,
+                       0.5f * m12 - 0.25f);
+
+  // Full-range JFIF YUV-RGB coefficients, matching yuv_rgb_generator.
+  Halide::Expr luma = y_warped(x, y);
+  Halide::Expr u = uv_warped(x, y, 1) - 128.0f;
+  Halide::Expr v = uv_warped(x, y, 0) - 128.0f;
+  Halide::Expr r = luma + 1.40200f * v;
+  Halide::Expr g = luma - 0.34414f * u - 0.71414f * v;
+  Halide::Expr b = luma + 1.77200f * u;
+  result(x, y, c) = Halide::clamp(
+      select(c == 0, r, c == 1, g, c == 2, b, 255.0f), 0.0f, 255.0f);
+}
+
 void rotate(Halide::Func input, Halide::Func result, Halide::Expr width,
             Halide::Expr height, Halide::Expr angle) {
   Halide::Var x{"x"}, y{"y"};
@@ -48,6 +48,26 @@ void resize_bilinear(Halide::Func input, Halide::Func result, Halide::Expr fx,
 void resize_bilinear_int(Halide::Func input, Halide::Func result,
                          Halide::Expr fx, Halide::Expr fy);
 
+// Affine warp with bilinear interpolation. Each output pixel (x, y) samples
+// the input at:
+//   (m00 * x + m01 * y + m02, m10 * x + m11 * y + m12)
+// The result is of type float; callers are expected to apply any boundary
+// condition to `input` beforehand.
+void warp_affine_bilinear(Halide::Func input, Halide::Func result,
+                          Halide::Expr m00, Halide::Expr m01, Halide::Expr m02,
+                          Halide::Expr m10, Halide::Expr m11,
+                          Halide::Expr m12);
+
+// Affine warp of a YUV 4:2:0 image straight into RGB(A), in float values
+// clamped to [0, 255]. `y_plane` is indexed by (x, y) and `uv_plane` by
+// (x, y, c) at half resolution, with c == 0 for V and c == 1 for U. The matrix
+// maps output pixels to Y plane coordinates as in warp_affine_bilinear; color
+// conversion is only performed for the sampled output pixels.
+void yuv_warp_affine_rgb(Halide::Func y_plane, Halide::Func uv_plane,
+                         Halide::Func result, Halide::Expr m00,
+                         Halide::Expr m01, Halide::Expr m02, Halide::Expr m10,
+                         Halide::Expr m11, Halide::Expr m12);
+
 // Note: width and height are the source image dimensions; angle must be one
 // of [0, 90, 180, 270] or the result is undefined.
 void rotate(Halide::Func input, Halide::Func result, Halide::Expr width,
@@ -0,0 +1,97 @@
+// Copyright 2023 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Halide.h"
+#include "mediapipe/util/frame_buffer/halide/common.h"
+
+namespace {
+
+using ::Halide::BoundaryConditions::constant_exterior;
+using ::Halide::BoundaryConditions::repeat_edge;
+using ::mediapipe::frame_buffer::halide::common::warp_affine_bilinear;
+
+// Samples an RGB/RGBA image through an affine transform (e.g. a rotated
+// region of interest) into an RGB/RGBA image.
+class RgbAffine : public Halide::Generator<RgbAffine> {
+ public:
+  Var x{"x"}, y{"y"}, c{"c"};
+
+  Input<Buffer<uint8_t, 3>> src_rgb{"src_rgb"};
+  // Row-major 2x3 matrix mapping output pixels to source pixels.
+  Input<float> m00{"m00"};
+  Input<float> m01{"m01"};
+  Input<float> m02{"m02"};
+  Input<float> m10{"m10"};
+  Input<float> m11{"m11"};
+  Input<float> m12{"m12"};
+  // If true, pixels outside of the source image read as zero; otherwise the
+  // nearest edge pixel is replicated.
+  Input<bool> zero_border{"zero_border"};
+
+  Output<Func> dst_rgb{"dst_rgb", UInt(8), 3};
+
+  void generate();
+  void schedule();
+};
+
+void RgbAffine::generate() {
+  Halide::Func zero = constant_exterior(src_rgb, 0);
+  Halide::Func replicate = repeat_edge(src_rgb);
+  Halide::Func bounded("bounded");
+  bounded(x, y, c) = select(zero_border, zero(x, y, c), replicate(x, y, c));
+
+  Halide::Func warped("warped");
+  warp_affine_bilinear(bounded, warped, m00, m01, m02, m10, m11, m12);
+  dst_rgb(x, y, c) =
+      Halide::saturating_cast<uint8_t>(Halide::round(warped(x, y, c)));
+}
+
+void RgbAffine::schedule() {
+  Halide::Func dst_rgb_func = dst_rgb;
+  Halide::OutputImageParam rgb_output = dst_rgb_func.output_buffer();
+  Halide::Expr input_rgb_channels = src_rgb.dim(2).extent();
+  Halide::Expr output_rgb_channels = rgb_output.dim(2).extent();
+
+  // Rows are independent; split them across the Halide thread pool. The
+  // vectorized implementation is specialized for RGB and RGBA output on images
+  // wide enough to support it.
+  const int vector_size = natural_vector_size<float>();
+  const Expr min_width = rgb_output.dim(0).extent();
+  dst_rgb_func.reorder(c, x, y).parallel(y);
+  for (int channels : {3, 4}) {
+    dst_rgb_func
+        .specialize(output_rgb_channels == channels && min_width >= vector_size)
+        .unroll(c)
+        .vectorize(x, vector_size);
+  }
+
+  // Require that the input/output buffer be interleaved; the input row stride
+  // may be padded.
+  src_rgb.dim(0).set_stride(input_rgb_channels);
+  src_rgb.dim(2).set_stride(1);
+  rgb_output.dim(0).set_stride(output_rgb_channels);
+  rgb_output.dim(2).set_stride(1);
+
+  // RGB planes starts at index zero in every dimension.
+  src_rgb.dim(0).set_min(0);
+  src_rgb.dim(1).set_min(0);
+  src_rgb.dim(2).set_min(0);
+  rgb_output.dim(0).set_min(0);
+  rgb_output.dim(1).set_min(0);
+  rgb_output.dim(2).set_min(0);
+}
+
+}  // namespace
+
+HALIDE_REGISTER_GENERATOR(RgbAffine, rgb_affine_generator)
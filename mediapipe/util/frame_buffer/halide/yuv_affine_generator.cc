@@ -0,0 +1,104 @@
+// Copyright 2023 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Halide.h"
+#include "mediapipe/util/frame_buffer/halide/common.h"
+
+namespace {
+
+using ::Halide::BoundaryConditions::constant_exterior;
+using ::Halide::BoundaryConditions::repeat_edge;
+using ::mediapipe::frame_buffer::halide::common::yuv_warp_affine_rgb;
+
+// Samples a YUV 4:2:0 image through an affine transform (e.g. a rotated
+// region of interest) into an RGB/RGBA image, converting only the sampled
+// pixels.
+class YuvAffine : public Halide::Generator<YuvAffine> {
+ public:
+  Var x{"x"}, y{"y"}, c{"c"};
+
+  Input<Buffer<uint8_t, 2>> src_y{"src_y"};
+  Input<Buffer<uint8_t, 3>> src_uv{"src_uv"};
+  // Row-major 2x3 matrix mapping output pixels to source pixels.
+  Input<float> m00{"m00"};
+  Input<float> m01{"m01"};
+  Input<float> m02{"m02"};
+  Input<float> m10{"m10"};
+  Input<float> m11{"m11"};
+  Input<float> m12{"m12"};
+  // If true, pixels outside of the source image read as black; otherwise the
+  // nearest edge pixel is replicated.
+  Input<bool> zero_border{"zero_border"};
+
+  Output<Func> dst_rgb{"dst_rgb", UInt(8), 3};
+
+  void generate();
+  void schedule();
+};
+
+void YuvAffine::generate() {
+  Halide::Func zero_y = constant_exterior(src_y, 0);
+  Halide::Func zero_uv = constant_exterior(src_uv, 128);
+  Halide::Func replicate_y = repeat_edge(src_y);
+  Halide::Func replicate_uv = repeat_edge(src_uv);
+  Halide::Func y_bounded("y_bounded"), uv_bounded("uv_bounded");
+  y_bounded(x, y) = select(zero_border, zero_y(x, y), replicate_y(x, y));
+  uv_bounded(x, y, c) =
+      select(zero_border, zero_uv(x, y, c), replicate_uv(x, y, c));
+
+  Halide::Func rgb("rgb");
+  yuv_warp_affine_rgb(y_bounded, uv_bounded, rgb, m00, m01, m02, m10, m11,
+                      m12);
+  dst_rgb(x, y, c) = Halide::cast<uint8_t>(Halide::round(rgb(x, y, c)));
+}
+
+void YuvAffine::schedule() {
+  Halide::Func dst_rgb_func = dst_rgb;
+  Halide::OutputImageParam rgb_output = dst_rgb_func.output_buffer();
+  Halide::Expr output_rgb_channels = rgb_output.dim(2).extent();
+
+  // Rows are independent; split them across the Halide thread pool. The
+  // vectorized implementation is specialized for RGB and RGBA output on images
+  // wide enough to support it.
+  const int vector_size = natural_vector_size<float>();
+  const Expr min_width = rgb_output.dim(0).extent();
+  dst_rgb_func.reorder(c, x, y).parallel(y);
+  for (int channels : {3, 4}) {
+    dst_rgb_func
+        .specialize(output_rgb_channels == channels && min_width >= vector_size)
+        .unroll(c)
+        .vectorize(x, vector_size);
+  }
+
+  // Y and UV planes start at zero. Remove default memory layout constraints
+  // on the UV source so that we accept generic UV (including semi-planar and
+  // planar).
+  src_y.dim(0).set_min(0);
+  src_y.dim(1).set_min(0);
+  src_uv.dim(0).set_min(0);
+  src_uv.dim(1).set_min(0);
+  src_uv.dim(2).set_bounds(0, 2);
+  src_uv.dim(0).set_stride(Expr());
+
+  // Require that the output buffer be interleaved and start at zero.
+  rgb_output.dim(0).set_stride(output_rgb_channels);
+  rgb_output.dim(2).set_stride(1);
+  rgb_output.dim(0).set_min(0);
+  rgb_output.dim(1).set_min(0);
+  rgb_output.dim(2).set_min(0);
+}
+
+}  // namespace
+
+HALIDE_REGISTER_GENERATOR(YuvAffine, yuv_affine_generator)
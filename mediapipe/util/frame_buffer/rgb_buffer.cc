@@ -19,6 +19,8 @@
 #include "mediapipe/util/frame_buffer/buffer_common.h"
 #include "mediapipe/util/frame_buffer/float_buffer.h"
 #include "mediapipe/util/frame_buffer/gray_buffer.h"
+#include "mediapipe/util/frame_buffer/halide/rgb_affine_float_halide.h"
+#include "mediapipe/util/frame_buffer/halide/rgb_affine_halide.h"
 #include "mediapipe/util/frame_buffer/halide/rgb_flip_halide.h"
 #include "mediapipe/util/frame_buffer/halide/rgb_float_halide.h"
 #include "mediapipe/util/frame_buffer/halide/rgb_gray_halide.h"
@@ -130,6 +132,29 @@ bool RgbBuffer::ToFloat(float scale, float offset, FloatBuffer* output) {
   return result == 0;
 }
 
+bool RgbBuffer::WarpAffine(const float matrix[6], bool zero_border,
+                           RgbBuffer* output) {
+  if (output->channels() > channels()) {
+    return false;
+  }
+  const int result = rgb_affine_halide(
+      buffer(), matrix[0], matrix[1], matrix[2], matrix[3], matrix[4],
+      matrix[5], zero_border, output->buffer());
+  return result == 0;
+}
+
+bool RgbBuffer::WarpAffineToFloat(const float matrix[6], bool zero_border,
+                                  float scale, float offset,
+                                  FloatBuffer* output) {
+  if (output->channels() > channels()) {
+    return false;
+  }
+  const int result = rgb_affine_float_halide(
+      buffer(), matrix[0], matrix[1], matrix[2], matrix[3], matrix[4],
+      matrix[5], zero_border, scale, offset, output->buffer());
+  return result == 0;
+}
+
 void RgbBuffer::Initialize(uint8_t* data, int width, int height, bool alpha) {
   const int channels = alpha ? 4 : 3;
   buffer_ = Halide::Runtime::Buffer<uint8_t>::make_interleaved(
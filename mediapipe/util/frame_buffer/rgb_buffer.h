@@ -110,6 +110,21 @@ class RgbBuffer {
   // Performs a RGB to float conversion.
   bool ToFloat(float scale, float offset, FloatBuffer* output);
 
+  // Samples this image through the given affine transform into the output
+  // buffer using bilinear interpolation. `matrix` is a row-major 2x3 matrix
+  // that maps output pixel coordinates to source pixel coordinates, which
+  // allows arbitrarily rotated regions to be cropped and resized in one pass.
+  // Source pixels outside of the image read as zero if `zero_border` is set,
+  // otherwise the nearest edge pixel is replicated.
+  //
+  // The output may have fewer channels than this image (RGBA to RGB).
+  bool WarpAffine(const float matrix[6], bool zero_border, RgbBuffer* output);
+
+  // Identical to the above, but converts the result to float using:
+  //   output = input * scale + offset
+  bool WarpAffineToFloat(const float matrix[6], bool zero_border, float scale,
+                         float offset, FloatBuffer* output);
+
   // Release ownership of the owned backing buffer.
   uint8_t* Release() { return owned_buffer_.release(); }
 
@@ -17,6 +17,9 @@
 #include <utility>
 
 #include "mediapipe/util/frame_buffer/buffer_common.h"
+#include "mediapipe/util/frame_buffer/float_buffer.h"
+#include "mediapipe/util/frame_buffer/halide/yuv_affine_float_halide.h"
+#include "mediapipe/util/frame_buffer/halide/yuv_affine_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_flip_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_resize_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_rgb_halide.h"
@@ -148,5 +151,22 @@ bool YuvBuffer::Convert(bool halve, RgbBuffer* output) {
   return result == 0;
 }
 
+bool YuvBuffer::WarpAffine(const float matrix[6], bool zero_border,
+                           RgbBuffer* output) {
+  const int result = yuv_affine_halide(
+      y_buffer(), uv_buffer(), matrix[0], matrix[1], matrix[2], matrix[3],
+      matrix[4], matrix[5], zero_border, output->buffer());
+  return result == 0;
+}
+
+bool YuvBuffer::WarpAffineToFloat(const float matrix[6], bool zero_border,
+                                  float scale, float offset,
+                                  FloatBuffer* output) {
+  const int result = yuv_affine_float_halide(
+      y_buffer(), uv_buffer(), matrix[0], matrix[1], matrix[2], matrix[3],
+      matrix[4], matrix[5], zero_border, scale, offset, output->buffer());
+  return result == 0;
+}
+
 }  // namespace frame_buffer
 }  // namespace mediapipe
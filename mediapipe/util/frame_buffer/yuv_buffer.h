@@ -22,6 +22,7 @@
 
 namespace mediapipe {
 namespace frame_buffer {
+class FloatBuffer;
 class RgbBuffer;
 
 // YuvBuffer represents a view over a YUV 4:2:0 image.
@@ -120,6 +121,19 @@ class YuvBuffer {
   // two by discarding three of four luminance values in every 2x2 block.
   bool Convert(bool halve, RgbBuffer* output);
 
+  // Samples this image through the given affine transform into the output
+  // RgbBuffer using bilinear interpolation, converting only the sampled pixels
+  // to RGB. `matrix` is a row-major 2x3 matrix that maps output pixel
+  // coordinates to luma pixel coordinates. Source pixels outside of the image
+  // read as black if `zero_border` is set, otherwise the nearest edge pixel is
+  // replicated.
+  bool WarpAffine(const float matrix[6], bool zero_border, RgbBuffer* output);
+
+  // Identical to the above, but converts the RGB result to float using:
+  //   output = input * scale + offset
+  bool WarpAffineToFloat(const float matrix[6], bool zero_border, float scale,
+                         float offset, FloatBuffer* output);
+
   // Release ownership of the owned backing buffer.
   uint8_t* Release() { return owned_buffer_.release(); }
 
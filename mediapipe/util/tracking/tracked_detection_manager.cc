@@ -116,6 +116,22 @@ std::vector<int> TrackedDetectionManager::RemoveObsoleteDetections(
   return ids_to_remove;
 }
 
+std::vector<int> TrackedDetectionManager::RemoveUnconfirmedDetections(
+    int64_t timestamp) {
+  std::vector<int> ids_to_remove;
+  for (auto& existing_detection : detections_) {
+    // Detections replace their duplicates, so the initial timestamp is the
+    // time the object was last detected.
+    if (existing_detection.second->initial_timestamp() < timestamp) {
+      ids_to_remove.push_back(existing_detection.first);
+    }
+  }
+  for (auto idx : ids_to_remove) {
+    detections_.erase(idx);
+  }
+  return ids_to_remove;
+}
+
 std::vector<int> TrackedDetectionManager::RemoveOutOfViewDetections() {
   std::vector<int> ids_to_remove;
   for (auto& existing_detection : detections_) {
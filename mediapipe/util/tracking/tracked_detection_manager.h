@@ -50,6 +50,11 @@ class TrackedDetectionManager {
   // of the detections that are removed.
   std::vector<int> RemoveObsoleteDetections(int64_t timestamp);
 
+  // Removes detections that were last detected, as opposed to updated by
+  // tracking, before |timestamp|. Returns the IDs of the detections that are
+  // removed.
+  std::vector<int> RemoveUnconfirmedDetections(int64_t timestamp);
+
   // TODO: Do we really need this? Pursuit tracker doesn't do well
   // in loop closure. Boxes out of view are usually not attached to objects
   // any more when it's in view again. Returns the IDs of the
@@ -0,0 +1,109 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tracking/tracked_detection_manager.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/util/tracking/tracked_detection.h"
+
+namespace mediapipe {
+namespace {
+
+using ::mediapipe::NormalizedRect;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+NormalizedRect MakeBox(float x_center, float y_center) {
+  NormalizedRect box;
+  box.set_x_center(x_center);
+  box.set_y_center(y_center);
+  box.set_width(0.2);
+  box.set_height(0.2);
+  return box;
+}
+
+std::unique_ptr<TrackedDetection> MakeDetection(int id, int64_t timestamp,
+                                                const NormalizedRect& box) {
+  return std::make_unique<TrackedDetection>(id, timestamp, box);
+}
+
+TEST(TrackedDetectionManagerTest, TrackingDoesNotConfirmDetections) {
+  TrackedDetectionManager manager;
+  EXPECT_THAT(manager.AddDetection(MakeDetection(1, 0, MakeBox(0.25, 0.25))),
+              IsEmpty());
+  EXPECT_THAT(
+      manager.AddDetection(MakeDetection(2, 1000, MakeBox(0.75, 0.75))),
+      IsEmpty());
+  // Tracking keeps both detections up to date, but only the detector
+  // confirms them.
+  EXPECT_THAT(manager.UpdateDetectionLocation(1, MakeBox(0.3, 0.25), 2500),
+              IsEmpty());
+  EXPECT_THAT(manager.UpdateDetectionLocation(2, MakeBox(0.7, 0.75), 2500),
+              IsEmpty());
+
+  EXPECT_THAT(manager.RemoveUnconfirmedDetections(500), ElementsAre(1));
+  EXPECT_EQ(manager.GetNumDetections(), 1);
+  EXPECT_NE(manager.GetTrackedDetection(2), nullptr);
+  EXPECT_THAT(manager.RemoveUnconfirmedDetections(1000), IsEmpty());
+  EXPECT_THAT(manager.RemoveUnconfirmedDetections(1001), ElementsAre(2));
+  EXPECT_EQ(manager.GetNumDetections(), 0);
+}
+
+TEST(TrackedDetectionManagerTest, RedetectionRefreshesConfirmation) {
+  TrackedDetectionManager manager;
+  manager.AddDetection(MakeDetection(1, 100, MakeBox(0.5, 0.5)));
+  manager.UpdateDetectionLocation(1, MakeBox(0.5, 0.5), 1500);
+
+  // The detector finds the object again: the new detection replaces the
+  // tracked one and carries the time of the new detection.
+  EXPECT_THAT(manager.AddDetection(MakeDetection(2, 1500, MakeBox(0.5, 0.5))),
+              ElementsAre(1));
+  const TrackedDetection* detection = manager.GetTrackedDetection(2);
+  ASSERT_NE(detection, nullptr);
+  EXPECT_EQ(detection->initial_timestamp(), 1500);
+  EXPECT_EQ(detection->previous_id(), 1);
+
+  EXPECT_THAT(manager.RemoveUnconfirmedDetections(1000), IsEmpty());
+  EXPECT_EQ(manager.GetNumDetections(), 1);
+}
+
+TEST(TrackedDetectionManagerTest, TrackedDuplicatesKeepLatestDetection) {
+  TrackedDetectionManager manager;
+  // A redetection far from the tracked box, e.g. during fast motion, doesn't
+  // replace it right away.
+  manager.AddDetection(MakeDetection(1, 100, MakeBox(0.25, 0.5)));
+  EXPECT_THAT(manager.AddDetection(MakeDetection(2, 1000, MakeBox(0.75, 0.5))),
+              IsEmpty());
+
+  // Once tracking brings both to the same place, the older detection is the
+  // one removed, so the remaining one is confirmed as of the redetection.
+  EXPECT_THAT(manager.UpdateDetectionLocation(1, MakeBox(0.5, 0.5), 2000),
+              IsEmpty());
+  EXPECT_THAT(manager.UpdateDetectionLocation(2, MakeBox(0.5, 0.5), 2000),
+              ElementsAre(1));
+  const TrackedDetection* detection = manager.GetTrackedDetection(2);
+  ASSERT_NE(detection, nullptr);
+  EXPECT_EQ(detection->initial_timestamp(), 1000);
+  EXPECT_EQ(detection->previous_id(), 1);
+
+  EXPECT_THAT(manager.RemoveUnconfirmedDetections(500), IsEmpty());
+}
+
+}  // namespace
+}  // namespace mediapipe